@@ -0,0 +1,15 @@
+#version 450 core
+
+layout (location=0) in vec4 vColor;
+layout (location=1) in vec2 vTex;
+layout (location=2) in float vIndex;
+
+layout (location=0) out vec4 fFragColor;
+
+uniform sampler2D[150] uTex2d;
+
+void main () {
+float dist = texture2D(uTex2d[int(vIndex)],vTex).r;
+float width = fwidth(dist);
+fFragColor = vec4(1.0,1.0,1.0,smoothstep(0.5 - width, 0.5 + width, dist)) * vColor;
+}
@@ -0,0 +1,163 @@
+/******************************************************************************
+*
+*	\copyright
+*		All content(C) 2023/2024 DigiPen Institute of Technology Singapore.
+*		All rights reserved. Reproduction or disclosure of this file or its
+*		contents without the prior written consent of DigiPen Institute of
+*		Technology is prohibited.
+*
+* *****************************************************************************
+*
+*	@file		AIDecisionJob.cpp
+*
+*	@author		agent
+*
+*	@email		agent\@local
+*
+*	@course		CSD 2401 - Software Engineering Project 3
+*				CSD 2451 - Software Engineering Project 4
+*
+*	@section	Section A
+*
+*	@date		19 October 2026
+*
+* *****************************************************************************
+*
+*	@brief		AI decisions spread across frames
+*
+*	Starting, polling and cancelling the background search of an enemy's
+*	move, and the frame statistics of enemy turns
+*
+******************************************************************************/
+
+#include "AIDecisionJob.h"
+#include "Battle.h"
+#include "debugdiagnostic.h"
+#include <algorithm>
+#include <cmath>
+
+//------------------------------------------------------------------------------------------
+const long long ASYNC_DEADLINE = 250000; //microseconds after which a background search is stopped and plays its best move so far
+//----------------------------------------------------------------------------------------
+
+AIDecisionJob aiDecisionJob;
+
+namespace {
+	using JobClock = std::chrono::steady_clock;
+
+	long long MicrosecondsSince(JobClock::time_point time) {
+		return std::chrono::duration_cast<std::chrono::microseconds>(JobClock::now() - time).count();
+	}
+}
+
+double AIFrameStats::AverageFrameMilliseconds() const {
+	return frames > 0 ? frameMilliseconds / frames : 0.0;
+}
+
+double AIFrameStats::FrameDeviationMilliseconds() const {
+	if (frames == 0) {
+		return 0.0;
+	}
+	double average{ AverageFrameMilliseconds() };
+	return std::sqrt(std::max(frameSquares / frames - average * average, 0.0));
+}
+
+AIDecisionJob::~AIDecisionJob() {
+	Cancel();
+}
+
+/*!
+* \brief Moves the active enemy's decision along
+*
+* Starts a search when none is running for the active enemy, otherwise
+* plays its move once the search is done. A search still running past
+* ASYNC_DEADLINE is told to stop, it unwinds within a few node checks and
+* its move is played on a following update.
+*
+*/
+void AIDecisionJob::Update(BattleSystem* battle) {
+	JobClock::time_point updateStart{ JobClock::now() };
+
+	if (running && battle->activeCharacter->entity != character) {
+		Cancel();
+	}
+
+	if (!running) {
+		Start(battle);
+	}
+	else {
+		++updates;
+		if (done.load(std::memory_order_acquire)) {
+			Finish(battle);
+		}
+		else if (!stop.load(std::memory_order_relaxed) && MicrosecondsSince(start) >= ASYNC_DEADLINE) {
+			stop.store(true, std::memory_order_relaxed);
+			++stats.forced;
+		}
+	}
+
+	stats.worstBlockingMicroseconds = std::max(stats.worstBlockingMicroseconds, MicrosecondsSince(updateStart));
+}
+
+void AIDecisionJob::Start(BattleSystem* battle) {
+	if (!tree) {
+		tree = std::make_unique<TreeManager>();
+	}
+
+	start = JobClock::now();
+	updates = 1;
+	if (!async) {
+		tree->Search(battle);
+		stats.lastLatencyMicroseconds = MicrosecondsSince(start);
+		stats.lastUpdates = updates;
+		++stats.decisions;
+		return;
+	}
+
+	if (!tree->Capture(battle, root, limits)) {
+		return;
+	}
+	//Depth is still limited, the deadline replaces the per frame time budget. The search stays on its own
+	//thread at normal priority, as the time critical pool workers would starve the frame for the whole deadline
+	limits.budgetMicroseconds = 0;
+	limits.threads = 1;
+	limits.stop = &stop;
+
+	character = battle->activeCharacter->entity;
+	done.store(false, std::memory_order_relaxed);
+	stop.store(false, std::memory_order_relaxed);
+	running = true;
+	thread = std::thread([this]() {
+		result = tree->SearchState(tree->GetContext(), root, limits);
+		done.store(true, std::memory_order_release);
+	});
+}
+
+void AIDecisionJob::Finish(BattleSystem* battle) {
+	thread.join();
+	running = false;
+
+	lastSearchResult = result;
+	tree->Decide(result);
+	stats.lastLatencyMicroseconds = MicrosecondsSince(start);
+	stats.lastUpdates = updates;
+	++stats.decisions;
+}
+
+void AIDecisionJob::Cancel() {
+	if (!running) {
+		return;
+	}
+	stop.store(true, std::memory_order_relaxed);
+	thread.join();
+	running = false;
+	DEBUG_PRINT("AI decision cancelled after %lld us", MicrosecondsSince(start));
+}
+
+void AIDecisionJob::SampleFrame(float dt) {
+	float milliseconds{ dt * 1000.f };
+	++stats.frames;
+	stats.frameMilliseconds += milliseconds;
+	stats.frameSquares += static_cast<double>(milliseconds) * milliseconds;
+	stats.worstFrameMilliseconds = std::max(stats.worstFrameMilliseconds, milliseconds);
+}
@@ -0,0 +1,101 @@
+/******************************************************************************
+*
+*	\copyright
+*		All content(C) 2023/2024 DigiPen Institute of Technology Singapore.
+*		All rights reserved. Reproduction or disclosure of this file or its
+*		contents without the prior written consent of DigiPen Institute of
+*		Technology is prohibited.
+*
+* *****************************************************************************
+*
+*	@file		AIDecisionJob.h
+*
+*	@author		agent
+*
+*	@email		agent\@local
+*
+*	@course		CSD 2401 - Software Engineering Project 3
+*				CSD 2451 - Software Engineering Project 4
+*
+*	@section	Section A
+*
+*	@date		19 October 2026
+*
+* *****************************************************************************
+*
+*	@brief		AI decisions spread across frames
+*
+*	When an enemy's turn starts, the battle is captured into a simulation
+*	state on the game thread and searched on a single background thread
+*	at normal priority, leaving the thread pool to the frame, while
+*	the enemy waits and the battle keeps animating. The move is played on
+*	the first battle update after the search completes, or once
+*	ASYNC_DEADLINE has passed, when the search is stopped and plays the
+*	best move of its last completed depth. Loading a scene cancels the
+*	search and discards its move.
+*
+*	With async off the search runs within the battle update as before,
+*	and the same frame statistics are kept to compare the two.
+*
+******************************************************************************/
+
+#pragma once
+#include "GameAITree.h"
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <thread>
+
+//Frame times of the battle while enemies take their turns, for the performance window
+struct AIFrameStats {
+	size_t decisions{};
+	size_t forced{};						//decisions stopped by the deadline
+	size_t frames{};						//battle updates sampled during enemy turns
+	double frameMilliseconds{};				//sum of the sampled frame times
+	double frameSquares{};					//sum of the squared frame times, for the deviation
+	float worstFrameMilliseconds{};
+	long long worstBlockingMicroseconds{};	//longest a battle update was held up by the AI
+	long long lastLatencyMicroseconds{};	//from the start of the last decision to its move
+	int lastUpdates{};						//battle updates the last decision was spread across
+
+	double AverageFrameMilliseconds() const;
+	double FrameDeviationMilliseconds() const;
+};
+
+class AIDecisionJob {
+public:
+	~AIDecisionJob();
+
+	//Called by the battle every update while the active enemy waits for a move, starts its search or plays its move once found
+	void Update(BattleSystem* battle);
+	//Stops the running search and discards its move
+	void Cancel();
+	//Records the frame time of a battle update during an enemy turn
+	void SampleFrame(float dt);
+
+	bool IsRunning() const { return running; }
+
+	bool async{ true };		//searches on a background thread instead of within the battle update
+	AIFrameStats stats{};
+
+private:
+	//Captures the battle and starts the search, or searches right away when not async
+	void Start(BattleSystem* battle);
+	//Plays the move of the finished search
+	void Finish(BattleSystem* battle);
+
+	std::unique_ptr<TreeManager> tree{};	//created on first use, its random stream is seeded from the random service
+	std::thread thread{};
+	std::atomic<bool> done{};
+	std::atomic<bool> stop{};
+	bool running{};
+	Entity character{};
+
+	BattleSimState root{};
+	SearchLimits limits{};
+	SearchResult result{};
+	std::chrono::steady_clock::time_point start{};
+	int updates{};
+};
+
+extern AIDecisionJob aiDecisionJob;
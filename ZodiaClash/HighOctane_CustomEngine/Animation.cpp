@@ -39,7 +39,7 @@
 #include "Global.h"
 #include "Camera.h"
 #include "Layering.h"
-#include <random>
+#include "Random.h"
 
 void AnimationSet::Initialise(Entity entity) {
 	Start(defaultAnimation, entity);
@@ -113,7 +113,6 @@ AnimationSet& AnimationSet::operator= (const AnimationSet& copy) {
 	initialised = copy.initialised;
 	animationSet = copy.animationSet;
 	defaultAnimation = copy.defaultAnimation;
-	animationQueue = copy.animationQueue;
 	activeAnimation = nullptr;
 	if (copy.activeAnimation != nullptr) {
 		for (auto& animation : animationSet) {
@@ -123,6 +122,18 @@ AnimationSet& AnimationSet::operator= (const AnimationSet& copy) {
 			}
 		}
 	}
+	//Queued animations point into the copied set, so queue this set's animations of the same names
+	animationQueue = {};
+	std::queue<AnimationGroup*> queued{ copy.animationQueue };
+	while (!queued.empty()) {
+		for (auto& animation : animationSet) {
+			if (animation.name == queued.front()->name) {
+				animationQueue.push(&animation);
+				break;
+			}
+		}
+		queued.pop();
+	}
 	return *this;
 }
 
@@ -540,19 +551,16 @@ void SoundAnimation::Update(int frameNum) {
 	}
 	if (frameNum >= nextKeyframe->frameNum) {
 		//Play sound
-		std::random_device rd;
-		std::mt19937 gen(rd());
 		std::string soundGroup{ "SFX" };
 		if (nextKeyframe->data.size() > 0) {
-			std::uniform_int_distribution<int> dis(0, (int)nextKeyframe->data.size() - 1);
-			int num{ dis(gen) };
-			FMOD::Channel* channel = assetmanager.audio.PlaySounds(nextKeyframe->data[num].c_str(), soundGroup.c_str());
+			int num{ randomService.Stream(RandomStream::AUDIO).RangeInt(0, (int)nextKeyframe->data.size() - 1) };
+			AudioChannelHandle channel = assetmanager.audio.PlaySounds(nextKeyframe->data[num].c_str(), soundGroup.c_str());
 			float offset{ 0.f };
 			if (ECS::ecs().GetComponent<Model>(parent).type == ModelType::GAMEPLAY) {
 				offset = camera.GetPos().x;
 			}
 			float pan{ (ECS::ecs().GetComponent<Transform>(parent).position.x - offset) / GRAPHICS::defaultWidthF };
-			channel->setPan(pan);
+			assetmanager.audio.SetChannelPan(channel, pan);
 		}
 		nextKeyframe++;
 		if (nextKeyframe == keyframes.end()) {
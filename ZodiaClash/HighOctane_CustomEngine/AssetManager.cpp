@@ -43,31 +43,63 @@
 #include "Layering.h"
 #include "UndoRedo.h"
 #include "Global.h"
+#include "TextureCache.h"
+#include "GameAILogic.h"
+#include "ECS.h"
+#include "Components.h"
+#include "SceneCache.h"
+#include "JsonStream.h"
+#include "SceneSaver.h"
+#include "AssetPack.h"
+#include "MultiThreading.h"
+#include <rapidjson-master/include/rapidjson/document.h>
 #include <cwchar>
 #include <filesystem>
+#include <chrono>
 //#define STB_IMAGE_IMPLEMENTATION
 #include <stb-master/stb_image.h>
 
 AssetManager assetmanager;
 
-void AssetManager::Initialize() {
+bool AssetManager::FindDefaultPath() {
     const std::string initFilePath = "init.txt";
     defaultPath = "Assets/";
-    std::string path{defaultPath + initFilePath};
     Serializer serializer;
-    if (!serializer.Open(path)) {
+    if (!serializer.Open(defaultPath + initFilePath)) {
         defaultPath = "../Assets/";
-        path = defaultPath + initFilePath;
-        if (!serializer.Open(path)) {
-            ASSERT(1, "Unable to initialize asset manager!");
-            return;
+        if (!serializer.Open(defaultPath + initFilePath)) {
+            return false;
         }
     }
+    return true;
+}
+
+void AssetManager::Initialize() {
+    const std::string initFilePath = "init.txt";
+    if (!FindDefaultPath()) {
+        ASSERT(1, "Unable to initialize asset manager!");
+        return;
+    }
+    // Assets are read from the pack when one was built with --pack
+    auto packStart{ std::chrono::high_resolution_clock::now() };
+    if (assetpack.Open(defaultPath + AssetPack::FILE_NAME, defaultPath)) {
+        std::chrono::duration<double, std::milli> packTime{ std::chrono::high_resolution_clock::now() - packStart };
+        DEBUG_PRINT("%s mapped in %.2f ms, %zu files", AssetPack::FILE_NAME, packTime.count(), assetpack.GetEntryCount());
+    }
+
+    std::string path{defaultPath + initFilePath};
+    Serializer serializer;
+    serializer.Open(path);
 
     audio.Initialize();
     fonts.Initialize();
     attacks.LoadAllAttacks();
+    GameAILogic::LoadWeights(defaultPath + "AI/Evaluation.json");
 
+    // Time the init.txt assets so startup can be compared with and without the texture cache
+    texturecache.ResetStats();
+    holder = initFilePath;
+    auto initStart{ std::chrono::high_resolution_clock::now() };
     while (!serializer.stream.eof()) {
         path.clear();
         serializer.ReadString(path);
@@ -75,6 +107,10 @@ void AssetManager::Initialize() {
             LoadAssets(path);
         }
     }
+    std::chrono::duration<double, std::milli> initTime{ std::chrono::high_resolution_clock::now() - initStart };
+    DEBUG_PRINT("init.txt assets loaded in %.2f ms (texture cache %s: %zu cached, %zu decoded, asset pack %s: %zu files read)",
+        initTime.count(), texturecache.enabled ? "on" : "off", texturecache.GetHits(), texturecache.GetMisses(),
+        assetpack.IsOpen() && assetpack.enabled ? "on" : "off", assetpack.GetHits());
 
     UpdatePrefabPaths();
     colors.ReadColors();
@@ -87,6 +123,164 @@ void AssetManager::UnloadAll() {
     fonts.Clear();
     prefabMap.clear();
     layering.clear();
+    heldAssets.clear();
+    holderCounts.clear();
+}
+
+void AssetManager::ChangeScene(const std::string& scenePath) {
+    auto switchStart{ std::chrono::high_resolution_clock::now() };
+    size_t loadedBefore{ assetsLoaded };
+    size_t reusedBefore{ assetsReused };
+    lastSwitch = SceneSwitchStats{};
+    lastSwitch.scene = scenePath;
+    lastSwitch.keptShared = keepSharedAssets;
+
+    if (keepSharedAssets) {
+        std::string oldScene{ sceneName };
+        layering.clear();
+        audio.ResetSceneAudio();
+        holder = scenePath;
+        if (scenePath != "") {
+            LoadAssets(scenePath);
+        }
+        // Released after the new scene is loaded, so assets both scenes use are never unloaded
+        if (oldScene != scenePath) {
+            ReleaseAssets(oldScene);
+        }
+    }
+    else {
+        UnloadAll();
+        holder = scenePath;
+        if (scenePath != "") {
+            LoadAssets(scenePath);
+        }
+    }
+
+    std::chrono::duration<double, std::milli> switchTime{ std::chrono::high_resolution_clock::now() - switchStart };
+    lastSwitch.milliseconds = switchTime.count();
+    lastSwitch.loaded = assetsLoaded - loadedBefore;
+    lastSwitch.reused = assetsReused - reusedBefore;
+    DEBUG_PRINT("Changed scene to %s in %.2f ms (%s: %zu assets loaded, %zu kept loaded, %zu unloaded)",
+        scenePath.c_str(), lastSwitch.milliseconds, keepSharedAssets ? "shared assets kept" : "all assets unloaded",
+        lastSwitch.loaded, lastSwitch.reused, lastSwitch.released);
+}
+
+int AssetManager::GetHolderCount(const std::string& assetPath) {
+    auto count{ holderCounts.find(assetPath) };
+    return count == holderCounts.end() ? 0 : count->second;
+}
+
+SceneSwitchStats const& AssetManager::GetLastSceneSwitch() {
+    return lastSwitch;
+}
+
+bool AssetManager::HoldAsset(const std::string& assetPath) {
+    bool loaded{ IsLoaded(assetPath) };
+    if (heldAssets[holder].insert(assetPath).second) {
+        ++holderCounts[assetPath];
+        loaded ? ++assetsReused : ++assetsLoaded;
+    }
+    return loaded;
+}
+
+bool AssetManager::IsLoaded(const std::string& assetPath) {
+    auto tex{ texture.data.find(assetPath) };
+    if (tex != texture.data.end() && tex->second.IsActive()) {
+        return true;
+    }
+    return audio.IsLoaded(assetPath.c_str()) || prefabMap.count(assetPath) != 0;
+}
+
+bool AssetManager::ReleaseAsset(const std::string& assetPath, const std::unordered_set<Texture*>& texturesInUse) {
+    auto tex{ texture.data.find(assetPath) };
+    if (tex != texture.data.end()) {
+        // Tex components point into the texture map, so a texture still drawn stays until a later scene change
+        if (texturesInUse.count(&tex->second)) {
+            return false;
+        }
+        texture.Remove(assetPath.c_str());
+    }
+    if (audio.IsLoaded(assetPath.c_str())) {
+        audio.FreeSound(assetPath.c_str());
+    }
+    auto prefab{ prefabMap.find(assetPath) };
+    if (prefab != prefabMap.end()) {
+        Entity entity{ prefab->second };
+        if (ECS::ecs().EntityExists(entity)) {
+            if (ECS::ecs().HasComponent<Parent>(entity)) {
+                for (Entity child : ECS::ecs().GetComponent<Parent>(entity).children) {
+                    if (ECS::ecs().EntityExists(child)) {
+                        ECS::ecs().DestroyEntity(child);
+                    }
+                }
+            }
+            ECS::ecs().DestroyEntity(entity);
+        }
+        prefabMap.erase(prefab);
+    }
+    return true;
+}
+
+void AssetManager::HoldAssets(const std::string& holderName, const std::vector<std::string>& assets) {
+    std::string sceneHolder{ holder };
+    holder = holderName;
+    for (const std::string& asset : assets) {
+        HoldAsset(asset);
+    }
+    holder = sceneHolder;
+}
+
+void AssetManager::RestoreScene(const std::string& scenePath, const std::vector<std::string>& assets) {
+    std::string oldScene{ sceneName };
+    holder = scenePath;
+    for (const std::string& asset : assets) {
+        HoldAsset(asset);
+    }
+    sceneName = scenePath;
+    if (oldScene != scenePath) {
+        ReleaseAssets(oldScene);
+    }
+}
+
+void AssetManager::ReleaseAssets(const std::string& holderName) {
+    auto held{ heldAssets.find(holderName) };
+    if (held != heldAssets.end()) {
+        for (const std::string& asset : held->second) {
+            --holderCounts[asset];
+        }
+        heldAssets.erase(held);
+    }
+
+    // Prefabs first, as their entities may be the only ones still using a texture
+    std::unordered_set<Texture*> noTextures{};
+    for (auto it{ holderCounts.begin() }; it != holderCounts.end();) {
+        if (it->second <= 0 && prefabMap.count(it->first)) {
+            ReleaseAsset(it->first, noTextures);
+            ++lastSwitch.released;
+            it = holderCounts.erase(it);
+        }
+        else {
+            ++it;
+        }
+    }
+
+    std::unordered_set<Texture*> texturesInUse{};
+    for (Tex* tex : ECS::ecs().GetComponentManager().GetComponentArrayRef<Tex>().GetDataArray()) {
+        texturesInUse.insert(tex->tex);
+        for (Texture* variant : tex->texVariants) {
+            texturesInUse.insert(variant);
+        }
+    }
+    // Assets kept because they were in use stay at zero holders and are tried again on the next change
+    for (auto it{ holderCounts.begin() }; it != holderCounts.end();) {
+        if (it->second <= 0 && ReleaseAsset(it->first, texturesInUse)) {
+            ++lastSwitch.released;
+            it = holderCounts.erase(it);
+        }
+        else {
+            ++it;
+        }
+    }
 }
 
 /**************************************TEXTURES**************************************************/
@@ -215,7 +409,7 @@ void AssetManager::UnloadPrefab(const std::string& prefabName) {
 }
 
 Entity AssetManager::GetPrefab(const std::string& prefabName) {
-    if (prefabName != "" && prefabMap.count(prefabName) == 0) {
+    if (prefabName != "" && !HoldAsset(prefabName)) {
         LoadPrefab(prefabName);
     }
     return prefabMap[prefabName];
@@ -231,14 +425,53 @@ std::string AssetManager::GetPrefabName(Entity prefabID) {
 }
 
 void AssetManager::UpdatePrefabPaths() {
-    std::filesystem::path prefabFolder{ assetmanager.GetDefaultPath() + "Prefabs/" };
-    std::vector<std::string> newPrefabPaths{};
-    for (auto& entry : std::filesystem::directory_iterator(prefabFolder)) {
-        std::string path{ entry.path().string() };
-        path = path.substr(path.find_last_of("/") + 1);
-        newPrefabPaths.push_back(path);
+    SetPrefabPaths(FilePath::ListFileNames(defaultPath + "Prefabs/"));
+}
+
+void AssetManager::SetPrefabPaths(std::vector<std::string> paths) {
+    prefabPaths = std::move(paths);
+}
+
+void AssetManager::ReloadPrefab(const std::string& prefabName, const rapidjson::Value& document) {
+    auto prefab{ prefabMap.find(prefabName) };
+    if (prefab == prefabMap.end() || !ECS::ecs().EntityExists(prefab->second)) {
+        return;
+    }
+    Entity reloaded{ Serializer::LoadEntityFromDocument(defaultPath + "Prefabs/" + prefabName, document, true) };
+    if (reloaded == 0) {
+        return;
+    }
+
+    // The prefab keeps its entity, as the editor and the clones refer to it. Children are not reloaded
+    auto& typeManager{ ECS::ecs().GetTypeManager() };
+    std::unordered_set<std::string> skipped{ typeid(Parent).name(), typeid(Child).name(), typeid(Clone).name() };
+    for (auto& ecsType : typeManager) {
+        if (!skipped.count(ecsType.second->name) && ecsType.second->HasComponent(reloaded)) {
+            ecsType.second->CopyComponent(prefab->second, reloaded);
+        }
+    }
+    if (ECS::ecs().HasComponent<Parent>(reloaded)) {
+        for (Entity child : ECS::ecs().GetComponent<Parent>(reloaded).children) {
+            ECS::ecs().DestroyEntity(child);
+        }
+    }
+    ECS::ecs().DestroyEntity(reloaded);
+
+    // Same as the prefab editor, clones take every component they did not change themselves
+    skipped.insert(typeid(Master).name());
+    auto& cloneArray{ ECS::ecs().GetComponentManager().GetComponentArrayRef<Clone>() };
+    for (Entity cloneEntity : cloneArray.GetEntityArray()) {
+        Clone const& clone{ cloneArray.GetData(cloneEntity) };
+        if (clone.prefab != prefabName) {
+            continue;
+        }
+        std::unordered_set<std::string> uniqueComponents{ clone.unique_components };
+        for (auto& ecsType : typeManager) {
+            if (!skipped.count(ecsType.second->name) && !uniqueComponents.count(ecsType.second->name) && ecsType.second->HasComponent(prefab->second)) {
+                ecsType.second->CopyComponent(cloneEntity, prefab->second);
+            }
+        }
     }
-    prefabPaths = newPrefabPaths;
 }
 
 std::unordered_map<std::string, Entity>& AssetManager::GetPrefabMap() {
@@ -250,41 +483,158 @@ std::vector<std::string> AssetManager::GetPrefabPaths() {
 }
 
 void AssetManager::LoadAllPrefabs() {
-    for (std::string path : prefabPaths) {
-        LoadPrefab(path);
+    PreloadPrefabs(prefabPaths, false);
+}
+
+/*!
+ * \brief A prefab file parsed on a worker thread
+ *
+ * Parsing and cooking only read and write the prefab's own files, so they
+ * run off the main thread. Creating its entities is left to CommitPrefabs.
+ *
+ */
+struct ParsedPrefab {
+    std::string name{};
+    std::string path{};
+    std::vector<char> buffer{};         //file text, the document's strings point into it
+    rapidjson::Document document{};
+    bool parsed{};                      //false if it is loaded from its cooked container, or could not be parsed
+};
+
+namespace {
+    void ParsePrefab(ParsedPrefab& prefab) {
+        if (scenecache.IsCooked(prefab.path) || !ReadJsonFile(prefab.path, prefab.buffer)) {
+            return;
+        }
+        prefab.document.ParseInsitu(prefab.buffer.data());
+        if (prefab.document.HasParseError() || !prefab.document.IsArray()) {
+            return;
+        }
+        prefab.parsed = true;
+
+        SceneCooker cooker;
+        for (const rapidjson::Value& entry : prefab.document.GetArray()) {
+            cooker.Add(entry);
+        }
+        scenecache.Cook(prefab.path, cooker);
     }
 }
 
+PrefabBatch AssetManager::ParsePrefabs(const std::vector<std::string>& prefabNames) {
+    PrefabBatch batch{};
+    std::unordered_set<std::string> queued{};
+    ThreadPool& pool{ ThreadPool::threadPool() };
+    for (const std::string& name : prefabNames) {
+        if (name == "" || !queued.insert(name).second) {
+            continue;
+        }
+        auto prefab{ std::make_shared<ParsedPrefab>() };
+        prefab->name = name;
+        prefab->path = defaultPath + "Prefabs/" + name;
+        batch.prefabs.push_back(prefab);
+        if (prefabMap.count(name)) {
+            batch.parsing.emplace_back();
+            continue;
+        }
+
+        auto task{ std::make_shared<std::packaged_task<void()>>([prefab]() { ParsePrefab(*prefab); }) };
+        batch.parsing.push_back(task->get_future());
+        if (pool.GetThreadCount() == 0) {
+            (*task)();
+        }
+        else {
+            pool.Enqueue([task]() { (*task)(); });
+        }
+    }
+    return batch;
+}
+
+void AssetManager::CommitPrefabs(PrefabBatch& batch, bool hold) {
+    // Every file is written before any prefab is added, as adding one may load a prefab it clones from file
+    for (std::future<void>& parsing : batch.parsing) {
+        if (parsing.valid()) {
+            parsing.wait();
+        }
+    }
+
+    auto commitStart{ std::chrono::high_resolution_clock::now() };
+    size_t committed{};
+    for (std::shared_ptr<ParsedPrefab>& prefab : batch.prefabs) {
+        // Also skips prefabs another prefab of the batch cloned from, which loaded them already
+        bool loaded{ hold ? HoldAsset(prefab->name) : prefabMap.count(prefab->name) != 0 };
+        if (loaded) {
+            continue;
+        }
+        prefabMap[prefab->name] = prefab->parsed ? Serializer::LoadEntityFromDocument(prefab->path, prefab->document, true)
+            : Serializer::LoadEntityFromJson(prefab->path, true);
+        ++committed;
+    }
+    if (committed > 0) {
+        std::chrono::duration<double, std::milli> commitTime{ std::chrono::high_resolution_clock::now() - commitStart };
+        DEBUG_PRINT("Preloaded %zu prefabs, added to the ECS in %.2f ms", committed, commitTime.count());
+    }
+    batch = PrefabBatch{};
+}
+
+void AssetManager::PreloadPrefabs(const std::vector<std::string>& prefabNames, bool hold) {
+    PrefabBatch batch{ ParsePrefabs(prefabNames) };
+    CommitPrefabs(batch, hold);
+}
+
 /**********************************GENERIC METHODS*********************************************/
 bool AssetManager::FileExists(const std::string& path) {
-    return std::filesystem::exists(path);
+    return assetpack.Contains(path) || std::filesystem::exists(path);
 }
 
 void AssetManager::LoadScene(const std::string& scenePath) {
     Serializer serializer;
     std::string path{ defaultPath };
     path += "Scenes/" + scenePath;
+    std::vector<std::string> assets{};
     if (serializer.Open(path)) {
         while (!serializer.stream.eof()) {
             path.clear();
             serializer.ReadString(path);
             if (path != "") {
-                LoadAssets(path);
+                assets.push_back(path);
             }
         }
     }
+
+    // Prefabs listed by the scene are parsed on the thread pool while its other assets load,
+    // and added before its entities, so the game does not load them the first time it clones them
+    std::vector<std::string> prefabs{};
+    for (const std::string& asset : assets) {
+        if (FilePath::GetFileExtension(asset) == ".prefab") {
+            prefabs.push_back(asset);
+        }
+    }
+    PrefabBatch batch{ ParsePrefabs(prefabs) };
+    for (const std::string& asset : assets) {
+        std::string extension{ FilePath::GetFileExtension(asset) };
+        if (extension == ".prefab") {
+            loadedFiles.push_back(asset);
+            continue;
+        }
+        if (extension == ".json") {
+            CommitPrefabs(batch);
+        }
+        LoadAssets(asset);
+    }
+    CommitPrefabs(batch);
     sceneName = scenePath;
 }
 
 void AssetManager::SaveScene(const std::string& scenePath) {
     std::ofstream sceneFile{ scenePath.c_str() };
+    assetpack.Evict(scenePath);
 
     std::string jsonPath{ scenePath.substr(0,scenePath.find(".scn")) + ".json" };
     std::vector<Entity> entityList{};
     for (auto& e : s_ptr->m_Entities) {
         entityList.push_back(e);
     }
-    Serializer::SaveEntityToJson(jsonPath, entityList);
+    sceneSaver.Save(jsonPath, entityList);
 
     std::string currentBGM{ audio.GetCurrentBGM() };
     if (currentBGM != "") {
@@ -308,6 +658,7 @@ void AssetManager::SaveScene(const std::string& scenePath) {
 
 void AssetManager::SaveSceneAssets(const std::string& scenePath) {
     std::ofstream sceneFile{ scenePath.c_str() };
+    assetpack.Evict(scenePath);
 
     std::string currentBGM{ audio.GetCurrentBGM() };
     if (currentBGM != "") {
@@ -384,6 +735,15 @@ void AssetManager::LoadAssets(const std::string& assetPath) {
         return;
     }
 
+    // Textures and sounds another scene already loaded are only held by this one as well.
+    // Music and ambience still go through the loaders so the scene starts playing them.
+    bool isTexture{ extension == ".png" || extension == ".jpg" || extension == ".jpeg" || extension == ".bmp" || extension == ".spritesheet" };
+    bool isAudio{ extension == ".wav" || extension == ".ogg" };
+    if ((isTexture || isAudio) && HoldAsset(assetPath) && isTexture) {
+        loadedFiles.push_back(assetPath);
+        return;
+    }
+
     if (extension == ".png" || extension == ".jpg" || extension == ".jpeg" || extension == ".bmp") {
         // Load as a texture
         LoadTexture(assetPath);
@@ -434,6 +794,9 @@ void AssetManager::LoadAssets(const std::string& assetPath) {
     else if (extension == ".json") {
         LoadEntities(assetPath);
     }
+    else if (extension == ".prefab") {
+        PreloadPrefabs({ assetPath });
+    }
     else if (extension == ".skill") {
         //LoadAttack(assetPath);
     }
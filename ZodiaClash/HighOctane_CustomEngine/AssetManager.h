@@ -37,12 +37,34 @@
 #pragma once
 #include <iostream>
 #include <unordered_map>
+#include <unordered_set>
 #include <filesystem>
+#include <future>
+#include <memory>
 #include "AudioManager.h"
 #include "Font.h"
 #include "texture.h"
 #include "Colors.h"
 #include "Attack.h"
+#include <rapidjson-master/include/rapidjson/fwd.h>
+
+//Timing and asset counts of the last scene change
+struct SceneSwitchStats {
+    std::string scene{};        //scene changed to
+    double milliseconds{};      //time taken to release the old scene's assets and load the new scene
+    size_t loaded{};            //assets the new scene loaded from file
+    size_t reused{};            //assets the new scene found already loaded
+    size_t released{};          //assets unloaded as no scene holds them anymore
+    bool keptShared{};          //false if the change unloaded everything like UnloadAll
+};
+
+struct ParsedPrefab;
+
+//Prefab files being parsed on the thread pool, added to the ECS by AssetManager::CommitPrefabs
+struct PrefabBatch {
+    std::vector<std::shared_ptr<ParsedPrefab>> prefabs{};
+    std::vector<std::future<void>> parsing{};   //one per prefab, not valid for prefabs already loaded
+};
 
 class AssetManager {
 public:
@@ -64,13 +86,16 @@ public:
     //Returns the full folder directory that the game assets folder is located in
     std::string GetDefaultPath();
 
+    //Finds the assets folder from the working directory without loading anything, for tools that run without graphics or audio
+    bool FindDefaultPath();
+
     //Returns a list of all assets loaded by the asset manager
     std::vector<std::string> GetFiles();
 
     //Initialises the asset manager
     void Initialize();
 
-    //Unloads ALL assets, to be called when changing scene
+    //Unloads ALL assets, used when changing scene with keepSharedAssets off
     void UnloadAll();
 
     //Returns true if the path exists
@@ -91,6 +116,28 @@ public:
     //Loads the cursor image
     void LoadMouseCursor(const std::string& curPath);
 
+    /***********************************************
+    RESIDENCY METHODS
+    Textures, sprite sheets, sounds and prefabs are held by the scene
+    that loaded them, and by init.txt for those loaded on start up.
+    An asset stays loaded while any scene holds it.
+    ***********************************************/
+    //When false, changing scene unloads every asset and loads the new scene from nothing
+    bool keepSharedAssets{ true };
+    //Changes to the scene using input scene path, loading only the assets that are not loaded
+    //and unloading only those that the old scene held and the new scene does not
+    void ChangeScene(const std::string& scenePath);
+    //Returns the number of scenes holding the asset
+    int GetHolderCount(const std::string& assetPath);
+    //Returns the timing and asset counts of the last scene change
+    SceneSwitchStats const& GetLastSceneSwitch();
+    //Holds the assets for holderName as well as the scene, so they stay loaded across scene changes
+    void HoldAssets(const std::string& holderName, const std::vector<std::string>& assets);
+    //Drops the hold of a scene or holderName on its assets and unloads those nothing holds anymore
+    void ReleaseAssets(const std::string& holderName);
+    //Makes scenePath the current scene again, holding assets, and releases the scene changed to since
+    void RestoreScene(const std::string& scenePath, const std::vector<std::string>& assets);
+
     /***********************************************
     TEXTURE METHODS
     ***********************************************/
@@ -134,18 +181,42 @@ public:
     std::string GetPrefabName(Entity prefabID);
     //Updates prefab path with all prefabs in prefab folder
     void UpdatePrefabPaths();
+    //Replaces the prefab paths with a list of the prefab folder made elsewhere
+    void SetPrefabPaths(std::vector<std::string> paths);
+    //Loads a prefab again from its parsed file into the prefab's entity, and copies its components to its clones
+    void ReloadPrefab(const std::string& prefabName, const rapidjson::Value& document);
     //Returns vector of strings of all prefabs in prefab folder (does not load them)
     std::vector<std::string> GetPrefabPaths();
     //Returns reference to the prefab map
     std::unordered_map<std::string, Entity>& GetPrefabMap(); 
     //Loads ALL prefabs, for editor asset library
     void LoadAllPrefabs();
+    //Starts parsing the files of the prefabs that are not loaded yet on the thread pool
+    PrefabBatch ParsePrefabs(const std::vector<std::string>& prefabNames);
+    //Waits for the batch to be parsed and adds its prefabs to the ECS, held by the scene being loaded if hold is true
+    void CommitPrefabs(PrefabBatch& batch, bool hold = true);
+    //Loads the prefabs with their files parsed in parallel
+    void PreloadPrefabs(const std::vector<std::string>& prefabNames, bool hold = true);
 
 private:
     std::string defaultPath{};
     std::vector<std::string> loadedFiles{};
     std::unordered_map<std::string, Entity> prefabMap{};
     std::vector<std::string> prefabPaths{}; //list of all prefabs in prefab folder
+
+    //Adds the asset to the assets held by the scene being loaded, returns true if it is already loaded
+    bool HoldAsset(const std::string& assetPath);
+    //Returns true if the asset is loaded
+    bool IsLoaded(const std::string& assetPath);
+    //Unloads an asset no scene holds, returns false if a live entity still uses it
+    bool ReleaseAsset(const std::string& assetPath, const std::unordered_set<Texture*>& texturesInUse);
+
+    std::string holder{};   //scene the assets being loaded are held by
+    std::unordered_map<std::string, std::unordered_set<std::string>> heldAssets{};  //assets held by each scene
+    std::unordered_map<std::string, int> holderCounts{};   //number of scenes holding each asset
+    size_t assetsLoaded{};  //assets loaded from file when first held by a scene
+    size_t assetsReused{};  //assets already loaded when first held by a scene
+    SceneSwitchStats lastSwitch{};
 };
 
 extern AssetManager assetmanager;
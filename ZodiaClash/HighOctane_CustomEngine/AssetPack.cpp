@@ -0,0 +1,389 @@
+/******************************************************************************
+*
+*	\copyright
+*		All content(C) 2023/2024 DigiPen Institute of Technology Singapore.
+*		All rights reserved. Reproduction or disclosure of this file or its
+*		contents without the prior written consent of DigiPen Institute of
+*		Technology is prohibited.
+*
+* *****************************************************************************
+*
+*	@file		AssetPack.cpp
+*
+*	@author		agent
+*
+*	@email		agent\@local
+*
+*	@course		CSD 2401 - Software Engineering Project 3
+*				CSD 2451 - Software Engineering Project 4
+*
+*	@section	Section A
+*
+*	@date		19 October 2026
+*
+* *****************************************************************************
+*
+*	@brief		Packed asset archive (.zpak)
+*
+*	Building, validation and lookup of .zpak archives, the --pack command
+*	line and the read benchmark.
+*
+******************************************************************************/
+
+#include "AssetPack.h"
+#include "AssetManager.h"
+#include "debugdiagnostic.h"
+
+#include <algorithm>
+#include <cctype>
+#include <chrono>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <vector>
+
+AssetPack assetpack;
+
+namespace {
+	constexpr uint32_t ZPAK_VERSION{ 1 };
+	constexpr uint32_t ZPAK_ALIGNMENT{ 16 };
+
+	//Lower case with forward slashes, so paths match however they were written
+	std::string NormalizePath(const std::string& path) {
+		std::string normalized{ path };
+		for (char& c : normalized) {
+			c = c == '\\' ? '/' : static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
+		}
+		return normalized;
+	}
+
+	uint64_t HashPath(const std::string& normalizedPath) {
+		uint64_t hash{ 14695981039346656037ull };
+		for (char c : normalizedPath) {
+			hash = (hash ^ static_cast<uint8_t>(c)) * 1099511628211ull;
+		}
+		return hash;
+	}
+
+	void Pad(std::ofstream& output, uint64_t alignment) {
+		static const char zeros[ZPAK_ALIGNMENT]{};
+		uint64_t position{ static_cast<uint64_t>(output.tellp()) };
+		output.write(zeros, static_cast<std::streamsize>((alignment - position % alignment) % alignment));
+	}
+
+	//Folders and files that are written while the game runs are not packed
+	bool IsPacked(const std::string& relativePath) {
+		std::string normalized{ NormalizePath(relativePath) };
+		std::string extension{ std::filesystem::path{ normalized }.extension().string() };
+		return normalized.rfind("cache/", 0) != 0 && normalized.rfind("scenes/autosave/", 0) != 0
+			&& extension != ".zpak" && extension != ".tmp";
+	}
+}
+
+bool AssetPack::Open(const std::string& packPath, const std::string& assetsFolder) {
+	Close();
+	if (!file.Open(packPath) || file.Size() < sizeof(ZpakHeader)) {
+		file.Close();
+		return false;
+	}
+	std::memcpy(&header, file.Data(), sizeof(ZpakHeader));
+	size_t size{ file.Size() };
+	if (std::memcmp(header.magic, "ZPAK", 4) != 0 || header.version != ZPAK_VERSION
+		|| header.indexOffset % alignof(ZpakEntry) != 0
+		|| header.indexOffset + static_cast<uint64_t>(header.entryCount) * sizeof(ZpakEntry) > size
+		|| header.pathOffset + header.pathSize > size) {
+		Close();
+		return false;
+	}
+	const ZpakEntry* index{ reinterpret_cast<const ZpakEntry*>(file.Data() + header.indexOffset) };
+	for (uint32_t i = 0; i < header.entryCount; ++i) {
+		if (index[i].offset + index[i].size > size || static_cast<uint64_t>(index[i].pathStart) + index[i].pathLength > header.pathSize
+			|| index[i].compression != static_cast<uint32_t>(ZpakCompression::NONE) || (i > 0 && index[i - 1].pathHash > index[i].pathHash)) {
+			Close();
+			return false;
+		}
+	}
+	entries = index;
+	paths = reinterpret_cast<const char*>(file.Data() + header.pathOffset);
+	root = NormalizePath(assetsFolder);
+	return true;
+}
+
+void AssetPack::Close() {
+	file.Close();
+	header = ZpakHeader{};
+	entries = nullptr;
+	paths = nullptr;
+	{
+		std::lock_guard<std::mutex> lock{ evictedMutex };
+		evicted.clear();
+	}
+	hits = 0;
+	misses = 0;
+}
+
+bool AssetPack::IsOpen() const {
+	return entries != nullptr;
+}
+
+const ZpakEntry* AssetPack::Find(const std::string& path) {
+	if (!enabled || !IsOpen()) {
+		return nullptr;
+	}
+	std::string normalized{ NormalizePath(path) };
+	if (normalized.rfind(root, 0) != 0) {
+		return nullptr;
+	}
+	std::string relative{ normalized.substr(root.length()) };
+	uint64_t hash{ HashPath(relative) };
+	{
+		std::lock_guard<std::mutex> lock{ evictedMutex };
+		if (evicted.count(hash)) {
+			return nullptr;
+		}
+	}
+
+	const ZpakEntry* end{ entries + header.entryCount };
+	const ZpakEntry* entry{ std::lower_bound(entries, end, hash, [](const ZpakEntry& e, uint64_t h) { return e.pathHash < h; }) };
+	for (; entry != end && entry->pathHash == hash; ++entry) {
+		if (NormalizePath(std::string{ paths + entry->pathStart, entry->pathLength }) == relative) {
+			return entry;
+		}
+	}
+	++misses;
+	return nullptr;
+}
+
+bool AssetPack::Contains(const std::string& path) {
+	return Find(path) != nullptr;
+}
+
+bool AssetPack::Read(const std::string& path, const unsigned char*& data, size_t& size) {
+	const ZpakEntry* entry{ Find(path) };
+	if (entry == nullptr) {
+		return false;
+	}
+	data = file.Data() + entry->offset;
+	size = static_cast<size_t>(entry->size);
+	++hits;
+	return true;
+}
+
+bool AssetPack::GetStamp(const std::string& path, uint64_t& time, uint64_t& size) {
+	const ZpakEntry* entry{ Find(path) };
+	if (entry == nullptr) {
+		return false;
+	}
+	time = entry->sourceTime;
+	size = entry->sourceSize;
+	return true;
+}
+
+void AssetPack::Evict(const std::string& path) {
+	std::string normalized{ NormalizePath(path) };
+	if (IsOpen() && normalized.rfind(root, 0) == 0) {
+		std::lock_guard<std::mutex> lock{ evictedMutex };
+		evicted.insert(HashPath(normalized.substr(root.length())));
+	}
+}
+
+size_t AssetPack::GetEntryCount() const {
+	return header.entryCount;
+}
+
+size_t AssetPack::GetHits() {
+	return hits;
+}
+
+size_t AssetPack::GetMisses() {
+	return misses;
+}
+
+bool AssetPack::Build(const std::string& assetsFolder, const std::string& packPath, ZpakBuildStats& stats) {
+	auto start{ std::chrono::high_resolution_clock::now() };
+	stats = ZpakBuildStats{};
+
+	// Sorted so the same folder always packs the same way
+	std::vector<std::filesystem::path> files;
+	std::error_code error;
+	for (auto it = std::filesystem::recursive_directory_iterator(assetsFolder, std::filesystem::directory_options::skip_permission_denied, error);
+		it != std::filesystem::recursive_directory_iterator(); it.increment(error)) {
+		if (error) {
+			break;
+		}
+		if (it->is_regular_file(error) && IsPacked(std::filesystem::relative(it->path(), assetsFolder, error).generic_string())) {
+			files.push_back(it->path());
+		}
+	}
+	std::sort(files.begin(), files.end());
+
+	std::string tempPath{ packPath + ".tmp" };
+	std::ofstream output{ tempPath, std::ios::binary | std::ios::trunc };
+	if (!output.is_open()) {
+		return false;
+	}
+	ZpakHeader packHeader{};
+	packHeader.version = ZPAK_VERSION;
+	packHeader.alignment = ZPAK_ALIGNMENT;
+	output.write(reinterpret_cast<const char*>(&packHeader), sizeof(ZpakHeader));
+
+	std::vector<ZpakEntry> index;
+	std::string pathCharacters;
+	std::vector<char> buffer;
+	for (const std::filesystem::path& source : files) {
+		std::ifstream input{ source.string(), std::ios::binary | std::ios::ate };
+		auto writeTime{ std::filesystem::last_write_time(source, error) };
+		if (!input.is_open() || error) {
+			++stats.skipped;
+			continue;
+		}
+		buffer.resize(static_cast<size_t>(input.tellg()));
+		input.seekg(0);
+		if (!input.read(buffer.data(), static_cast<std::streamsize>(buffer.size()))) {
+			++stats.skipped;
+			continue;
+		}
+
+		std::string relative{ std::filesystem::relative(source, assetsFolder, error).generic_string() };
+		Pad(output, ZPAK_ALIGNMENT);
+		ZpakEntry entry{};
+		entry.pathHash = HashPath(NormalizePath(relative));
+		entry.offset = static_cast<uint64_t>(output.tellp());
+		entry.size = buffer.size();
+		entry.sourceTime = static_cast<uint64_t>(writeTime.time_since_epoch().count());
+		entry.sourceSize = buffer.size();
+		entry.pathStart = static_cast<uint32_t>(pathCharacters.length());
+		entry.pathLength = static_cast<uint32_t>(relative.length());
+		entry.compression = static_cast<uint32_t>(ZpakCompression::NONE);
+		output.write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+		pathCharacters += relative;
+		index.push_back(entry);
+	}
+
+	// Two paths with the same hash would find each other's files
+	std::sort(index.begin(), index.end(), [](const ZpakEntry& a, const ZpakEntry& b) { return a.pathHash < b.pathHash; });
+	for (size_t i = 1; i < index.size(); ++i) {
+		if (index[i - 1].pathHash == index[i].pathHash) {
+			DEBUG_PRINT("Pack: %.*s and %.*s have the same hash", index[i - 1].pathLength, pathCharacters.c_str() + index[i - 1].pathStart,
+				index[i].pathLength, pathCharacters.c_str() + index[i].pathStart);
+			output.close();
+			std::filesystem::remove(tempPath, error);
+			return false;
+		}
+	}
+
+	Pad(output, ZPAK_ALIGNMENT);
+	packHeader.entryCount = static_cast<uint32_t>(index.size());
+	packHeader.indexOffset = static_cast<uint64_t>(output.tellp());
+	output.write(reinterpret_cast<const char*>(index.data()), static_cast<std::streamsize>(index.size() * sizeof(ZpakEntry)));
+	packHeader.pathOffset = static_cast<uint64_t>(output.tellp());
+	packHeader.pathSize = pathCharacters.length();
+	output.write(pathCharacters.data(), static_cast<std::streamsize>(pathCharacters.length()));
+	stats.bytes = static_cast<uint64_t>(output.tellp());
+	output.seekp(0);
+	output.write(reinterpret_cast<const char*>(&packHeader), sizeof(ZpakHeader));
+	output.close();
+	if (!output) {
+		std::filesystem::remove(tempPath, error);
+		return false;
+	}
+
+	std::filesystem::rename(tempPath, packPath, error);
+	if (error) {
+		std::filesystem::remove(tempPath, error);
+		return false;
+	}
+	stats.files = index.size();
+	stats.milliseconds = std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - start).count();
+	return true;
+}
+
+bool IsPackCommandLine(std::string const& commandLine) {
+	std::istringstream arguments{ commandLine };
+	std::string argument{};
+	while (arguments >> argument) {
+		if (argument == "--pack") {
+			return true;
+		}
+	}
+	return false;
+}
+
+int RunPackCommandLine() {
+	if (!assetmanager.FindDefaultPath()) {
+		std::cerr << "Pack: unable to find the Assets folder\n";
+		return 1;
+	}
+	std::string packPath{ assetmanager.GetDefaultPath() + AssetPack::FILE_NAME };
+	ZpakBuildStats stats{};
+	if (!AssetPack::Build(assetmanager.GetDefaultPath(), packPath, stats)) {
+		std::cerr << "Pack: unable to write " << packPath << "\n";
+		return 1;
+	}
+	std::cout << "Pack: " << stats.files << " files (" << stats.skipped << " unreadable) packed into " << packPath << ", "
+		<< stats.bytes / (1024.0 * 1024.0) << " MB in " << stats.milliseconds << " ms\n";
+	return 0;
+}
+
+AssetReadBenchmarkResult RunAssetReadBenchmark() {
+	using clock = std::chrono::high_resolution_clock;
+	AssetReadBenchmarkResult result{};
+
+	if (!assetpack.IsOpen()) {
+		return result;
+	}
+
+	std::vector<std::string> files;
+	std::string root{ assetmanager.GetDefaultPath() };
+	std::error_code error;
+	for (auto it = std::filesystem::recursive_directory_iterator(root, std::filesystem::directory_options::skip_permission_denied, error);
+		it != std::filesystem::recursive_directory_iterator(); it.increment(error)) {
+		if (error) {
+			break;
+		}
+		std::string path{ it->path().generic_string() };
+		if (it->is_regular_file(error) && assetpack.Contains(path)) {
+			files.push_back(path);
+		}
+	}
+
+	bool wasEnabled{ assetpack.enabled };
+	result.files = files.size();
+
+	// Every page is touched so the mapped reads are not free
+	auto start{ clock::now() };
+	for (const std::string& path : files) {
+		const unsigned char* data{};
+		size_t size{};
+		if (assetpack.Read(path, data, size)) {
+			for (size_t b = 0; b < size; b += 4096) {
+				result.checksum += data[b];
+			}
+			result.bytes += size;
+		}
+	}
+	result.packMilliseconds = std::chrono::duration<double, std::milli>(clock::now() - start).count();
+
+	// The way assets were read before, checking for each file and opening it
+	assetpack.enabled = false;
+	std::vector<char> buffer;
+	start = clock::now();
+	for (const std::string& path : files) {
+		if (assetmanager.FileExists(path)) {
+			std::ifstream input{ path, std::ios::binary | std::ios::ate };
+			buffer.resize(static_cast<size_t>(input.tellg()));
+			input.seekg(0);
+			input.read(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+			for (size_t b = 0; b < buffer.size(); b += 4096) {
+				result.checksum += static_cast<unsigned char>(buffer[b]);
+			}
+		}
+	}
+	result.looseMilliseconds = std::chrono::duration<double, std::milli>(clock::now() - start).count();
+	assetpack.enabled = wasEnabled;
+
+	DEBUG_PRINT("Asset read benchmark: %zu files, pack %.2f ms, loose files %.2f ms", result.files, result.packMilliseconds, result.looseMilliseconds);
+	return result;
+}
@@ -0,0 +1,154 @@
+/******************************************************************************
+*
+*	\copyright
+*		All content(C) 2023/2024 DigiPen Institute of Technology Singapore.
+*		All rights reserved. Reproduction or disclosure of this file or its
+*		contents without the prior written consent of DigiPen Institute of
+*		Technology is prohibited.
+*
+* *****************************************************************************
+*
+*	@file		AssetPack.h
+*
+*	@author		agent
+*
+*	@email		agent\@local
+*
+*	@course		CSD 2401 - Software Engineering Project 3
+*				CSD 2451 - Software Engineering Project 4
+*
+*	@section	Section A
+*
+*	@date		19 October 2026
+*
+* *****************************************************************************
+*
+*	@brief		Packed asset archive (.zpak)
+*
+*	Every file of the Assets folder packed into one file, Assets/Assets.zpak,
+*	built by running the game with --pack. When it exists it is memory
+*	mapped on start up and files are read from the mapping instead of being
+*	checked for and opened one by one. Textures are decoded from memory,
+*	sounds and fonts are created over the mapping without a copy.
+*
+*	Container layout:
+*	[ZpakHeader][pad to 16][file 0][pad to 16]...[file n-1][pad to 16]
+*	[ZpakEntry x entryCount, sorted by path hash][path characters]
+*
+*	Paths are stored relative to the Assets folder with forward slashes, and
+*	found by a binary search of the 64 bit FNV-1a hash of their lower case
+*	form, as asset names in scene files do not always match the case of the
+*	file. The last write time and size of each file when it was packed are kept, so
+*	the texture and scene caches can check their stamps without touching
+*	the loose file.
+*
+*	Files written by the editor after packing (scenes, prefabs) are evicted
+*	from the pack and read from the folder again. Other changed assets are
+*	only picked up by packing again or deleting the pack.
+*
+******************************************************************************/
+
+#pragma once
+#include "File.h"
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <unordered_set>
+
+//Compression of a packed file. Only stored files are written for now, other values are rejected when loading
+enum class ZpakCompression : uint32_t {
+	NONE = 0
+};
+
+struct ZpakHeader {
+	char magic[4]{ 'Z','P','A','K' };
+	uint32_t version{};
+	uint32_t entryCount{};
+	uint32_t alignment{};		//files start on multiples of this
+	uint64_t indexOffset{};		//byte offset of the first ZpakEntry
+	uint64_t pathOffset{};		//byte offset of the path characters
+	uint64_t pathSize{};		//total bytes of path characters
+};
+
+struct ZpakEntry {
+	uint64_t pathHash{};		//FNV-1a of the path relative to the Assets folder
+	uint64_t offset{};			//byte offset of the file
+	uint64_t size{};			//size of the file as stored
+	uint64_t sourceTime{};		//last write time of the file when packed
+	uint64_t sourceSize{};		//size of the file when packed
+	uint32_t pathStart{};		//offset of the path in the path characters
+	uint32_t pathLength{};
+	uint32_t compression{};		//ZpakCompression
+	uint32_t reserved{};
+};
+
+//Result of building a pack
+struct ZpakBuildStats {
+	size_t files{};
+	size_t skipped{};			//files that could not be read
+	uint64_t bytes{};			//size of the pack
+	double milliseconds{};
+};
+
+class AssetPack {
+public:
+	static constexpr const char* FILE_NAME{ "Assets.zpak" };	//name of the pack in the Assets folder
+
+	bool enabled{ true };		//when false every file is read from the Assets folder
+
+	//Maps the pack at packPath, with paths relative to assetsFolder. Returns false if there is no valid pack
+	bool Open(const std::string& packPath, const std::string& assetsFolder);
+	void Close();
+	bool IsOpen() const;
+
+	//Returns true if the file at path, under the Assets folder, is read from the pack
+	bool Contains(const std::string& path);
+	//Points data at the packed copy of path. The memory stays valid while the pack is open
+	bool Read(const std::string& path, const unsigned char*& data, size_t& size);
+	//Gets the last write time and size path had when it was packed
+	bool GetStamp(const std::string& path, uint64_t& time, uint64_t& size);
+	//Reads path from the Assets folder from now on, after it was written there
+	void Evict(const std::string& path);
+
+	size_t GetEntryCount() const;
+	size_t GetHits();		//files read from the pack since it was opened
+	size_t GetMisses();		//lookups of files under the Assets folder that are not packed
+
+	//Packs every file under assetsFolder into packPath, leaving out caches, autosaves and packs
+	static bool Build(const std::string& assetsFolder, const std::string& packPath, ZpakBuildStats& stats);
+
+private:
+	//Finds the entry of path, or nullptr if it is not packed or evicted
+	const ZpakEntry* Find(const std::string& path);
+
+	MappedFile file{};
+	ZpakHeader header{};
+	const ZpakEntry* entries{};
+	const char* paths{};
+	std::string root{};							//Assets folder, lower case with forward slashes
+	std::unordered_set<uint64_t> evicted{};
+	std::mutex evictedMutex{};		//files are evicted by the asset watcher while others are read on the thread pool
+	std::atomic<size_t> hits{};		//prefabs are read from the thread pool
+	std::atomic<size_t> misses{};
+};
+
+extern AssetPack assetpack;
+
+//True if the command line asks for the Assets folder to be packed
+bool IsPackCommandLine(std::string const& commandLine);
+
+//Packs the Assets folder into Assets/Assets.zpak. Returns the process exit code
+int RunPackCommandLine();
+
+//Result of RunAssetReadBenchmark
+struct AssetReadBenchmarkResult {
+	size_t files{};					//0 if there is no pack to read from
+	uint64_t bytes{};
+	double packMilliseconds{};
+	double looseMilliseconds{};		//the same files read from the Assets folder
+	uint64_t checksum{};			//of a byte per page read, the same for any run over the same files
+};
+
+//Reads every packed file from the pack and from the Assets folder and compares the times
+AssetReadBenchmarkResult RunAssetReadBenchmark();
@@ -0,0 +1,429 @@
+/******************************************************************************
+*
+*	\copyright
+*		All content(C) 2023/2024 DigiPen Institute of Technology Singapore.
+*		All rights reserved. Reproduction or disclosure of this file or its
+*		contents without the prior written consent of DigiPen Institute of
+*		Technology is prohibited.
+*
+* *****************************************************************************
+*
+*	@file		AssetWatcher.cpp
+*
+*	@author		agent
+*
+*	@email		agent\@local
+*
+*	@course		CSD 2401 - Software Engineering Project 3
+*				CSD 2451 - Software Engineering Project 4
+*
+*	@section	Section A
+*
+*	@date		19 October 2026
+*
+* *****************************************************************************
+*
+*	@brief		Hot reloading of changed assets
+*
+*	Definitions of AssetWatcher.
+*
+******************************************************************************/
+
+#include "AssetWatcher.h"
+#include "AssetManager.h"
+#include "AssetPack.h"
+#include "SceneCache.h"
+#include "JsonStream.h"
+#include "MultiThreading.h"
+#include "File.h"
+#include "Global.h"
+#include "debugdiagnostic.h"
+#include <rapidjson-master/include/rapidjson/document.h>
+#include <stb-master/stb_image.h>
+#include <algorithm>
+#include <cctype>
+#include <filesystem>
+#include <memory>
+#ifdef _WIN32
+#include <Windows.h>
+#else
+#include <sys/inotify.h>
+#include <poll.h>
+#include <unistd.h>
+#include <cerrno>
+#endif
+
+AssetWatcher assetwatcher;
+
+namespace {
+	constexpr const char* PREFAB_FOLDER{ "Prefabs/" };
+	constexpr const char* SKILL_FOLDER{ "Skills/" };
+	constexpr const char* AUDIO_FOLDERS[]{ "Sound/", "Music/", "Ambience/" };
+
+	std::string ToLower(std::string text) {
+		std::transform(text.begin(), text.end(), text.begin(), [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+		return text;
+	}
+
+	//Files the engine writes itself, which are never reimported
+	bool IsIgnored(const std::string& relativePath) {
+		std::string lower{ ToLower(relativePath) };
+		std::string extension{ FilePath::GetFileExtension(lower) };
+		return lower.rfind("cache/", 0) == 0 || lower.rfind("scenes/autosave/", 0) == 0 || extension == ".tmp" || extension == ".zpak";
+	}
+
+	bool IsAudioFolder(const std::string& folder) {
+		return std::find(std::begin(AUDIO_FOLDERS), std::end(AUDIO_FOLDERS), folder) != std::end(AUDIO_FOLDERS);
+	}
+
+	//A prefab file parsed on the thread pool, the document's strings point into buffer
+	struct ParsedFile {
+		std::vector<char> buffer{};
+		rapidjson::Document document{};
+	};
+}
+
+AssetWatcher::~AssetWatcher() {
+	Stop();
+}
+
+bool AssetWatcher::Start(const std::string& assetsFolder) {
+	Stop();
+	root = assetsFolder;
+#ifdef _WIN32
+	HANDLE directory{ CreateFileA(root.c_str(), FILE_LIST_DIRECTORY, FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE,
+		nullptr, OPEN_EXISTING, FILE_FLAG_BACKUP_SEMANTICS | FILE_FLAG_OVERLAPPED, nullptr) };
+	if (directory == INVALID_HANDLE_VALUE) {
+		return false;
+	}
+	directoryHandle = directory;
+	stopEvent = CreateEventA(nullptr, TRUE, FALSE, nullptr);
+#else
+	inotifyDescriptor = inotify_init1(IN_CLOEXEC);
+	if (inotifyDescriptor < 0) {
+		return false;
+	}
+	if (pipe(stopPipe) != 0) {
+		close(inotifyDescriptor);
+		inotifyDescriptor = -1;
+		return false;
+	}
+#endif
+	stopping = false;
+	watcher = std::thread{ &AssetWatcher::Watch, this };
+	DEBUG_PRINT("Watching %s for changed assets", root.c_str());
+	return true;
+}
+
+void AssetWatcher::Stop() {
+	if (!watcher.joinable()) {
+		return;
+	}
+	stopping = true;
+#ifdef _WIN32
+	SetEvent(static_cast<HANDLE>(stopEvent));
+	watcher.join();
+	CloseHandle(static_cast<HANDLE>(stopEvent));
+	CloseHandle(static_cast<HANDLE>(directoryHandle));
+	stopEvent = nullptr;
+	directoryHandle = nullptr;
+#else
+	char wake{};
+	if (write(stopPipe[1], &wake, 1) < 0) {
+		DEBUG_PRINT("Unable to wake the asset watcher");
+	}
+	watcher.join();
+	close(stopPipe[0]);
+	close(stopPipe[1]);
+	close(inotifyDescriptor);
+	stopPipe[0] = stopPipe[1] = -1;
+	inotifyDescriptor = -1;
+#endif
+}
+
+bool AssetWatcher::IsRunning() const {
+	return watcher.joinable();
+}
+
+void AssetWatcher::Watch() {
+#ifdef _WIN32
+	HANDLE directory{ static_cast<HANDLE>(directoryHandle) };
+	OVERLAPPED overlapped{};
+	overlapped.hEvent = CreateEventA(nullptr, TRUE, FALSE, nullptr);
+	HANDLE handles[2]{ overlapped.hEvent, static_cast<HANDLE>(stopEvent) };
+	// DWORD aligned as ReadDirectoryChangesW needs, and no larger than 64 KB so it also works on network shares
+	std::vector<DWORD> buffer(16 * 1024);
+	while (!stopping) {
+		ResetEvent(overlapped.hEvent);
+		if (!ReadDirectoryChangesW(directory, buffer.data(), static_cast<DWORD>(buffer.size() * sizeof(DWORD)), TRUE,
+			FILE_NOTIFY_CHANGE_FILE_NAME | FILE_NOTIFY_CHANGE_DIR_NAME | FILE_NOTIFY_CHANGE_LAST_WRITE | FILE_NOTIFY_CHANGE_SIZE,
+			nullptr, &overlapped, nullptr)) {
+			break;
+		}
+		DWORD bytes{};
+		if (WaitForMultipleObjects(2, handles, FALSE, INFINITE) != WAIT_OBJECT_0) {
+			CancelIo(directory);
+			GetOverlappedResult(directory, &overlapped, &bytes, TRUE);
+			break;
+		}
+		if (!GetOverlappedResult(directory, &overlapped, &bytes, FALSE)) {
+			break;
+		}
+		if (bytes == 0) {
+			// Too many changes for the buffer, they are lost, so the folders the editor lists are listed again
+			Record(PREFAB_FOLDER, false, true);
+			Record(AUDIO_FOLDERS[0], false, true);
+			continue;
+		}
+		const unsigned char* next{ reinterpret_cast<const unsigned char*>(buffer.data()) };
+		while (true) {
+			const FILE_NOTIFY_INFORMATION* info{ reinterpret_cast<const FILE_NOTIFY_INFORMATION*>(next) };
+			int length{ static_cast<int>(info->FileNameLength / sizeof(WCHAR)) };
+			int size{ WideCharToMultiByte(CP_UTF8, 0, info->FileName, length, nullptr, 0, nullptr, nullptr) };
+			std::string path(size, '\0');
+			WideCharToMultiByte(CP_UTF8, 0, info->FileName, length, path.data(), size, nullptr, nullptr);
+			std::replace(path.begin(), path.end(), '\\', '/');
+			bool content{ info->Action == FILE_ACTION_ADDED || info->Action == FILE_ACTION_MODIFIED || info->Action == FILE_ACTION_RENAMED_NEW_NAME };
+			Record(path, content, info->Action != FILE_ACTION_MODIFIED);
+			if (info->NextEntryOffset == 0) {
+				break;
+			}
+			next += info->NextEntryOffset;
+		}
+	}
+	CloseHandle(overlapped.hEvent);
+#else
+	// inotify only watches one folder at a time, so every folder under root gets a watch
+	std::unordered_map<int, std::string> folders{};
+	auto addWatch{ [this, &folders](const std::string& folder) {
+		int watch{ inotify_add_watch(inotifyDescriptor, (root + folder).c_str(), IN_CLOSE_WRITE | IN_CREATE | IN_DELETE | IN_MOVED_FROM | IN_MOVED_TO) };
+		if (watch >= 0) {
+			folders[watch] = folder;
+		}
+	} };
+	addWatch("");
+	std::error_code error;
+	std::string rootPath{ std::filesystem::path{ root }.generic_string() };
+	for (auto it = std::filesystem::recursive_directory_iterator(root, std::filesystem::directory_options::skip_permission_denied, error);
+		!error && it != std::filesystem::recursive_directory_iterator(); it.increment(error)) {
+		std::string path{ it->path().generic_string() };
+		if (it->is_directory(error) && path.rfind(rootPath, 0) == 0) {
+			addWatch(path.substr(rootPath.length()) + "/");
+		}
+	}
+
+	alignas(inotify_event) char buffer[16 * 1024];
+	pollfd polled[2]{ { inotifyDescriptor, POLLIN, 0 }, { stopPipe[0], POLLIN, 0 } };
+	while (!stopping) {
+		if (poll(polled, 2, -1) < 0) {
+			if (errno == EINTR) {
+				continue;
+			}
+			break;
+		}
+		if (polled[1].revents != 0) {
+			break;
+		}
+		ssize_t bytes{ read(inotifyDescriptor, buffer, sizeof(buffer)) };
+		if (bytes <= 0) {
+			break;
+		}
+		for (char* next = buffer; next < buffer + bytes;) {
+			const inotify_event* event{ reinterpret_cast<const inotify_event*>(next) };
+			next += sizeof(inotify_event) + event->len;
+			if (event->mask & IN_Q_OVERFLOW) {
+				Record(PREFAB_FOLDER, false, true);
+				Record(AUDIO_FOLDERS[0], false, true);
+				continue;
+			}
+			auto folder{ folders.find(event->wd) };
+			if (folder == folders.end() || event->len == 0) {
+				continue;
+			}
+			std::string path{ folder->second + event->name };
+			if ((event->mask & IN_ISDIR) && (event->mask & (IN_CREATE | IN_MOVED_TO))) {
+				addWatch(path + "/");
+			}
+			bool content{ !(event->mask & IN_ISDIR) && (event->mask & (IN_CLOSE_WRITE | IN_MOVED_TO)) != 0 };
+			Record(path, content, (event->mask & (IN_CREATE | IN_DELETE | IN_MOVED_FROM | IN_MOVED_TO)) != 0);
+		}
+	}
+#endif
+}
+
+void AssetWatcher::Record(const std::string& relativePath, bool content, bool listing) {
+	if (IsIgnored(relativePath)) {
+		return;
+	}
+	std::lock_guard<std::mutex> lock{ pendingMutex };
+	Change& change{ pending[relativePath] };
+	change.time = Clock::now();
+	change.content = change.content || content;
+	change.listing = change.listing || listing;
+}
+
+void AssetWatcher::Update() {
+	// Finished reimports are applied in the order they were started
+	for (auto it = jobs.begin(); it != jobs.end();) {
+		if (it->apply.wait_for(std::chrono::seconds(0)) != std::future_status::ready) {
+			++it;
+			continue;
+		}
+		std::function<void()> apply{ it->apply.get() };
+		if (apply) {
+			apply();
+			stats.lastFile = it->file;
+			stats.lastMilliseconds = std::chrono::duration<double, std::milli>(Clock::now() - it->start).count();
+		}
+		it = jobs.erase(it);
+	}
+
+	if (!enabled || GetCurrentSystemMode() != SystemMode::EDIT) {
+		return;
+	}
+	std::vector<std::pair<std::string, Change>> settled{};
+	{
+		std::lock_guard<std::mutex> lock{ pendingMutex };
+		Clock::time_point now{ Clock::now() };
+		for (auto it = pending.begin(); it != pending.end();) {
+			// A file still being reimported waits for it, so an older reimport cannot be applied after a newer one
+			bool running{ std::any_of(jobs.begin(), jobs.end(), [&it](Job const& job) { return job.file == it->first; }) };
+			if (running || std::chrono::duration<float>(now - it->second.time).count() < debounceSeconds) {
+				++it;
+				continue;
+			}
+			settled.emplace_back(*it);
+			it = pending.erase(it);
+		}
+	}
+	for (auto& [path, change] : settled) {
+		Reimport(path, change);
+	}
+}
+
+void AssetWatcher::Reimport(const std::string& relativePath, Change const& change) {
+	std::string fullPath{ root + relativePath };
+	std::string folder{ relativePath.substr(0, relativePath.find_last_of('/') + 1) };
+	std::string name{ relativePath.substr(relativePath.find_last_of('/') + 1) };
+	std::string extension{ ToLower(FilePath::GetFileExtension(name)) };
+
+	// The file is read from the folder from now on, not from the pack
+	assetpack.Evict(fullPath);
+
+	if (change.listing && (folder == PREFAB_FOLDER || IsAudioFolder(folder))) {
+		Rescan(folder);
+	}
+	if (!change.content) {
+		return;
+	}
+
+	if (extension == ".png" || extension == ".jpg" || extension == ".jpeg" || extension == ".bmp") {
+		if (!assetmanager.texture.HasSource(fullPath)) {
+			return;
+		}
+		Run(relativePath, [this, fullPath]() -> std::function<void()> {
+			int width{};
+			int height{};
+			int channels{};
+			std::shared_ptr<unsigned char> pixels{ stbi_load(fullPath.c_str(), &width, &height, &channels, channelnum), stbi_image_free };
+			if (!pixels) {
+				return [this, fullPath]() {
+					++stats.failed;
+					DEBUG_PRINT("Unable to decode %s, the loaded texture is kept", fullPath.c_str());
+				};
+			}
+			return [this, fullPath, pixels, width, height]() {
+				if (assetmanager.texture.Reload(fullPath, pixels.get(), width, height) > 0) {
+					++stats.textures;
+				}
+			};
+		});
+	}
+	else if (folder == SKILL_FOLDER && extension == ".skill") {
+		Run(relativePath, [this, fullPath]() -> std::function<void()> {
+			auto attack{ std::make_shared<Attack>() };
+			std::string error{};
+			if (!AttackList::ReadAttack(fullPath, *attack, error) || !error.empty()) {
+				return [this, fullPath, error]() {
+					++stats.failed;
+					DEBUG_PRINT("%s: %s, the loaded skill is kept", error.c_str(), fullPath.c_str());
+				};
+			}
+			return [this, attack]() {
+				assetmanager.attacks.ReloadAttack(*attack);
+				++stats.skills;
+			};
+		});
+	}
+	else if (folder == PREFAB_FOLDER && extension == ".prefab") {
+		if (!assetmanager.GetPrefabMap().count(name)) {
+			return;
+		}
+		Run(relativePath, [this, fullPath, name]() -> std::function<void()> {
+			auto prefab{ std::make_shared<ParsedFile>() };
+			if (ReadJsonFile(fullPath, prefab->buffer)) {
+				prefab->document.ParseInsitu(prefab->buffer.data());
+			}
+			if (prefab->buffer.empty() || prefab->document.HasParseError() || !prefab->document.IsArray()) {
+				return [this, fullPath]() {
+					++stats.failed;
+					DEBUG_PRINT("Unable to parse %s, the loaded prefab is kept", fullPath.c_str());
+				};
+			}
+			SceneCooker cooker;
+			for (const rapidjson::Value& entry : prefab->document.GetArray()) {
+				cooker.Add(entry);
+			}
+			scenecache.Cook(fullPath, cooker);
+			return [this, prefab, name]() {
+				assetmanager.ReloadPrefab(name, prefab->document);
+				++stats.prefabs;
+			};
+		});
+	}
+}
+
+void AssetWatcher::Rescan(const std::string& folder) {
+	std::string assetsFolder{ assetmanager.GetDefaultPath() };
+	if (folder == PREFAB_FOLDER) {
+		Run(folder, [this, assetsFolder]() -> std::function<void()> {
+			auto names{ std::make_shared<std::vector<std::string>>(FilePath::ListFileNames(assetsFolder + PREFAB_FOLDER)) };
+			return [this, names]() {
+				assetmanager.SetPrefabPaths(std::move(*names));
+				++stats.folders;
+			};
+		});
+	}
+	else if (IsAudioFolder(folder)) {
+		// The audio folders are listed together, as the audio manager replaces all three lists at once
+		Run(AUDIO_FOLDERS[0], [this, assetsFolder]() -> std::function<void()> {
+			auto sound{ std::make_shared<std::vector<std::string>>(FilePath::ListFileNames(assetsFolder + AUDIO_FOLDERS[0])) };
+			auto music{ std::make_shared<std::vector<std::string>>(FilePath::ListFileNames(assetsFolder + AUDIO_FOLDERS[1])) };
+			auto ambience{ std::make_shared<std::vector<std::string>>(FilePath::ListFileNames(assetsFolder + AUDIO_FOLDERS[2])) };
+			return [this, sound, music, ambience]() {
+				assetmanager.audio.SetAudioPaths(std::move(*sound), std::move(*music), std::move(*ambience));
+				++stats.folders;
+			};
+		});
+	}
+}
+
+void AssetWatcher::Run(const std::string& file, std::function<std::function<void()>()> work) {
+	auto task{ std::make_shared<std::packaged_task<std::function<void()>()>>(std::move(work)) };
+	Job job{};
+	job.file = file;
+	job.start = Clock::now();
+	job.apply = task->get_future();
+	ThreadPool& pool{ ThreadPool::threadPool() };
+	if (pool.GetThreadCount() == 0) {
+		(*task)();
+	}
+	else {
+		pool.Enqueue([task]() { (*task)(); });
+	}
+	jobs.push_back(std::move(job));
+}
+
+HotReloadStats const& AssetWatcher::GetStats() const {
+	return stats;
+}
@@ -0,0 +1,124 @@
+/******************************************************************************
+*
+*	\copyright
+*		All content(C) 2023/2024 DigiPen Institute of Technology Singapore.
+*		All rights reserved. Reproduction or disclosure of this file or its
+*		contents without the prior written consent of DigiPen Institute of
+*		Technology is prohibited.
+*
+* *****************************************************************************
+*
+*	@file		AssetWatcher.h
+*
+*	@author		agent
+*
+*	@email		agent\@local
+*
+*	@course		CSD 2401 - Software Engineering Project 3
+*				CSD 2451 - Software Engineering Project 4
+*
+*	@section	Section A
+*
+*	@date		19 October 2026
+*
+* *****************************************************************************
+*
+*	@brief		Hot reloading of changed assets
+*
+*	A thread of its own waits for changes under the Assets folder
+*	(ReadDirectoryChangesW on Windows, inotify elsewhere) and records the
+*	files that changed. Once a file has not changed for debounceSeconds, it
+*	is reimported on the thread pool and the result is applied on the frame
+*	thread by Update:
+*	- a loaded texture is decoded again and uploaded in place, so entities
+*	  and sprite sheets using it keep their Texture pointers
+*	- a .skill file is read and its effects compiled again, and replaces the
+*	  attack and the copies of it held by characters
+*	- a loaded .prefab is parsed again and its components copied into the
+*	  prefab entity and into the clones that did not change them
+*	- files added to or removed from the prefab and audio folders list the
+*	  folder again
+*
+*	Changes are only reimported while editing.
+*
+******************************************************************************/
+
+#pragma once
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <future>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+//Counts of the assets reimported since the editor started
+struct HotReloadStats {
+	size_t textures{};
+	size_t skills{};
+	size_t prefabs{};
+	size_t folders{};			//folder listings made again
+	size_t failed{};			//files that could not be read, the loaded copy is kept
+	std::string lastFile{};		//last file reimported
+	double lastMilliseconds{};	//time from the reimport starting to it being applied
+};
+
+class AssetWatcher {
+public:
+	bool enabled{ true };			//when false changes are still recorded, and reimported once it is true again
+	float debounceSeconds{ 0.25f };	//a file is reimported once it has not changed for this long
+
+	~AssetWatcher();
+
+	//Starts watching every folder under assetsFolder. Returns false if the folder cannot be watched
+	bool Start(const std::string& assetsFolder);
+	void Stop();
+	bool IsRunning() const;
+
+	//Applies the reimports that finished and starts reimporting the files that stopped changing. Called every frame
+	void Update();
+	//Lists a folder of the Assets folder again on the thread pool, e.g. "Prefabs/" or "Sound/"
+	void Rescan(const std::string& folder);
+
+	HotReloadStats const& GetStats() const;
+
+private:
+	using Clock = std::chrono::steady_clock;
+
+	struct Change {
+		Clock::time_point time{};	//time of the last change
+		bool content{};				//the file was written
+		bool listing{};				//the file was added, removed or renamed
+	};
+
+	//A reimport running on the thread pool, apply is run on the frame thread once it finishes
+	struct Job {
+		std::string file{};
+		Clock::time_point start{};
+		std::future<std::function<void()>> apply{};
+	};
+
+	void Watch();	//runs on the watcher thread until Stop
+	void Record(const std::string& relativePath, bool content, bool listing);
+	void Reimport(const std::string& relativePath, Change const& change);
+	void Run(const std::string& file, std::function<std::function<void()>()> work);
+
+	std::string root{};							//Assets folder being watched
+	std::thread watcher{};
+	std::atomic<bool> stopping{};
+	std::mutex pendingMutex{};
+	std::unordered_map<std::string, Change> pending{};	//changed files by path relative to root, not reimported yet
+	std::vector<Job> jobs{};
+	HotReloadStats stats{};
+#ifdef _WIN32
+	void* directoryHandle{ nullptr };
+	void* stopEvent{ nullptr };
+#else
+	int inotifyDescriptor{ -1 };
+	int stopPipe[2]{ -1, -1 };
+#endif
+};
+
+extern AssetWatcher assetwatcher;
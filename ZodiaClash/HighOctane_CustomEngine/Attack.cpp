@@ -36,13 +36,13 @@
 #include "AssetManager.h"
 #include "EntityFactory.h"
 #include "Animation.h"
-#include <random>
+#include "Random.h"
+#include "JsonStream.h"
 
 #include <rapidjson-master/include/rapidjson/document.h>
 #include <rapidjson-master/include/rapidjson/writer.h>
 #include <rapidjson-master/include/rapidjson/prettywriter.h>
 #include <rapidjson-master/include/rapidjson/stringbuffer.h>
-#include <rapidjson-master/include/rapidjson/istreamwrapper.h>
 
 /**
  * @brief Executes the skill against the target(s).
@@ -50,217 +50,11 @@
  * This function applies the skill to the selected target
  */
 void Attack::UseAttack(CharacterStats* target) {
-    std::random_device rd;
-    std::mt19937 gen(rd());
-    static std::uniform_real_distribution<float> rand(0.f, 1.f);
-
     CalculateDamage(*target);
 
-    //Cat ult
-    if (attackName == "Secret Arts: Pounce") {
-        while (target->debuffs.bloodStack) {
-            target->ApplyBloodStack();
-        }
-    
-    }
-    //Enemy goat attack
-    else if (attackName == "Raging Surge") {
-        if (owner->stats.health < 0.5f * owner->stats.maxHealth && owner->charge) {
-            owner->TakeDamage(-damage);
-            owner->action.battleManager->aiMultiplier += 1000000;
-            owner->charge = false;
-        }
-        else if (owner->stats.health < 0.5f * owner->stats.maxHealth && !owner->charge) {
-            damage = 0;
-        }
-    }
-    //Player goat attack
-    else if (attackName == "Yin-Yang Strike") {
-        if (rand(gen) > 0.75f) {
-            target->buffs.attackStack = 0;
-            target->buffs.attackBuff = 0.f;
-            target->buffs.defenseStack = 0;
-            target->buffs.defenseBuff = 0.f;
-        }
-    }
-    //Enemy goat heal
-    else if (attackName == "Dark Rising") {
-        damage = -0.3f * owner->stats.maxHealth;
-        target->debuffs.bloodStack = 0;
-        target->debuffs.tauntStack = 0;
-        target->debuffs.stunStack = 0;
-    }
-    //Player goat heal
-    else if (attackName == "Shepherd's Grace") {
-        damage = -0.3f * owner->stats.maxHealth;
-        target->debuffs.bloodStack = 0;
-        target->debuffs.tauntStack = 0;
-        target->debuffs.stunStack = 0;
-    }
-    //Enemy goat speedup
-    else if (attackName == "Dark Chi Surge") {
-        target->SpeedBuff(target);
-        target->buffs.attackBuff = 0.3f;
-        target->buffs.attackStack = 1;
-        if (target->tag == CharacterType::ENEMY) {
-            owner->action.battleManager->aiMultiplier += 100000;
-        }
-    }
-    //Player goat speedup
-    else if (attackName == "Chi Surge") {
-        target->SpeedBuff(target);
-        target->buffs.attackBuff = 0.3f;
-        target->buffs.attackStack = 1;
-    }
-    //Enemy goat charge
-    else if (attackName == "Charging up Raging Surge!") {
-        if (owner->stats.health < 0.5f * owner->stats.maxHealth && !owner->charge) {
-            owner->action.battleManager->aiMultiplier += 1000000;
-        }
-        owner->charge = true;
-    }
-    //Player ox attack
-    else if (attackName == "Shield Thrust") {
-        if (!target->buffs.shieldStack) {
-            target->debuffs.defenseDebuff = 0.5f;
-            target->debuffs.defenseStack = 2;
-        }
-    }
-    //Enemy ox attack
-    else if (attackName == "Shield Smash") {
-        if (owner->cycle > 0 && owner->charge) {
-            owner->action.battleManager->aiMultiplier += 100000;
-            owner->cycle = owner->cycle > 2 ? 0 : owner->cycle + 1;
-        }
-    }
-    //Enemy ox skill
-    else if (attackName == "Resolute Charge") {
-        if (!target->buffs.shieldStack) {
-            target->debuffs.stunStack += 1;
-        }
-    }
-    //Enemy ox skill
-    else if (attackName == "Unstoppable Charge") {
-        target->debuffs.stunStack += 1;
-        if (owner->cycle > 0 && !owner->charge) {
-            owner->action.battleManager->aiMultiplier += 100000;
-            owner->cycle = owner->cycle > 2 ? 0 : owner->cycle + 1;
-            if (owner->cycle > 2) {
-                owner->cycle = 0;
-                owner->charge = true;
-            }
-        }
-    }
-    //Enemy ox ult
-    else if (attackName == "Cursed War God's Wrath") {
-        target->debuffs.tauntStack += 1;
-        target->debuffs.tauntTarget = owner->entity;
-        owner->buffs.defenseBuff = 0.5f;
-        owner->buffs.defenseStack = 2;
-        if (owner->cycle == 0) {
-            owner->action.battleManager->aiMultiplier += 100000;
-            owner->cycle = 1;
-        }
-    }
-    //Player ox ult
-    else if (attackName == "War God's Wrath") {
-        target->debuffs.tauntStack += 1;
-        target->debuffs.tauntTarget = owner->entity;
-        owner->buffs.defenseBuff = 0.5f;
-        owner->buffs.defenseStack = 2;
-    }
-    //Enemy emperor buff
-    else if (attackName == "Primal Fury") {
-        if (owner->cycle == 0 && target->entity == owner->entity) {
-            owner->action.battleManager->aiMultiplier += 100000;
-            owner->cycle++;
-        }
-        owner->buffs.attackBuff = 0.3f;
-        owner->buffs.attackStack = 4;
-    }
-    //Enemy emperor lock-on
-    else if (attackName == "Hunter's Focus") {
-        if (owner->cycle == 1 && (ECS::ecs().GetComponent<Name>(target->entity).name == "Cat" || ECS::ecs().GetComponent<Name>(target->entity).name == "Player_Goat")) {
-            owner->action.battleManager->aiMultiplier += 100000;
-            owner->cycle++;
-        }
-        else {
-            owner->action.battleManager->aiMultiplier -= 100000;
-        }
-        target->debuffs.huntedStack = 3;
-    }
-    //Enemy emperor attack
-    else if (attackName == "Nimble Strike") {
-        if (owner->cycle > 1) {
-            owner->action.battleManager->aiMultiplier += 10000;
-        }
-        owner->cycle++;
-        if (owner->cycle > 3) {
-            owner->cycle = 0;
-        }
-    }
-    //Enemy monkey attack
-    else if (attackName == "Golden Strike") {
-        owner->cycle++;
-        if (owner->cycle > 2) {
-            owner->cycle = 0;
-        }
-    }
-    //Enemy monkey AOE
-    else if (attackName == "Flaming Cyclone") {
-        if (target->debuffs.igniteStack && owner->action.battleManager->GetEnemies().size() > 2) {
-            owner->action.battleManager->aiMultiplier -= 100000;
-        }
-        target->debuffs.igniteStack = 3;
-    }
-    //Enemy monkey shield
-    else if (attackName == "Stone Skin") {
-        if (owner->buffs.shieldStack == 0 && owner->action.battleManager->GetEnemies().size() > 1) {
-            bool hasStun{ false };
-            for (auto& enemy : owner->action.battleManager->GetEnemies()) {
-                if (enemy->debuffs.stunStack) {
-                    hasStun = true;
-                    break;
-                }
-            }
-            
-            if (!hasStun) {
-                owner->action.battleManager->aiMultiplier += 200000;
-
-                if (owner->action.battleManager->m_Entities.size()) {
-                    Entity shield{ EntityFactory::entityFactory().ClonePrefab("enemy_shield.prefab") };
-                    for (auto& enemy : owner->action.battleManager->GetEnemies()) {
-                        if (enemy->debuffs.stunStack) {
-                            hasStun = true;
-                            break;
-                        }
-                        enemy->buffs.shieldStack = 1;
-                        enemy->buffs.shieldEntity = shield;
-
-                        CharacterStats dispel{};
-                        enemy->debuffs = dispel.debuffs;
-
-                        if (ECS::ecs().HasComponent<Parent>(enemy->entity)) {
-                            Entity child_shield{ ECS::ecs().GetComponent<Parent>(enemy->entity).GetChildByName("Monkey Shield") };
-                            if (child_shield) {
-                                ECS::ecs().GetComponent<AnimationSet>(child_shield).Start("Appear",child_shield);
-                            }
-                        }
-                    }
-                    owner->action.battleManager->AddCharacter(shield);
-                }
-                
-                owner->cycle++;
-                if (owner->cycle > 2) {
-                    owner->cycle = 0;
-                }
-
-            }
-        }
-        else {
-            owner->action.battleManager->aiMultiplier -= 100000;
-        }
-    }
+    RunSkillEffects(effects.hit.data(), effects.hit.size(),
+        [this, target](EffectInstruction const& instruction) { return TestEffect(instruction, target); },
+        [this, target](EffectInstruction const& instruction) { ExecuteEffect(instruction, target); });
 
     target->debuffs.bloodStack += bleed;
 
@@ -312,15 +106,9 @@ void Attack::UseAttack(std::vector<CharacterStats*> target) {
         UseAttack(t);
     }
 
-    if (attackName == "Flaming Cyclone") {
-        if (owner->cycle == 0 || owner->action.battleManager->GetEnemies().size() <= 2) {
-            owner->action.battleManager->aiMultiplier += 100000;
-            owner->cycle++;
-        }
-        else {
-            owner->action.battleManager->aiMultiplier -= 100000;
-        }
-    }
+    RunSkillEffects(effects.finish.data(), effects.finish.size(),
+        [this](EffectInstruction const& instruction) { return TestEffect(instruction, nullptr); },
+        [this](EffectInstruction const& instruction) { ExecuteEffect(instruction, nullptr); });
 
     if (owner->debuffs.igniteStack && chiCost > 0) {
         float igniteDamage{ 0.1f * owner->stats.maxHealth };
@@ -331,6 +119,159 @@ void Attack::UseAttack(std::vector<CharacterStats*> target) {
     }
 }
 
+/**
+ * @brief Condition of a skill effect
+ *
+ * This function checks a branch condition of the skill's effect program, target is null for finish effects
+ */
+bool Attack::TestEffect(EffectInstruction const& instruction, CharacterStats* target) {
+    switch (instruction.condition) {
+    case EffectCondition::OWNER_HEALTH_BELOW:
+        return owner->stats.health < instruction.value * owner->stats.maxHealth;
+    case EffectCondition::OWNER_CHARGED:
+        return owner->charge;
+    case EffectCondition::OWNER_CYCLE:
+        return owner->cycle == instruction.amount;
+    case EffectCondition::OWNER_CYCLE_ABOVE:
+        return owner->cycle > instruction.amount;
+    case EffectCondition::OWNER_SHIELDED:
+        return owner->buffs.shieldStack != 0;
+    case EffectCondition::TARGET_SHIELDED:
+        return target->buffs.shieldStack != 0;
+    case EffectCondition::TARGET_IS_ENEMY:
+        return target->tag == CharacterType::ENEMY;
+    case EffectCondition::TARGET_IS_OWNER:
+        return target->entity == owner->entity;
+    case EffectCondition::TARGET_IS_PREY: {
+        std::string const& name{ ECS::ecs().GetComponent<Name>(target->entity).name };
+        return name == "Cat" || name == "Player_Goat";
+    }
+    case EffectCondition::TARGET_IGNITED:
+        return target->debuffs.igniteStack != 0;
+    case EffectCondition::ENEMIES_ABOVE:
+        return static_cast<int>(owner->action.battleManager->GetEnemies().size()) > instruction.amount;
+    case EffectCondition::ENEMY_STUNNED:
+        for (CharacterStats* enemy : owner->action.battleManager->GetEnemies()) {
+            if (enemy->debuffs.stunStack) {
+                return true;
+            }
+        }
+        return false;
+    case EffectCondition::PROC:
+        if (procRoll != ProcRoll::RANDOM) {
+            return procRoll == ProcRoll::ALWAYS;
+        }
+        return randomService.Stream(RandomStream::COMBAT).Float() > 0.75f;
+    default:
+        return false;
+    }
+}
+
+/**
+ * @brief Operation of a skill effect
+ *
+ * This function applies an operation of the skill's effect program, target is null for finish effects
+ */
+void Attack::ExecuteEffect(EffectInstruction const& instruction, CharacterStats* target) {
+    CharacterStats* subject{ instruction.subject == EffectSubject::OWNER ? owner : target };
+    switch (instruction.op) {
+    case EffectOp::HEAL:
+        damage = -instruction.value * owner->stats.maxHealth;
+        break;
+    case EffectOp::CANCEL_DAMAGE:
+        damage = 0;
+        break;
+    case EffectOp::LIFESTEAL:
+        owner->TakeDamage(-damage);
+        break;
+    case EffectOp::CLEAR_DEBUFFS:
+        target->debuffs.bloodStack = 0;
+        target->debuffs.tauntStack = 0;
+        target->debuffs.stunStack = 0;
+        break;
+    case EffectOp::CLEAR_BUFFS:
+        target->buffs.attackStack = 0;
+        target->buffs.attackBuff = 0.f;
+        target->buffs.defenseStack = 0;
+        target->buffs.defenseBuff = 0.f;
+        break;
+    case EffectOp::CONSUME_BLEED:
+        while (target->debuffs.bloodStack) {
+            target->ApplyBloodStack();
+        }
+        break;
+    case EffectOp::SPEED_UP:
+        target->SpeedBuff(target);
+        break;
+    case EffectOp::ATTACK_BUFF:
+        subject->buffs.attackBuff = instruction.value;
+        subject->buffs.attackStack = instruction.amount;
+        break;
+    case EffectOp::DEFENSE_BUFF:
+        subject->buffs.defenseBuff = instruction.value;
+        subject->buffs.defenseStack = instruction.amount;
+        break;
+    case EffectOp::DEFENSE_DEBUFF:
+        target->debuffs.defenseDebuff = instruction.value;
+        target->debuffs.defenseStack = instruction.amount;
+        break;
+    case EffectOp::STUN:
+        target->debuffs.stunStack += instruction.amount;
+        break;
+    case EffectOp::TAUNT:
+        target->debuffs.tauntStack += instruction.amount;
+        target->debuffs.tauntTarget = owner->entity;
+        break;
+    case EffectOp::HUNTED:
+        target->debuffs.huntedStack = instruction.amount;
+        break;
+    case EffectOp::IGNITE:
+        target->debuffs.igniteStack = instruction.amount;
+        break;
+    case EffectOp::SET_CHARGE:
+        owner->charge = instruction.amount != 0;
+        break;
+    case EffectOp::ADVANCE_CYCLE:
+        owner->cycle++;
+        if (owner->cycle > instruction.amount) {
+            owner->cycle = 0;
+        }
+        break;
+    case EffectOp::SET_CYCLE:
+        owner->cycle = instruction.amount;
+        break;
+    case EffectOp::AI_SCORE:
+        owner->action.battleManager->aiMultiplier += instruction.amount;
+        break;
+    case EffectOp::SPAWN_SHIELD:
+        //AI simulations have no entities to spawn
+        if (owner->action.battleManager->m_Entities.size()) {
+            Entity shield{ EntityFactory::entityFactory().ClonePrefab(effects.shieldPrefab) };
+            for (auto& enemy : owner->action.battleManager->GetEnemies()) {
+                if (enemy->debuffs.stunStack) {
+                    break;
+                }
+                enemy->buffs.shieldStack = 1;
+                enemy->buffs.shieldEntity = shield;
+
+                CharacterStats dispel{};
+                enemy->debuffs = dispel.debuffs;
+
+                if (ECS::ecs().HasComponent<Parent>(enemy->entity)) {
+                    Entity child_shield{ ECS::ecs().GetComponent<Parent>(enemy->entity).GetChildByName("Monkey Shield") };
+                    if (child_shield) {
+                        ECS::ecs().GetComponent<AnimationSet>(child_shield).Start("Appear",child_shield);
+                    }
+                }
+            }
+            owner->action.battleManager->AddCharacter(shield);
+        }
+        break;
+    default:
+        break;
+    }
+}
+
 /**
  * @brief Damage formula of the game
  *
@@ -339,28 +280,24 @@ void Attack::UseAttack(std::vector<CharacterStats*> target) {
 void Attack::CalculateDamage(CharacterStats& target)
 {
     //critical hit chance
-    std::random_device rd;
-    std::mt19937 gen(rd());
-    static std::uniform_real_distribution<float> rand(0.f, 1.f);
+    Xoshiro128& rng{ randomService.Stream(RandomStream::COMBAT) };
     
     float randomValue{1.f};
 
     //NO CRITS IF ITS AN AI SIMULATION
     if (target.parent->m_Entities.size() > 0) {
-        randomValue = rand(gen);
+        randomValue = rng.Float();
     }
     
     float finalAttack{ owner->stats.attack * (1 + owner->buffs.attackBuff - owner->debuffs.attackDebuff) };
     float finalDefense{ target.stats.defense * (1 + owner->buffs.defenseBuff - owner->debuffs.defenseDebuff) };
 
-    std::uniform_real_distribution<float> drand(minAttackMultiplier, maxAttackMultiplier);
-
     if (randomValue <= critRate)
     {
         //critical hit
         target.crit = true;
 
-        damage = (drand(gen) *
+        damage = (rng.Range(minAttackMultiplier, maxAttackMultiplier) *
             ((float)skillAttackPercent / 100.f) * (finalAttack * (100.f / (100.f + finalDefense)))
             * critMultiplier);
     }
@@ -368,7 +305,7 @@ void Attack::CalculateDamage(CharacterStats& target)
     {
         target.crit = false;
 
-        damage = (drand(gen) *
+        damage = (rng.Range(minAttackMultiplier, maxAttackMultiplier) *
             ((float)skillAttackPercent / 100.f) * (finalAttack * (100.f / (100.f + finalDefense))));
     }
     damage = roundf(damage);
@@ -429,6 +366,7 @@ void AttackList::SaveAttack(Attack const& attack) {
     object.AddMember("Chi Cost", attack.chiCost, allocator);
     object.AddMember("Bleed", attack.bleed, allocator);
     object.AddMember("Static", attack.staticAnimation, allocator);
+    WriteSkillEffects(attack.effects, object, allocator);
     document.PushBack(object, allocator);
 
     // Save the JSON document to a file
@@ -443,28 +381,24 @@ void AttackList::SaveAttack(Attack const& attack) {
 }
 
 /**
- * @brief Load Attack
+ * @brief Read Attack
  *
- * This function loads an attack into the system
+ * This function reads an attack from a .skill file without adding it to the system.
+ * It only uses its arguments, so skill files can be read off the main thread
  */
-void AttackList::LoadAttack(std::string attackPath) {
-    Attack atk{};
-    std::string atkname{};
-    rapidjson::Document document;
-    std::ifstream file(attackPath);
-    
-    if (!file.is_open()) {
-        std::cout << "Failed to open file: " << attackPath << "\n";
-        ASSERT(1, "Unable to open attack file!");
-        return;
+bool AttackList::ReadAttack(std::string const& attackPath, Attack& atk, std::string& error) {
+    std::vector<char> buffer;
+    if (!ReadJsonFile(attackPath, buffer)) {
+        error = "Failed to open file";
+        return false;
     }
-    rapidjson::IStreamWrapper isw(file);
-    document.ParseStream(isw);
+    // Parsed in place, the strings of the document point into buffer
+    rapidjson::Document document;
+    document.ParseInsitu(buffer.data());
 
     if (document.HasParseError()) {
-        std::cerr << "Failed to parse attack file: " << attackPath << "\n";
-        ASSERT(1, "Unable to parse attack file!");
-        return;
+        error = "Failed to parse attack file";
+        return false;
     }
 
     for (rapidjson::SizeType i = 0; i < document.Size(); ++i) {
@@ -472,8 +406,7 @@ void AttackList::LoadAttack(std::string attackPath) {
 
         if (mainObject.HasMember("Name")) {
             const rapidjson::Value& object = mainObject["Name"];
-            atkname = object.GetString();
-            atk.attackName = atkname;
+            atk.attackName = object.GetString();
         }
 
         if (mainObject.HasMember("Texture")) {
@@ -530,8 +463,51 @@ void AttackList::LoadAttack(std::string attackPath) {
             const rapidjson::Value& object = mainObject["Static"];
             atk.staticAnimation = object.GetBool();
         }
+
+        std::string effectError{};
+        if (!CompileSkillEffects(mainObject, atk.effects, effectError)) {
+            error = "Invalid effects in attack file: " + effectError;
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief Load Attack
+ *
+ * This function loads an attack into the system
+ */
+void AttackList::LoadAttack(std::string attackPath) {
+    Attack atk{};
+    std::string error{};
+    if (!ReadAttack(attackPath, atk, error)) {
+        std::cerr << error << ": " << attackPath << "\n";
+        ASSERT(1, "Unable to read attack file!");
+        return;
+    }
+    if (!error.empty()) {
+        std::cerr << error << ": " << attackPath << "\n";
+        ASSERT(1, "Invalid skill effects!");
+    }
+    data[atk.attackName] = atk;
+}
+
+/**
+ * @brief Reload Attack
+ *
+ * This function replaces an attack that was read again from its file, and the
+ * copies of it held by the skills of every character
+ */
+void AttackList::ReloadAttack(Attack const& attack) {
+    data[attack.attackName] = attack;
+    ComponentArray<CharacterStats>& statsArray{ ECS::ecs().GetComponentManager().GetComponentArrayRef<CharacterStats>() };
+    for (Entity entity : statsArray.GetEntityArray()) {
+        for (Attack& skill : statsArray.GetData(entity).action.skills) {
+            if (skill.attackName == attack.attackName) {
+                skill = attack;
+            }
+        }
     }
-    data[atkname] = atk;
 }
 
 /**
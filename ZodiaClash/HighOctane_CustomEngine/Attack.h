@@ -32,6 +32,7 @@
 
 #pragma once
 #include "CharacterCommon.h"
+#include "SkillEffect.h"
 class CharacterStats;
 
 enum class AttackType {
@@ -41,6 +42,13 @@ enum class AttackType {
     ALLYSELF
 };
 
+//How effects with a 25% chance (Yin-Yang Strike) decide whether they happen
+enum class ProcRoll {
+    RANDOM, //roll the combat stream
+    NEVER,
+    ALWAYS  //NEVER and ALWAYS let the simulation parity check play the roll it chose
+};
+
 class Attack {
 public:
     void UseAttack(CharacterStats* target);
@@ -62,8 +70,13 @@ public:
     int   bleed{};
     bool critCheck{};
     bool staticAnimation{}; //if animation is static
+    EffectProgram effects{}; //special rules, compiled from the skill file
+    ProcRoll procRoll{};
 
 private:
+    bool TestEffect(EffectInstruction const& instruction, CharacterStats* target);
+    void ExecuteEffect(EffectInstruction const& instruction, CharacterStats* target);
+
     CharacterStats* owner{};
     float damage{};
 };
@@ -72,6 +85,10 @@ class AttackList {
 public:
     void SaveAttack(Attack const& attack);
     void LoadAttack(std::string attackPath);
+    //Reads the attack in a skill file. Returns false if the file cannot be read. Invalid effects are described in error, the attack is still read
+    static bool ReadAttack(std::string const& attackPath, Attack& atk, std::string& error);
+    //Replaces the attack and the copies of it in the skills of every character
+    void ReloadAttack(Attack const& attack);
     std::vector<std::string> GetAttackNames();
     void LoadAllAttacks();
     std::unordered_map<std::string, Attack> data;
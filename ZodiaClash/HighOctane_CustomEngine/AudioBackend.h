@@ -0,0 +1,109 @@
+/******************************************************************************
+*
+*	\copyright
+*		All content(C) 2023/2024 DigiPen Institute of Technology Singapore.
+*		All rights reserved. Reproduction or disclosure of this file or its
+*		contents without the prior written consent of DigiPen Institute of
+*		Technology is prohibited.
+*
+* *****************************************************************************
+*
+*	@file		AudioBackend.h
+*
+*	@author		agent
+*
+*	@email		agent\@local
+*
+*	@course		CSD 2401 - Software Engineering Project 3
+*				CSD 2451 - Software Engineering Project 4
+*
+*	@section	Section A
+*
+*	@date		19 October 2026
+*
+* *****************************************************************************
+*
+*	@brief		Audio backend interface
+*
+*	The audio manager plays sounds through one of these. Sounds, channels
+*	and groups are referred to by handles, so a sound can be handed out
+*	while it is still loading and a channel can be asked for before the
+*	sound is ready to play it.
+*
+*	- FmodAudioBackend plays through FMOD, which is only linked on Windows
+*	- SoftwareAudioBackend decodes .wav and .ogg files itself and mixes them
+*	  to a null sink, so loading, memory and decoding can be measured where
+*	  FMOD is not available
+*
+******************************************************************************/
+
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+//How a sound is held once loaded
+enum class AudioResidency {
+	DECODED,		//decoded to PCM when loaded
+	COMPRESSED,		//file kept in memory as is and decoded while playing
+	STREAMED		//read from the file a piece at a time while playing
+};
+
+enum class AudioLoadState {
+	LOADING,
+	READY,
+	FAILED
+};
+
+//0 is never a valid handle
+using AudioSoundHandle = uint32_t;
+using AudioChannelHandle = uint32_t;
+using AudioGroupHandle = uint32_t;
+
+struct AudioSoundInfo {
+	AudioLoadState state{ AudioLoadState::FAILED };
+	size_t memory{};				//bytes held for the sound, the stream buffer for streamed sounds
+	double loadMilliseconds{};		//time from CreateSound to the sound being ready
+};
+
+class IAudioBackend {
+public:
+	virtual ~IAudioBackend() = default;
+
+	virtual const char* GetName() const = 0;
+	//Returns false if the device or library could not be started
+	virtual bool Initialize() = 0;
+	//Called every frame
+	virtual void Update() = 0;
+	virtual void Release() = 0;
+
+	virtual AudioGroupHandle GetMasterGroup() = 0;
+	//Creates a group mixed into the master group
+	virtual AudioGroupHandle CreateGroup(const char* name) = 0;
+	virtual void SetGroupVolume(AudioGroupHandle group, float volume) = 0;
+	virtual float GetGroupVolume(AudioGroupHandle group) = 0;
+	virtual void SetGroupPaused(AudioGroupHandle group, bool paused) = 0;
+	virtual bool IsGroupPaused(AudioGroupHandle group) = 0;
+	virtual void StopGroup(AudioGroupHandle group) = 0;
+
+	//Starts loading path, from the asset pack if it is packed. With async the handle is returned
+	//before the sound is loaded and GetSoundInfo reports when it is ready. Returns 0 if it cannot be loaded
+	virtual AudioSoundHandle CreateSound(const char* path, AudioResidency residency, bool loop, bool async) = 0;
+	virtual AudioSoundInfo GetSoundInfo(AudioSoundHandle sound) = 0;
+	//Stops the channels playing the sound and frees it
+	virtual void ReleaseSound(AudioSoundHandle sound) = 0;
+
+	//Plays sound in group. A sound still loading starts playing once it is ready
+	virtual AudioChannelHandle Play(AudioSoundHandle sound, AudioGroupHandle group) = 0;
+	//True until the channel finishes, is stopped, or its sound fails to load
+	virtual bool IsPlaying(AudioChannelHandle channel) = 0;
+	//-1 is full left, 1 is full right
+	virtual void SetChannelPan(AudioChannelHandle channel, float pan) = 0;
+	//1 leaves the channel unfiltered, lower values cut more of the high frequencies
+	virtual void SetChannelLowPass(AudioChannelHandle channel, float gain) = 0;
+};
+
+#ifdef _WIN32
+std::unique_ptr<IAudioBackend> CreateFmodAudioBackend();
+#endif
+std::unique_ptr<IAudioBackend> CreateSoftwareAudioBackend();
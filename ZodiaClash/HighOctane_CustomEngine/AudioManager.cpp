@@ -28,30 +28,35 @@
 *   Contains functions to play audio
 *	Audio manager loads and unloads all audio files as well as
 *   stores them in a central map
+*	Sounds are played through an IAudioBackend, FMOD on Windows and the
+*	software mixer elsewhere. Sound effects are kept compressed, music and
+*	ambience are streamed, and groups over their memory budget unload the
+*	sounds played least recently
 *
 ******************************************************************************/
 
 #include "AudioManager.h"
 #include "AssetManager.h"
+#include "File.h"
 #include "DebugDiagnostic.h"
 #include <iostream>
 #include <filesystem>
+#include <algorithm>
+#include <chrono>
 
 void AudioManager::Initialize() {
-    FMOD_RESULT result;
-
-    result = FMOD::System_Create(&system);      // Create the main system object.
-    if (result != FMOD_OK)
-    {
-        ASSERT(1, "Unable to create FMOD system!");
+#ifdef _WIN32
+    backend = CreateFmodAudioBackend();
+    if (!backend->Initialize()) {
+        DEBUG_PRINT("Unable to initialise FMOD, sounds are mixed in software without output");
+        backend.reset();
     }
-
-    result = system->init(512, FMOD_INIT_CHANNEL_LOWPASS, 0);    // Initialize FMOD.
-    if (result != FMOD_OK)
-    {
-        ASSERT(1, "Unable to initialise FMOD system!");
+#endif
+    if (!backend) {
+        backend = CreateSoftwareAudioBackend();
+        backend->Initialize();
     }
-    system->getMasterChannelGroup(&group["Master"]);
+    group["Master"] = backend->GetMasterGroup();
     CreateGroup("SFX");
     CreateGroup("BGM");
     CreateGroup("ENV");
@@ -61,111 +66,169 @@ void AudioManager::Initialize() {
 }
 
 void AudioManager::Update() {
-    system->update();
+    backend->Update();
     for (auto& c : channels) {
-        std::vector<FMOD::Channel*> removeList{};
-        for (auto& s : c.second) {
-            bool isPlaying;
-            s->isPlaying(&isPlaying);
-            if (!isPlaying) {
-                removeList.push_back(s);
+        c.second.remove_if([this](AudioChannelHandle channel) { return !backend->IsPlaying(channel); });
+    }
+    for (auto it = data.begin(); it != data.end();) {
+        SoundEntry& entry{ it->second };
+        entry.channels.erase(std::remove_if(entry.channels.begin(), entry.channels.end(),
+            [this](AudioChannelHandle channel) { return !backend->IsPlaying(channel); }), entry.channels.end());
+        if (entry.state == AudioLoadState::LOADING) {
+            AudioSoundInfo info{ backend->GetSoundInfo(entry.handle) };
+            entry.state = info.state;
+            entry.memory = info.memory;
+            if (info.state == AudioLoadState::READY) {
+                ++stats.loads;
+                stats.loadMilliseconds += info.loadMilliseconds;
+                stats.lastLoad = it->first;
+                stats.lastLoadMilliseconds = info.loadMilliseconds;
             }
         }
-        for (auto& r : removeList) {
-            c.second.remove(r);
+        // A sound that could not be loaded is forgotten, so playing it tries to load it again
+        if (entry.state == AudioLoadState::FAILED) {
+            DEBUG_PRINT("Unable to load sound %s", it->first.c_str());
+            ++stats.failed;
+            backend->ReleaseSound(entry.handle);
+            it = data.erase(it);
+            continue;
         }
+        ++it;
     }
+    UnloadOverBudget();
 }
 
-void AudioManager::UpdateAudioDirectory() {
-    std::filesystem::path soundFolder{ assetmanager.GetDefaultPath() + "Sound/" };
-    std::vector <std::string> newSoundPaths{};
-    std::vector <std::string> newMusicPaths{};
-    std::vector <std::string> newAmbiencePaths{};
-    for (auto& entry : std::filesystem::directory_iterator(soundFolder)) {
-        std::string path{ entry.path().string() };
-        path = path.substr(path.find_last_of("/") + 1);
-        newSoundPaths.push_back(path);
-    }
-    std::filesystem::path musicFolder{ assetmanager.GetDefaultPath() + "Music/" };
-    for (auto& entry : std::filesystem::directory_iterator(musicFolder)) {
-        std::string path{ entry.path().string() };
-        path = path.substr(path.find_last_of("/") + 1);
-        newMusicPaths.push_back(path);
-    }
-    std::filesystem::path ambienceFolder{ assetmanager.GetDefaultPath() + "Ambience/" };
-    for (auto& entry : std::filesystem::directory_iterator(ambienceFolder)) {
-        std::string path{ entry.path().string() };
-        path = path.substr(path.find_last_of("/") + 1);
-        newAmbiencePaths.push_back(path);
+void AudioManager::UnloadOverBudget() {
+    for (auto const& budget : budgets) {
+        if (budget.second == 0) {
+            continue;
+        }
+        size_t used{ GetGroupMemory(budget.first.c_str()) };
+        while (used > budget.second) {
+            auto oldest{ data.end() };
+            for (auto it = data.begin(); it != data.end(); ++it) {
+                SoundEntry const& entry{ it->second };
+                if (entry.group != budget.first || entry.state != AudioLoadState::READY || !entry.channels.empty()
+                    || it->first == currentBGM || it->first == currentAmbience) {
+                    continue;
+                }
+                if (oldest == data.end() || entry.lastUsed < oldest->second.lastUsed) {
+                    oldest = it;
+                }
+            }
+            // Everything left is playing
+            if (oldest == data.end()) {
+                break;
+            }
+            used -= oldest->second.memory;
+            ++stats.unloaded;
+            backend->ReleaseSound(oldest->second.handle);
+            data.erase(oldest);
+        }
     }
-    soundPaths = newSoundPaths;
-    musicPaths = newMusicPaths;
-    ambiencePaths = newAmbiencePaths;
+}
+
+void AudioManager::UpdateAudioDirectory() {
+    SetAudioPaths(FilePath::ListFileNames(assetmanager.GetDefaultPath() + "Sound/"),
+        FilePath::ListFileNames(assetmanager.GetDefaultPath() + "Music/"),
+        FilePath::ListFileNames(assetmanager.GetDefaultPath() + "Ambience/"));
+}
+
+void AudioManager::SetAudioPaths(std::vector<std::string> sound, std::vector<std::string> music, std::vector<std::string> ambience) {
+    soundPaths = std::move(sound);
+    musicPaths = std::move(music);
+    ambiencePaths = std::move(ambience);
 }
 
 void AudioManager::Release() {
-    system->release();
+    data.clear();
+    channels.clear();
+    backend->Release();
 }
 
-FMOD::ChannelGroup* AudioManager::CreateGroup(const char* name) {
+AudioGroupHandle AudioManager::CreateGroup(const char* name) {
     if (group.count(name)) {
         return group[name];
     }
-    FMOD::ChannelGroup* channelgroup;
-    system->createChannelGroup(name, &channelgroup);
-    group[name] = channelgroup;
+    group[name] = backend->CreateGroup(name);
     return group[name];
 }
 
 void AudioManager::SetGroupVolume(const char* name, float volume) {
-    group[name]->setVolume(volume);
+    backend->SetGroupVolume(group[name], volume);
 }
 
 float AudioManager::GetGroupVolume(const char* name) {
-    float volume{};
-    group[name]->getVolume(&volume);
-    return volume;
+    return backend->GetGroupVolume(group[name]);
 }
 
 void AudioManager::StopGroup(const char* name) {
-    group[name]->stop();
+    backend->StopGroup(group[name]);
 }
 
 void AudioManager::ResumeGroup(const char* name) {
-    group[name]->setPaused(false);
+    backend->SetGroupPaused(group[name], false);
 }
 
 void AudioManager::PauseGroup(const char* name) {
-    group[name]->setPaused(true);
+    backend->SetGroupPaused(group[name], true);
 }
 
 bool AudioManager::IsGroupPaused(const char* name) {
-    bool status;
-    group[name]->getPaused(&status);
-    return status;
+    return backend->IsGroupPaused(group[name]);
+}
+
+void AudioManager::SetGroupBudget(const char* name, size_t bytes) {
+    budgets[name] = bytes;
+}
+
+size_t AudioManager::GetGroupBudget(const char* name) {
+    auto it{ budgets.find(name) };
+    return it == budgets.end() ? 0 : it->second;
 }
 
-FMOD::Sound* AudioManager::AddSound(const char* path, const char* name) {
-    if (data.count(name) && data[name] != nullptr) {
-        return data[name];
+size_t AudioManager::GetGroupMemory(const char* name) {
+    size_t memory{};
+    for (auto const& sound : data) {
+        if (sound.second.group == name) {
+            memory += sound.second.memory;
+        }
     }
-    FMOD_RESULT result;
-    result = system->createSound(path, FMOD_DEFAULT,0,&data[name]);
-    if (result != FMOD_OK) {
+    return memory;
+}
+
+AudioSoundHandle AudioManager::Load(const char* path, const char* name, const char* groupName, AudioResidency residency, bool loop) {
+    AudioSoundHandle handle{ backend->CreateSound(path, residency, loop, asyncLoads) };
+    if (handle == 0) {
+        ++stats.failed;
         ASSERT(1, "Error creating sound!");
+        return 0;
+    }
+    SoundEntry& entry{ data[name] };
+    entry.handle = handle;
+    entry.group = groupName;
+    entry.lastUsed = ++useCount;
+    return handle;
+}
+
+AudioSoundHandle AudioManager::AddSound(const char* path, const char* name) {
+    auto it{ data.find(name) };
+    if (it != data.end()) {
+        return it->second.handle;
     }
-    return data[name];
+    return Load(path, name, "SFX", compressSounds ? AudioResidency::COMPRESSED : AudioResidency::DECODED, false);
 }
 
-FMOD::Sound* AudioManager::AddMusic(const char* path, const char* name) {
-    if (data[name] != nullptr) {
-        return data[name];
+AudioSoundHandle AudioManager::AddMusic(const char* path, const char* name) {
+    auto it{ data.find(name) };
+    //Music kept loaded across a scene change still starts as the new scene's BGM
+    if (it != data.end() && originalBGM != "") {
+        return it->second.handle;
     }
-    FMOD_RESULT result;
-    result = system->createSound(path, FMOD_LOOP_NORMAL, 0, &data[name]);
-    if (result != FMOD_OK) {
-        ASSERT(1, "Error creating music!");
+    AudioSoundHandle handle{ it != data.end() ? it->second.handle
+        : Load(path, name, "BGM", streamMusic ? AudioResidency::STREAMED : AudioResidency::DECODED, true) };
+    if (handle == 0) {
+        return 0;
     }
 
     //If no BGM loaded, player current BGM
@@ -174,17 +237,18 @@ FMOD::Sound* AudioManager::AddMusic(const char* path, const char* name) {
         originalBGM = name;
         currentBGM = name;
     }
-    return data[name];
+    return handle;
 }
 
-FMOD::Sound* AudioManager::AddAmbience(const char* path, const char* name) {
-    if (data[name] != nullptr) {
-        return data[name];
+AudioSoundHandle AudioManager::AddAmbience(const char* path, const char* name) {
+    auto it{ data.find(name) };
+    if (it != data.end() && currentAmbience != "") {
+        return it->second.handle;
     }
-    FMOD_RESULT result;
-    result = system->createSound(path, FMOD_LOOP_NORMAL, 0, &data[name]);
-    if (result != FMOD_OK) {
-        ASSERT(1, "Error creating ambience!");
+    AudioSoundHandle handle{ it != data.end() ? it->second.handle
+        : Load(path, name, "ENV", streamMusic ? AudioResidency::STREAMED : AudioResidency::DECODED, true) };
+    if (handle == 0) {
+        return 0;
     }
 
     //If no BGM loaded, player current BGM
@@ -192,27 +256,44 @@ FMOD::Sound* AudioManager::AddAmbience(const char* path, const char* name) {
         PlaySounds(name, "ENV");
         currentAmbience = name;
     }
-    return data[name];
+    return handle;
 }
 
-FMOD::Channel* AudioManager::PlaySounds(const char* sound, const char* channelGroup) {
-    FMOD::Channel* tmp;
-    if (data[sound] == nullptr) {
+AudioChannelHandle AudioManager::PlaySounds(const char* sound, const char* channelGroup) {
+    if (!IsLoaded(sound)) {
         assetmanager.LoadAssets(sound);
     }
-    if (channelGroup == nullptr) {
-        system->playSound(data[sound], 0, false, &tmp);
+    auto it{ data.find(sound) };
+    if (it == data.end()) {
+        return 0;
+    }
+    SoundEntry& entry{ it->second };
+    entry.lastUsed = ++useCount;
+    AudioGroupHandle target{ backend->GetMasterGroup() };
+    if (channelGroup != nullptr) {
+        entry.group = channelGroup;
+        if (group.count(channelGroup)) {
+            target = group[channelGroup];
+        }
     }
-    else {
-        system->playSound(data[sound], group[channelGroup], false, &tmp);
+    AudioChannelHandle channel{ backend->Play(entry.handle, target) };
+    if (channel != 0) {
+        entry.channels.push_back(channel);
+        channels[channelGroup != nullptr ? channelGroup : "Master"].push_back(channel);
     }
-    channels[channelGroup].push_back(tmp);
-    return tmp;
+    return channel;
+}
+
+void AudioManager::SetChannelPan(AudioChannelHandle channel, float pan) {
+    backend->SetChannelPan(channel, pan);
 }
 
 void AudioManager::FreeSound(const char* sound) {
-    data[sound]->release();
-    data.erase(sound);
+    auto it{ data.find(sound) };
+    if (it != data.end()) {
+        backend->ReleaseSound(it->second.handle);
+        data.erase(it);
+    }
 }
 
 void AudioManager::SetBGM(const char* name) {
@@ -235,7 +316,7 @@ void AudioManager::SetAmbience(const char* name) {
 
 void AudioManager::ReleaseAllSounds() {
     for (auto const& sound : data) {
-        sound.second->release();
+        backend->ReleaseSound(sound.second.handle);
     }
     data.clear();
     currentBGM.clear();
@@ -243,8 +324,73 @@ void AudioManager::ReleaseAllSounds() {
     currentAmbience.clear();
 }
 
-FMOD::System* AudioManager::GetSystem() {
-    return system;
+void AudioManager::ResetSceneAudio() {
+    StopGroup("BGM");
+    StopGroup("ENV");
+    currentBGM.clear();
+    originalBGM.clear();
+    currentAmbience.clear();
+}
+
+bool AudioManager::IsLoaded(const char* sound) {
+    return data.count(sound) != 0;
+}
+
+const char* AudioManager::GetBackendName() const {
+    return backend ? backend->GetName() : "None";
+}
+
+AudioStats AudioManager::GetStats() const {
+    AudioStats current{ stats };
+    for (auto const& sound : data) {
+        ++current.sounds;
+        current.loading += sound.second.state == AudioLoadState::LOADING;
+        current.memory += sound.second.memory;
+    }
+    return current;
+}
+
+AudioLoadBenchmarkResult AudioManager::RunLoadBenchmark() {
+    using clock = std::chrono::high_resolution_clock;
+
+    struct Folder {
+        const char* name;
+        std::vector<std::string> const& files;
+        AudioResidency residency;
+        bool loop;
+    };
+    Folder const folders[]{
+        { "Sound/", soundPaths, compressSounds ? AudioResidency::COMPRESSED : AudioResidency::DECODED, false },
+        { "Music/", musicPaths, streamMusic ? AudioResidency::STREAMED : AudioResidency::DECODED, true },
+        { "Ambience/", ambiencePaths, streamMusic ? AudioResidency::STREAMED : AudioResidency::DECODED, true }
+    };
+
+    // Blocking loads, so the time is the time to load and not how long the frame took
+    AudioLoadBenchmarkResult result{};
+    result.backend = backend->GetName();
+    for (int pass = 0; pass < 2; ++pass) {
+        AudioLoadBenchmarkPass& measured{ pass == 0 ? result.decoded : result.asSet };
+        std::vector<AudioSoundHandle> handles;
+        auto start{ clock::now() };
+        for (Folder const& folder : folders) {
+            for (std::string const& file : folder.files) {
+                std::string path{ assetmanager.GetDefaultPath() + folder.name + file };
+                AudioSoundHandle handle{ backend->CreateSound(path.c_str(), pass == 0 ? AudioResidency::DECODED : folder.residency, folder.loop, false) };
+                if (handle != 0) {
+                    handles.push_back(handle);
+                    measured.memory += backend->GetSoundInfo(handle).memory;
+                }
+            }
+        }
+        measured.milliseconds = std::chrono::duration<double, std::milli>(clock::now() - start).count();
+        measured.files = handles.size();
+        for (AudioSoundHandle handle : handles) {
+            backend->ReleaseSound(handle);
+        }
+    }
+
+    DEBUG_PRINT("Audio load benchmark (%s): decoded %.2f ms, as set %.2f ms", result.backend.c_str(), result.decoded.milliseconds, result.asSet.milliseconds);
+    return result;
 }
 
 std::vector<std::string> AudioManager::GetSoundNames() {
@@ -277,6 +423,6 @@ std::string AudioManager::GetCurrentAmbience() {
 
 void AudioManager::SetGroupFilter(const char* name, float filter) {
     for (auto& c : channels[name]) {
-        c->setLowPassGain(filter);
+        backend->SetChannelLowPass(c, filter);
     }
 }
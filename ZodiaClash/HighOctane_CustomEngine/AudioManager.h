@@ -27,25 +27,60 @@
 *
 *   Contains functions to play audio
 *	Audio manager loads and unloads all audio files as well as stores them in a central map
+*	Sounds, channels and groups are handles of the backend playing them, see AudioBackend.h
 *
 ******************************************************************************/
 
 #pragma once
-#include <fmod/core/inc/fmod.hpp>
+#include "AudioBackend.h"
+#include <list>
+#include <memory>
 #include <unordered_map>
 #include <string>
+#include <vector>
 
 const float LOW_FILTER_VALUE{ 0.5f };
 
+//Sounds loaded and the time they took, for the performance window
+struct AudioStats {
+	size_t sounds{};				//sounds loaded or loading
+	size_t loading{};
+	size_t memory{};				//bytes held by the sounds loaded
+	size_t loads{};					//sounds that finished loading since start up
+	size_t failed{};				//sounds that could not be loaded since start up
+	size_t unloaded{};				//sounds unloaded to keep a group within its budget
+	double loadMilliseconds{};		//total time of the loads
+	std::string lastLoad{};
+	double lastLoadMilliseconds{};
+};
+
+//One pass of AudioManager::RunLoadBenchmark
+struct AudioLoadBenchmarkPass {
+	size_t files{};					//files that could be loaded
+	size_t memory{};				//bytes held by them once loaded
+	double milliseconds{};
+};
+
+//Result of AudioManager::RunLoadBenchmark
+struct AudioLoadBenchmarkResult {
+	std::string backend{};			//empty if the benchmark was not run
+	AudioLoadBenchmarkPass decoded{};
+	AudioLoadBenchmarkPass asSet{};	//loaded the way streamMusic and compressSounds load them
+};
+
 class AudioManager {
 public:
-	void Initialize(); //Creates FMOD system
-	void Update(); //Updates FMOD, to be called every frame
+	bool asyncLoads{ true };		//sounds load without blocking the frame, a sound played while loading starts once it is ready
+	bool streamMusic{ true };		//music and ambience are streamed instead of decoded when loaded
+	bool compressSounds{ true };	//sound effects are kept compressed and decoded while playing
+
+	void Initialize(); //Creates the audio backend, FMOD where it is linked
+	void Update(); //Updates the backend, to be called every frame
 	void Release(); //DELETES THE AUDIO SYSTEM, ONLY CALL AT END OF PROGRAM
 
 	//FUNCTIONS FOR CHANNEL GROUPS
 	//Creates a group with input name
-	FMOD::ChannelGroup* CreateGroup(const char* name); 
+	AudioGroupHandle CreateGroup(const char* name); 
 	//Sets the volume of the group
 	void SetGroupVolume(const char* name, float volume); 
 	//Get the group volume, float* is the input volume
@@ -60,6 +95,11 @@ public:
 	void PauseGroup(const char* name); 
 	//Returns true if group is paused
 	bool IsGroupPaused(const char* name); 
+	//Sets the bytes the sounds last played in the group may hold before the least recently used are unloaded, 0 for no limit
+	void SetGroupBudget(const char* name, size_t bytes);
+	size_t GetGroupBudget(const char* name);
+	//Bytes held by the sounds last played in the group
+	size_t GetGroupMemory(const char* name);
 	//Sets the BGM of the scene
 	void SetBGM(const char* name); 
 	//Restarts scene BGM to original
@@ -69,18 +109,27 @@ public:
 
 	//Releases all sounds from audio manager
 	void ReleaseAllSounds(); 
-	//Add a sound to FMOD and audio manager
-	FMOD::Sound* AddSound(const char* path, const char* name); 
-	//Add music to FMOD and audio manager
-	FMOD::Sound* AddMusic(const char* path, const char* name); 
-	//Add ambience to FMOD and audio manager
-	FMOD::Sound* AddAmbience(const char* path, const char* name); 
-	//Plays loaded sound
-	FMOD::Channel* PlaySounds(const char* sound, const char* channelGroup = nullptr);
-	//Free a sound from FMOD and audio manager
+	//Stops the scene's BGM and ambience, the next music and ambience loaded will play as the new scene's
+	void ResetSceneAudio();
+	//Returns true if the sound is loaded or loading
+	bool IsLoaded(const char* sound);
+	//Add a sound to the backend and audio manager
+	AudioSoundHandle AddSound(const char* path, const char* name); 
+	//Add music to the backend and audio manager
+	AudioSoundHandle AddMusic(const char* path, const char* name); 
+	//Add ambience to the backend and audio manager
+	AudioSoundHandle AddAmbience(const char* path, const char* name); 
+	//Plays loaded sound, loading it first if needed. Returns 0 if it cannot be played
+	AudioChannelHandle PlaySounds(const char* sound, const char* channelGroup = nullptr);
+	//Pans a playing channel, -1 is full left and 1 is full right
+	void SetChannelPan(AudioChannelHandle channel, float pan);
+	//Free a sound from the backend and audio manager
 	void FreeSound(const char* sound); 
-	//Gets the FMOD system
-	FMOD::System* GetSystem(); 
+	//Gets the name of the backend playing the sounds
+	const char* GetBackendName() const;
+	AudioStats GetStats() const;
+	//Loads every file of the sound, music and ambience folders decoded, then the way they are loaded now, and measures the memory and time taken
+	AudioLoadBenchmarkResult RunLoadBenchmark();
 
 	//Get names of all sounds currently loaded
 	std::vector<std::string> GetSoundNames(); 
@@ -96,11 +145,29 @@ public:
 	std::string GetCurrentAmbience();
 	//Update the paths in sound and music folders
 	void UpdateAudioDirectory(); 
+	//Replaces the paths of the sound, music and ambience folders with lists made elsewhere
+	void SetAudioPaths(std::vector<std::string> sound, std::vector<std::string> music, std::vector<std::string> ambience);
 private:
-	FMOD::System* system{};
-	std::unordered_map<std::string, FMOD::Sound*> data{};
-	std::unordered_map<std::string, FMOD::ChannelGroup*> group{};
-	std::unordered_map<std::string, std::list<FMOD::Channel*>> channels{};
+	struct SoundEntry {
+		AudioSoundHandle handle{};
+		AudioLoadState state{ AudioLoadState::LOADING };
+		std::string group{};		//group the sound counts towards, the one it was last played in
+		size_t memory{};			//known once loaded
+		uint64_t lastUsed{};		//useCount when it was loaded or last played
+		std::vector<AudioChannelHandle> channels{};		//channels playing it
+	};
+
+	AudioSoundHandle Load(const char* path, const char* name, const char* groupName, AudioResidency residency, bool loop);
+	//Unloads the least recently used sounds that are not playing from groups over their budget
+	void UnloadOverBudget();
+
+	std::unique_ptr<IAudioBackend> backend{};
+	std::unordered_map<std::string, SoundEntry> data{};
+	std::unordered_map<std::string, AudioGroupHandle> group{};
+	std::unordered_map<std::string, std::list<AudioChannelHandle>> channels{};
+	std::unordered_map<std::string, size_t> budgets{ { "SFX", 32u << 20 }, { "VOC", 16u << 20 } };
+	uint64_t useCount{};
+	AudioStats stats{};
 
 	std::string currentBGM{};
 	std::string originalBGM{};
@@ -0,0 +1,694 @@
+/******************************************************************************
+*
+*	\copyright
+*		All content(C) 2023/2024 DigiPen Institute of Technology Singapore.
+*		All rights reserved. Reproduction or disclosure of this file or its
+*		contents without the prior written consent of DigiPen Institute of
+*		Technology is prohibited.
+*
+* *****************************************************************************
+*
+*	@file		BalanceSim.cpp
+*
+*	@author		agent
+*
+*	@email		agent\@local
+*
+*	@course		CSD 2401 - Software Engineering Project 3
+*				CSD 2451 - Software Engineering Project 4
+*
+*	@section	Section A
+*
+*	@date		19 October 2026
+*
+* *****************************************************************************
+*
+*	@brief		Headless battle balance simulator
+*
+*	Battle playouts on worker threads, the JSON and CSV report and the
+*	command line
+*
+******************************************************************************/
+
+#include "BalanceSim.h"
+#include "GameAITree.h"
+#include "GameAILogic.h"
+#include "TranspositionTable.h"
+#include "AssetManager.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <thread>
+#include <rapidjson-master/include/rapidjson/prettywriter.h>
+#include <rapidjson-master/include/rapidjson/stringbuffer.h>
+
+//------------------------------------------------------------------------------------------
+const size_t BATCH_SIZE = 64; //battles a thread takes at a time
+//----------------------------------------------------------------------------------------
+
+namespace {
+	struct BattleSetup {
+		BattleSimContext context{};
+		BattleSimState initial{};
+	};
+
+	const char* PolicyName(BalancePolicy policy) {
+		switch (policy) {
+		case BalancePolicy::RANDOM:
+			return "random";
+		case BalancePolicy::GREEDY:
+			return "greedy";
+		default:
+			return "search";
+		}
+	}
+
+	bool ParsePolicy(std::string const& name, BalancePolicy& policy) {
+		for (BalancePolicy p : { BalancePolicy::RANDOM, BalancePolicy::GREEDY, BalancePolicy::SEARCH }) {
+			if (name == PolicyName(p)) {
+				policy = p;
+				return true;
+			}
+		}
+		return false;
+	}
+
+	//Health changes are added up in thousandths so totals do not depend on the order threads add them in
+	long long ToMilli(float health) {
+		return std::llround(static_cast<double>(health) * 1000.0);
+	}
+
+	double FromMilli(long long milli) {
+		return static_cast<double>(milli) / 1000.0;
+	}
+
+	SimAction ChooseMove(BalanceConfig const& config, BalancePolicy policy, BattleSetup const& setup, BattleSimState const& state,
+		TreeManager& ai, TranspositionTable& table, Xoshiro128& gen) {
+		SimAction actions[SIM_MAX_ACTIONS];
+		int count{ state.GetActions(setup.context, actions) };
+		if (count == 0) {
+			return SimAction{};
+		}
+		if (count == 1 || policy == BalancePolicy::RANDOM) {
+			return actions[gen.RangeInt(0, count - 1)];
+		}
+		//No time budget or extra tasks, so a move only depends on the seed
+		SearchLimits limits{ policy == BalancePolicy::GREEDY ? 1 : config.depth, 0, 1 };
+		limits.table = &table;
+		return ai.SearchState(setup.context, state, limits).action;
+	}
+
+	/*!
+	* \brief Plays one battle to the end
+	*
+	* Damage is the health the other side lost while a skill's move was
+	* played, so bleed and burn ticks of the move count towards its skill.
+	*
+	*/
+	void PlayBattle(BalanceConfig const& config, BattleSetup const& setup, uint64_t seed, TreeManager& ai, TranspositionTable& table, BalanceTotals& totals) {
+		BattleSimContext const& context{ setup.context };
+		Xoshiro128 gen{ seed };
+		ai.Seed(gen());
+
+		BattleSimState state{ setup.initial };
+		int moves{};
+		while (!state.IsOver() && moves < config.maxTurns) {
+			int8_t active{ state.activeCharacter };
+			CharacterType side{ context.characters[active].tag };
+			SimAction action{ ChooseMove(config, side == CharacterType::PLAYER ? config.players : config.enemies, setup, state, ai, table, gen) };
+
+			float health[SIM_MAX_CHARACTERS]{};
+			for (int i = 0; i < state.characterCount; ++i) {
+				health[i] = state.characters[i].health;
+			}
+			state.Apply(context, action, RollSimSkill(context, state, action, gen));
+			++moves;
+
+			if (action.skill == SIM_NONE) {
+				continue;
+			}
+			BalanceSkill& skill{ totals.skills[active][action.skill] };
+			++skill.uses;
+			for (int i = 0; i < state.characterCount; ++i) {
+				float change{ health[i] - state.characters[i].health };
+				if (context.characters[i].tag != side && change > 0.f) {
+					skill.damage += ToMilli(change);
+				}
+				else if (context.characters[i].tag == side && change < 0.f) {
+					skill.healing -= ToMilli(change);
+				}
+			}
+		}
+
+		++totals.battles;
+		if (!state.IsOver()) {
+			++totals.unfinished;
+		}
+		else if (state.battleState == WIN) {
+			++totals.playerWins;
+			++totals.playerWinTurns[moves];
+		}
+		else {
+			++totals.enemyWins;
+			++totals.enemyWinTurns[moves];
+		}
+		for (int i = 0; i < state.characterCount; ++i) {
+			if (!state.characters[i].removed && state.characters[i].health > 0.f) {
+				++totals.survived[i];
+			}
+		}
+	}
+
+	//Reads stat overrides from a CSV with a header row, the columns are found by name
+	bool LoadStatOverrides(std::string const& path, std::vector<SimStatOverride>& overrides, std::string& error) {
+		std::ifstream file(path);
+		if (!file.is_open()) {
+			file.open(assetmanager.GetDefaultPath() + path);
+		}
+		if (!file.is_open()) {
+			error = "unable to open " + path;
+			return false;
+		}
+
+		auto split = [](std::string const& line) {
+			std::vector<std::string> cells{};
+			std::stringstream stream(line);
+			std::string cell{};
+			while (std::getline(stream, cell, ',')) {
+				if (!cell.empty() && cell.back() == '\r') {
+					cell.pop_back();
+				}
+				cells.push_back(cell);
+			}
+			return cells;
+		};
+
+		std::string line{};
+		std::getline(file, line);
+		std::vector<std::string> header{ split(line) };
+		auto column = [&header](const char* name) {
+			auto found{ std::find(header.begin(), header.end(), name) };
+			return found == header.end() ? -1 : static_cast<int>(found - header.begin());
+		};
+		int nameColumn{ column("name") };
+		if (nameColumn < 0) {
+			error = path + " has no name column";
+			return false;
+		}
+		int healthColumn{ column("maxHealth") };
+		int attackColumn{ column("attack") };
+		int defenseColumn{ column("defense") };
+		int speedColumn{ column("speed") };
+
+		while (std::getline(file, line)) {
+			std::vector<std::string> cells{ split(line) };
+			if (static_cast<int>(cells.size()) <= nameColumn || cells[nameColumn].empty()) {
+				continue;
+			}
+			auto cellValue = [&cells](int index, float fallback) {
+				return index >= 0 && index < static_cast<int>(cells.size()) && !cells[index].empty() ? std::strtof(cells[index].c_str(), nullptr) : fallback;
+			};
+			SimStatOverride stats{};
+			stats.name = cells[nameColumn];
+			stats.maxHealth = cellValue(healthColumn, -1.f);
+			stats.attack = cellValue(attackColumn, -1.f);
+			stats.defense = cellValue(defenseColumn, -1.f);
+			stats.speed = static_cast<int>(cellValue(speedColumn, -1.f));
+			overrides.push_back(stats);
+		}
+		return true;
+	}
+
+	//Splits a command line into arguments, keeping quoted arguments together
+	std::vector<std::string> SplitCommandLine(std::string const& commandLine) {
+		std::vector<std::string> arguments{};
+		std::string current{};
+		bool quoted{};
+		bool started{};
+		for (char c : commandLine) {
+			if (c == '"') {
+				quoted = !quoted;
+				started = true;
+			}
+			else if (!quoted && (c == ' ' || c == '\t')) {
+				if (started) {
+					arguments.push_back(current);
+					current.clear();
+					started = false;
+				}
+			}
+			else {
+				current += c;
+				started = true;
+			}
+		}
+		if (started) {
+			arguments.push_back(current);
+		}
+		return arguments;
+	}
+
+	//Turn statistics of a histogram of battles by number of moves
+	struct TurnSummary {
+		size_t battles{};
+		double average{};
+		int median{};
+		int p90{};
+		int shortest{};
+		int longest{};
+	};
+
+	TurnSummary SummariseTurns(std::vector<size_t> const& histogram) {
+		TurnSummary summary{};
+		double total{};
+		for (size_t turns = 0; turns < histogram.size(); ++turns) {
+			summary.battles += histogram[turns];
+			total += static_cast<double>(turns) * histogram[turns];
+		}
+		if (summary.battles == 0) {
+			return summary;
+		}
+		summary.average = total / summary.battles;
+		size_t seen{};
+		bool first{ true };
+		for (size_t turns = 0; turns < histogram.size(); ++turns) {
+			if (histogram[turns] == 0) {
+				continue;
+			}
+			if (first) {
+				summary.shortest = static_cast<int>(turns);
+				first = false;
+			}
+			if (seen < (summary.battles + 1) / 2 && seen + histogram[turns] >= (summary.battles + 1) / 2) {
+				summary.median = static_cast<int>(turns);
+			}
+			if (seen < (summary.battles * 9 + 9) / 10 && seen + histogram[turns] >= (summary.battles * 9 + 9) / 10) {
+				summary.p90 = static_cast<int>(turns);
+			}
+			seen += histogram[turns];
+			summary.longest = static_cast<int>(turns);
+		}
+		return summary;
+	}
+}
+
+void BalanceTotals::Add(BalanceTotals const& other) {
+	battles += other.battles;
+	playerWins += other.playerWins;
+	enemyWins += other.enemyWins;
+	unfinished += other.unfinished;
+	playerWinTurns.resize(std::max(playerWinTurns.size(), other.playerWinTurns.size()));
+	enemyWinTurns.resize(std::max(enemyWinTurns.size(), other.enemyWinTurns.size()));
+	for (size_t i = 0; i < other.playerWinTurns.size(); ++i) {
+		playerWinTurns[i] += other.playerWinTurns[i];
+	}
+	for (size_t i = 0; i < other.enemyWinTurns.size(); ++i) {
+		enemyWinTurns[i] += other.enemyWinTurns[i];
+	}
+	for (int c = 0; c < SIM_MAX_CHARACTERS; ++c) {
+		survived[c] += other.survived[c];
+		for (int s = 0; s < SIM_MAX_SKILLS; ++s) {
+			skills[c][s].damage += other.skills[c][s].damage;
+			skills[c][s].healing += other.skills[c][s].healing;
+			skills[c][s].uses += other.skills[c][s].uses;
+		}
+	}
+}
+
+/*!
+* \brief Plays the battles of a configuration across threads
+*
+* Threads take BATCH_SIZE battles at a time. Battle i is seeded from the
+* batch seed and i alone and every total is an integer, so the report is
+* the same for any number of threads.
+*
+*/
+bool RunBalanceSimulation(BalanceConfig const& config, BalanceReport& report, std::string& error) {
+	report = BalanceReport{};
+	report.config = config;
+
+	std::vector<std::string> prefabs{ config.prefabs };
+	if (prefabs.empty()) {
+		for (SimBattlePreset const& preset : GetBossBattles()) {
+			if (config.battle == preset.name) {
+				prefabs = preset.prefabs;
+			}
+		}
+		if (prefabs.empty()) {
+			error = "unknown battle " + config.battle;
+			return false;
+		}
+	}
+
+	std::vector<SimStatOverride> overrides{};
+	if (!config.statsFile.empty() && !LoadStatOverrides(config.statsFile, overrides, error)) {
+		return false;
+	}
+	BattleSetup setup{};
+	if (!BuildSimBattle(prefabs, setup.context, setup.initial, &overrides, &report.names)) {
+		error = "unable to build the battle from its prefabs";
+		return false;
+	}
+	for (int i = 0; i < setup.initial.characterCount; ++i) {
+		report.sides.push_back(setup.context.characters[i].tag);
+	}
+
+	int threadCount{ config.threads > 0 ? config.threads : static_cast<int>(std::thread::hardware_concurrency()) };
+	threadCount = std::max(threadCount, 1);
+	std::vector<BalanceTotals> threadTotals(threadCount);
+	std::atomic<size_t> nextBattle{};
+
+	auto work = [&config, &setup, &nextBattle](BalanceTotals& totals) {
+		TreeManager ai{};
+		TranspositionTable table{};
+		totals.playerWinTurns.assign(config.maxTurns + 1, 0);
+		totals.enemyWinTurns.assign(config.maxTurns + 1, 0);
+		for (size_t first = nextBattle.fetch_add(BATCH_SIZE); first < config.battles; first = nextBattle.fetch_add(BATCH_SIZE)) {
+			size_t last{ std::min(first + BATCH_SIZE, config.battles) };
+			for (size_t battle = first; battle < last; ++battle) {
+				PlayBattle(config, setup, config.seed ^ (battle * 0x9E3779B97F4A7C15ull), ai, table, totals);
+			}
+		}
+	};
+
+	std::chrono::steady_clock::time_point start{ std::chrono::steady_clock::now() };
+	std::vector<std::thread> threads{};
+	for (int t = 1; t < threadCount; ++t) {
+		threads.emplace_back(work, std::ref(threadTotals[t]));
+	}
+	work(threadTotals[0]);
+	for (std::thread& thread : threads) {
+		thread.join();
+	}
+	report.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+	for (BalanceTotals const& totals : threadTotals) {
+		report.totals.Add(totals);
+	}
+	return true;
+}
+
+/*!
+* \brief Writes a report
+*
+* output.json holds the whole report. output_skills.csv has a row per skill
+* with its character's survival rate, and output_turns.csv the number of
+* battles each side won in each number of moves.
+*
+*/
+bool WriteBalanceReport(BalanceReport const& report) {
+	BalanceConfig const& config{ report.config };
+	BalanceTotals const& totals{ report.totals };
+	double battles{ static_cast<double>(std::max<size_t>(totals.battles, 1)) };
+	std::vector<size_t> allTurns{ totals.playerWinTurns };
+	allTurns.resize(std::max(allTurns.size(), totals.enemyWinTurns.size()));
+	for (size_t i = 0; i < totals.enemyWinTurns.size(); ++i) {
+		allTurns[i] += totals.enemyWinTurns[i];
+	}
+
+	rapidjson::StringBuffer buffer;
+	rapidjson::PrettyWriter<rapidjson::StringBuffer> writer(buffer);
+	auto writeTurns = [&writer](const char* key, std::vector<size_t> const& histogram) {
+		TurnSummary summary{ SummariseTurns(histogram) };
+		writer.Key(key);
+		writer.StartObject();
+		writer.Key("Battles");
+		writer.Uint64(summary.battles);
+		writer.Key("Average");
+		writer.Double(summary.average);
+		writer.Key("Median");
+		writer.Int(summary.median);
+		writer.Key("P90");
+		writer.Int(summary.p90);
+		writer.Key("Shortest");
+		writer.Int(summary.shortest);
+		writer.Key("Longest");
+		writer.Int(summary.longest);
+		writer.EndObject();
+	};
+
+	writer.StartObject();
+	writer.Key("Battle");
+	writer.String(config.battle.c_str());
+	writer.Key("Battles");
+	writer.Uint64(totals.battles);
+	writer.Key("Seed");
+	writer.Uint64(config.seed);
+	writer.Key("Players");
+	writer.String(PolicyName(config.players));
+	writer.Key("Enemies");
+	writer.String(PolicyName(config.enemies));
+	writer.Key("Depth");
+	writer.Int(config.depth);
+	writer.Key("Stats");
+	writer.String(config.statsFile.c_str());
+	writer.Key("Seconds");
+	writer.Double(report.seconds);
+	writer.Key("Player Win Rate");
+	writer.Double(totals.playerWins / battles);
+	writer.Key("Enemy Win Rate");
+	writer.Double(totals.enemyWins / battles);
+	writer.Key("Unfinished Rate");
+	writer.Double(totals.unfinished / battles);
+	writeTurns("Turns", allTurns);
+	writeTurns("Player Win Turns", totals.playerWinTurns);
+	writeTurns("Enemy Win Turns", totals.enemyWinTurns);
+	writer.Key("Characters");
+	writer.StartArray();
+	for (size_t c = 0; c < report.names.characters.size(); ++c) {
+		writer.StartObject();
+		writer.Key("Name");
+		writer.String(report.names.characters[c].c_str());
+		writer.Key("Side");
+		writer.String(report.sides[c] == CharacterType::PLAYER ? "Player" : "Enemy");
+		writer.Key("Survival Rate");
+		writer.Double(totals.survived[c] / battles);
+		writer.Key("Skills");
+		writer.StartArray();
+		for (size_t s = 0; s < std::min<size_t>(report.names.skills[c].size(), SIM_MAX_SKILLS); ++s) {
+			BalanceSkill const& skill{ totals.skills[c][s] };
+			writer.StartObject();
+			writer.Key("Name");
+			writer.String(report.names.skills[c][s].c_str());
+			writer.Key("Uses");
+			writer.Uint64(skill.uses);
+			writer.Key("Damage");
+			writer.Double(FromMilli(skill.damage));
+			writer.Key("Damage Per Use");
+			writer.Double(skill.uses > 0 ? FromMilli(skill.damage) / skill.uses : 0.0);
+			writer.Key("Healing");
+			writer.Double(FromMilli(skill.healing));
+			writer.EndObject();
+		}
+		writer.EndArray();
+		writer.EndObject();
+	}
+	writer.EndArray();
+	writer.EndObject();
+
+	std::ofstream json(config.output + ".json");
+	std::ofstream skills(config.output + "_skills.csv");
+	std::ofstream turns(config.output + "_turns.csv");
+	if (!json.is_open() || !skills.is_open() || !turns.is_open()) {
+		return false;
+	}
+	json << buffer.GetString();
+
+	skills << "Character,Side,Survival Rate,Skill,Uses,Damage,Damage Per Use,Healing\n";
+	for (size_t c = 0; c < report.names.characters.size(); ++c) {
+		for (size_t s = 0; s < std::min<size_t>(report.names.skills[c].size(), SIM_MAX_SKILLS); ++s) {
+			BalanceSkill const& skill{ totals.skills[c][s] };
+			skills << report.names.characters[c] << ',' << (report.sides[c] == CharacterType::PLAYER ? "Player" : "Enemy") << ','
+				<< totals.survived[c] / battles << ',' << report.names.skills[c][s] << ',' << skill.uses << ','
+				<< FromMilli(skill.damage) << ',' << (skill.uses > 0 ? FromMilli(skill.damage) / skill.uses : 0.0) << ','
+				<< FromMilli(skill.healing) << '\n';
+		}
+	}
+
+	turns << "Turns,Player Wins,Enemy Wins\n";
+	for (size_t t = 0; t < allTurns.size(); ++t) {
+		if (allTurns[t] == 0) {
+			continue;
+		}
+		turns << t << ',' << (t < totals.playerWinTurns.size() ? totals.playerWinTurns[t] : 0) << ','
+			<< (t < totals.enemyWinTurns.size() ? totals.enemyWinTurns[t] : 0) << '\n';
+	}
+	return true;
+}
+
+bool IsBalanceCommandLine(std::string const& commandLine) {
+	std::vector<std::string> arguments{ SplitCommandLine(commandLine) };
+	return std::find(arguments.begin(), arguments.end(), "--balance") != arguments.end();
+}
+
+/*!
+* \brief Balance simulation from the command line
+*
+* --balance <boss battle>, or --prefabs a.prefab,b.prefab with --balance
+* naming the report, then --battles, --seed, --threads, --depth,
+* --max-turns, --players and --enemies (random, greedy or search),
+* --stats <csv> and --out <file name without extension>.
+*
+*/
+int RunBalanceCommandLine(std::string const& commandLine) {
+	std::vector<std::string> arguments{ SplitCommandLine(commandLine) };
+	BalanceConfig config{};
+	for (size_t i = 0; i + 1 < arguments.size(); i += 2) {
+		std::string const& option{ arguments[i] };
+		std::string const& value{ arguments[i + 1] };
+		bool valid{ true };
+		if (option == "--balance") {
+			config.battle = value;
+		}
+		else if (option == "--prefabs") {
+			std::stringstream stream(value);
+			std::string prefab{};
+			while (std::getline(stream, prefab, ',')) {
+				config.prefabs.push_back(prefab);
+			}
+		}
+		else if (option == "--battles") {
+			config.battles = std::strtoull(value.c_str(), nullptr, 10);
+		}
+		else if (option == "--seed") {
+			config.seed = std::strtoull(value.c_str(), nullptr, 10);
+		}
+		else if (option == "--threads") {
+			config.threads = std::atoi(value.c_str());
+		}
+		else if (option == "--depth") {
+			config.depth = std::max(std::atoi(value.c_str()), 1);
+		}
+		else if (option == "--max-turns") {
+			config.maxTurns = std::max(std::atoi(value.c_str()), 1);
+		}
+		else if (option == "--players") {
+			valid = ParsePolicy(value, config.players);
+		}
+		else if (option == "--enemies") {
+			valid = ParsePolicy(value, config.enemies);
+		}
+		else if (option == "--stats") {
+			config.statsFile = value;
+		}
+		else if (option == "--out") {
+			config.output = value;
+		}
+		else {
+			valid = false;
+		}
+		if (!valid) {
+			std::cerr << "Balance: invalid option " << option << " " << value << "\n";
+			return 1;
+		}
+	}
+
+	if (!assetmanager.FindDefaultPath()) {
+		std::cerr << "Balance: unable to find the Assets folder\n";
+		return 1;
+	}
+	assetmanager.attacks.LoadAllAttacks();
+	GameAILogic::LoadWeights(assetmanager.GetDefaultPath() + "AI/Evaluation.json");
+
+	std::cout << "Balance: " << config.battles << " battles of " << config.battle << ", seed " << config.seed
+		<< ", players " << PolicyName(config.players) << ", enemies " << PolicyName(config.enemies) << ", depth " << config.depth << "\n";
+	BalanceReport report{};
+	std::string error{};
+	if (!RunBalanceSimulation(config, report, error)) {
+		std::cerr << "Balance: " << error << "\n";
+		return 1;
+	}
+	if (!WriteBalanceReport(report)) {
+		std::cerr << "Balance: unable to write " << config.output << "\n";
+		return 1;
+	}
+
+	BalanceTotals const& totals{ report.totals };
+	double battles{ static_cast<double>(std::max<size_t>(totals.battles, 1)) };
+	std::cout << "Balance: players win " << totals.playerWins * 100.0 / battles << "%, enemies win " << totals.enemyWins * 100.0 / battles
+		<< "%, unfinished " << totals.unfinished * 100.0 / battles << "% in " << report.seconds << " s ("
+		<< totals.battles / std::max(report.seconds, 1e-9) << " battles/s), report written to " << config.output << ".json\n";
+	return 0;
+}
+
+bool IsVerifySimCommandLine(std::string const& commandLine) {
+	std::vector<std::string> arguments{ SplitCommandLine(commandLine) };
+	return std::find(arguments.begin(), arguments.end(), "--verify-sim") != arguments.end();
+}
+
+/*!
+* \brief Simulation parity check from the command line
+*
+* --verify-sim <boss battle> or all, then --battles, --seed and --max-turns.
+* Battles with a mismatch are listed with their seed and the move that
+* differs, so they can be replayed with --battles 1 --seed <seed>.
+*
+*/
+int RunVerifySimCommandLine(std::string const& commandLine) {
+	std::vector<std::string> arguments{ SplitCommandLine(commandLine) };
+	std::string battle{};
+	int battles{ 100 };
+	uint64_t seed{ 2024 };
+	int maxTurns{ 300 };
+	for (size_t i = 0; i + 1 < arguments.size(); i += 2) {
+		std::string const& option{ arguments[i] };
+		std::string const& value{ arguments[i + 1] };
+		if (option == "--verify-sim") {
+			battle = value;
+		}
+		else if (option == "--battles") {
+			battles = std::max(std::atoi(value.c_str()), 1);
+		}
+		else if (option == "--seed") {
+			seed = std::strtoull(value.c_str(), nullptr, 10);
+		}
+		else if (option == "--max-turns") {
+			maxTurns = std::max(std::atoi(value.c_str()), 1);
+		}
+		else {
+			std::cerr << "Verify: invalid option " << option << " " << value << "\n";
+			return 1;
+		}
+	}
+
+	if (!assetmanager.FindDefaultPath()) {
+		std::cerr << "Verify: unable to find the Assets folder\n";
+		return 1;
+	}
+	assetmanager.attacks.LoadAllAttacks();
+	GameAILogic::LoadWeights(assetmanager.GetDefaultPath() + "AI/Evaluation.json");
+
+	int exitCode{};
+	bool found{};
+	for (SimBattlePreset const& preset : GetBossBattles()) {
+		if (battle != "all" && battle != preset.name) {
+			continue;
+		}
+		found = true;
+		SimParityResult result{ VerifySimParity(preset.prefabs, seed, battles, maxTurns) };
+		if (!result.built) {
+			std::cerr << "Verify: unable to build " << preset.name << " from its prefabs\n";
+			exitCode = 1;
+			continue;
+		}
+		std::cout << "Verify: " << preset.name << ", " << result.battles << " battles, " << result.moves << " moves compared, "
+			<< result.mismatches.size() << " mismatches\n";
+		for (SimParityMismatch const& mismatch : result.mismatches) {
+			std::cout << "Verify: seed " << mismatch.seed << " differs on move " << mismatch.move << ", skill " << static_cast<int>(mismatch.action.skill)
+				<< " on target " << static_cast<int>(mismatch.action.target) << "\n";
+		}
+		if (!result.mismatches.empty()) {
+			exitCode = 1;
+		}
+	}
+	if (!found) {
+		std::cerr << "Verify: unknown battle " << battle << "\n";
+		return 1;
+	}
+	return exitCode;
+}
@@ -0,0 +1,120 @@
+/******************************************************************************
+*
+*	\copyright
+*		All content(C) 2023/2024 DigiPen Institute of Technology Singapore.
+*		All rights reserved. Reproduction or disclosure of this file or its
+*		contents without the prior written consent of DigiPen Institute of
+*		Technology is prohibited.
+*
+* *****************************************************************************
+*
+*	@file		BalanceSim.h
+*
+*	@author		agent
+*
+*	@email		agent\@local
+*
+*	@course		CSD 2401 - Software Engineering Project 3
+*				CSD 2451 - Software Engineering Project 4
+*
+*	@section	Section A
+*
+*	@date		19 October 2026
+*
+* *****************************************************************************
+*
+*	@brief		Headless battle balance simulator
+*
+*	Plays a battle built from its prefabs and .skill files many times with
+*	the combat rules of BattleSimState, both sides picking their moves with
+*	an AI policy, across every core. Reports win rates, the distribution
+*	of turns per battle, damage and healing per skill and how often each
+*	character survives, as JSON and CSV.
+*
+*	Each battle is seeded from the batch seed and its index, and every
+*	total is an integer, so the same seed gives the same report whatever
+*	the number of threads.
+*
+*	Runs from the command line without graphics or audio:
+*	ZodiaClash.exe --balance "Emperor and Monkey" --battles 100000 --seed 7
+*		--players search --enemies search --depth 2 --stats CSV/ZodiaClashCharacters.csv --out balance
+*
+*	The simulation parity check also runs from here, see VerifySimParity:
+*	ZodiaClash.exe --verify-sim Goat --battles 200 --seed 7
+*
+******************************************************************************/
+
+#pragma once
+#include "BattleSim.h"
+#include <cstdint>
+#include <string>
+#include <vector>
+
+//How a side picks its moves
+enum class BalancePolicy : uint8_t {
+	RANDOM,	//any move the character can make
+	GREEDY,	//best move one move ahead
+	SEARCH	//the AI search to BalanceConfig::depth without a time budget
+};
+
+struct BalanceConfig {
+	std::string battle{};				//name of a boss battle or the report's name for prefabs
+	std::vector<std::string> prefabs{};	//characters of the battle, the boss battle's if empty
+	std::string statsFile{};			//CSV of stat overrides with name, maxHealth, attack, defense and speed columns, blank cells keep the prefab's
+	std::string output{ "balance" };	//report file name without its extension
+	size_t battles{ 10000 };
+	uint64_t seed{ 2024 };
+	int threads{};						//0 uses every core
+	int depth{ 2 };						//moves looked ahead by the SEARCH policy
+	int maxTurns{ 300 };				//battles still going after this many moves count as unfinished
+	BalancePolicy players{ BalancePolicy::SEARCH };
+	BalancePolicy enemies{ BalancePolicy::SEARCH };
+};
+
+//Totals of one skill slot
+struct BalanceSkill {
+	long long damage{};		//thousandths of health taken from the other side during the skill's moves, bleed and burn included
+	long long healing{};	//thousandths of health given to the user's side
+	size_t uses{};
+};
+
+//Totals of a number of battles
+struct BalanceTotals {
+	size_t battles{};
+	size_t playerWins{};
+	size_t enemyWins{};
+	size_t unfinished{};
+	std::vector<size_t> playerWinTurns{};	//battles won by the players by number of moves
+	std::vector<size_t> enemyWinTurns{};	//battles won by the enemies by number of moves
+	size_t survived[SIM_MAX_CHARACTERS]{};
+	BalanceSkill skills[SIM_MAX_CHARACTERS][SIM_MAX_SKILLS]{};
+
+	void Add(BalanceTotals const& other);
+};
+
+struct BalanceReport {
+	BalanceConfig config{};
+	SimBattleNames names{};
+	std::vector<CharacterType> sides{};
+	BalanceTotals totals{};
+	double seconds{};
+};
+
+//Plays the battles of a configuration. Skills must already be loaded. Returns false and describes the problem in error if the battle cannot be built.
+bool RunBalanceSimulation(BalanceConfig const& config, BalanceReport& report, std::string& error);
+
+//Writes a report to output.json, output_skills.csv and output_turns.csv
+bool WriteBalanceReport(BalanceReport const& report);
+
+//True if the command line asks for a balance simulation
+bool IsBalanceCommandLine(std::string const& commandLine);
+
+//Loads the skills, runs the simulation described by the command line and writes its report. Returns the process exit code.
+int RunBalanceCommandLine(std::string const& commandLine);
+
+//True if the command line asks for the simulation parity check
+bool IsVerifySimCommandLine(std::string const& commandLine);
+
+//Loads the skills and runs VerifySimParity on the battle of the command line. The ECS components must already be registered.
+//Returns the process exit code, 1 if the battle cannot be built or the simulation and the battle system disagree.
+int RunVerifySimCommandLine(std::string const& commandLine);
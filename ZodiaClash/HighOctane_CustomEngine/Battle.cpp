@@ -39,7 +39,7 @@
 #include "GameStateManager.h"
 #include "debuglog.h"
 #include "Events.h"
-#include "GameAITree.h"
+#include "AIDecisionJob.h"
 #include "ECS.h"
 #include <algorithm>
 #include <iostream>
@@ -111,6 +111,7 @@ BattleSystem::BattleSystem(BattleSystem const& input) {
  */
 void BattleSystem::Initialize() 
 {
+    aiDecisionJob.Cancel();
     battleState = NEWGAME;
     battlestarted = false;
     attackingAnimation = false;
@@ -159,7 +160,6 @@ void BattleSystem::Update()
 {
     int enemyAmount = 0;
     int playerAmount = 0;
-    TreeManager gameAI{};
     
     // Access component arrays through the ComponentManager
     ComponentArray<CharacterStats>* statsArray{};
@@ -302,8 +302,10 @@ void BattleSystem::Update()
         }
         break;
     case ENEMYTURN:
+        aiDecisionJob.SampleFrame(g_dt);
         if (activeCharacter->action.entityState == WAITING && activeCharacter->debuffs.stunStack == 0) {
-            gameAI.Search(this);
+            //Searches on a background thread across updates, the enemy keeps waiting until its move is played
+            aiDecisionJob.Update(this);
         }
         [[fallthrough]];
 
@@ -158,7 +158,7 @@ public:
 	Entity chiLabel;
 	Entity battleInfoButton;
 
-	int aiMultiplier; //in order to control certain AI logic
+	int aiMultiplier{}; //in order to control certain AI logic
 	int dialogueCalled{ 0 };
 	int tutorialLock{ 0 };
 	int skillTooltipCalled{ 0 };
@@ -167,8 +167,9 @@ public:
 	bool battlestarted{ false };
 	bool emperorDead{ false }; //To call dialogue for emperor
 private:
+	friend class BattleSimContext; //captures the battle for the AI simulation
 	
-	bool roundInProgress;
+	bool roundInProgress{};
 	bool speedupAnimationPlayed{ false };
 
 	//Variables for animation
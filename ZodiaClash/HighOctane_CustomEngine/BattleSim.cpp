@@ -0,0 +1,1203 @@
+/******************************************************************************
+*
+*	\copyright
+*		All content(C) 2023/2024 DigiPen Institute of Technology Singapore.
+*		All rights reserved. Reproduction or disclosure of this file or its
+*		contents without the prior written consent of DigiPen Institute of
+*		Technology is prohibited.
+*
+* *****************************************************************************
+*
+*	@file		BattleSim.cpp
+*
+*	@author		agent
+*
+*	@email		agent\@local
+*
+*	@course		CSD 2401 - Software Engineering Project 3
+*				CSD 2451 - Software Engineering Project 4
+*
+*	@section	Section A
+*
+*	@date		19 October 2026
+*
+* *****************************************************************************
+*
+*	@brief		Compact battle simulation state for the AI
+*
+*	The rules here mirror BattleSystem::Update, CharacterAction::UpdateState,
+*	CharacterStats and Attack::UseAttack as they run on a battle system copy
+*	without entities. Changes to the combat rules need to be made in both
+*	places, VerifySimParity() (ZodiaClash.exe --verify-sim <battle>) reports
+*	where they disagree.
+*
+******************************************************************************/
+
+#include "BattleSim.h"
+#include "CharacterStats.h"
+#include "CheatCode.h"
+#include "debugdiagnostic.h"
+#include "AssetManager.h"
+#include "Random.h"
+#include "GameAILogic.h"
+
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <unordered_map>
+
+#include <rapidjson-master/include/rapidjson/document.h>
+#include <rapidjson-master/include/rapidjson/istreamwrapper.h>
+
+namespace {
+	const int MAX_STEPS{ 256 }; //guards against rules that never reach the next turn
+
+	bool IsSkillOne(std::string const& attackName) {
+		return attackName == "Skill 1";
+	}
+}
+
+/**************************
+******** CONTEXT **********
+**************************/
+
+int8_t BattleSimContext::Find(Entity entity) const {
+	for (int8_t i = 0; i < SIM_MAX_CHARACTERS; ++i) {
+		if (characters[i].entity == entity) {
+			return i;
+		}
+	}
+	return SIM_NONE;
+}
+
+/*!
+* \brief Add character
+*
+* Appends a character to the context and state. Stacks referring to other characters
+* by entity are resolved by Capture() once every character has been added.
+*
+*/
+bool BattleSimContext::AddCharacter(CharacterStats const& character, std::string const& name, BattleSimState& state) {
+	if (state.characterCount >= SIM_MAX_CHARACTERS) {
+		return false;
+	}
+	int index{ state.characterCount++ };
+
+	SimCharacterInfo& info{ characters[index] };
+	info.entity = character.entity;
+	info.tag = character.tag;
+	info.boss = character.boss;
+	info.untargetable = character.untargetable;
+	info.prey = (name == "Cat" || name == "Player_Goat");
+	info.kind = name == "Goat_Enemy" ? SimKind::GOAT_ENEMY
+		: name == "Ox_Enemy" ? SimKind::OX_ENEMY
+		: name == "Emperor" ? SimKind::EMPEROR
+		: SimKind::NORMAL;
+	info.skillCount = 0;
+	for (Attack const& attack : character.action.skills) {
+		if (info.skillCount >= SIM_MAX_SKILLS) {
+			break;
+		}
+		SimSkill skill;
+		skill.attacktype = attack.attacktype;
+		skill.refundChi = IsSkillOne(attack.attackName);
+		skill.usesProc = attack.effects.usesProc;
+		skill.hitEffects = static_cast<uint16_t>(effects.size());
+		skill.hitEffectCount = static_cast<uint16_t>(attack.effects.hit.size());
+		effects.insert(effects.end(), attack.effects.hit.begin(), attack.effects.hit.end());
+		skill.finishEffects = static_cast<uint16_t>(effects.size());
+		skill.finishEffectCount = static_cast<uint16_t>(attack.effects.finish.size());
+		effects.insert(effects.end(), attack.effects.finish.begin(), attack.effects.finish.end());
+		skill.skillAttackPercent = attack.skillAttackPercent;
+		skill.minAttackMultiplier = attack.minAttackMultiplier;
+		skill.maxAttackMultiplier = attack.maxAttackMultiplier;
+		skill.critRate = attack.critRate;
+		skill.critMultiplier = attack.critMultiplier;
+		skill.chiCost = attack.chiCost;
+		skill.bleed = attack.bleed;
+		info.skills[info.skillCount++] = static_cast<uint16_t>(skills.size());
+		skills.push_back(skill);
+	}
+
+	SimCharacter& sim{ state.characters[index] };
+	sim = SimCharacter{};
+	sim.maxHealth = character.stats.maxHealth;
+	sim.health = character.stats.health;
+	sim.attack = character.stats.attack;
+	sim.defense = character.stats.defense;
+	sim.damage = character.damage;
+	sim.attackBuff = character.buffs.attackBuff;
+	sim.defenseBuff = character.buffs.defenseBuff;
+	sim.attackDebuff = character.debuffs.attackDebuff;
+	sim.defenseDebuff = character.debuffs.defenseDebuff;
+	sim.attackStack = static_cast<int8_t>(character.buffs.attackStack);
+	sim.defenseStack = static_cast<int8_t>(character.buffs.defenseStack);
+	sim.reflectStack = static_cast<int8_t>(character.buffs.reflectStack);
+	sim.shieldStack = static_cast<int8_t>(character.buffs.shieldStack);
+	sim.bloodStack = static_cast<int8_t>(character.debuffs.bloodStack);
+	sim.tauntStack = static_cast<int8_t>(character.debuffs.tauntStack);
+	sim.stunStack = static_cast<int8_t>(character.debuffs.stunStack);
+	sim.huntedStack = static_cast<int8_t>(character.debuffs.huntedStack);
+	sim.igniteStack = static_cast<int8_t>(character.debuffs.igniteStack);
+	sim.attackDebuffStack = static_cast<int8_t>(character.debuffs.attackStack);
+	sim.defenseDebuffStack = static_cast<int8_t>(character.debuffs.defenseStack);
+	sim.cycle = character.cycle;
+	sim.entityState = static_cast<uint8_t>(character.action.entityState);
+	sim.charge = character.charge;
+	sim.crit = character.crit;
+	return true;
+}
+
+/*!
+* \brief Capture
+*
+* Copies a battle into the context and initial state. Only valid while the active
+* character is waiting for a move.
+*
+*/
+bool BattleSimContext::Capture(BattleSystem const& battle, BattleSimState& state) {
+	*this = BattleSimContext{};
+	state = BattleSimState{};
+	godMode = godModeOn;
+	endGame = endGameOn;
+
+	for (CharacterStats const& c : battle.turnManage.characterList) {
+		std::string name{};
+		if (ECS::ecs().EntityExists(c.entity) && ECS::ecs().HasComponent<Name>(c.entity)) {
+			name = ECS::ecs().GetComponent<Name>(c.entity).name;
+		}
+		if (!AddCharacter(c, name, state)) {
+			DEBUG_PRINT("AI: battle has more than %d characters, cannot simulate", SIM_MAX_CHARACTERS);
+			return false;
+		}
+		if (catAttack == 0.f && c.tag == CharacterType::PLAYER && c.icon == "mockup_icon_cat.png") {
+			catAttack = c.stats.attack;
+		}
+	}
+
+	//Resolve references between characters
+	int index{};
+	for (CharacterStats const& c : battle.turnManage.characterList) {
+		state.characters[index].shieldEntity = c.buffs.shieldEntity ? Find(c.buffs.shieldEntity) : SIM_NONE;
+		state.characters[index].tauntTarget = c.debuffs.tauntTarget ? Find(c.debuffs.tauntTarget) : SIM_NONE;
+		++index;
+	}
+
+	for (CharacterStats const* c : battle.turnManage.turnOrderList) {
+		if (state.turnCount >= SIM_MAX_TURNS) {
+			return false;
+		}
+		state.turnOrder[state.turnCount++] = Find(c->entity);
+	}
+
+	state.activeCharacter = battle.activeCharacter ? Find(battle.activeCharacter->entity) : SIM_NONE;
+	state.speedupCharacter = battle.speedupCharacter ? Find(battle.speedupCharacter->entity) : SIM_NONE;
+	state.battleState = static_cast<uint8_t>(battle.battleState);
+	state.speedup = battle.speedup;
+	state.speedupAnimationPlayed = battle.speedupAnimationPlayed;
+	state.roundInProgress = battle.roundInProgress;
+	state.roundCharacterCount = battle.roundManage.characterCount;
+	state.roundCounter = battle.roundManage.roundCounter;
+	state.chi = battle.chi;
+	state.aiMultiplier = battle.aiMultiplier;
+	state.CountSides(*this);
+	return state.activeCharacter != SIM_NONE;
+}
+
+/**************************
+********* STATE ***********
+**************************/
+
+bool BattleSimState::IsOver() const {
+	return battleState == WIN || battleState == LOSE;
+}
+
+int BattleSimState::GetActions(BattleSimContext const& context, SimAction* output) const {
+	SimCharacter const& active{ characters[activeCharacter] };
+	if (active.stunStack > 0) {
+		output[0] = SimAction{};
+		return 1;
+	}
+
+	int count{};
+	SimCharacterInfo const& info{ context.characters[activeCharacter] };
+	for (int8_t s = 0; s < static_cast<int8_t>(info.skillCount); ++s) {
+		SimSkill const& skill{ context.skills[info.skills[s]] };
+		if (info.tag == CharacterType::PLAYER && skill.chiCost > chi) {
+			continue;
+		}
+		for (int8_t t = 0; t < static_cast<int8_t>(characterCount); ++t) {
+			if (characters[t].removed) {
+				continue;
+			}
+			//Do not enable self-targeting
+			if (skill.attacktype != AttackType::ALLYSELF && t == activeCharacter) {
+				continue;
+			}
+			output[count++] = SimAction{ s, t };
+		}
+	}
+	return count;
+}
+
+int BattleSimState::GetPlayers(BattleSimContext const& context, int8_t* output) const {
+	int count{};
+	for (int8_t i = 0; i < static_cast<int8_t>(characterCount); ++i) {
+		if (!characters[i].removed && context.characters[i].tag == CharacterType::PLAYER) {
+			output[count++] = i;
+		}
+	}
+	return count;
+}
+
+//Bosses first, in reverse order, as BattleSystem::GetEnemies does
+int BattleSimState::GetEnemies(BattleSimContext const& context, int8_t* output) const {
+	int count{};
+	for (int8_t i = static_cast<int8_t>(characterCount) - 1; i >= 0; --i) {
+		if (!characters[i].removed && context.characters[i].tag == CharacterType::ENEMY && context.characters[i].boss) {
+			output[count++] = i;
+		}
+	}
+	for (int8_t i = 0; i < static_cast<int8_t>(characterCount); ++i) {
+		if (!characters[i].removed && context.characters[i].tag == CharacterType::ENEMY && !context.characters[i].boss) {
+			output[count++] = i;
+		}
+	}
+	return count;
+}
+
+void BattleSimState::CountCharacter(BattleSimContext const& context, int index, int sign) {
+	CharacterType tag{ context.characters[index].tag };
+	if (characters[index].removed || (tag != CharacterType::PLAYER && tag != CharacterType::ENEMY)) {
+		return;
+	}
+	int side{ tag == CharacterType::PLAYER ? 0 : 1 };
+	sideHealth[side] += sign * static_cast<double>(characters[index].health);
+	sideStanding[side] += static_cast<int8_t>(characters[index].health != 0.f ? sign : 0);
+}
+
+void BattleSimState::CountSides(BattleSimContext const& context) {
+	sideHealth[0] = sideHealth[1] = 0.0;
+	sideStanding[0] = sideStanding[1] = 0;
+	for (int i = 0; i < characterCount; ++i) {
+		CountCharacter(context, i, 1);
+	}
+}
+
+void BattleSimState::SetHealth(BattleSimContext const& context, int index, float health) {
+	CountCharacter(context, index, -1);
+	characters[index].health = health;
+	CountCharacter(context, index, 1);
+}
+
+void BattleSimState::Remove(BattleSimContext const& context, int index) {
+	CountCharacter(context, index, -1);
+	characters[index].removed = true;
+}
+
+//CharacterStats::TakeDamage
+void BattleSimState::TakeDamage(BattleSimContext const& context, int index, float d) {
+	SimCharacter& c{ characters[index] };
+	CharacterType tag{ context.characters[index].tag };
+	d = floorf(d);
+	if (context.godMode && tag == CharacterType::PLAYER) {
+		SetHealth(context, index, c.maxHealth);
+		return;
+	}
+	if (context.godMode && tag == CharacterType::ENEMY) {
+		d *= 2;
+	}
+	float health{ c.health };
+	if (context.endGame && tag == CharacterType::ENEMY) {
+		health = 0.f;
+	}
+
+	if (c.shieldStack) {
+		int8_t enemies[SIM_MAX_CHARACTERS];
+		int enemyCount{ GetEnemies(context, enemies) };
+		for (int i = 0; i < enemyCount; ++i) {
+			if (enemies[i] == c.shieldEntity) {
+				SimCharacter& shield{ characters[enemies[i]] };
+				SetHealth(context, enemies[i], d > shield.health ? 0.f : shield.health - d);
+				shield.damage = d;
+				if (context.endGame) {
+					SetHealth(context, enemies[i], 0.f);
+					shield.damage = shield.maxHealth;
+				}
+				break;
+			}
+		}
+	}
+	else {
+		health -= d;
+		c.damage = d;
+	}
+
+	if (health <= 0) {
+		health = 0;
+		c.entityState = DYING;
+	}
+	else if (health > c.maxHealth) {
+		health = c.maxHealth;
+	}
+	SetHealth(context, index, health);
+}
+
+//CharacterStats::ApplyBloodStack
+void BattleSimState::ApplyBloodStack(BattleSimContext const& context, int index) {
+	const float bleedPercent{ 0.1f };
+	if (characters[index].bloodStack > 0) {
+		float d = context.catAttack * bleedPercent;
+		TakeDamage(context, index, d);
+		characters[index].bloodStack--;
+	}
+}
+
+//BattleSystem::SwitchTurnOrder
+void BattleSimState::SwitchTurnOrder(int index) {
+	if (turnCount < SIM_MAX_TURNS) {
+		int position{ turnCount > 0 ? 1 : 0 };
+		for (int i = turnCount; i > position; --i) {
+			turnOrder[i] = turnOrder[i - 1];
+		}
+		turnOrder[position] = static_cast<int8_t>(index);
+		++turnCount;
+	}
+	speedup = true;
+	speedupCharacter = static_cast<int8_t>(index);
+	speedupAnimationPlayed = false;
+}
+
+/*!
+* \brief Single target attack
+*
+* Attack::CalculateDamage and Attack::UseAttack(CharacterStats*), returns the damage
+* dealt so the caller can reuse it.
+*
+*/
+float BattleSimState::UseAttack(BattleSimContext const& context, SimSkill const& skill, int ownerIndex, int targetIndex, SimRoll const& roll) {
+	SimCharacter& owner{ characters[ownerIndex] };
+	SimCharacter& target{ characters[targetIndex] };
+	SimCharacterInfo const& ownerInfo{ context.characters[ownerIndex] };
+	SimCharacterInfo const& targetInfo{ context.characters[targetIndex] };
+
+	//CalculateDamage
+	float finalAttack{ owner.attack * (1 + owner.attackBuff - owner.attackDebuff) };
+	float finalDefense{ target.defense * (1 + owner.defenseBuff - owner.defenseDebuff) };
+	float damage{};
+	target.crit = roll.crit;
+	if (roll.crit) {
+		damage = (roll.multiplier *
+			((float)skill.skillAttackPercent / 100.f) * (finalAttack * (100.f / (100.f + finalDefense)))
+			* skill.critMultiplier);
+	}
+	else {
+		damage = (roll.multiplier *
+			((float)skill.skillAttackPercent / 100.f) * (finalAttack * (100.f / (100.f + finalDefense))));
+	}
+	damage = roundf(damage);
+
+	RunSkillEffects(context.effects.data() + skill.hitEffects, skill.hitEffectCount,
+		[&](EffectInstruction const& instruction) { return TestEffect(context, instruction, ownerIndex, targetIndex, roll); },
+		[&](EffectInstruction const& instruction) { ExecuteEffect(context, instruction, ownerIndex, targetIndex, damage); });
+
+	target.bloodStack += static_cast<int8_t>(skill.bleed);
+	if (target.bloodStack > 5) {
+		target.bloodStack = 5;
+	}
+	if (target.shieldStack || targetInfo.untargetable) {
+		target.bloodStack = 0;
+		target.tauntStack = 0;
+		target.tauntTarget = SIM_NONE;
+		target.stunStack = 0;
+		target.huntedStack = 0;
+		target.igniteStack = 0;
+		target.attackDebuffStack = 0;
+		target.attackDebuff = 0.f;
+		target.defenseDebuffStack = 0;
+		target.defenseDebuff = 0.f;
+	}
+
+	if (damage > 0 && targetInfo.tag == ownerInfo.tag) {
+		aiMultiplier -= 100000;
+	}
+	if (owner.tauntStack && owner.tauntTarget == targetIndex) {
+		aiMultiplier += 500000;
+	}
+	if (target.huntedStack) {
+		aiMultiplier += 10000;
+	}
+
+	TakeDamage(context, targetIndex, damage);
+	if (target.reflectStack > 0) {
+		float reflectDamage{ 0.5f * damage };
+		if (reflectDamage >= owner.health) {
+			reflectDamage = owner.health - 1;
+		}
+		TakeDamage(context, ownerIndex, reflectDamage);
+	}
+
+	if (owner.igniteStack && skill.chiCost > 0 && skill.attacktype != AttackType::AOE) {
+		float igniteDamage{ 0.1f * owner.maxHealth };
+		if (igniteDamage >= owner.health) {
+			igniteDamage = owner.health - 1;
+		}
+		TakeDamage(context, ownerIndex, igniteDamage);
+	}
+	return damage;
+}
+
+//Attack::TestEffect, target is SIM_NONE for finish effects
+bool BattleSimState::TestEffect(BattleSimContext const& context, EffectInstruction const& instruction, int ownerIndex, int targetIndex, SimRoll const& roll) const {
+	SimCharacter const& owner{ characters[ownerIndex] };
+	int8_t enemies[SIM_MAX_CHARACTERS];
+	switch (instruction.condition) {
+	case EffectCondition::OWNER_HEALTH_BELOW:
+		return owner.health < instruction.value * owner.maxHealth;
+	case EffectCondition::OWNER_CHARGED:
+		return owner.charge;
+	case EffectCondition::OWNER_CYCLE:
+		return owner.cycle == instruction.amount;
+	case EffectCondition::OWNER_CYCLE_ABOVE:
+		return owner.cycle > instruction.amount;
+	case EffectCondition::OWNER_SHIELDED:
+		return owner.shieldStack != 0;
+	case EffectCondition::TARGET_SHIELDED:
+		return characters[targetIndex].shieldStack != 0;
+	case EffectCondition::TARGET_IS_ENEMY:
+		return context.characters[targetIndex].tag == CharacterType::ENEMY;
+	case EffectCondition::TARGET_IS_OWNER:
+		return targetIndex == ownerIndex;
+	case EffectCondition::TARGET_IS_PREY:
+		return context.characters[targetIndex].prey;
+	case EffectCondition::TARGET_IGNITED:
+		return characters[targetIndex].igniteStack != 0;
+	case EffectCondition::ENEMIES_ABOVE:
+		return GetEnemies(context, enemies) > instruction.amount;
+	case EffectCondition::ENEMY_STUNNED: {
+		int enemyCount{ GetEnemies(context, enemies) };
+		for (int i = 0; i < enemyCount; ++i) {
+			if (characters[enemies[i]].stunStack) {
+				return true;
+			}
+		}
+		return false;
+	}
+	case EffectCondition::PROC:
+		return roll.proc;
+	default:
+		return false;
+	}
+}
+
+//Attack::ExecuteEffect, target is SIM_NONE for finish effects
+void BattleSimState::ExecuteEffect(BattleSimContext const& context, EffectInstruction const& instruction, int ownerIndex, int targetIndex, float& damage) {
+	SimCharacter& owner{ characters[ownerIndex] };
+	SimCharacter& target{ characters[targetIndex == SIM_NONE ? ownerIndex : targetIndex] };
+	SimCharacter& subject{ instruction.subject == EffectSubject::OWNER ? owner : target };
+	switch (instruction.op) {
+	case EffectOp::HEAL:
+		damage = -instruction.value * owner.maxHealth;
+		break;
+	case EffectOp::CANCEL_DAMAGE:
+		damage = 0;
+		break;
+	case EffectOp::LIFESTEAL:
+		TakeDamage(context, ownerIndex, -damage);
+		break;
+	case EffectOp::CLEAR_DEBUFFS:
+		target.bloodStack = 0;
+		target.tauntStack = 0;
+		target.stunStack = 0;
+		break;
+	case EffectOp::CLEAR_BUFFS:
+		target.attackStack = 0;
+		target.attackBuff = 0.f;
+		target.defenseStack = 0;
+		target.defenseBuff = 0.f;
+		break;
+	case EffectOp::CONSUME_BLEED:
+		while (target.bloodStack) {
+			ApplyBloodStack(context, targetIndex);
+		}
+		break;
+	case EffectOp::SPEED_UP:
+		SwitchTurnOrder(targetIndex);
+		break;
+	case EffectOp::ATTACK_BUFF:
+		subject.attackBuff = instruction.value;
+		subject.attackStack = static_cast<int8_t>(instruction.amount);
+		break;
+	case EffectOp::DEFENSE_BUFF:
+		subject.defenseBuff = instruction.value;
+		subject.defenseStack = static_cast<int8_t>(instruction.amount);
+		break;
+	case EffectOp::DEFENSE_DEBUFF:
+		target.defenseDebuff = instruction.value;
+		target.defenseDebuffStack = static_cast<int8_t>(instruction.amount);
+		break;
+	case EffectOp::STUN:
+		target.stunStack += static_cast<int8_t>(instruction.amount);
+		break;
+	case EffectOp::TAUNT:
+		target.tauntStack += static_cast<int8_t>(instruction.amount);
+		target.tauntTarget = static_cast<int8_t>(ownerIndex);
+		break;
+	case EffectOp::HUNTED:
+		target.huntedStack = static_cast<int8_t>(instruction.amount);
+		break;
+	case EffectOp::IGNITE:
+		target.igniteStack = static_cast<int8_t>(instruction.amount);
+		break;
+	case EffectOp::SET_CHARGE:
+		owner.charge = instruction.amount != 0;
+		break;
+	case EffectOp::ADVANCE_CYCLE:
+		owner.cycle++;
+		if (owner.cycle > instruction.amount) {
+			owner.cycle = 0;
+		}
+		break;
+	case EffectOp::SET_CYCLE:
+		owner.cycle = instruction.amount;
+		break;
+	case EffectOp::AI_SCORE:
+		aiMultiplier += instruction.amount;
+		break;
+	case EffectOp::SPAWN_SHIELD:
+		//simulated battles have no entities, so no shield is spawned
+		break;
+	default:
+		break;
+	}
+}
+
+//CharacterAction::ApplySkill and Attack::UseAttack(std::vector<CharacterStats*>)
+void BattleSimState::ApplySkill(BattleSimContext const& context, SimAction action, SimRoll const& roll) {
+	int ownerIndex{ activeCharacter };
+	SimCharacterInfo const& ownerInfo{ context.characters[ownerIndex] };
+	SimSkill const& skill{ context.skills[ownerInfo.skills[action.skill]] };
+
+	chi -= skill.chiCost;
+	if (chi > 5) {
+		chi = 5;
+	}
+	if (skill.refundChi) {
+		chi += 1;
+	}
+
+	if (skill.attacktype != AttackType::AOE) {
+		UseAttack(context, skill, ownerIndex, action.target, roll);
+		return;
+	}
+
+	int8_t targets[SIM_MAX_CHARACTERS];
+	int targetCount{ ownerInfo.tag == CharacterType::PLAYER ? GetEnemies(context, targets) : GetPlayers(context, targets) };
+	for (int i = 0; i < targetCount; ++i) {
+		UseAttack(context, skill, ownerIndex, targets[i], roll);
+	}
+
+	float damage{};
+	RunSkillEffects(context.effects.data() + skill.finishEffects, skill.finishEffectCount,
+		[&](EffectInstruction const& instruction) { return TestEffect(context, instruction, ownerIndex, SIM_NONE, roll); },
+		[&](EffectInstruction const& instruction) { ExecuteEffect(context, instruction, ownerIndex, SIM_NONE, damage); });
+
+	SimCharacter& owner{ characters[ownerIndex] };
+	if (owner.igniteStack && skill.chiCost > 0) {
+		float igniteDamage{ 0.1f * owner.maxHealth };
+		if (igniteDamage >= owner.health) {
+			igniteDamage = owner.health - 1;
+		}
+		TakeDamage(context, ownerIndex, igniteDamage);
+	}
+}
+
+//CharacterAction::UpdateState
+void BattleSimState::UpdateState(BattleSimContext const& context, SimAction action, SimRoll const& roll) {
+	SimCharacter& c{ characters[activeCharacter] };
+	switch (c.entityState) {
+	case START:
+		c.entityState = WAITING;
+		break;
+	case WAITING:
+		if (c.stunStack > 0) {
+			c.stunStack -= 1;
+			c.entityState = ENDING;
+		}
+		break;
+	case ATTACKING:
+		ApplySkill(context, action, roll);
+		c.entityState = ENDING;
+		break;
+	}
+
+	if (c.entityState == ENDING) {
+		if (c.attackStack > 0) {
+			c.attackStack -= 1;
+			if (c.attackStack == 0) {
+				c.attackBuff = 0.f;
+			}
+		}
+		if (c.defenseStack > 0) {
+			c.defenseStack -= 1;
+			if (c.defenseStack == 0) {
+				c.defenseBuff = 0.f;
+			}
+		}
+		int8_t enemies[SIM_MAX_CHARACTERS];
+		if (c.reflectStack > 0 && GetEnemies(context, enemies) == 1) {
+			c.reflectStack -= 1;
+		}
+		if (c.attackDebuffStack > 0) {
+			c.attackDebuffStack -= 1;
+			if (c.attackDebuffStack == 0) {
+				c.attackDebuff = 0.f;
+			}
+		}
+		if (c.defenseDebuffStack > 0) {
+			c.defenseDebuffStack -= 1;
+			if (c.defenseDebuffStack == 0) {
+				c.defenseDebuff = 0.f;
+			}
+		}
+		if (c.tauntStack > 0) {
+			c.tauntStack -= 1;
+		}
+		if (c.huntedStack > 0) {
+			c.huntedStack -= 1;
+		}
+		if (c.igniteStack > 0) {
+			c.igniteStack -= 1;
+		}
+		c.entityState = END;
+	}
+}
+
+//End of turn handling in BattleSystem::Update: turn order rotation and deaths
+void BattleSimState::EndTurn(BattleSimContext const& context) {
+	if (speedup && turnCount > 0 && speedupCharacter == turnOrder[0] && speedupAnimationPlayed) {
+		for (int i = 1; i < turnCount; ++i) {
+			turnOrder[i - 1] = turnOrder[i];
+		}
+		--turnCount;
+		speedup = false;
+		roundCharacterCount--;
+	}
+	else if (turnCount > 0) {
+		if (speedup) {
+			speedupAnimationPlayed = true;
+		}
+		int8_t front{ turnOrder[0] };
+		for (int i = 1; i < turnCount; ++i) {
+			turnOrder[i - 1] = turnOrder[i];
+		}
+		turnOrder[turnCount - 1] = front;
+	}
+
+	//Process dead characters
+	int8_t dead[SIM_MAX_TURNS * 2];
+	int deadCount{};
+	for (int i = 0; i < turnCount; ++i) {
+		if (characters[turnOrder[i]].health <= 0) {
+			dead[deadCount++] = turnOrder[i];
+		}
+	}
+	for (int d = 0; d < deadCount; ++d) {
+		int8_t index{ dead[d] };
+		SimCharacterInfo const& info{ context.characters[index] };
+		if (info.kind == SimKind::GOAT_ENEMY) {
+			for (int i = 0; i < characterCount; ++i) {
+				SimCharacter& character{ characters[i] };
+				if (character.removed) {
+					continue;
+				}
+				if (context.characters[i].tag == CharacterType::PLAYER) {
+					float health{ character.health + 0.6f * characters[index].maxHealth };
+					character.damage = 0.6f * characters[index].maxHealth;
+					if (health > character.maxHealth) {
+						health = character.maxHealth;
+					}
+					SetHealth(context, i, health);
+				}
+				if (context.characters[i].tag == CharacterType::ENEMY) {
+					character.attackBuff = 0.5f;
+					character.attackStack = 9;
+				}
+			}
+		}
+		else if (info.kind == SimKind::OX_ENEMY || info.kind == SimKind::EMPEROR) {
+			for (int i = 0; i < turnCount; ++i) {
+				SimCharacter& character{ characters[turnOrder[i]] };
+				if (context.characters[turnOrder[i]].tag == CharacterType::ENEMY && character.health != 0.f) {
+					character.damage = character.health;
+					SetHealth(context, turnOrder[i], 0.f);
+					if (deadCount < SIM_MAX_TURNS * 2) {
+						dead[deadCount++] = turnOrder[i];
+					}
+				}
+			}
+		}
+		else if (info.untargetable) {
+			for (int i = 0; i < turnCount; ++i) {
+				SimCharacter& character{ characters[turnOrder[i]] };
+				if (character.shieldEntity == index) {
+					character.shieldStack = 0;
+					character.shieldEntity = SIM_NONE;
+					character.stunStack = 1;
+				}
+			}
+		}
+	}
+	for (int d = 0; d < deadCount; ++d) {
+		int8_t index{ dead[d] };
+		int kept{};
+		for (int i = 0; i < turnCount; ++i) {
+			if (turnOrder[i] != index) {
+				turnOrder[kept++] = turnOrder[i];
+			}
+		}
+		turnCount = static_cast<uint8_t>(kept);
+		Remove(context, index);
+	}
+
+	battleState = NEXTTURN;
+}
+
+//One call of BattleSystem::Update on a battle system without entities
+void BattleSimState::Step(BattleSimContext const& context, SimAction action, SimRoll const& roll) {
+	switch (battleState) {
+	case NEWROUND:
+		if (!roundInProgress) {
+			roundInProgress = true;
+			++roundCounter;
+			battleState = NEXTTURN;
+		}
+		break;
+	case NEXTTURN: {
+		int playerAmount{};
+		int enemyAmount{};
+		int aliveCount{};
+		for (int i = 0; i < characterCount; ++i) {
+			if (characters[i].removed) {
+				continue;
+			}
+			++aliveCount;
+			if (context.characters[i].tag == CharacterType::PLAYER) {
+				playerAmount++;
+			}
+			else if (context.characters[i].tag == CharacterType::ENEMY) {
+				enemyAmount++;
+			}
+		}
+		if (!enemyAmount) {
+			battleState = WIN;
+		}
+		else if (!playerAmount) {
+			battleState = LOSE;
+		}
+		else if (roundCharacterCount < aliveCount) {
+			activeCharacter = turnOrder[0];
+			for (int guard = 0; context.characters[activeCharacter].untargetable && guard < turnCount; ++guard) {
+				int8_t front{ turnOrder[0] };
+				for (int i = 1; i < turnCount; ++i) {
+					turnOrder[i - 1] = turnOrder[i];
+				}
+				turnOrder[turnCount - 1] = front;
+				activeCharacter = turnOrder[0];
+			}
+
+			SimCharacter& active{ characters[activeCharacter] };
+			if (context.characters[activeCharacter].tag == CharacterType::ENEMY) {
+				ApplyBloodStack(context, activeCharacter);
+				if (active.health <= 0) {
+					active.entityState = DYING;
+				}
+				battleState = ENEMYTURN;
+			}
+			else if (context.characters[activeCharacter].tag == CharacterType::PLAYER) {
+				battleState = PLAYERTURN;
+			}
+			if (active.entityState != DYING) {
+				active.entityState = START;
+			}
+			roundCharacterCount++;
+		}
+		else {
+			battleState = NEWROUND;
+			roundCharacterCount = 0;
+			roundInProgress = false;
+		}
+		break;
+	}
+	case ENEMYTURN:
+	case PLAYERTURN:
+		UpdateState(context, action, roll);
+		if (characters[activeCharacter].entityState == END || characters[activeCharacter].entityState == DYING) {
+			EndTurn(context);
+		}
+		break;
+	default:
+		break;
+	}
+}
+
+void BattleSimState::Start(BattleSimContext const& context) {
+	int steps{};
+	while ((activeCharacter == SIM_NONE || characters[activeCharacter].entityState != WAITING) && !IsOver() && ++steps < MAX_STEPS) {
+		Step(context, SimAction{}, SimRoll{});
+	}
+}
+
+/*!
+* \brief Apply a move
+*
+* Plays the move and keeps updating the battle until the next character is waiting
+* for a move, the same way the AI advanced its copied battle systems.
+*
+*/
+void BattleSimState::Apply(BattleSimContext const& context, SimAction action, SimRoll const& roll) {
+	if (action.skill != SIM_NONE) {
+		characters[activeCharacter].entityState = ATTACKING;
+	}
+	int steps{};
+	do {
+		if (IsOver()) {
+			break;
+		}
+		Step(context, action, roll);
+	} while (characters[activeCharacter].entityState != WAITING && ++steps < MAX_STEPS);
+}
+
+/**************************
+******** BUILDING *********
+**************************/
+
+namespace {
+	//Reads the character stats of the first entity in a prefab, the same way Serialization does
+	bool LoadPrefabCharacter(std::string const& prefab, CharacterStats& character, std::string& name) {
+		std::ifstream file(assetmanager.GetDefaultPath() + "Prefabs/" + prefab);
+		if (!file.is_open()) {
+			DEBUG_PRINT("AI: unable to open prefab %s", prefab.c_str());
+			return false;
+		}
+		rapidjson::IStreamWrapper isw(file);
+		rapidjson::Document document;
+		document.ParseStream(isw);
+		if (document.HasParseError() || !document.IsArray()) {
+			DEBUG_PRINT("AI: unable to parse prefab %s", prefab.c_str());
+			return false;
+		}
+		for (rapidjson::Value const& entityObject : document.GetArray()) {
+			if (!entityObject.HasMember("CharacterStats")) {
+				continue;
+			}
+			if (entityObject.HasMember("Entity") && entityObject["Entity"].HasMember("Name")) {
+				name = entityObject["Entity"]["Name"].GetString();
+			}
+			const rapidjson::Value& statsObject = entityObject["CharacterStats"];
+			character.stats.attack = statsObject["Attack"].GetFloat();
+			character.stats.defense = statsObject["Defense"].GetFloat();
+			character.stats.maxHealth = statsObject["Max Health"].GetFloat();
+			character.stats.health = character.stats.maxHealth;
+			character.stats.speed = statsObject["Speed"].GetInt();
+			character.tag = (CharacterType)statsObject["Character type"].GetInt();
+			if (statsObject.HasMember("Icon")) {
+				character.icon = statsObject["Icon"].GetString();
+			}
+			if (statsObject.HasMember("Boss")) {
+				character.boss = statsObject["Boss"].GetBool();
+			}
+			for (auto& a : statsObject["Skills"].GetArray()) {
+				character.action.skills.push_back(assetmanager.attacks.data[a.GetString()]);
+			}
+			if (statsObject.HasMember("Untargetable")) {
+				character.untargetable = statsObject["Untargetable"].GetBool();
+			}
+			return true;
+		}
+		DEBUG_PRINT("AI: prefab %s has no character stats", prefab.c_str());
+		return false;
+	}
+}
+
+SimRoll RollSimSkill(BattleSimContext const& context, BattleSimState const& state, SimAction action, Xoshiro128& gen) {
+	SimRoll roll;
+	if (action.skill == SIM_NONE) {
+		return roll;
+	}
+	SimSkill const& skill{ context.skills[context.characters[state.activeCharacter].skills[action.skill]] };
+	roll.multiplier = gen.Range(skill.minAttackMultiplier, skill.maxAttackMultiplier);
+	roll.crit = gen.Float() <= skill.critRate;
+	roll.proc = gen.Float() > 0.75f;
+	return roll;
+}
+
+std::vector<SimBattlePreset> const& GetBossBattles() {
+	static const std::vector<SimBattlePreset> battles{
+		{ "Goat", { "Player_Cat.prefab", "Player_Ox.prefab", "enemy_goat.prefab", "guards.prefab", "guards.prefab" } },
+		{ "Ox", { "Player_Cat.prefab", "Player_Goat.prefab", "enemy_ox.prefab", "guards.prefab", "guards.prefab" } },
+		{ "Emperor and Monkey", { "Player_Cat.prefab", "Player_Goat.prefab", "Player_Ox.prefab", "enemy_emperor.prefab", "enemy_monkey.prefab", "guards.prefab" } }
+	};
+	return battles;
+}
+
+/*!
+* \brief Build a battle
+*
+* Sets up a battle the way BattleSystem::StartBattle and DetermineTurnOrder do,
+* with stand-in entity ids, and advances it to the first character's move.
+* Overrides are matched against the character's name in the prefab or the
+* prefab's file name without its extension.
+*
+*/
+bool BuildSimBattle(std::vector<std::string> const& prefabs, BattleSimContext& context, BattleSimState& state,
+	std::vector<SimStatOverride> const* overrides, SimBattleNames* names) {
+	context = BattleSimContext{};
+	state = BattleSimState{};
+	if (names) {
+		*names = SimBattleNames{};
+	}
+	context.godMode = godModeOn;
+	context.endGame = endGameOn;
+
+	std::vector<int> speeds{};
+	Entity entity{ 1 };
+	for (std::string const& prefab : prefabs) {
+		CharacterStats character{};
+		std::string name{};
+		if (!LoadPrefabCharacter(prefab, character, name)) {
+			return false;
+		}
+		character.entity = entity++;
+		if (overrides) {
+			std::string fileName{ prefab.substr(0, prefab.find_last_of('.')) };
+			for (SimStatOverride const& stats : *overrides) {
+				if (stats.name != name && stats.name != fileName) {
+					continue;
+				}
+				if (stats.maxHealth >= 0.f) {
+					character.stats.maxHealth = stats.maxHealth;
+					character.stats.health = stats.maxHealth;
+				}
+				if (stats.attack >= 0.f) {
+					character.stats.attack = stats.attack;
+				}
+				if (stats.defense >= 0.f) {
+					character.stats.defense = stats.defense;
+				}
+				if (stats.speed >= 0) {
+					character.stats.speed = stats.speed;
+				}
+			}
+		}
+		if (names) {
+			names->characters.push_back(name);
+			names->skills.emplace_back();
+			for (Attack const& skill : character.action.skills) {
+				names->skills.back().push_back(skill.attackName);
+			}
+		}
+		if (name == "Ox_Enemy") {
+			character.buffs.reflectStack = 1;
+		}
+		if (!context.AddCharacter(character, name, state)) {
+			return false;
+		}
+		speeds.push_back(character.stats.speed);
+		if (context.catAttack == 0.f && character.tag == CharacterType::PLAYER && character.icon == "mockup_icon_cat.png") {
+			context.catAttack = character.stats.attack;
+		}
+	}
+	if (state.characterCount > SIM_MAX_TURNS) {
+		return false;
+	}
+
+	for (int8_t i = 0; i < static_cast<int8_t>(state.characterCount); ++i) {
+		state.turnOrder[state.turnCount++] = i;
+	}
+	std::stable_sort(state.turnOrder, state.turnOrder + state.turnCount, [&speeds](int8_t a, int8_t b) { return speeds[a] > speeds[b]; });
+
+	state.battleState = NEWROUND;
+	state.chi = 3;
+	state.CountSides(context);
+	state.Start(context);
+	return !state.IsOver() && state.activeCharacter != SIM_NONE;
+}
+
+/**************************
+********* PARITY **********
+**************************/
+
+namespace {
+	bool SameCharacter(CharacterStats const& full, SimCharacter const& sim, BattleSimContext const& context) {
+		int8_t shield{ full.buffs.shieldEntity ? context.Find(full.buffs.shieldEntity) : SIM_NONE };
+		int8_t taunt{ full.debuffs.tauntTarget ? context.Find(full.debuffs.tauntTarget) : SIM_NONE };
+		return full.stats.health == sim.health
+			&& full.buffs.attackStack == sim.attackStack && full.buffs.attackBuff == sim.attackBuff
+			&& full.buffs.defenseStack == sim.defenseStack && full.buffs.defenseBuff == sim.defenseBuff
+			&& full.buffs.reflectStack == sim.reflectStack && full.buffs.shieldStack == sim.shieldStack
+			&& shield == sim.shieldEntity
+			&& full.debuffs.bloodStack == sim.bloodStack && full.debuffs.tauntStack == sim.tauntStack
+			&& taunt == sim.tauntTarget && full.debuffs.stunStack == sim.stunStack
+			&& full.debuffs.huntedStack == sim.huntedStack && full.debuffs.igniteStack == sim.igniteStack
+			&& full.debuffs.attackStack == sim.attackDebuffStack && full.debuffs.attackDebuff == sim.attackDebuff
+			&& full.debuffs.defenseStack == sim.defenseDebuffStack && full.debuffs.defenseDebuff == sim.defenseDebuff
+			&& full.cycle == sim.cycle && full.charge == sim.charge
+			&& static_cast<uint8_t>(full.action.entityState) == sim.entityState;
+	}
+
+	bool SameBattle(BattleSystem const& full, BattleSimContext const& context, BattleSimState const& previous, BattleSimState const& sim) {
+		bool match{ static_cast<uint8_t>(full.battleState) == sim.battleState && full.chi == sim.chi && full.aiMultiplier == sim.aiMultiplier
+			&& full.roundManage.roundCounter == sim.roundCounter && full.roundManage.characterCount == sim.roundCharacterCount
+			&& full.speedup == sim.speedup && full.turnManage.turnOrderList.size() == sim.turnCount };
+		if (match && !sim.IsOver()) {
+			match = full.activeCharacter != nullptr && context.Find(full.activeCharacter->entity) == sim.activeCharacter;
+		}
+		int turn{};
+		for (CharacterStats const* c : full.turnManage.turnOrderList) {
+			if (!match || turn >= sim.turnCount) {
+				break;
+			}
+			match = context.Find(c->entity) == sim.turnOrder[turn++];
+		}
+		int alive{};
+		for (int c = 0; c < sim.characterCount; ++c) {
+			alive += sim.characters[c].removed ? 0 : 1;
+		}
+		match = match && static_cast<int>(full.turnManage.characterList.size()) == alive;
+		match = match && GameAILogic::Evaluate(context, previous, sim) == GameAILogic::EvaluateRecount(context, previous, sim);
+		for (CharacterStats const& c : full.turnManage.characterList) {
+			if (!match) {
+				break;
+			}
+			int8_t index{ context.Find(c.entity) };
+			match = index != SIM_NONE && !sim.characters[index].removed && SameCharacter(c, sim.characters[index], context);
+		}
+		return match;
+	}
+
+	/*!
+	* \brief Build a battle system
+	*
+	* Sets up a battle system without entities the way BattleSystem::StartBattle and
+	* DetermineTurnOrder do. Each character gets an entity with only its Name, which
+	* the battle system's boss rules look up.
+	*
+	*/
+	bool BuildFullBattle(std::vector<std::string> const& prefabs, BattleSystem& battle, std::vector<Entity>& entities) {
+		for (std::string const& prefab : prefabs) {
+			CharacterStats character{};
+			std::string name{};
+			if (!LoadPrefabCharacter(prefab, character, name)) {
+				return false;
+			}
+			character.entity = ECS::ecs().CreateEntity();
+			entities.push_back(character.entity);
+			Name component{};
+			component.name = name;
+			ECS::ecs().AddComponent<Name>(character.entity, component);
+			if (name == "Ox_Enemy") {
+				character.buffs.reflectStack = 1;
+			}
+			battle.turnManage.characterList.push_back(character);
+		}
+		for (CharacterStats& c : battle.turnManage.characterList) {
+			c.parent = &battle;
+			c.Start();
+			battle.turnManage.turnOrderList.push_back(&c);
+		}
+		battle.turnManage.turnOrderList.sort([](const CharacterStats* a, const CharacterStats* b) { return a->stats.speed > b->stats.speed; });
+		battle.turnManage.originalTurnOrderList = battle.turnManage.turnOrderList;
+		battle.roundManage = RoundManagement{};
+		battle.chi = 3;
+		battle.battleState = NEWROUND;
+		return true;
+	}
+
+	//Updates the battle system until the next character is waiting for a move or the battle is over
+	bool AdvanceFullBattle(BattleSystem& battle) {
+		int steps{};
+		do {
+			if (battle.battleState == WIN || battle.battleState == LOSE) {
+				return true;
+			}
+			//The animation system unlocks the battle once its animations finish, there are none to wait for here
+			battle.locked = false;
+			battle.Update();
+		} while ((battle.activeCharacter == nullptr || battle.activeCharacter->action.entityState != WAITING) && ++steps < MAX_STEPS);
+		return steps < MAX_STEPS;
+	}
+
+	//Plays the move with the rolls of the simulation, the way the player or the AI selects it in game
+	bool ApplyFullBattle(BattleSystem& battle, BattleSimContext const& context, SimAction action, SimRoll const& roll) {
+		CharacterStats& active{ *battle.activeCharacter };
+		if (action.skill != SIM_NONE) {
+			Attack attack{ active.action.skills[action.skill] };
+			attack.minAttackMultiplier = roll.multiplier;
+			attack.maxAttackMultiplier = roll.multiplier;
+			//Battles without entities only crit when the crit rate is certain
+			attack.critRate = roll.crit ? 1.f : 0.f;
+			attack.procRoll = roll.proc ? ProcRoll::ALWAYS : ProcRoll::NEVER;
+			active.action.selectedSkill = attack;
+			for (CharacterStats& t : battle.turnManage.characterList) {
+				if (t.entity == context.characters[action.target].entity) {
+					active.action.targetSelect.selectedTarget = &t;
+				}
+			}
+			active.action.entityState = ATTACKING;
+		}
+		return AdvanceFullBattle(battle);
+	}
+
+	//Plays one seeded battle on both sides and adds it to the result. Returns false if the battle cannot be built.
+	bool ReplaySimParity(std::vector<std::string> const& prefabs, uint64_t seed, int maxTurns, SimParityResult& result) {
+		BattleSystem full{};
+		std::vector<Entity> entities{};
+		BattleSimContext context;
+		BattleSimState sim;
+		bool built{ BuildFullBattle(prefabs, full, entities) && AdvanceFullBattle(full) && context.Capture(full, sim) };
+		if (built) {
+			++result.battles;
+			Xoshiro128 gen{ seed };
+			SimAction actions[SIM_MAX_ACTIONS];
+			for (int move = 1; move <= maxTurns && !sim.IsOver(); ++move) {
+				int actionCount{ sim.GetActions(context, actions) };
+				if (actionCount == 0) {
+					break;
+				}
+				SimAction action{ actions[gen.RangeInt(0, actionCount - 1)] };
+				SimRoll roll{ RollSimSkill(context, sim, action, gen) };
+				BattleSimState previous{ sim };
+				sim.Apply(context, action, roll);
+				++result.moves;
+				if (!ApplyFullBattle(full, context, action, roll) || !SameBattle(full, context, previous, sim)) {
+					result.mismatches.push_back({ seed, move, action });
+					break;
+				}
+			}
+		}
+		for (Entity entity : entities) {
+			ECS::ecs().DestroyEntity(entity);
+		}
+		return built;
+	}
+}
+
+/*!
+* \brief Parity check
+*
+* Plays seeded battles of the prefabs on a BattleSystem without entities and on a
+* BattleSimState side by side. Moves are picked at random, the simulation draws the
+* damage roll, crit and proc of each move and the battle system is made to play the
+* same ones, so procs and crits are covered. After every move the stats, stacks,
+* turn order and battle state are compared, a battle stops at its first mismatch.
+*
+*/
+SimParityResult VerifySimParity(std::vector<std::string> const& prefabs, uint64_t seed, int battles, int maxTurns) {
+	SimParityResult result{};
+	result.built = true;
+	for (int i = 0; i < battles && result.built; ++i) {
+		result.built = ReplaySimParity(prefabs, seed + i, maxTurns, result);
+	}
+	return result;
+}
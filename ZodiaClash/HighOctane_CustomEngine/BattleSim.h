@@ -0,0 +1,261 @@
+/******************************************************************************
+*
+*	\copyright
+*		All content(C) 2023/2024 DigiPen Institute of Technology Singapore.
+*		All rights reserved. Reproduction or disclosure of this file or its
+*		contents without the prior written consent of DigiPen Institute of
+*		Technology is prohibited.
+*
+* *****************************************************************************
+*
+*	@file		BattleSim.h
+*
+*	@author		agent
+*
+*	@email		agent\@local
+*
+*	@course		CSD 2401 - Software Engineering Project 3
+*				CSD 2451 - Software Engineering Project 4
+*
+*	@section	Section A
+*
+*	@date		19 October 2026
+*
+* *****************************************************************************
+*
+*	@brief		Compact battle simulation state for the AI
+*
+*	BattleSimState is a flat, trivially copyable copy of the parts of a
+*	BattleSystem the combat rules read and write. Everything that does not
+*	change during a battle (entities, names, skill data) lives in a shared
+*	BattleSimContext, so states only hold stats, stacks and turn order.
+*
+*	Apply() reproduces what BattleSystem::Update, CharacterAction::UpdateState
+*	and Attack::UseAttack do to a copied battle system while the AI
+*	simulates a move, without touching the ECS. Skill effects run the same
+*	compiled effect programs as Attack::UseAttack.
+*
+******************************************************************************/
+
+#pragma once
+#include "Battle.h"
+#include "Attack.h"
+#include "CharacterCommon.h"
+#include "Random.h"
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <type_traits>
+
+const int SIM_MAX_CHARACTERS = 10;
+const int SIM_MAX_SKILLS = 4;
+const int SIM_MAX_TURNS = 16; //turn order can hold a sped up character twice
+const int SIM_MAX_ACTIONS = SIM_MAX_SKILLS * SIM_MAX_CHARACTERS;
+const int8_t SIM_NONE = -1;
+
+//Characters whose death BattleSystem::Update handles specially
+enum class SimKind : uint8_t {
+	NORMAL,
+	GOAT_ENEMY,
+	OX_ENEMY,
+	EMPEROR
+};
+
+//Flat copy of the Attack fields the combat rules read
+struct SimSkill {
+	AttackType attacktype{};
+	bool refundChi{}; //"Skill 1" gives back a chi
+	bool usesProc{}; //has effects with a 25% chance
+	uint16_t hitEffects{}; //start of the effects run on every target in BattleSimContext::effects
+	uint16_t hitEffectCount{};
+	uint16_t finishEffects{}; //start of the effects run after every AOE target is hit
+	uint16_t finishEffectCount{};
+	int skillAttackPercent{};
+	float minAttackMultiplier{};
+	float maxAttackMultiplier{};
+	float critRate{};
+	float critMultiplier{};
+	int chiCost{};
+	int bleed{};
+};
+
+//Random outcomes of a move, chosen by the caller so Apply() stays deterministic
+struct SimRoll {
+	float multiplier{ 1.f }; //damage roll between the skill's min and max attack multiplier
+	bool crit{}; //critical hit
+	bool proc{}; //25% chance effects (Yin-Yang Strike)
+};
+
+//Skill slot of the active character and target slot, skill SIM_NONE skips a stunned turn
+struct SimAction {
+	int8_t skill{ SIM_NONE };
+	int8_t target{ SIM_NONE };
+};
+
+//Character data that does not change during the battle
+struct SimCharacterInfo {
+	Entity entity{};
+	CharacterType tag{};
+	SimKind kind{};
+	bool boss{};
+	bool untargetable{};
+	bool prey{}; //favoured target of Hunter's Focus
+	uint8_t skillCount{};
+	uint16_t skills[SIM_MAX_SKILLS]{}; //indices into BattleSimContext::skills
+};
+
+//Character data that changes during the battle
+struct SimCharacter {
+	float maxHealth{};
+	float health{};
+	float attack{};
+	float defense{};
+	float damage{};
+	float attackBuff{};
+	float defenseBuff{};
+	float attackDebuff{};
+	float defenseDebuff{};
+	int cycle{}; //as wide as CharacterStats::cycle, Advance Cycle without a Wrap never resets it
+	int8_t attackStack{};
+	int8_t defenseStack{};
+	int8_t reflectStack{};
+	int8_t shieldStack{};
+	int8_t shieldEntity{ SIM_NONE }; //slot of the shield protecting this character
+	int8_t bloodStack{};
+	int8_t tauntStack{};
+	int8_t tauntTarget{ SIM_NONE };
+	int8_t stunStack{};
+	int8_t huntedStack{};
+	int8_t igniteStack{};
+	int8_t attackDebuffStack{};
+	int8_t defenseDebuffStack{};
+	uint8_t entityState{};
+	bool charge{};
+	bool crit{};
+	bool removed{}; //removed from the character list after dying
+};
+
+class BattleSimState;
+
+class BattleSimContext {
+public:
+	//Copies the battle into the context and the initial state, returns false if the battle does not fit
+	bool Capture(BattleSystem const& battle, BattleSimState& state);
+	//Adds a character, used by Capture and by tools that build battles without the ECS
+	bool AddCharacter(CharacterStats const& character, std::string const& name, BattleSimState& state);
+	//Index of the character with the entity, SIM_NONE if there is none
+	int8_t Find(Entity entity) const;
+
+	SimCharacterInfo characters[SIM_MAX_CHARACTERS]{};
+	std::vector<SimSkill> skills{};
+	std::vector<EffectInstruction> effects{}; //effect programs of every skill, see SimSkill
+	float catAttack{}; //bleed damage is based on the cat's attack
+	bool godMode{};
+	bool endGame{};
+};
+
+class BattleSimState {
+public:
+	//Advances a battle built with BuildSimBattle until the first character is waiting for a move
+	void Start(BattleSimContext const& context);
+	//Plays the active character's move, then advances the battle until the next character is waiting for a move
+	void Apply(BattleSimContext const& context, SimAction action, SimRoll const& roll);
+	//Moves the active character can make, in the same order the AI has always expanded them. Returns the count.
+	//Players cannot pick skills they do not have the chi for.
+	int GetActions(BattleSimContext const& context, SimAction* output) const;
+	//True once the battle is won or lost
+	bool IsOver() const;
+	//Recounts the side totals from every character, after characters are added
+	void CountSides(BattleSimContext const& context);
+
+	SimCharacter characters[SIM_MAX_CHARACTERS]{};
+	int8_t turnOrder[SIM_MAX_TURNS]{};
+	uint8_t characterCount{}; //slots used in characters, including removed ones
+	uint8_t turnCount{};
+	int8_t activeCharacter{ SIM_NONE };
+	int8_t speedupCharacter{ SIM_NONE };
+	uint8_t battleState{};
+	bool speedup{};
+	bool speedupAnimationPlayed{};
+	bool roundInProgress{};
+	int roundCharacterCount{};
+	int roundCounter{};
+	int chi{};
+	int aiMultiplier{};
+	//Health and number of characters standing of the players (0) and enemies (1), not counting removed characters.
+	//Kept up to date as health changes so GameAILogic::Evaluate does not have to go through the characters.
+	double sideHealth[2]{};
+	int8_t sideStanding[2]{};
+
+private:
+	//Sets a character's health and updates the side totals, every change of health goes through here
+	void SetHealth(BattleSimContext const& context, int index, float health);
+	//Removes a dead character from the battle and from the side totals
+	void Remove(BattleSimContext const& context, int index);
+	//Adds (sign 1) or takes away (sign -1) a character from its side's totals
+	void CountCharacter(BattleSimContext const& context, int index, int sign);
+	void Step(BattleSimContext const& context, SimAction action, SimRoll const& roll);
+	void UpdateState(BattleSimContext const& context, SimAction action, SimRoll const& roll);
+	void EndTurn(BattleSimContext const& context);
+	void ApplySkill(BattleSimContext const& context, SimAction action, SimRoll const& roll);
+	float UseAttack(BattleSimContext const& context, SimSkill const& skill, int owner, int target, SimRoll const& roll);
+	bool TestEffect(BattleSimContext const& context, EffectInstruction const& instruction, int owner, int target, SimRoll const& roll) const;
+	void ExecuteEffect(BattleSimContext const& context, EffectInstruction const& instruction, int owner, int target, float& damage);
+	void TakeDamage(BattleSimContext const& context, int index, float damage);
+	void ApplyBloodStack(BattleSimContext const& context, int index);
+	void SwitchTurnOrder(int index);
+	int GetPlayers(BattleSimContext const& context, int8_t* output) const;
+	int GetEnemies(BattleSimContext const& context, int8_t* output) const;
+};
+
+static_assert(std::is_trivially_copyable_v<BattleSimState>, "BattleSimState must stay trivially copyable");
+
+//Random rolls of a move, drawn as Attack::CalculateDamage and Attack::UseAttack draw them in game
+SimRoll RollSimSkill(BattleSimContext const& context, BattleSimState const& state, SimAction action, Xoshiro128& gen);
+
+//Boss battle of the game, its enemies use the Boss *.skill skill sets
+struct SimBattlePreset {
+	const char* name;
+	std::vector<std::string> prefabs;
+};
+
+//Boss battles used by the AI benchmarks and the balance simulator
+std::vector<SimBattlePreset> const& GetBossBattles();
+
+//Stats replacing those of the prefab whose character or file name matches, negative values keep the prefab's
+struct SimStatOverride {
+	std::string name{};
+	float maxHealth{ -1.f };
+	float attack{ -1.f };
+	float defense{ -1.f };
+	int speed{ -1 };
+};
+
+//Names of the characters of a built battle and of their skills, by slot
+struct SimBattleNames {
+	std::vector<std::string> characters{};
+	std::vector<std::vector<std::string>> skills{};
+};
+
+//Builds a new battle from character prefabs without the ECS, for the AI benchmarks. Skills must already be loaded by the asset manager.
+bool BuildSimBattle(std::vector<std::string> const& prefabs, BattleSimContext& context, BattleSimState& state,
+	std::vector<SimStatOverride> const* overrides = nullptr, SimBattleNames* names = nullptr);
+
+//First move of a battle on which the simulation and the battle system disagree
+struct SimParityMismatch {
+	uint64_t seed{};	//seed of the battle
+	int move{};			//moves played including this one
+	SimAction action{};
+};
+
+//Result of VerifySimParity
+struct SimParityResult {
+	bool built{};	//false if a battle could not be built from the prefabs
+	int battles{};
+	int moves{};	//moves compared
+	std::vector<SimParityMismatch> mismatches{};
+};
+
+//Plays battles of the prefabs seeded from seed to seed + battles - 1 on both a BattleSystem without entities and a BattleSimState,
+//comparing them after every move. The ECS components must already be registered, the battle system looks up the characters' names.
+SimParityResult VerifySimParity(std::vector<std::string> const& prefabs, uint64_t seed, int battles, int maxTurns);
@@ -75,6 +75,35 @@ CharacterStats::CharacterStats(CharacterStats const& input) {
     untargetable = input.untargetable;
 }
 
+/**
+ * @brief Copy assignment for CharacterStats. Copies every field of the input, keeping the action referring to this instance.
+ * @param input A constant reference to another CharacterStats object.
+ * @return A reference to this instance.
+ */
+CharacterStats& CharacterStats::operator=(CharacterStats const& input) {
+    if (this == &input) {
+        return *this;
+    }
+    checkedStatus = input.checkedStatus;
+    tag = input.tag;
+    entity = input.entity;
+    action = input.action;
+    action.characterStats = this;
+    parent = input.parent;
+    icon = input.icon;
+    stats = input.stats;
+    buffs = input.buffs;
+    debuffs = input.debuffs;
+    boss = input.boss;
+    untargetable = input.untargetable;
+    cycle = input.cycle;
+    charge = input.charge;
+    crit = input.crit;
+    damage = input.damage;
+    gameObject = input.gameObject;
+    return *this;
+}
+
 /**
  * @brief Initializes the CharacterStats by setting the battle manager and the characterStats reference for the action.
  */
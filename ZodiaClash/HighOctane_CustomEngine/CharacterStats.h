@@ -49,6 +49,7 @@ class CharacterStats
 public:
     CharacterStats();
     CharacterStats(CharacterStats const&);
+    CharacterStats& operator=(CharacterStats const&);
     bool checkedStatus;
     CharacterType tag{};
     Entity entity{}; //for reference back to ECS
@@ -0,0 +1,221 @@
+/******************************************************************************
+*
+*	\copyright
+*		All content(C) 2023/2024 DigiPen Institute of Technology Singapore.
+*		All rights reserved. Reproduction or disclosure of this file or its
+*		contents without the prior written consent of DigiPen Institute of
+*		Technology is prohibited.
+*
+* *****************************************************************************
+*
+*	@file		ComponentReflection.h
+*
+*	@author		agent
+*
+*	@email		agent\@local
+*
+*	@course		CSD 2401 - Software Engineering Project 3
+*				CSD 2451 - Software Engineering Project 4
+*
+*	@section	Section A
+*
+*	@date		19 October 2026
+*
+* *****************************************************************************
+*
+*	@brief		Field lists of the components saved in scene files
+*
+*	Components made only of plain values are saved and loaded from these
+*	lists. The keys are the ones scene and prefab files already use.
+*	Components that refer to assets or hold nested data (textures, models,
+*	text labels, buttons, stats, animation sets, dialogue) keep their own
+*	save and load code in Serialization.cpp.
+*
+******************************************************************************/
+
+#pragma once
+#include "Reflection.h"
+#include "Components.h"
+#include "UIComponents.h"
+#include "Particles.h"
+
+template <>
+struct Reflect<Name> {
+	static constexpr auto fields{ std::make_tuple(
+		MakeField("Name", &Name::name),
+		MakeField("Current Layer", &Name::serializationLayer),
+		MakeField("Order in Layer", &Name::serializationOrderInLayer),
+		MakeField("isLocked", &Name::lock),
+		MakeField("isSkipped", &Name::skip)
+	) };
+};
+
+template <>
+struct Reflect<Color> {
+	static constexpr auto fields{ std::make_tuple(
+		MakeField("r", &Color::color, &glm::vec4::r),
+		MakeField("g", &Color::color, &glm::vec4::g),
+		MakeField("b", &Color::color, &glm::vec4::b),
+		MakeField("a", &Color::color, &glm::vec4::a)
+	) };
+};
+
+template <>
+struct Reflect<Transform> {
+	static constexpr auto fields{ std::make_tuple(
+		MakeField("position_x", &Transform::position, &Vec2::x),
+		MakeField("position_y", &Transform::position, &Vec2::y),
+		MakeField("rotation", &Transform::rotation),
+		MakeField("scale", &Transform::scale),
+		MakeField("velocity_x", &Transform::velocity, &Vec2::x),
+		MakeField("velocity_y", &Transform::velocity, &Vec2::y)
+	) };
+};
+
+template <>
+struct Reflect<Visible> {
+	static constexpr auto fields{ std::make_tuple(
+		MakeField("isVisible", &Visible::isVisible)
+	) };
+};
+
+template <>
+struct Reflect<Size> {
+	static constexpr auto fields{ std::make_tuple(
+		MakeField("width", &Size::width),
+		MakeField("height", &Size::height)
+	) };
+};
+
+template <>
+struct Reflect<Circle> {
+	static constexpr auto fields{ std::make_tuple(
+		MakeField("radius", &Circle::radius)
+	) };
+};
+
+template <>
+struct Reflect<AABB> {
+	static constexpr auto fields{ std::make_tuple(
+		MakeField("Min X", &AABB::min, &Vec2::x),
+		MakeField("Min Y", &AABB::min, &Vec2::y),
+		MakeField("Max X", &AABB::max, &Vec2::x),
+		MakeField("Max Y", &AABB::max, &Vec2::y),
+		MakeField("Extent X", &AABB::extents, &Vec2::x),
+		MakeField("Extent Y", &AABB::extents, &Vec2::y)
+	) };
+};
+
+template <>
+struct Reflect<Collider> {
+	static constexpr auto fields{ std::make_tuple(
+		MakeField("Collider Enum", &Collider::bodyShape),
+		MakeField("Dimension X", &Collider::dimension, &Vec2::x),
+		MakeField("Dimension Y", &Collider::dimension, &Vec2::y),
+		MakeField("Type", &Collider::type),
+		MakeField("Event Name", &Collider::eventName),
+		MakeField("Event Input", &Collider::eventInput)
+	) };
+};
+
+template <>
+struct Reflect<Emitter> {
+	static constexpr auto fields{ std::make_tuple(
+		MakeField("Emitter Lifetime", &Emitter::emitterLifetime),
+		MakeField("Emitter PositionX", &Emitter::position, &Vec2::x),
+		MakeField("Emitter PositionY", &Emitter::position, &Vec2::y),
+		MakeField("Particles SizeX", &Emitter::size, &Vec2::x),
+		MakeField("Particles SizeY", &Emitter::size, &Vec2::y),
+		MakeField("Particles ColorR", &Emitter::particleColor, &Color::color, &glm::vec4::r),
+		MakeField("Particles ColorG", &Emitter::particleColor, &Color::color, &glm::vec4::g),
+		MakeField("Particles ColorB", &Emitter::particleColor, &Color::color, &glm::vec4::b),
+		MakeField("Particles ColorA", &Emitter::particleColor, &Color::color, &glm::vec4::a),
+		MakeField("Particle Rate", &Emitter::particlesRate),
+		MakeField("Frequency", &Emitter::frequency),
+		MakeField("Particle Lifetime", &Emitter::particleLifetime),
+		MakeField("Rotation", &Emitter::rotation),
+		MakeField("Rotation Speed", &Emitter::rotationSpeed),
+		MakeField("VelocityX", &Emitter::velocity, &Vec2::x),
+		MakeField("VelocityY", &Emitter::velocity, &Vec2::y),
+		MakeField("Single Sided", &Emitter::singleSided),
+		MakeField("Textures", &Emitter::textures)
+	) };
+};
+
+//Emitters saved before some of their fields existed load with these
+template <>
+inline Emitter LoadDefault<Emitter>() {
+	Emitter emitter;
+	emitter.emitterLifetime = 2.f;
+	emitter.size = Vec2{ 5.f, 5.f };
+	emitter.particleColor.color = glm::vec4{ 1.f, 1.f, 1.f, 1.f };
+	emitter.particlesRate = 1;
+	emitter.frequency = 1.f;
+	emitter.particleLifetime = 1.f;
+	return emitter;
+}
+
+template <>
+struct Reflect<HealthBar> {
+	static constexpr auto fields{ std::make_tuple(
+		MakeField("Show Health Stat", &HealthBar::showHealthStat),
+		MakeField("Show Value or Percentage", &HealthBar::showValOrPct),
+		MakeField("Bar Width", &HealthBar::barWidth),
+		MakeField("Bar Height", &HealthBar::barHeight),
+		MakeField("Current Health", &HealthBar::currentHealth),
+		MakeField("Max Health", &HealthBar::maxHealth),
+		MakeField("Health Percentage", &HealthBar::healthPct)
+	) };
+};
+
+template <>
+struct Reflect<HealthRemaining> {
+	static constexpr auto fields{ std::make_tuple(
+		MakeField("Current Health", &HealthRemaining::currentHealth)
+	) };
+};
+
+template <>
+struct Reflect<SkillPointHUD> {
+	static constexpr auto fields{ std::make_tuple(
+		MakeField("Skill Point Balance", &SkillPointHUD::skillPointBalance),
+		MakeField("Skill Point Cap", &SkillPointHUD::maxSkillPoints)
+	) };
+};
+
+template <>
+struct Reflect<SkillPoint> {
+	static constexpr auto fields{ std::make_tuple(
+		MakeField("Active State", &SkillPoint::isActive)
+	) };
+};
+
+template <>
+struct Reflect<AttackSkill> {
+	static constexpr auto fields{ std::make_tuple(
+		MakeField("Skill Index", &AttackSkill::skillIndex)
+	) };
+};
+
+template <>
+struct Reflect<AllyHUD> {
+	static constexpr auto fields{ std::make_tuple(
+		MakeField("Ally Index", &AllyHUD::allyIndex)
+	) };
+};
+
+template <>
+struct Reflect<EnemyHUD> {
+	static constexpr auto fields{ std::make_tuple(
+		MakeField("Enemy Index", &EnemyHUD::enemyIndex)
+	) };
+};
+
+template <>
+struct Reflect<SliderUI> {
+	static constexpr auto fields{ std::make_tuple(
+		MakeField("Linked Entity", &SliderUI::linkedEntity),
+		MakeField("Slider Type", &SliderUI::type),
+		MakeField("Control Which", &SliderUI::controlWhich)
+	) };
+};
@@ -91,6 +91,12 @@ bool EntityManager::EntityExists(Entity entity) {
     return (bool)(m_ExistingEntities.count(entity));
 }
 
+void EntityManager::SetEntities(std::set<Entity> const& existing, std::queue<Entity> const& available) {
+    m_ExistingEntities = existing;
+    m_AvailableEntities = available;
+    m_LivingEntityCount = static_cast<uint32_t>(existing.size());
+}
+
 
 ///////////////////////////////////////////////////////////////////////////
 ////////// COMPONENT //////////////////////////////////////////////////////
@@ -158,7 +164,9 @@ void ECS::Init() {
 
 // Entity methods
 Entity ECS::CreateEntity() {
-    return m_EntityManager->CreateEntity();
+    Entity entity{ m_EntityManager->CreateEntity() };
+    MarkChanged(entity);
+    return entity;
 }
 
 // Returns the total number of Entities existing
@@ -178,9 +186,15 @@ std::unordered_map<std::string, std::shared_ptr<ComponentFunctions>>& ECS::GetTy
     return m_TypeManager;
 }
 
+// Return the Entity Manager, for snapshots of the entity IDs in use
+EntityManager& ECS::GetEntityManager() {
+    return *m_EntityManager;
+}
+
 // Destroys the Entity and updates the corresponding arrays
 void ECS::DestroyEntity(Entity entity) {
     m_EntityManager->DestroyEntity(entity);
+    MarkChanged(entity);
 
     m_ComponentManager->EntityDestroyed(entity);
 
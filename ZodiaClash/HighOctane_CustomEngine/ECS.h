@@ -72,6 +72,10 @@
 #include <memory>
 #include <functional>
 #include <algorithm>
+#include <unordered_set>
+#include <vector>
+#include <cstring>
+#include <type_traits>
 #include "debugdiagnostic.h"
 #include "Components.h"
 #include "MemoryManager.h"
@@ -116,6 +120,19 @@ public:
     // Returns true if entity exists
     bool EntityExists(Entity entity);
 
+    // Returns the IDs of all living entities
+    std::set<Entity> const& GetExistingEntities() {
+        return m_ExistingEntities;
+    }
+
+    // Returns the queue of unused entity IDs
+    std::queue<Entity> const& GetAvailableEntities() {
+        return m_AvailableEntities;
+    }
+
+    // Replaces the living and unused entity IDs, to bring back a snapshot with its old IDs
+    void SetEntities(std::set<Entity> const& existing, std::queue<Entity> const& available);
+
 private:
     // Queue of unused entity IDs
     std::queue<Entity> m_AvailableEntities{};
@@ -131,6 +148,38 @@ private:
 
 
 ////////// COMPONENT //////////////////////////////////////////////////////////
+
+// Copies of every component of one type, taken for a scene snapshot
+class ComponentSnapshot {
+public:
+    virtual ~ComponentSnapshot() = default;
+    std::vector<Entity> entities{};
+};
+
+template <typename T>
+class ComponentArraySnapshot : public ComponentSnapshot {
+public:
+    std::vector<T> components{};
+};
+
+// Copies a component into or out of a snapshot. Trivially copyable components
+// are copied as bytes, the others by assignment unless they have their own version.
+template <typename T>
+void CloneComponent(T& dst, T const& src) {
+    if constexpr (std::is_trivially_copyable_v<T>) {
+        std::memcpy(static_cast<void*>(&dst), static_cast<void const*>(&src), sizeof(T));
+    }
+    else {
+        dst = src;
+    }
+}
+
+// Components holding pointers to their own data, defined in SceneSnapshot.cpp
+class AnimationSet;
+class TextLabel;
+template <> void CloneComponent<AnimationSet>(AnimationSet& dst, AnimationSet const& src);
+template <> void CloneComponent<TextLabel>(TextLabel& dst, TextLabel const& src);
+
 class ComponentFunctions {
 public:
     //Adds component to the current entity
@@ -144,6 +193,12 @@ public:
 
     //Copies component from dst entity to src entity
     virtual void CopyComponent(Entity dst, Entity src) = 0;
+
+    //Copies the component of every entity that has it
+    virtual std::shared_ptr<ComponentSnapshot> Snapshot() = 0;
+
+    //Sets every entity's component back to the snapshot, adding or removing it where needed
+    virtual void Restore(ComponentSnapshot const& snapshot) = 0;
     
     std::string name{};
 };
@@ -163,6 +218,12 @@ public:
 
     //Copies component from dst entity to src entity
     void CopyComponent(Entity dst, Entity src);
+
+    //Copies the component of every entity that has it
+    std::shared_ptr<ComponentSnapshot> Snapshot();
+
+    //Sets every entity's component back to the snapshot, adding or removing it where needed
+    void Restore(ComponentSnapshot const& snapshot);
 };
 
 // This virtual class is used to store the functions of a component
@@ -499,6 +560,7 @@ public:
     template<typename T>
     void AddComponent(Entity entity, T component) {
         m_ComponentManager->AddComponent<T>(entity, component);
+        MarkChanged(entity);
 
         Signature signature = m_EntityManager->GetSignature(entity);
         signature.set(m_ComponentManager->GetComponentType<T>(), true);
@@ -511,6 +573,7 @@ public:
     template<typename T>
     void RemoveComponent(Entity entity) {
         m_ComponentManager->RemoveComponent<T>(entity);
+        MarkChanged(entity);
 
         Signature signature = m_EntityManager->GetSignature(entity);
         signature.set(m_ComponentManager->GetComponentType<T>(), false);
@@ -548,6 +611,8 @@ public:
 
     std::unordered_map<std::string, std::shared_ptr<ComponentFunctions>>& GetTypeManager();
 
+    EntityManager& GetEntityManager();
+
     // System methods ---------------------------------------------------------
     // Registers a system
     template<typename T>
@@ -572,9 +637,33 @@ public:
         return m_EntityManager->EntityExists(entity);
     }
 
+    // Change tracking, for saving only the entities that changed ------------
+    // Marks an entity as changed since the scene was last saved
+    void MarkChanged(Entity entity) {
+        m_Changed.set(entity);
+    }
+
+    // Marks every entity as changed, after components were written without going through the ECS
+    void MarkAllChanged() {
+        m_AllChanged = true;
+    }
+
+    // Returns true if the entity changed since the last ClearChanged
+    bool IsChanged(Entity entity) {
+        return m_AllChanged || m_Changed.test(entity);
+    }
+
+    // Forgets the changes once they are saved
+    void ClearChanged() {
+        m_Changed.reset();
+        m_AllChanged = false;
+    }
+
 private:
     // Constructor
     ECS() {}
+    std::bitset<MAX_ENTITIES> m_Changed{};
+    bool m_AllChanged{ true };
     std::unordered_map<std::string, std::shared_ptr<ComponentFunctions>> m_TypeManager;
     std::unique_ptr<ComponentManager> m_ComponentManager;
     std::unique_ptr<EntityManager> m_EntityManager;
@@ -606,12 +695,47 @@ template <typename T>
 void IComponentFunctions<T>::CopyComponent(Entity dst, Entity src) {
     if (ECS::ecs().HasComponent<T>(dst)) {
         ECS::ecs().GetComponent<T>(dst) = ECS::ecs().GetComponent<T>(src);
+        ECS::ecs().MarkChanged(dst);
     }
     else {
         ECS::ecs().AddComponent<T>(dst, ECS::ecs().GetComponent<T>(src));
     }
 }
 
+// Copies the component of every entity that has it
+template <typename T>
+std::shared_ptr<ComponentSnapshot> IComponentFunctions<T>::Snapshot() {
+    std::shared_ptr<ComponentArraySnapshot<T>> snapshot{ std::make_shared<ComponentArraySnapshot<T>>() };
+    std::vector<std::pair<Entity, T*>> pairs{ ECS::ecs().GetComponentManager().GetComponentArrayRef<T>().GetPairArray() };
+    snapshot->entities.reserve(pairs.size());
+    snapshot->components.resize(pairs.size());
+    for (size_t i{}; i < pairs.size(); ++i) {
+        snapshot->entities.push_back(pairs[i].first);
+        CloneComponent(snapshot->components[i], *pairs[i].second);
+    }
+    return snapshot;
+}
+
+// Sets every entity's component back to the snapshot, components kept are written in place
+template <typename T>
+void IComponentFunctions<T>::Restore(ComponentSnapshot const& snapshot) {
+    ComponentArraySnapshot<T> const& saved{ static_cast<ComponentArraySnapshot<T> const&>(snapshot) };
+    ComponentArray<T>& componentArray{ ECS::ecs().GetComponentManager().GetComponentArrayRef<T>() };
+    std::unordered_set<Entity> savedEntities{ saved.entities.begin(), saved.entities.end() };
+    for (Entity e : componentArray.GetEntityArray()) {
+        if (!savedEntities.count(e)) {
+            ECS::ecs().RemoveComponent<T>(e);
+        }
+    }
+    for (size_t i{}; i < saved.entities.size(); ++i) {
+        Entity e{ saved.entities[i] };
+        if (!componentArray.HasComponent(e)) {
+            ECS::ecs().AddComponent<T>(e, T{});
+        }
+        CloneComponent(componentArray.GetData(e), saved.components[i]);
+    }
+}
+
 ////////// System Declarations ////////////////////////////////////////////////
 
 class PhysicsSystem : public System {
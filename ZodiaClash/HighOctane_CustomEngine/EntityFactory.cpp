@@ -64,6 +64,7 @@
 #include <filesystem>
 #include "CharacterStats.h"
 #include "UndoRedo.h"
+#include "SpatialIndex.h"
 
 
 /******************************************************************************
@@ -281,6 +282,7 @@ void EntityFactory::UpdateDeletion() {
 		if (ECS::ecs().EntityExists(entity)) {
 			ECS::ecs().DestroyEntity(entity);
 			RemoveEntityFromLayering(entity);
+			spatialGrid.Remove(entity);
 		}
 	}
 	deletionEntitiesList.clear();
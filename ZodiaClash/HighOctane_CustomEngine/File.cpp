@@ -29,6 +29,15 @@
 ******************************************************************************/
 #include "File.h"
 #include <algorithm>
+#include <filesystem>
+#ifdef _WIN32
+#include <Windows.h>
+#else
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
 
 /*!***********************************************************************
  \brief
@@ -115,6 +124,23 @@ std::string FilePath::GetFileExtension(const std::string& filePath) {
 	return ""; // If no dot (.) is found, return an empty string to indicate no extension.
 }
 
+/*!***********************************************************************
+ \brief
+	Lists the names of the files and folders directly inside a folder.
+	Only reads the file system, so folders can be listed off the main thread
+ \param [in] folder
+ \return
+	names without the folder, empty if the folder cannot be read
+ *************************************************************************/
+std::vector<std::string> FilePath::ListFileNames(const std::string& folder) {
+	std::vector<std::string> names{};
+	std::error_code error;
+	for (auto it = std::filesystem::directory_iterator(folder, error); !error && it != std::filesystem::directory_iterator(); it.increment(error)) {
+		names.push_back(it->path().filename().string());
+	}
+	return names;
+}
+
 /*!***********************************************************************
 	\brief
 	One stop function to create filepath for all file types,
@@ -150,3 +176,111 @@ std::string FilePath::FilePathDir(std::string fileName, FileType fileType) {
 	}
 	return retFile;
 }
+
+/*!***********************************************************************
+ \brief
+	Unmaps the file if it is still mapped
+ *************************************************************************/
+MappedFile::~MappedFile() {
+	Close();
+}
+
+/*!***********************************************************************
+ \brief
+	Maps the whole file as a read-only view. Any previously mapped file is
+	closed first.
+ \param [in] path
+	Path of the file to map
+ \return
+	true if the file was opened and mapped
+ *************************************************************************/
+bool MappedFile::Open(const std::string& path) {
+	Close();
+#ifdef _WIN32
+	HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+	if (file == INVALID_HANDLE_VALUE) {
+		return false;
+	}
+	LARGE_INTEGER fileSize{};
+	if (!GetFileSizeEx(file, &fileSize) || fileSize.QuadPart == 0) {
+		CloseHandle(file);
+		return false;
+	}
+	HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+	if (mapping == nullptr) {
+		CloseHandle(file);
+		return false;
+	}
+	void* view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+	if (view == nullptr) {
+		CloseHandle(mapping);
+		CloseHandle(file);
+		return false;
+	}
+	fileHandle = file;
+	mappingHandle = mapping;
+	data = static_cast<const unsigned char*>(view);
+	size = static_cast<size_t>(fileSize.QuadPart);
+#else
+	int fd = open(path.c_str(), O_RDONLY);
+	if (fd < 0) {
+		return false;
+	}
+	struct stat fileStat {};
+	if (fstat(fd, &fileStat) != 0 || fileStat.st_size == 0) {
+		close(fd);
+		return false;
+	}
+	void* view = mmap(nullptr, static_cast<size_t>(fileStat.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+	if (view == MAP_FAILED) {
+		close(fd);
+		return false;
+	}
+	fileDescriptor = fd;
+	data = static_cast<const unsigned char*>(view);
+	size = static_cast<size_t>(fileStat.st_size);
+#endif
+	return true;
+}
+
+/*!***********************************************************************
+ \brief
+	Releases the view and the underlying file handles
+ *************************************************************************/
+void MappedFile::Close() {
+#ifdef _WIN32
+	if (data != nullptr) {
+		UnmapViewOfFile(data);
+	}
+	if (mappingHandle != nullptr) {
+		CloseHandle(mappingHandle);
+	}
+	if (fileHandle != nullptr) {
+		CloseHandle(fileHandle);
+	}
+	mappingHandle = nullptr;
+	fileHandle = nullptr;
+#else
+	if (data != nullptr) {
+		munmap(const_cast<unsigned char*>(data), size);
+	}
+	if (fileDescriptor >= 0) {
+		close(fileDescriptor);
+	}
+	fileDescriptor = -1;
+#endif
+	data = nullptr;
+	size = 0;
+}
+
+bool MappedFile::IsOpen() const {
+	return data != nullptr;
+}
+
+const unsigned char* MappedFile::Data() const {
+	return data;
+}
+
+size_t MappedFile::Size() const {
+	return size;
+}
@@ -29,7 +29,9 @@
 ******************************************************************************/
 #pragma once
 #include <string>
+#include <vector>
 #include <cctype>
+#include <cstddef>
 
 enum class FileType {
 	CSV,
@@ -49,6 +51,7 @@ public:
 	void SetFilePath(std::string file);
 	std::string GetFilePathWithNewExtension(const std::string& newExtension);
 	static std::string GetFileExtension(const std::string& filePath);
+	static std::vector<std::string> ListFileNames(const std::string& folder); //names of the entries of a folder, empty if it cannot be read
 	std::string FilePathDir(std::string fileName, FileType fileType);
 
 	std::string Extension;
@@ -56,3 +59,32 @@ public:
 	std::string FullDirectory;
 	std::string FullPath;
 };
+
+/*
+Read-only memory mapping of a whole file. The view stays valid until Close()
+is called or the object goes out of scope. Used by cooked asset containers so
+that their payload can be handed to the GPU without an intermediate copy.
+*/
+class MappedFile {
+public:
+	MappedFile() {};
+	~MappedFile();
+	MappedFile(const MappedFile&) = delete;
+	MappedFile& operator=(const MappedFile&) = delete;
+
+	bool Open(const std::string& path); //maps the file, returns false if it cannot be opened
+	void Close(); //unmaps the file
+	bool IsOpen() const; //true if a view is currently mapped
+	const unsigned char* Data() const; //pointer to the first byte of the view
+	size_t Size() const; //size of the view in bytes
+
+private:
+	const unsigned char* data{ nullptr };
+	size_t size{};
+#ifdef _WIN32
+	void* fileHandle{ nullptr };
+	void* mappingHandle{ nullptr };
+#else
+	int fileDescriptor{ -1 };
+#endif
+};
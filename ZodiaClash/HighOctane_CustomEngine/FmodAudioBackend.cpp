@@ -0,0 +1,369 @@
+/******************************************************************************
+*
+*	\copyright
+*		All content(C) 2023/2024 DigiPen Institute of Technology Singapore.
+*		All rights reserved. Reproduction or disclosure of this file or its
+*		contents without the prior written consent of DigiPen Institute of
+*		Technology is prohibited.
+*
+* *****************************************************************************
+*
+*	@file		FmodAudioBackend.cpp
+*
+*	@author		agent
+*
+*	@email		agent\@local
+*
+*	@course		CSD 2401 - Software Engineering Project 3
+*				CSD 2451 - Software Engineering Project 4
+*
+*	@section	Section A
+*
+*	@date		19 October 2026
+*
+* *****************************************************************************
+*
+*	@brief		Audio backend playing through FMOD
+*
+*	Decoded sounds are created as samples, compressed sounds with
+*	FMOD_CREATECOMPRESSEDSAMPLE and streamed sounds with FMOD_CREATESTREAM.
+*	Async loads are FMOD_NONBLOCKING and polled with getOpenState every
+*	Update. A channel asked for while its sound is loading is kept here with
+*	its pan and filter, and started once the sound is ready.
+*
+******************************************************************************/
+
+#ifdef _WIN32
+#include "AudioBackend.h"
+#include "AssetPack.h"
+#include "DebugDiagnostic.h"
+#include <fmod/core/inc/fmod.hpp>
+#include <chrono>
+#include <unordered_map>
+#include <vector>
+
+namespace {
+	using Clock = std::chrono::steady_clock;
+
+	class FmodAudioBackend : public IAudioBackend {
+	public:
+		const char* GetName() const override { return "FMOD"; }
+		bool Initialize() override;
+		void Update() override;
+		void Release() override;
+
+		AudioGroupHandle GetMasterGroup() override { return 1; }
+		AudioGroupHandle CreateGroup(const char* name) override;
+		void SetGroupVolume(AudioGroupHandle group, float volume) override;
+		float GetGroupVolume(AudioGroupHandle group) override;
+		void SetGroupPaused(AudioGroupHandle group, bool paused) override;
+		bool IsGroupPaused(AudioGroupHandle group) override;
+		void StopGroup(AudioGroupHandle group) override;
+
+		AudioSoundHandle CreateSound(const char* path, AudioResidency residency, bool loop, bool async) override;
+		AudioSoundInfo GetSoundInfo(AudioSoundHandle sound) override;
+		void ReleaseSound(AudioSoundHandle sound) override;
+
+		AudioChannelHandle Play(AudioSoundHandle sound, AudioGroupHandle group) override;
+		bool IsPlaying(AudioChannelHandle channel) override;
+		void SetChannelPan(AudioChannelHandle channel, float pan) override;
+		void SetChannelLowPass(AudioChannelHandle channel, float gain) override;
+
+	private:
+		struct Sound {
+			FMOD::Sound* sound{};
+			AudioResidency residency{};
+			AudioLoadState state{ AudioLoadState::LOADING };
+			size_t memory{};
+			Clock::time_point start{};
+			double loadMilliseconds{};
+		};
+
+		//channel is null until the sound has loaded
+		struct Channel {
+			FMOD::Channel* channel{};
+			AudioSoundHandle sound{};
+			AudioGroupHandle group{};
+			float pan{};
+			float lowPass{ 1.f };
+		};
+
+		FMOD::ChannelGroup* FindGroup(AudioGroupHandle group);
+		//Checks if a sound loading without blocking is ready
+		void Poll(Sound& sound);
+		bool Start(Channel& channel, Sound& sound);
+
+		FMOD::System* system{};
+		std::vector<FMOD::ChannelGroup*> groups{};		//by handle - 1
+		std::unordered_map<AudioSoundHandle, Sound> sounds{};
+		std::unordered_map<AudioChannelHandle, Channel> channels{};
+		AudioSoundHandle nextSound{ 1 };
+		AudioChannelHandle nextChannel{ 1 };
+	};
+
+	bool FmodAudioBackend::Initialize() {
+		if (FMOD::System_Create(&system) != FMOD_OK) {
+			system = nullptr;
+			return false;
+		}
+		if (system->init(512, FMOD_INIT_CHANNEL_LOWPASS, 0) != FMOD_OK) {
+			system->release();
+			system = nullptr;
+			return false;
+		}
+		FMOD::ChannelGroup* master{};
+		system->getMasterChannelGroup(&master);
+		groups.push_back(master);
+		return true;
+	}
+
+	void FmodAudioBackend::Update() {
+		system->update();
+		for (auto& sound : sounds) {
+			if (sound.second.state == AudioLoadState::LOADING) {
+				Poll(sound.second);
+			}
+		}
+		for (auto it = channels.begin(); it != channels.end();) {
+			bool keep{ true };
+			if (it->second.channel == nullptr) {
+				auto sound{ sounds.find(it->second.sound) };
+				if (sound == sounds.end() || sound->second.state == AudioLoadState::FAILED) {
+					keep = false;
+				}
+				else if (sound->second.state == AudioLoadState::READY) {
+					keep = Start(it->second, sound->second);
+				}
+			}
+			else {
+				bool playing{};
+				keep = it->second.channel->isPlaying(&playing) == FMOD_OK && playing;
+			}
+			it = keep ? std::next(it) : channels.erase(it);
+		}
+	}
+
+	void FmodAudioBackend::Release() {
+		for (auto& sound : sounds) {
+			sound.second.sound->release();
+		}
+		sounds.clear();
+		channels.clear();
+		groups.clear();
+		system->release();
+		system = nullptr;
+	}
+
+	FMOD::ChannelGroup* FmodAudioBackend::FindGroup(AudioGroupHandle group) {
+		return group == 0 || group > groups.size() ? nullptr : groups[group - 1];
+	}
+
+	AudioGroupHandle FmodAudioBackend::CreateGroup(const char* name) {
+		FMOD::ChannelGroup* channelgroup{};
+		if (system->createChannelGroup(name, &channelgroup) != FMOD_OK) {
+			return 0;
+		}
+		groups.push_back(channelgroup);
+		return static_cast<AudioGroupHandle>(groups.size());
+	}
+
+	void FmodAudioBackend::SetGroupVolume(AudioGroupHandle group, float volume) {
+		if (FMOD::ChannelGroup* channelgroup{ FindGroup(group) }) {
+			channelgroup->setVolume(volume);
+		}
+	}
+
+	float FmodAudioBackend::GetGroupVolume(AudioGroupHandle group) {
+		float volume{};
+		if (FMOD::ChannelGroup* channelgroup{ FindGroup(group) }) {
+			channelgroup->getVolume(&volume);
+		}
+		return volume;
+	}
+
+	void FmodAudioBackend::SetGroupPaused(AudioGroupHandle group, bool paused) {
+		if (FMOD::ChannelGroup* channelgroup{ FindGroup(group) }) {
+			channelgroup->setPaused(paused);
+		}
+	}
+
+	bool FmodAudioBackend::IsGroupPaused(AudioGroupHandle group) {
+		bool paused{};
+		if (FMOD::ChannelGroup* channelgroup{ FindGroup(group) }) {
+			channelgroup->getPaused(&paused);
+		}
+		return paused;
+	}
+
+	void FmodAudioBackend::StopGroup(AudioGroupHandle group) {
+		FMOD::ChannelGroup* channelgroup{ FindGroup(group) };
+		if (channelgroup == nullptr) {
+			return;
+		}
+		channelgroup->stop();
+		// Channels waiting for their sound would otherwise start after the group was stopped
+		for (auto it = channels.begin(); it != channels.end();) {
+			bool waiting{ it->second.channel == nullptr && (it->second.group == group || group == GetMasterGroup()) };
+			it = waiting ? channels.erase(it) : std::next(it);
+		}
+	}
+
+	AudioSoundHandle FmodAudioBackend::CreateSound(const char* path, AudioResidency residency, bool loop, bool async) {
+		FMOD_MODE mode{ loop ? FMOD_LOOP_NORMAL : FMOD_DEFAULT };
+		switch (residency) {
+		case AudioResidency::DECODED:
+			mode |= FMOD_CREATESAMPLE;
+			break;
+		case AudioResidency::COMPRESSED:
+			mode |= FMOD_CREATECOMPRESSEDSAMPLE;
+			break;
+		case AudioResidency::STREAMED:
+			mode |= FMOD_CREATESTREAM;
+			break;
+		}
+		if (async) {
+			mode |= FMOD_NONBLOCKING;
+		}
+
+		Sound sound{};
+		sound.residency = residency;
+		sound.start = Clock::now();
+		FMOD_RESULT result;
+		// Sounds are created over their packed copy when there is one, so the file is not opened again
+		const unsigned char* packed{};
+		size_t packedSize{};
+		if (assetpack.Read(path, packed, packedSize)) {
+			FMOD_CREATESOUNDEXINFO info{};
+			info.cbsize = sizeof(FMOD_CREATESOUNDEXINFO);
+			info.length = static_cast<unsigned int>(packedSize);
+			result = system->createSound(reinterpret_cast<const char*>(packed), mode | FMOD_OPENMEMORY_POINT, &info, &sound.sound);
+		}
+		else {
+			result = system->createSound(path, mode, 0, &sound.sound);
+		}
+		if (result != FMOD_OK) {
+			DEBUG_PRINT("FMOD could not create %s (error %d)", path, static_cast<int>(result));
+			return 0;
+		}
+		Poll(sound);
+
+		AudioSoundHandle handle{ nextSound++ };
+		sounds[handle] = sound;
+		return handle;
+	}
+
+	void FmodAudioBackend::Poll(Sound& sound) {
+		FMOD_OPENSTATE openstate{};
+		if (sound.sound->getOpenState(&openstate, nullptr, nullptr, nullptr) != FMOD_OK || openstate == FMOD_OPENSTATE_ERROR) {
+			sound.state = AudioLoadState::FAILED;
+			return;
+		}
+		if (openstate == FMOD_OPENSTATE_LOADING || openstate == FMOD_OPENSTATE_CONNECTING) {
+			return;
+		}
+
+		sound.state = AudioLoadState::READY;
+		sound.loadMilliseconds = std::chrono::duration<double, std::milli>(Clock::now() - sound.start).count();
+		unsigned int bytes{};
+		if (sound.residency == AudioResidency::STREAMED) {
+			FMOD_TIMEUNIT unit{};
+			system->getStreamBufferSize(&bytes, &unit);
+		}
+		else {
+			// Compressed samples hold the file data, decoded samples hold PCM
+			sound.sound->getLength(&bytes, sound.residency == AudioResidency::COMPRESSED ? FMOD_TIMEUNIT_RAWBYTES : FMOD_TIMEUNIT_PCMBYTES);
+		}
+		sound.memory = bytes;
+	}
+
+	AudioSoundInfo FmodAudioBackend::GetSoundInfo(AudioSoundHandle sound) {
+		auto it{ sounds.find(sound) };
+		if (it == sounds.end()) {
+			return {};
+		}
+		return { it->second.state, it->second.memory, it->second.loadMilliseconds };
+	}
+
+	void FmodAudioBackend::ReleaseSound(AudioSoundHandle sound) {
+		auto it{ sounds.find(sound) };
+		if (it == sounds.end()) {
+			return;
+		}
+		// Releasing the sound stops its channels
+		for (auto channel = channels.begin(); channel != channels.end();) {
+			channel = channel->second.sound == sound ? channels.erase(channel) : std::next(channel);
+		}
+		it->second.sound->release();
+		sounds.erase(it);
+	}
+
+	bool FmodAudioBackend::Start(Channel& channel, Sound& sound) {
+		FMOD::ChannelGroup* channelgroup{ FindGroup(channel.group) };
+		if (system->playSound(sound.sound, channelgroup, true, &channel.channel) != FMOD_OK) {
+			return false;
+		}
+		if (channel.pan != 0.f) {
+			channel.channel->setPan(channel.pan);
+		}
+		if (channel.lowPass != 1.f) {
+			channel.channel->setLowPassGain(channel.lowPass);
+		}
+		channel.channel->setPaused(false);
+		return true;
+	}
+
+	AudioChannelHandle FmodAudioBackend::Play(AudioSoundHandle sound, AudioGroupHandle group) {
+		auto it{ sounds.find(sound) };
+		if (it == sounds.end() || it->second.state == AudioLoadState::FAILED) {
+			return 0;
+		}
+		Channel channel{};
+		channel.sound = sound;
+		channel.group = group;
+		if (it->second.state == AudioLoadState::READY && !Start(channel, it->second)) {
+			return 0;
+		}
+		AudioChannelHandle handle{ nextChannel++ };
+		channels[handle] = channel;
+		return handle;
+	}
+
+	bool FmodAudioBackend::IsPlaying(AudioChannelHandle channel) {
+		auto it{ channels.find(channel) };
+		if (it == channels.end()) {
+			return false;
+		}
+		if (it->second.channel == nullptr) {
+			return true;
+		}
+		bool playing{};
+		return it->second.channel->isPlaying(&playing) == FMOD_OK && playing;
+	}
+
+	void FmodAudioBackend::SetChannelPan(AudioChannelHandle channel, float pan) {
+		auto it{ channels.find(channel) };
+		if (it == channels.end()) {
+			return;
+		}
+		it->second.pan = pan;
+		if (it->second.channel != nullptr) {
+			it->second.channel->setPan(pan);
+		}
+	}
+
+	void FmodAudioBackend::SetChannelLowPass(AudioChannelHandle channel, float gain) {
+		auto it{ channels.find(channel) };
+		if (it == channels.end()) {
+			return;
+		}
+		it->second.lowPass = gain;
+		if (it->second.channel != nullptr) {
+			it->second.channel->setLowPassGain(gain);
+		}
+	}
+}
+
+std::unique_ptr<IAudioBackend> CreateFmodAudioBackend() {
+	return std::make_unique<FmodAudioBackend>();
+}
+#endif
@@ -42,7 +42,9 @@
 ******************************************************************************/
 
 #include "Font.h"
+#include "GlyphAtlas.h"
 #include "AssetManager.h"
+#include "AssetPack.h"
 #include <iostream>
 
 FontManager fonts;
@@ -209,12 +211,19 @@ void FontManager::LoadFontFilePath(const std::string ftFilePath) {
 */
 void FontManager::LoadValidFont(Font& fontData, const std::string& fontFilePath) {
     // if fontData's characters already has textures loaded, return
-    if (!fontData.characters.empty())
+    if (fontData.IsLoaded())
         return;
 
     //Load font face
     FT_Error err;
-    err = FT_New_Face(fonts.fontLibrary, fontFilePath.c_str(), 0, &fontData.fontFace);
+    const unsigned char* packed{};
+    size_t packedSize{};
+    if (assetpack.Read(fontFilePath, packed, packedSize)) {
+        err = FT_New_Memory_Face(fonts.fontLibrary, packed, static_cast<FT_Long>(packedSize), 0, &fontData.fontFace);
+    }
+    else {
+        err = FT_New_Face(fonts.fontLibrary, fontFilePath.c_str(), 0, &fontData.fontFace);
+    }
     switch (err) {
     case(FT_Err_Unknown_File_Format):
         DEBUG_PRINT("ERROR::FONT: Able to open and read font, but font format is unsupported");
@@ -225,16 +234,16 @@ void FontManager::LoadValidFont(Font& fontData, const std::string& fontFilePath)
     case(FT_Err_Ok):
         // Define pixel font size
         // set pixel height to 100, so relFontSize can be 0.XXf to 1.0f
-        FT_Set_Pixel_Sizes(fontData.fontFace, 0, 100);
-        assetmanager.texture.Add(fontData);
+        // glyphs are rasterized into glyphAtlas on first use
+        FT_Set_Pixel_Sizes(fontData.fontFace, 0, GLYPH_PIXEL_SIZE);
         break;
     default:
         DEBUG_PRINT("ERROR::FONT: Font file cannot be open or read!");
     }
 
     // if loading failed, clear away fontFace
-    if (fontData.characters.empty()) {
-        FT_Done_Face(fontData.fontFace);
+    if (err != FT_Err_Ok) {
+        fontData.fontFace = nullptr;
         return;
     }
 
@@ -248,9 +257,22 @@ void FontManager::LoadValidFont(Font& fontData, const std::string& fontFilePath)
 
     // for textbox size calculations, get largest offset for the font
     // to account for characters like 'g', 'y', etc.,
-    // standardized for all TextLabels using that font
-    for (const auto& pair : fontData.characters) {
-        int yOffset = pair.second.bearing.y - pair.second.size.y;
+    // standardized for all TextLabels using that font.
+    // read from outline metrics so no glyph has to be rendered
+    for (unsigned int c = 32; c < 175; c++) {
+        //skip over characters not in intended range
+        if (((c > 127) && (c < 169)) || ((c > 169) && (c < 174))) {
+            continue;
+        }
+        if (FT_Load_Char(fontData.fontFace, c, FT_LOAD_DEFAULT)) {
+            continue;
+        }
+        const FT_Glyph_Metrics& metrics = fontData.fontFace->glyph->metrics;
+        // bitmap_top - rows of the rendered glyph, floored to whole pixels
+        int yOffset = static_cast<int>((metrics.horiBearingY - metrics.height) >> 6);
+        if (glyphAtlas.sdf) {
+            yOffset -= GLYPH_SDF_SPREAD;
+        }
 
         if (yOffset < fontData.largestNegativeOffset) {
             fontData.largestNegativeOffset = yOffset;
@@ -264,14 +286,17 @@ void FontManager::LoadValidFont(Font& fontData, const std::string& fontFilePath)
 * \brief Clear
 *
 * Called in AssetManager UnloadAll() when new set is set.
-* Textures are unloaded, so clearing characters map in Font object is necessary
-* to prevent empty texture pointers.
+* Textures are unloaded, so clearing characters table in Font object is necessary
+* to prevent empty texture pointers. Font faces stay open, glyphs are rasterized
+* again on demand.
 *
 */
 void FontManager::Clear() {
     for (auto& t : fontCollection) {
-        t.second.font.characters.clear();
+        t.second.font.characters.fill(Character{});
+        ++t.second.font.generation;
     }
+    glyphAtlas.Clear();
 }
 
 /*!
@@ -331,7 +356,7 @@ Font* FontManager::GetFont(const std::string& ftFamily, const std::string& ftVar
         if (it->second.font.GetInfo().second == ftVariant) {
 
             // if character textures not loaded, load textures
-            if (it->second.font.characters.empty()) {
+            if (!it->second.font.IsLoaded()) {
                 LoadFontEntry(it->second);
             }
 
@@ -504,6 +529,24 @@ void FontManager::SetDefaultFont() {
 /**************************
 * FONT CLASS OBJ FUNCTIONS
 **************************/
+/*!
+* \brief Glyph getter
+*
+* Returns the glyph for c, rasterizing it into the glyph atlas the first time it is used.
+* Glyphs missing from the font are returned with a null textureID.
+*
+*/
+const Character& Font::GetCharacter(char c) {
+    Character& ch = characters[static_cast<unsigned char>(c)];
+    if (!ch.loaded && fontFace != nullptr) {
+        glyphAtlas.LoadGlyph(*this, static_cast<unsigned char>(c));
+    }
+    else if (ch.textureID != nullptr) {
+        glyphAtlas.Touch(ch.shelf);
+    }
+    return ch;
+}
+
 /*!
 * \brief Font object info getter
 *
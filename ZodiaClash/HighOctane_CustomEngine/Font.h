@@ -41,6 +41,7 @@
 #include <filesystem>
 #include <string>
 #include <unordered_map>
+#include <array>
 #include "texture.h"
 
 // character object - stores data of extracted glyph
@@ -51,14 +52,22 @@ public:
 	glm::ivec2  size;       // Size of glyph
 	glm::ivec2	bearing;    // Offset from baseline to left/top of glyph
 	size_t		advance;    // Offset to advance to next glyph
+	bool		loaded{};	// True once the glyph has been looked up (textureID is nullptr if the font lacks it)
+	uint16_t	shelf{};	// Glyph atlas shelf holding the glyph
 };
 
 // font object - stores loaded FontFace and the FontFace's extracted glyphs
 class Font {
 public:
 	FT_Face fontFace{};
-	std::unordered_map<char, Character> characters{};
+	std::array<Character, 256> characters{}; // flat glyph table indexed by (unsigned char)
 	int largestNegativeOffset{};
+	unsigned int generation{}; // incremented every time glyphs are evicted or cleared, invalidates cached label quads
+
+	// glyph lookup, rasterizes the glyph into the glyph atlas on first use
+	const Character& GetCharacter(char c);
+	// true if the font face has been opened
+	bool IsLoaded() const { return fontFace != nullptr; }
 
 	Font(const std::string& ftFamily, const std::string& ftVariant)
 		: fontFamily(ftFamily), fontVariant(ftVariant) {}
@@ -102,6 +111,7 @@ public:
 	//void LoadChar(Font& fontData);  -- moved to TextureManager
 	//void LoadAllFonts(); -- decomposed into its smaller functions
 	//bool LoadNewFont(Font& fontData, const std::string& fontPath); -- dropped, to use LoadFontFilePath()
+	//TextureManager::Add(Font& font); -- dropped, glyphs are rasterized on demand into glyphAtlas
 
 	// boolean checkers to prevent duplicates (current usage in Initialize)
 	bool CheckFamilyName(const std::string& ftFamily);
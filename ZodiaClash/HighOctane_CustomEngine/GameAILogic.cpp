@@ -32,19 +32,50 @@
 *	MORE CONTROL OVER THE AI
 ******************************************************************************/
 
-//----------------------------------------------------------------------------------------
-//DEFINES FOR AI WEIGHTS
-
-const int playerWeight = 1000;
-const int enemyWeight = 1000;
-const float damageRate = 10.f;
-const float healRate = 10000.f;
-//----------------------------------------------------------------------------------------
-
 #include "GameAILogic.h"
 #include "CharacterStats.h"
+#include "debugdiagnostic.h"
+#include <fstream>
+#include <rapidjson-master/include/rapidjson/document.h>
+#include <rapidjson-master/include/rapidjson/istreamwrapper.h>
 
 namespace GameAILogic {
+	Weights weights{};
+
+	/**
+	* @brief Loads the AI weights
+	*
+	* {"Player Weight": 1000, "Enemy Weight": 1000, "Damage Rate": 10.0, "Heal Rate": 10000.0}
+	*/
+	bool LoadWeights(std::string const& path) {
+		std::ifstream file(path);
+		if (!file.is_open()) {
+			return false;
+		}
+		rapidjson::IStreamWrapper isw(file);
+		rapidjson::Document document;
+		document.ParseStream(isw);
+		if (document.HasParseError() || !document.IsObject()) {
+			DEBUG_PRINT("AI: unable to parse %s", path.c_str());
+			return false;
+		}
+		Weights loaded{};
+		if (document.HasMember("Player Weight") && document["Player Weight"].IsInt()) {
+			loaded.playerWeight = document["Player Weight"].GetInt();
+		}
+		if (document.HasMember("Enemy Weight") && document["Enemy Weight"].IsInt()) {
+			loaded.enemyWeight = document["Enemy Weight"].GetInt();
+		}
+		if (document.HasMember("Damage Rate") && document["Damage Rate"].IsNumber()) {
+			loaded.damageRate = document["Damage Rate"].GetFloat();
+		}
+		if (document.HasMember("Heal Rate") && document["Heal Rate"].IsNumber()) {
+			loaded.healRate = document["Heal Rate"].GetFloat();
+		}
+		weights = loaded;
+		return true;
+	}
+
 	/**
 	* @brief AI evaluation function
 	*
@@ -86,10 +117,90 @@ namespace GameAILogic {
 				effectiveHealing -= c.stats.health;
 			}
 		}
-		value += playerWeight * (-playerChange);
-		value += enemyWeight * enemyChange;
-		value += (int)(effectiveDamage * damageRate);
-		value += (int)(effectiveHealing * healRate);
+		value += weights.playerWeight * (-playerChange);
+		value += weights.enemyWeight * enemyChange;
+		value += (int)(effectiveDamage * weights.damageRate);
+		value += (int)(effectiveHealing * weights.healRate);
+		value += end.aiMultiplier - start.aiMultiplier;
+
+		return value;
+	}
+
+	/**
+	* @brief AI evaluation function for simulated battles
+	*
+	* Same formula as above from the totals of each side, which the
+	* states update as health changes and characters are removed
+	*/
+	int Evaluate(BattleSimContext const&, BattleSimState const& start, BattleSimState const& end) {
+		int value = 0;
+
+		int playerChange = end.sideStanding[0] - start.sideStanding[0];
+		int enemyChange = end.sideStanding[1] - start.sideStanding[1];
+		float effectiveDamage = static_cast<float>(start.sideHealth[0] - end.sideHealth[0]);
+		float effectiveHealing = static_cast<float>(end.sideHealth[1] - start.sideHealth[1]);
+		value += weights.playerWeight * (-playerChange);
+		value += weights.enemyWeight * enemyChange;
+		value += (int)(effectiveDamage * weights.damageRate);
+		value += (int)(effectiveHealing * weights.healRate);
+		value += end.aiMultiplier - start.aiMultiplier;
+
+		return value;
+	}
+
+	/**
+	* @brief AI evaluation function counted from every character
+	*
+	* Characters removed from the battle are skipped as they are
+	* no longer in the character list
+	*/
+	int EvaluateRecount(BattleSimContext const& context, BattleSimState const& start, BattleSimState const& end) {
+		int value = 0;
+
+		int playerChange = 0;
+		int enemyChange = 0;
+		float effectiveDamage = 0;
+		float effectiveHealing = 0;
+		for (int i = 0; i < end.characterCount; ++i) {
+			SimCharacter const& c{ end.characters[i] };
+			if (c.removed) {
+				continue;
+			}
+			if (context.characters[i].tag == CharacterType::PLAYER) {
+				if (c.health != 0) {
+					playerChange++;
+				}
+				effectiveDamage -= c.health;
+			}
+			if (context.characters[i].tag == CharacterType::ENEMY) {
+				if (c.health != 0) {
+					enemyChange++;
+				}
+				effectiveHealing += c.health;
+			}
+		}
+		for (int i = 0; i < start.characterCount; ++i) {
+			SimCharacter const& c{ start.characters[i] };
+			if (c.removed) {
+				continue;
+			}
+			if (context.characters[i].tag == CharacterType::PLAYER) {
+				if (c.health != 0) {
+					playerChange--;
+				}
+				effectiveDamage += c.health;
+			}
+			if (context.characters[i].tag == CharacterType::ENEMY) {
+				if (c.health != 0) {
+					enemyChange--;
+				}
+				effectiveHealing -= c.health;
+			}
+		}
+		value += weights.playerWeight * (-playerChange);
+		value += weights.enemyWeight * enemyChange;
+		value += (int)(effectiveDamage * weights.damageRate);
+		value += (int)(effectiveHealing * weights.healRate);
 		value += end.aiMultiplier - start.aiMultiplier;
 
 		return value;
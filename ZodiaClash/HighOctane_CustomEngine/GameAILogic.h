@@ -34,8 +34,27 @@
 
 #pragma once
 #include <list>
+#include <string>
 #include "Battle.h"
+#include "BattleSim.h"
 
 namespace GameAILogic {
+	//Weights of the evaluation, loaded from Assets/AI/Evaluation.json
+	struct Weights {
+		int playerWeight{ 1000 };	//per player knocked out
+		int enemyWeight{ 1000 };	//per enemy still standing
+		float damageRate{ 10.f };	//per health taken from the players
+		float healRate{ 10000.f };	//per health gained by the enemies
+	};
+
+	extern Weights weights;
+
+	//Loads the weights from a JSON file, keeping the defaults of missing values. Returns false if the file cannot be read.
+	bool LoadWeights(std::string const& path);
+
 	int Evaluate(BattleSystem const& start, BattleSystem const& end);
+	//Reads the side totals the states keep up to date, without going through the characters
+	int Evaluate(BattleSimContext const& context, BattleSimState const& start, BattleSimState const& end);
+	//Same value counted from every character, to check and benchmark the side totals against
+	int EvaluateRecount(BattleSimContext const& context, BattleSimState const& start, BattleSimState const& end);
 };
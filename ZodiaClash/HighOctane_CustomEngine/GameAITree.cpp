@@ -25,263 +25,812 @@
 *
 *	@brief
 *
-*	This file contains AI for the game using an evaluation decision tree 
-*	calculating all possible moves
-* 
+*	This file contains AI for the game, searching the moves of every
+*	character in turn order on a simulated copy of the battle
+*
 *	Works as follows:
-*	For all possible moves and targets, create a new node and increase its
-*	depth counter, and add it to list of nodes to continue branching if
-*	the game state is still ongoing. After that, advance the gamestate
-*	stored in the node to the next turn.
-* 
-*	Continue branching nodes until all nodes reaches the MAXDEPTH value or
-*	until the AI finds a state that it can win
-* 
-*	If the AI finds a win state, it chooses that move.
-*	If not, it evaluates all the final nodes in all branches and then
-*	picks the node with the highest evaluated value.
+*	Iterative deepening from one move ahead, adding a move per iteration
+*	until the depth limit or the time budget is reached. Enemy turns pick
+*	the highest evaluation and player turns the lowest (alpha-beta), and
+*	each move is averaged over its possible damage rolls, crits and
+*	procs (expectimax chance nodes). The root moves of each iteration are
+*	split across thread pool tasks, which share a transposition table so
+*	states reached through different move orders are searched once.
+*
+*	A win for the enemies scores above any evaluation, and a loss below.
+*	The AI picks randomly among the moves of the last completed iteration
+*	that are within DEVIATION of the best.
 *
 ******************************************************************************/
 
 
 #include "GameAITree.h"
-#include <random>
+#include "debugdiagnostic.h"
+#include "MultiThreading.h"
+#include "TranspositionTable.h"
+#include "AIDecisionJob.h"
+#include <algorithm>
+#include <atomic>
+#include <climits>
+#include <cmath>
+#include <condition_variable>
 #include <limits>
+#include <memory>
+#include <mutex>
 
 //----------------------------------------------------------------------------------------
 //DEFINES FOR AI SEARCH SETTINGS
 
-//WARNING: INCREASING THIS VALUE RESULTS IN EXPONENTIALLY HIGHER SEARCH TIMES
-const int MAXDEPTH = 0;
+//WARNING: INCREASING THESE VALUES RESULTS IN EXPONENTIALLY HIGHER SEARCH TIMES, THE TIME BUDGET STILL APPLIES
+const int MAXDEPTH = 6; //moves looked ahead by bosses
+const int MINION_MAXDEPTH = 3; //moves looked ahead by other enemies
+
+const long long TIME_BUDGET = 4000; //microseconds per decision
+
+const int CHANCE_DEPTH = 2; //moves from the root whose rolls branch into outcomes, deeper moves use the average roll
 
 const int DEVIATION = 1000;
+
+const int WIN_SCORE = 100000000; //above any evaluation
+const int SCORE_INFINITY = INT_MAX;
+
+const size_t TIME_CHECK_INTERVAL = 64; //nodes between clock reads
+
+const int SCALING_DEPTH = 4; //fixed depth of the thread scaling benchmark
+const int SCALING_POSITIONS = 4; //boss decisions timed per battle in the thread scaling benchmark
 //----------------------------------------------------------------------------------------
 
-Node::Node(BattleSystem const& initial) {
-	previous = nullptr;
-	battlesystem = initial;
-	depth = 0;
-	battlesystem.m_Entities.clear();
-	next.reserve(100);
+SearchResult lastSearchResult{};
+
+namespace {
+	using SearchClock = std::chrono::steady_clock;
+
+	//Worker slices of one depth. Pool tasks and the searching thread claim slices until none are left, so the
+	//search only waits for the slices that started and not for tasks still queued behind other jobs of the pool
+	struct RootSplit {
+		std::atomic<int> next{};
+		int finished{};
+		std::mutex mutex{};
+		std::condition_variable condition{};
+	};
+
+	//Wins and losses are stored relative to the state so they can be reused at another ply
+	int ToTableScore(int value, int ply) {
+		if (value >= WIN_SCORE / 2) {
+			return value + ply;
+		}
+		if (value <= -WIN_SCORE / 2) {
+			return value - ply;
+		}
+		return value;
+	}
+
+	int FromTableScore(int value, int ply) {
+		if (value >= WIN_SCORE / 2) {
+			return value - ply;
+		}
+		if (value <= -WIN_SCORE / 2) {
+			return value + ply;
+		}
+		return value;
+	}
 }
 
-Node::Node(Node* node) {
-	previous = node;
-	battlesystem = node->battlesystem;
-	depth = node->depth + 1;
-	next.reserve(100);
+void TreeManager::Seed(unsigned int seed) {
+	gen.Seed(seed);
 }
 
-Node* Node::GetFront() {
-	Node* current = this;
-	while (current->previous != nullptr) {
-		current = current->previous;
+/*!***********************************************************************
+ \brief
+  Lists the outcomes of a move's random rolls. The damage roll is split into its lower and upper half,
+  crits follow the skill's crit rate and Yin-Yang Strike's buff removal has a 25% chance. Skills that
+  deal no damage have a single outcome, as do moves deeper than CHANCE_DEPTH, which use the average roll.
+ \param action
+  Move to list the outcomes of.
+ \param state
+  State the move is played from.
+ \param ply
+  Moves between the root and this move.
+ \param output
+  Array of at least 8 outcomes.
+ \return
+  Number of outcomes, their weights add up to 1.
+ *************************************************************************/
+int SearchWorker::GetOutcomes(SimAction action, BattleSimState const& state, int ply, Outcome* output) const {
+	if (action.skill == SIM_NONE) {
+		output[0] = Outcome{ SimRoll{}, 1.f };
+		return 1;
+	}
+	SimSkill const& skill{ context->skills[context->characters[state.activeCharacter].skills[action.skill]] };
+	float critChance{ std::clamp(skill.critRate, 0.f, 1.f) };
+	if (skill.skillAttackPercent == 0 && !skill.usesProc) {
+		output[0] = Outcome{ SimRoll{}, 1.f };
+		return 1;
+	}
+	if (ply >= CHANCE_DEPTH) {
+		SimRoll roll;
+		roll.multiplier = (skill.minAttackMultiplier + skill.maxAttackMultiplier) / 2.f * (1.f + critChance * (skill.critMultiplier - 1.f));
+		output[0] = Outcome{ roll, 1.f };
+		return 1;
+	}
+
+	float multipliers[2]{ (skill.minAttackMultiplier + skill.maxAttackMultiplier) / 2.f };
+	int multiplierCount{ 1 };
+	if (skill.maxAttackMultiplier > skill.minAttackMultiplier) {
+		float range{ skill.maxAttackMultiplier - skill.minAttackMultiplier };
+		multipliers[0] = skill.minAttackMultiplier + 0.25f * range;
+		multipliers[1] = skill.minAttackMultiplier + 0.75f * range;
+		multiplierCount = 2;
+	}
+
+	Outcome crits[2]{};
+	int critCount{};
+	if (critChance > 0.f) {
+		crits[critCount].roll.crit = true;
+		crits[critCount++].weight = critChance;
 	}
-	return current;
+	if (critChance < 1.f) {
+		crits[critCount].roll.crit = false;
+		crits[critCount++].weight = 1.f - critChance;
+	}
+
+	Outcome procs[2]{ Outcome{ SimRoll{}, 1.f } };
+	int procCount{ 1 };
+	if (skill.usesProc) {
+		procs[0].roll.proc = true;
+		procs[0].weight = 0.25f;
+		procs[1].roll.proc = false;
+		procs[1].weight = 0.75f;
+		procCount = 2;
+	}
+
+	int count{};
+	for (int m = 0; m < multiplierCount; ++m) {
+		for (int c = 0; c < critCount; ++c) {
+			for (int p = 0; p < procCount; ++p) {
+				Outcome& outcome{ output[count++] };
+				outcome.roll.multiplier = multipliers[m];
+				outcome.roll.crit = crits[c].roll.crit;
+				outcome.roll.proc = procs[p].roll.proc;
+				outcome.weight = crits[c].weight * procs[p].weight / multiplierCount;
+			}
+		}
+	}
+	return count;
 }
 
-Node* Node::GetChosen() {
-	Node* current = this;
-	while (current->previous->previous != nullptr) {
-		current = current->previous;
+bool SearchWorker::OutOfTime() {
+	if (!aborted && checkTime && nodes % TIME_CHECK_INTERVAL == 0 && (SearchClock::now() >= deadline || (stop && stop->load(std::memory_order_relaxed)))) {
+		aborted = true;
 	}
-	return current;
+	return aborted;
 }
 
-std::vector<Node*> Node::GetBack(int* nodeCount) {
-	std::vector<Node*> output;
-	Advance(this, output, nodeCount);
-	return output;
+int SearchWorker::Leaf(BattleSimState const& state, int ply) const {
+	//Players lost, prefer the quickest win
+	if (state.battleState == LOSE) {
+		return WIN_SCORE - ply;
+	}
+	//Enemies lost, prefer the slowest loss
+	if (state.battleState == WIN) {
+		return -WIN_SCORE + ply;
+	}
+	return GameAILogic::Evaluate(*context, *root, state);
 }
 
-void Node::Advance(Node* node, std::vector<Node*>& input, int* nodeCount) {
-	if (nodeCount != nullptr) {
-		(*nodeCount)++;
+/*!***********************************************************************
+ \brief
+  Expected value of a move over its outcomes. A move with a single outcome passes the alpha-beta
+  window on, otherwise every outcome is searched with a full window so the average is exact.
+ *************************************************************************/
+int SearchWorker::Expect(BattleSimState const& state, SimAction action, int depth, int ply, int alpha, int beta) {
+	ArenaScope scope{ arena };
+	Outcome* outcomes{ arena.Allocate<Outcome>(8) };
+	BattleSimState& next{ *arena.Allocate<BattleSimState>() };
+	int outcomeCount{ GetOutcomes(action, state, ply, outcomes) };
+	if (outcomeCount == 1) {
+		next = state;
+		next.Apply(*context, action, outcomes[0].roll);
+		++nodes;
+		return AlphaBeta(next, depth, ply + 1, alpha, beta);
 	}
-	if (node->next.size() == 0) {
-		input.push_back(node);
-		return;
+
+	double value{};
+	for (int i = 0; i < outcomeCount; ++i) {
+		next = state;
+		next.Apply(*context, action, outcomes[i].roll);
+		++nodes;
+		value += outcomes[i].weight * AlphaBeta(next, depth, ply + 1, -SCORE_INFINITY, SCORE_INFINITY);
+		if (aborted) {
+			return 0;
+		}
 	}
-	for (Node& n : node->next) {
-		Advance(&n, input, nodeCount);
+	return static_cast<int>(std::lround(value));
+}
+
+/*!***********************************************************************
+ \brief
+  Alpha-beta search over the turn order. The side of the active character decides whether the
+  node maximises (enemies) or minimises (players) the evaluation.
+ *************************************************************************/
+int SearchWorker::AlphaBeta(BattleSimState const& state, int depth, int ply, int alpha, int beta) {
+	if (OutOfTime()) {
+		return 0;
+	}
+	if (depth == 0 || state.IsOver()) {
+		return Leaf(state, ply);
+	}
+
+	ArenaScope scope{ arena };
+	SimAction* actions{ arena.Allocate<SimAction>(SIM_MAX_ACTIONS) };
+	int actionCount{ state.GetActions(*context, actions) };
+	if (actionCount == 0) {
+		return Leaf(state, ply);
+	}
+
+	//Moves near the root branch on their rolls and are not shared between states
+	bool useTable{ ply >= CHANCE_DEPTH };
+	uint64_t key{};
+	if (useTable) {
+		key = table->Key(state);
+		TranspositionTable::Entry entry;
+		++ttProbes;
+		if (table->Probe(key, entry)) {
+			//Only reuse values of the same depth, so the result does not depend on which worker stored first
+			if (entry.depth == depth) {
+				int value{ FromTableScore(entry.eval, ply) };
+				if (entry.bound == TranspositionTable::Bound::EXACT
+					|| (entry.bound == TranspositionTable::Bound::LOWER && value >= beta)
+					|| (entry.bound == TranspositionTable::Bound::UPPER && value <= alpha)) {
+					++ttHits;
+					nodesSaved += entry.nodes;
+					return value;
+				}
+			}
+			//Search the stored best move first
+			SimAction* stored{ std::find_if(actions, actions + actionCount, [&entry](SimAction const& a) {
+				return a.skill == entry.move.skill && a.target == entry.move.target;
+			}) };
+			std::rotate(actions, stored, stored + (stored == actions + actionCount ? 0 : 1));
+		}
+	}
+
+	int alphaStart{ alpha };
+	int betaStart{ beta };
+	size_t nodesStart{ nodes };
+	SimAction bestAction{};
+	bool maximise{ context->characters[state.activeCharacter].tag == CharacterType::ENEMY };
+	int best{ maximise ? -SCORE_INFINITY : SCORE_INFINITY };
+	for (int i = 0; i < actionCount; ++i) {
+		int value{ Expect(state, actions[i], depth - 1, ply, alpha, beta) };
+		if (aborted) {
+			return 0;
+		}
+		if (maximise ? value > best : value < best) {
+			best = value;
+			bestAction = actions[i];
+		}
+		if (maximise) {
+			alpha = std::max(alpha, value);
+		}
+		else {
+			beta = std::min(beta, value);
+		}
+		if (alpha >= beta) {
+			break;
+		}
+	}
+
+	if (useTable && std::abs(best) <= TranspositionTable::MAX_EVAL) {
+		TranspositionTable::Entry entry;
+		entry.eval = ToTableScore(best, ply);
+		entry.depth = depth;
+		entry.bound = best <= alphaStart ? TranspositionTable::Bound::UPPER
+			: best >= betaStart ? TranspositionTable::Bound::LOWER
+			: TranspositionTable::Bound::EXACT;
+		entry.move = bestAction;
+		entry.nodes = nodes - nodesStart;
+		table->Store(key, entry);
+	}
+	return best;
+}
+
+void SearchWorker::Begin(BattleSimContext const& searchedContext, BattleSimState const& searchedRoot, SearchClock::time_point searchDeadline, SearchLimits const& limits) {
+	context = &searchedContext;
+	root = &searchedRoot;
+	deadline = searchDeadline;
+	stop = limits.stop;
+	table = limits.table ? limits.table : &transpositionTable;
+	arena.Reset();
+	nodes = 0;
+	ttProbes = 0;
+	ttHits = 0;
+	nodesSaved = 0;
+	checkTime = false;
+	aborted = false;
+}
+
+int SearchWorker::SearchRootMove(SimAction action, int depth, int side, int alpha) {
+	return side * (side > 0
+		? Expect(*root, action, depth - 1, 0, alpha, SCORE_INFINITY)
+		: Expect(*root, action, depth - 1, 0, -SCORE_INFINITY, alpha == -SCORE_INFINITY ? SCORE_INFINITY : -alpha));
+}
+
+/*!***********************************************************************
+ \brief
+  Searches the root moves assigned to a worker for one depth. Moves are dealt out round robin in
+  root order, and each worker narrows its window from its own best move only, so every exact score
+  and every move close enough to be chosen is the same whatever the number of workers or timing.
+ *************************************************************************/
+void TreeManager::SearchRootMoves(int worker, int threadCount, int depth, int side) {
+	SearchWorker& searcher{ workers[worker] };
+	searcher.checkTime = depth > 1;
+	int best{ -SCORE_INFINITY };
+	for (int i = worker; i < rootCount; i += threadCount) {
+		int a{ rootOrder[i] };
+		int alpha{ best == -SCORE_INFINITY ? -SCORE_INFINITY : best - DEVIATION };
+		int value{ searcher.SearchRootMove(rootActions[a], depth, side, alpha) };
+		if (searcher.aborted) {
+			return;
+		}
+		rootScores[a] = value;
+		rootExact[a] = value > alpha;
+		best = std::max(best, value);
 	}
-	return;
 }
 
 /*!***********************************************************************
  \brief
-  Applies the decision from a chosen node to the battle system. This involves setting the active character's selected skill and target based on the decision represented by the node.
- \param chosenNode
-  A pointer to the Node that represents the chosen decision in the decision tree. This node contains the selected skill and target that should be applied to the active character's action.
+  Iterative deepening search of the active character's move. Each depth splits the root moves
+  across thread pool tasks and the calling thread, and waits for the slices they took. The first depth always completes so there
+  is a move to play, deeper iterations are discarded if the time budget runs out. Root moves are
+  searched best first.
+ \param context
+  Data shared by every state of the battle.
+ \param root
+  State where the active character is waiting for a move.
+ \param limits
+  Maximum depth, time budget and number of tasks.
+ \return
+  The chosen move, picked randomly among the moves within DEVIATION of the best, and search statistics.
+ *************************************************************************/
+SearchResult TreeManager::SearchState(BattleSimContext const& searchedContext, BattleSimState const& root, SearchLimits const& limits) {
+	SearchClock::time_point start{ SearchClock::now() };
+	SearchClock::time_point deadline{ limits.budgetMicroseconds > 0 ? start + std::chrono::microseconds(limits.budgetMicroseconds) : SearchClock::time_point::max() };
+
+	SearchResult result{};
+	rootCount = root.GetActions(searchedContext, rootActions);
+	if (rootCount == 0) {
+		return result;
+	}
+
+	int threadCount{ limits.threads > 0 ? limits.threads : static_cast<int>(ThreadPool::threadPool().GetThreadCount()) };
+	threadCount = std::clamp(threadCount, 1, rootCount);
+	if (ThreadPool::threadPool().GetThreadCount() == 0) {
+		threadCount = 1;
+	}
+	(limits.table ? *limits.table : transpositionTable).NewSearch(root);
+	workers.resize(threadCount);
+	for (SearchWorker& worker : workers) {
+		worker.Begin(searchedContext, root, deadline, limits);
+	}
+
+	//Scores are kept from the active character's side so the root always maximises
+	int side{ searchedContext.characters[root.activeCharacter].tag == CharacterType::PLAYER ? -1 : 1 };
+	int scores[SIM_MAX_ACTIONS]{};
+	bool exact[SIM_MAX_ACTIONS]{};
+	for (int i = 0; i < rootCount; ++i) {
+		rootOrder[i] = i;
+	}
+
+	for (int depth = 1; depth <= std::max(limits.maxDepth, 1); ++depth) {
+		if (threadCount == 1) {
+			SearchRootMoves(0, 1, depth, side);
+		}
+		else {
+			//A task that starts after every slice was taken returns without touching the search, which may have ended
+			auto split{ std::make_shared<RootSplit>() };
+			auto searchSlices{ [this, split, threadCount, depth, side]() {
+				for (int w = split->next++; w < threadCount; w = split->next++) {
+					SearchRootMoves(w, threadCount, depth, side);
+					std::lock_guard<std::mutex> lock{ split->mutex };
+					++split->finished;
+					split->condition.notify_all();
+				}
+			} };
+			for (int w = 1; w < threadCount; ++w) {
+				ThreadPool::threadPool().Enqueue(searchSlices);
+			}
+			searchSlices();
+			std::unique_lock<std::mutex> lock{ split->mutex };
+			split->condition.wait(lock, [&split, threadCount]() { return split->finished == threadCount; });
+		}
+
+		bool aborted{ false };
+		for (SearchWorker const& worker : workers) {
+			aborted = aborted || worker.aborted;
+		}
+		if (aborted) {
+			result.timedOut = true;
+			break;
+		}
+
+		std::copy(rootScores, rootScores + rootCount, scores);
+		std::copy(rootExact, rootExact + rootCount, exact);
+		int best{ *std::max_element(scores, scores + rootCount) };
+		result.depth = depth;
+		result.eval = side * best;
+		std::stable_sort(rootOrder, rootOrder + rootCount, [&scores](int a, int b) { return scores[a] > scores[b]; });
+
+		//The result is already decided
+		if (std::abs(best) >= WIN_SCORE / 2) {
+			break;
+		}
+	}
+
+	//Randomly choose a move among the moves close to the best, in move order so the choice does not depend on the search order
+	int best{ scores[rootOrder[0]] };
+	int selected[SIM_MAX_ACTIONS]{};
+	int selectedCount{};
+	for (int i = 0; i < rootCount; ++i) {
+		if (exact[i] && scores[i] > best - DEVIATION) {
+			selected[selectedCount++] = i;
+		}
+	}
+	result.action = rootActions[selected[gen.RangeInt(0, selectedCount - 1)]];
+	for (SearchWorker const& worker : workers) {
+		result.nodes += worker.nodes;
+		result.ttProbes += worker.ttProbes;
+		result.ttHits += worker.ttHits;
+		result.nodesSaved += worker.nodesSaved;
+		result.arenaBytes += worker.arena.GetStats().peakBytes;
+		result.arenaAllocations += worker.arena.GetStats().allocations;
+		result.heapAllocations += worker.arena.GetStats().heapAllocations;
+	}
+	result.threads = threadCount;
+	result.microseconds = std::chrono::duration_cast<std::chrono::microseconds>(SearchClock::now() - start).count();
+	return result;
+}
+
+/*!***********************************************************************
+ \brief
+  Applies the chosen move to the battle system. This involves setting the active character's selected skill and target based on the move's skill slot and target slot.
+ \param action
+  Skill slot of the active character and target slot in the simulation context.
  \return
   This function does not return a value. It directly modifies the battle system's state by updating the active character's selected skill and target based on the chosen decision.
  *************************************************************************/
-void TreeManager::MakeDecision(Node* chosenNode) {
-	original ->activeCharacter->action.selectedSkill = chosenNode->GetChosen()->nodeCharacter->action.selectedSkill;
-	Node* chosen = chosenNode->GetChosen();
+void TreeManager::MakeDecision(SimAction action) {
+	original->activeCharacter->action.selectedSkill = original->activeCharacter->action.skills[action.skill];
+	Entity target{ context.characters[action.target].entity };
 	for (CharacterStats& chosenChar : original->turnManage.characterList) {
-		if (chosenChar.entity == chosen->selectedTarget) {
+		if (chosenChar.entity == target) {
 			original->activeCharacter->action.targetSelect.selectedTarget = &chosenChar;
 		}
 	}
 	original->activeCharacter->action.entityState = ATTACKING;
 }
 
+void TreeManager::MakeFallbackDecision() {
+	std::vector<CharacterStats*> players{ original->GetPlayers() };
+	if (original->activeCharacter->action.skills.empty() || players.empty()) {
+		return;
+	}
+	original->activeCharacter->action.selectedSkill = original->activeCharacter->action.skills.front();
+	original->activeCharacter->action.targetSelect.selectedTarget = players.front();
+	original->activeCharacter->action.entityState = ATTACKING;
+}
+
 /*!***********************************************************************
  \brief
-  Performs a search through the decision tree to find the best move for the AI. It evaluates potential moves and their outcomes by simulating the battle states that result from different actions. This function builds a tree of possible moves and evaluates them to select the most advantageous move according to the game's AI logic. The selected move is then applied to the battle system.
+  Captures the battle once into a compact simulation state for the active enemy's decision, along
+  with the limits of its search. The AI's random choice is reseeded from the AI stream so decisions
+  replay with the scene's seed however many frames they take.
  \param start
-  A pointer to the BattleSystem that represents the current state of the battle from which the search will begin. This battle system is used as the root for generating the decision tree.
+  Battle the active enemy is waiting in.
+ \param root
+  Set to the state of the battle.
+ \param limits
+  Set to the depth and time budget of the decision.
  \return
-  This function does not return a value. It selects the best move based on the evaluation of the decision tree and applies this decision to the battle system, potentially altering the course of the battle.
+  False if the battle cannot be simulated, the fallback move has then been made.
  *************************************************************************/
-void TreeManager::Search(BattleSystem* start) {
-	int currentEval{ INT_MIN };
-	std::vector<Node*> selectedNodes;
+bool TreeManager::Capture(BattleSystem* start, BattleSimState& root, SearchLimits& limits) {
 	original = start;
-	std::list<Node*> currentNodes;
-	Node parent(*start);
-	currentNodes.push_back(&parent);
-	Node* backup{}; //IN CASE ENEMY CANT FIND ANY NODES
-
-	bool createFinish = false;
-	while (createFinish == false) {
-		std::vector<Node*> toRemove{};
-		
-		auto pointer = currentNodes.begin();
-		int currentSize = static_cast<int>(currentNodes.size());
-		for (int i = 0; i < currentSize; i++) {
-			Node* n = *pointer;
-			if (n->depth > MAXDEPTH) {
-				pointer++;
-				continue;
-			}
+	gen = randomService.Stream(RandomStream::AI).Split();
 
-			//FOR ALL POSSIBLE MOVES, CREATE A NEW CHILD AND ADD TO CURRENTNODES
-			for (Attack const& a : n->battlesystem.activeCharacter->action.skills) {
-				
-				std::vector<CharacterStats*> targetList{};
+	if (!context.Capture(*start, root)) {
+		MakeFallbackDecision();
+		return false;
+	}
 
-				for (auto& c : n->battlesystem.turnManage.characterList) {
-					targetList.push_back(&c);
-				}
+	limits = SearchLimits{ context.characters[root.activeCharacter].boss ? MAXDEPTH : MINION_MAXDEPTH, TIME_BUDGET };
+	return true;
+}
+
+void TreeManager::Decide(SearchResult const& result) {
+	if (result.action.skill == SIM_NONE) {
+		MakeFallbackDecision();
+		return;
+	}
+	MakeDecision(result.action);
+}
+
+/*!***********************************************************************
+ \brief
+  Performs a search for the best move of the active enemy within the time budget, and applies the chosen move to the battle system.
+ \param start
+  A pointer to the BattleSystem that represents the current state of the battle from which the search will begin.
+ \return
+  This function does not return a value. It selects the best move and applies this decision to the battle system, potentially altering the course of the battle.
+ *************************************************************************/
+void TreeManager::Search(BattleSystem* start) {
+	BattleSimState root{};
+	SearchLimits limits{};
+	if (!Capture(start, root, limits)) {
+		return;
+	}
+	lastSearchResult = SearchState(context, root, limits);
+	Decide(lastSearchResult);
+}
 
-				//FOR ALL POSSIBLE TARGETS, CREATE A NEW CHILD AND ADD TO CURRENTNODES
-				for (CharacterStats* c : targetList) {
-					//Do not enable self-targeting
-					if (a.attacktype != AttackType::ALLYSELF && n->battlesystem.activeCharacter->entity == c->entity) {
-						continue;
-					}
-
-					n->next.push_back(Node{ n });
-					Node* child{ &n->next[n->next.size() - 1] };
-
-					//ASSIGN SKILL
-					child->battlesystem.activeCharacter->action.selectedSkill = a;
-
-					//ASSIGN TO CHILDS VERSION OF THE CHARACTER
-					for (CharacterStats& t : child->battlesystem.turnManage.characterList) {
-						if (t.entity == c->entity) {
-							child->battlesystem.activeCharacter->action.targetSelect.selectedTarget = &t;
-						}
-					}
-
-					//IF TARGET DOES NOT EXIST
-					if (child->battlesystem.activeCharacter->action.targetSelect.selectedTarget == nullptr) {
-						continue;
-					}
-
-					//SET ACTIVE CHARACTER STATE
-					child->battlesystem.activeCharacter->action.entityState = ATTACKING;
-
-					//ASSIGN CURRENT CHARACTER TO NODE
-					child->nodeCharacter = child->battlesystem.activeCharacter;
-					child->selectedTarget = child->battlesystem.activeCharacter->action.targetSelect.selectedTarget->entity;
-					
-					//UPDATE TO NEXT TURN
-					//THIS UPDATES ACTIVE CHARACTER TO NEXT TURNS ACTIVE CHARACTER
-					while (child->battlesystem.activeCharacter->action.entityState != WAITING) {
-						if (child->battlesystem.battleState == WIN) {
-							break;
-						}
-						if (child->battlesystem.battleState == LOSE) {
-							MakeDecision(child);
-							return;
-						}
-						child->battlesystem.Update();
-					}
-					//IF ENEMY LOSES, DONT PUSH NODE
-					if (child->battlesystem.battleState == WIN) {
-						child->eval = GameAILogic::Evaluate(*start, child->battlesystem);
-						if (backup == nullptr) {
-							backup = child;
-						}
-						else if (child->eval > backup->eval) {
-							backup = child;
-						}
-						break;
-					}
-
-					//EVALUATE NODES
-					child->eval = GameAILogic::Evaluate(*start, child->battlesystem);
-					currentNodes.push_back(child);
+/*!***********************************************************************
+ \brief
+  Headless AI benchmark. Builds the boss battles from their prefabs and plays them out without the
+  ECS, with enemies searching as they do in game and players picking random moves. Battles restart
+  once over until the number of enemy decisions is reached.
+ \param decisions
+  Enemy decisions to time per battle.
+ *************************************************************************/
+std::vector<AISearchBenchmarkResult> RunAISearchBenchmark(int decisions) {
+	aiDecisionJob.Cancel();
+
+	std::vector<AISearchBenchmarkResult> results{};
+	for (SimBattlePreset const& scenario : GetBossBattles()) {
+		BattleSimContext context;
+		BattleSimState initial;
+		if (!BuildSimBattle(scenario.prefabs, context, initial)) {
+			DEBUG_PRINT("  %s: unable to build battle", scenario.name);
+			continue;
+		}
+
+		TreeManager ai;
+		ai.Seed(2024);
+		Xoshiro128 gen{ 2024 };
+		std::vector<long long> latencies{};
+		latencies.reserve(decisions);
+		size_t nodes{};
+		size_t ttProbes{};
+		size_t ttHits{};
+		size_t nodesSaved{};
+		size_t peakArenaBytes{};
+		size_t arenaAllocations{};
+		size_t heapAllocations{};
+		int depths{};
+		int timeouts{};
+		int battles{ 1 };
+		BattleSimState state{ initial };
+		for (int moves = 0; static_cast<int>(latencies.size()) < decisions && moves < decisions * 50; ++moves) {
+			if (state.IsOver()) {
+				state = initial;
+				++battles;
+			}
+			SimAction actions[SIM_MAX_ACTIONS];
+			SimAction action{};
+			SimCharacterInfo const& active{ context.characters[state.activeCharacter] };
+			if (active.tag == CharacterType::ENEMY && state.characters[state.activeCharacter].stunStack == 0) {
+				SearchResult result{ ai.SearchState(context, state, SearchLimits{ active.boss ? MAXDEPTH : MINION_MAXDEPTH, TIME_BUDGET }) };
+				latencies.push_back(result.microseconds);
+				nodes += result.nodes;
+				ttProbes += result.ttProbes;
+				ttHits += result.ttHits;
+				nodesSaved += result.nodesSaved;
+				peakArenaBytes = std::max(peakArenaBytes, result.arenaBytes);
+				arenaAllocations += result.arenaAllocations;
+				heapAllocations += result.heapAllocations;
+				depths += result.depth;
+				timeouts += result.timedOut ? 1 : 0;
+				action = result.action;
+			}
+			else {
+				int actionCount{ state.GetActions(context, actions) };
+				if (actionCount > 0) {
+					action = actions[gen.RangeInt(0, actionCount - 1)];
 				}
 			}
-			toRemove.push_back(n);
-			pointer++;
+			state.Apply(context, action, RollSimSkill(context, state, action, gen));
 		}
 
-		//REMOVE EVALUATED NODES
-		if (toRemove.size() == 0) {
-			createFinish = true;
+		if (latencies.empty()) {
+			DEBUG_PRINT("  %s: no enemy decisions made", scenario.name);
+			continue;
 		}
-		for (Node* n : toRemove) {
-			currentNodes.remove(n);
+		long long total{};
+		for (long long l : latencies) {
+			total += l;
 		}
-		toRemove.clear();
+		std::sort(latencies.begin(), latencies.end());
+		size_t count{ latencies.size() };
+		AISearchBenchmarkResult result{};
+		result.battle = scenario.name;
+		result.decisions = count;
+		result.battles = battles;
+		result.averageDepth = static_cast<double>(depths) / count;
+		result.timeouts = timeouts;
+		result.nodesPerSecond = total > 0 ? nodes * 1000000.0 / total : 0.0;
+		result.nodesPerDecision = static_cast<double>(nodes) / count;
+		result.averageMicroseconds = static_cast<double>(total) / count;
+		result.p95Microseconds = latencies[count * 95 / 100];
+		result.maxMicroseconds = latencies.back();
+		result.ttProbes = ttProbes;
+		result.ttHits = ttHits;
+		result.nodesSaved = nodesSaved;
+		result.peakArenaBytes = peakArenaBytes;
+		result.arenaAllocationsPerDecision = static_cast<double>(arenaAllocations) / count;
+		result.heapAllocationsPerDecision = static_cast<double>(heapAllocations) / count;
+		DEBUG_PRINT("AI benchmark %s: %zu decisions, %.0f nodes/sec, average %.1f us, p95 %lld us",
+			result.battle.c_str(), result.decisions, result.nodesPerSecond, result.averageMicroseconds, result.p95Microseconds);
+		results.push_back(result);
 	}
+	return results;
+}
 
-	//IF ENEMY CANT FIND ANY VALID MOVES
-	if (currentNodes.size() == 0) {
-		MakeDecision(backup);
-		return;
+/*!***********************************************************************
+ \brief
+  Thread scaling benchmark. Collects the first boss decisions of each boss battle from a seeded
+  playout, then searches all of them to a fixed depth without a time budget, with the root moves
+  split across 1 to N thread pool tasks. Reports the time and speedup of each task count and checks
+  that every task count chose the same moves with the same evaluations.
+ *************************************************************************/
+AIScalingBenchmarkResult RunAIScalingBenchmark() {
+	aiDecisionJob.Cancel();
+	AIScalingBenchmarkResult benchmark{};
+	struct Position {
+		BattleSimContext const* context;
+		BattleSimState state;
+	};
+	std::vector<SimBattlePreset> const& benchmarkBattles{ GetBossBattles() };
+	std::vector<BattleSimContext> contexts(benchmarkBattles.size());
+	std::vector<Position> positions{};
+	for (size_t b = 0; b < benchmarkBattles.size(); ++b) {
+		BattleSimState state;
+		if (!BuildSimBattle(benchmarkBattles[b].prefabs, contexts[b], state)) {
+			DEBUG_PRINT("AI scaling benchmark: unable to build %s battle", benchmarkBattles[b].name);
+			continue;
+		}
+		BattleSimContext const& context{ contexts[b] };
+		Xoshiro128 gen{ 2024 };
+		int found{};
+		for (int moves = 0; found < SCALING_POSITIONS && moves < 500 && !state.IsOver(); ++moves) {
+			SimCharacterInfo const& active{ context.characters[state.activeCharacter] };
+			if (active.tag == CharacterType::ENEMY && active.boss && state.characters[state.activeCharacter].stunStack == 0) {
+				positions.push_back(Position{ &context, state });
+				++found;
+			}
+			SimAction actions[SIM_MAX_ACTIONS];
+			int actionCount{ state.GetActions(context, actions) };
+			SimAction action{ actionCount > 0 ? actions[gen.RangeInt(0, actionCount - 1)] : SimAction{} };
+			state.Apply(context, action, RollSimSkill(context, state, action, gen));
+		}
+	}
+	if (positions.empty()) {
+		return benchmark;
 	}
 
-	//EVALUATE NODES
-	for (Node* n : currentNodes) {
-		n->eval = GameAILogic::Evaluate(*start, n->battlesystem);
-		if (n->eval > currentEval) {
-			std::vector<Node*> newSelectedNodes;
-			currentEval = n->eval;
-			newSelectedNodes.push_back(n);
-			for (Node* sn : selectedNodes) {
-				if (sn->eval > currentEval - DEVIATION) {
-					newSelectedNodes.push_back(sn);
-				}
+	int maxThreads{ std::max(1, static_cast<int>(ThreadPool::threadPool().GetThreadCount())) };
+	benchmark.decisions = positions.size();
+	benchmark.depth = SCALING_DEPTH;
+	std::vector<SearchResult> reference{};
+	double singleMs{};
+	for (int threads = 1; threads <= maxThreads; ++threads) {
+		TreeManager ai;
+		size_t nodes{};
+		size_t ttProbes{};
+		size_t ttHits{};
+		bool same{ true };
+		SearchClock::time_point start{ SearchClock::now() };
+		for (size_t p = 0; p < positions.size(); ++p) {
+			ai.Seed(2024);
+			SearchResult result{ ai.SearchState(*positions[p].context, positions[p].state, SearchLimits{ SCALING_DEPTH, 0, threads }) };
+			nodes += result.nodes;
+			ttProbes += result.ttProbes;
+			ttHits += result.ttHits;
+			if (threads == 1) {
+				reference.push_back(result);
+			}
+			else if (result.eval != reference[p].eval || result.action.skill != reference[p].action.skill || result.action.target != reference[p].action.target) {
+				same = false;
 			}
-			selectedNodes = newSelectedNodes;
 		}
-		else if (n->eval > currentEval - DEVIATION) {
-			selectedNodes.push_back(n);
+		double ms{ std::chrono::duration<double, std::milli>(SearchClock::now() - start).count() };
+		if (threads == 1) {
+			singleMs = ms;
 		}
+		AIScalingBenchmarkRow row{};
+		row.tasks = threads;
+		row.milliseconds = ms;
+		row.nodesPerSecond = ms > 0 ? nodes * 1000.0 / ms : 0.0;
+		row.speedup = ms > 0 ? singleMs / ms : 0.0;
+		row.ttHitRate = ttProbes > 0 ? ttHits * 100.0 / ttProbes : 0.0;
+		row.sameMoves = same;
+		DEBUG_PRINT("AI scaling benchmark: %2d tasks, %9.2f ms, speedup %.2fx%s", row.tasks, row.milliseconds, row.speedup, row.sameMoves ? "" : ", DIFFERENT MOVES");
+		benchmark.rows.push_back(row);
 	}
+	return benchmark;
+}
 
-	//Randomly choose an attack among the selected attacks
-	std::random_device rd;
-	std::mt19937 gen(rd());
-	std::uniform_int_distribution<size_t> rand_node(0, selectedNodes.size() - 1);
-	size_t chosenNum{ rand_node(gen) };
-	Node* chosenNode = selectedNodes[chosenNum];
-	std::vector<Node*> branch{};
-	Node* reverse{ chosenNode };
-	while (reverse->previous != nullptr) {
-		branch.push_back(reverse);
-		reverse = reverse->previous;
-	}
-	MakeDecision(chosenNode);
+/*!***********************************************************************
+ \brief
+  Evaluation micro-benchmark. Collects states from random playouts of each boss battle, then
+  evaluates all of them against the battle's first state repeatedly, once from the side totals
+  kept by the states and once counting every character, and reports the time per evaluation and
+  any state where the two differ.
+ \param states
+  States collected per battle.
+ \param repeats
+  Times each state is evaluated.
+ *************************************************************************/
+std::vector<EvaluationBenchmarkResult> RunEvaluationBenchmark(int states, int repeats) {
+	std::vector<EvaluationBenchmarkResult> results{};
+	for (SimBattlePreset const& scenario : GetBossBattles()) {
+		BattleSimContext context;
+		BattleSimState initial;
+		if (!BuildSimBattle(scenario.prefabs, context, initial)) {
+			DEBUG_PRINT("  %s: unable to build battle", scenario.name);
+			continue;
+		}
+
+		Xoshiro128 gen{ 2024 };
+		std::vector<BattleSimState> positions{};
+		positions.reserve(states);
+		BattleSimState state{ initial };
+		while (static_cast<int>(positions.size()) < states) {
+			if (state.IsOver()) {
+				state = initial;
+			}
+			SimAction actions[SIM_MAX_ACTIONS];
+			int actionCount{ state.GetActions(context, actions) };
+			SimAction action{ actionCount > 0 ? actions[gen.RangeInt(0, actionCount - 1)] : SimAction{} };
+			state.Apply(context, action, RollSimSkill(context, state, action, gen));
+			positions.push_back(state);
+		}
+
+		int mismatches{};
+		for (BattleSimState const& position : positions) {
+			if (GameAILogic::Evaluate(context, initial, position) != GameAILogic::EvaluateRecount(context, initial, position)) {
+				++mismatches;
+			}
+		}
+
+		long long incrementalSum{};
+		SearchClock::time_point start{ SearchClock::now() };
+		for (int r = 0; r < repeats; ++r) {
+			for (BattleSimState const& position : positions) {
+				incrementalSum += GameAILogic::Evaluate(context, initial, position);
+			}
+		}
+		double incrementalTime{ std::chrono::duration<double, std::nano>(SearchClock::now() - start).count() };
 
-	int nodeCount = 0;
-	parent.GetBack(&nodeCount);
+		long long recountSum{};
+		start = SearchClock::now();
+		for (int r = 0; r < repeats; ++r) {
+			for (BattleSimState const& position : positions) {
+				recountSum += GameAILogic::EvaluateRecount(context, initial, position);
+			}
+		}
+		double recountTime{ std::chrono::duration<double, std::nano>(SearchClock::now() - start).count() };
 
-	return;
+		double evaluations{ static_cast<double>(positions.size()) * std::max(repeats, 1) };
+		EvaluationBenchmarkResult result{};
+		result.battle = scenario.name;
+		result.states = positions.size();
+		result.sideTotalsNanoseconds = incrementalTime / evaluations;
+		result.recountNanoseconds = recountTime / evaluations;
+		result.mismatches = mismatches;
+		result.sumsMatch = incrementalSum == recountSum;
+		DEBUG_PRINT("Evaluation benchmark %s: side totals %.2f ns, counting characters %.2f ns per evaluation, %d mismatches",
+			result.battle.c_str(), result.sideTotalsNanoseconds, result.recountNanoseconds, result.mismatches);
+		results.push_back(result);
+	}
+	return results;
 }
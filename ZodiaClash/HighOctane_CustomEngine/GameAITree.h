@@ -25,76 +25,195 @@
 *
 *	@brief
 *
-*	This file contains AI for the game using an evaluation decision tree
-*	calculating all possible moves
+*	This file contains AI for the game, searching the moves of every
+*	character in turn order on a simulated copy of the battle
 *
 *	Works as follows:
-*	For all possible moves and targets, create a new node and increase its
-*	depth counter, and add it to list of nodes to continue branching if
-*	the game state is still ongoing. After that, advance the gamestate
-*	stored in the node to the next turn.
+*	Iterative deepening from one move ahead, adding a move per iteration
+*	until the depth limit or the time budget is reached. Enemy turns pick
+*	the highest evaluation and player turns the lowest (alpha-beta), and
+*	each move is averaged over its possible damage rolls, crits and
+*	procs (expectimax chance nodes). The root moves of each iteration are
+*	split across thread pool tasks, which share a transposition table so
+*	states reached through different move orders are searched once.
 *
-*	Continue branching nodes until all nodes reaches the MAXDEPTH value or
-*	until the AI finds a state that it can win
-*
-*	If the AI finds a win state, it chooses that move.
-*	If not, it evaluates all the final nodes in all branches and then
-*	picks the node with the highest evaluated value.
+*	A win for the enemies scores above any evaluation, and a loss below.
+*	The AI picks randomly among the moves of the last completed iteration
+*	that are within DEVIATION of the best.
 *
 ******************************************************************************/
 
 #pragma once
 #include <vector>
+#include <chrono>
+#include <atomic>
 #include "GameAILogic.h"
+#include "BattleSim.h"
+#include "SearchArena.h"
+#include "Random.h"
 #include "CharacterStats.h"
 #include "Attack.h"
 
-class Node {
-public:
-	//Constructor for the initial node of the AI tree
-	Node(BattleSystem const& initial);
+class TranspositionTable;
 
-	//Constructor for the child nodes of the AI tree
-	Node(Node* previous);
+//Limits of a single AI decision
+struct SearchLimits {
+	int maxDepth{};					//moves to look ahead, across all characters
+	long long budgetMicroseconds{};	//time after which the search stops and keeps the last completed depth, 0 for no limit
+	int threads{};					//root moves are split into this many slices, searched by the thread pool and the calling thread, 0 uses every worker
+	std::atomic<bool> const* stop{};	//stops the search like the time budget once set, for searches running across frames
+	TranspositionTable* table{};		//shared by the workers, the game's table if null. Searches running at the same time need their own.
+};
 
-	//Gets the frontmost node of the tree
-	Node* GetFront();
+//Outcome and cost of a single AI decision
+struct SearchResult {
+	SimAction action{};
+	int eval{};
+	int depth{};			//last completed depth
+	size_t nodes{};			//moves simulated
+	long long microseconds{};
+	int threads{};			//tasks the root moves were split across
+	size_t ttProbes{};		//transposition table lookups
+	size_t ttHits{};		//lookups whose stored value was used instead of searching
+	size_t nodesSaved{};	//approximate moves the table hits did not have to simulate
+	size_t arenaBytes{};		//peak search memory, summed over the workers
+	size_t arenaAllocations{};	//states and move lists allocated from the workers' arenas
+	size_t heapAllocations{};	//arena blocks allocated from the heap, 0 once the arenas are warmed up
+	bool timedOut{};
+};
 
-	//Gets the node that the AI tree has chosen as its move
-	Node* GetChosen();
+//Statistics of the last decision made in game, for the performance window
+extern SearchResult lastSearchResult;
 
-	//Gets the backmost nodes of the AI tree, returns the amount of nodes in nodeCount
-	std::vector<Node*> GetBack(int* nodeCount = nullptr);
+//Searches a share of the root moves, each thread pool task has its own
+class SearchWorker {
+public:
+	//Prepares the worker for a new decision
+	void Begin(BattleSimContext const& context, BattleSimState const& root, std::chrono::steady_clock::time_point deadline, SearchLimits const& limits);
+	//Value of a root move from the active character's side (1 for enemies, -1 for players), searched with a window starting at alpha
+	int SearchRootMove(SimAction action, int depth, int side, int alpha);
 
-	//Copy of the battle system stored in this node
-	BattleSystem battlesystem{};
+	size_t nodes{};
+	size_t ttProbes{};
+	size_t ttHits{};
+	size_t nodesSaved{};
+	SearchArena arena{};	//states and move lists of the nodes being searched, reset at the start of each decision
+	bool checkTime{};
+	bool aborted{};
+private:
+	//One possible outcome of a move's random rolls
+	struct Outcome {
+		SimRoll roll{};
+		float weight{};
+	};
 
-	//Selected entity for this node
-	Entity selectedTarget;
+	//Fills the outcomes of a move and returns the count
+	int GetOutcomes(SimAction action, BattleSimState const& state, int ply, Outcome* output) const;
+	//Value of a state with the given moves left, enemies maximise and players minimise
+	int AlphaBeta(BattleSimState const& state, int depth, int ply, int alpha, int beta);
+	//Expected value of playing a move over all of its outcomes
+	int Expect(BattleSimState const& state, SimAction action, int depth, int ply, int alpha, int beta);
+	//Value of a state at the end of the search
+	int Leaf(BattleSimState const& state, int ply) const;
+	//True once the time budget is used up or the search is stopped, the search then unwinds and discards the current depth
+	bool OutOfTime();
 
-	//Selected target for this node
-	CharacterStats* nodeCharacter;
+	BattleSimContext const* context{};
+	BattleSimState const* root{};
+	std::chrono::steady_clock::time_point deadline{};
+	std::atomic<bool> const* stop{};
+	TranspositionTable* table{};
+};
 
-	//Previous node
-	Node* previous{};
+class TreeManager {
+public:
+	void Search(BattleSystem* start);
 
-	//Next node
-	std::vector<Node> next{};
+	//Captures the battle for the active character's decision, makes a fallback move and returns false if it cannot be simulated
+	bool Capture(BattleSystem* start, BattleSimState& root, SearchLimits& limits);
+	//Plays a move chosen for the battle captured last
+	void Decide(SearchResult const& result);
+	BattleSimContext const& GetContext() const { return context; }
 
-	//Current depth in the AI tree
-	size_t depth{};
+	//Searches the move of the active character in a simulated battle, used by Search and the AI benchmarks
+	SearchResult SearchState(BattleSimContext const& context, BattleSimState const& root, SearchLimits const& limits);
 
-	//Evaluation score of the node
-	int eval{};
+	//Seeds the random choice between equally good moves, for repeatable benchmarks
+	void Seed(unsigned int seed);
 private:
-	//Used for getting the backmost nodes, advances to the next node and puts the current node into the input vector
-	void Advance(Node* node, std::vector<Node*>& input, int* nodeCount);
+	//Searches every threadCount-th root move starting from the worker's index, for one depth
+	void SearchRootMoves(int worker, int threadCount, int depth, int side);
+
+	void MakeDecision(SimAction action);
+	//Used when the battle cannot be simulated, attacks the first player with the first skill
+	void MakeFallbackDecision();
+
+	BattleSystem* original{};
+	BattleSimContext context{};
+	std::vector<SearchWorker> workers{};
+
+	//Root moves of the current decision, shared by the workers which each write to their own moves
+	SimAction rootActions[SIM_MAX_ACTIONS]{};
+	int rootOrder[SIM_MAX_ACTIONS]{};
+	int rootScores[SIM_MAX_ACTIONS]{};
+	bool rootExact[SIM_MAX_ACTIONS]{};
+	int rootCount{};
+
+	Xoshiro128 gen{ randomService.Stream(RandomStream::AI).Split() };
 };
 
-class TreeManager {
-public:
-	void Search(BattleSystem* start);
-private:
-	void MakeDecision(Node*);
-	BattleSystem* original;
+//Result of RunAISearchBenchmark for one boss battle
+struct AISearchBenchmarkResult {
+	std::string battle{};
+	size_t decisions{};
+	int battles{};						//battles played to make the decisions
+	double averageDepth{};
+	int timeouts{};						//decisions that hit the time budget
+	double nodesPerSecond{};
+	double nodesPerDecision{};
+	double averageMicroseconds{};
+	long long p95Microseconds{};
+	long long maxMicroseconds{};
+	size_t ttProbes{};
+	size_t ttHits{};
+	size_t nodesSaved{};
+	size_t peakArenaBytes{};
+	double arenaAllocationsPerDecision{};
+	double heapAllocationsPerDecision{};
+};
+
+//Plays AI decisions in simulated boss battles and measures nodes per second and decision latency
+std::vector<AISearchBenchmarkResult> RunAISearchBenchmark(int decisions = 200);
+
+//Time of the scaling benchmark's decisions with one number of tasks
+struct AIScalingBenchmarkRow {
+	int tasks{};
+	double milliseconds{};
+	double nodesPerSecond{};
+	double speedup{};		//time with one task over this time
+	double ttHitRate{};		//percent of table probes that hit
+	bool sameMoves{};		//picked the same moves with the same evaluations as one task
+};
+
+//Result of RunAIScalingBenchmark
+struct AIScalingBenchmarkResult {
+	size_t decisions{};
+	int depth{};
+	std::vector<AIScalingBenchmarkRow> rows{};
 };
+
+//Times the same boss decisions with the root moves split across 1 to N thread pool tasks and checks they pick the same moves
+AIScalingBenchmarkResult RunAIScalingBenchmark();
+
+//Result of RunEvaluationBenchmark for one boss battle
+struct EvaluationBenchmarkResult {
+	std::string battle{};
+	size_t states{};
+	double sideTotalsNanoseconds{};	//per evaluation
+	double recountNanoseconds{};	//per evaluation
+	int mismatches{};				//states the two evaluations differ on
+	bool sumsMatch{};				//the timed evaluations added up to the same total
+};
+
+//Times the evaluation from the side totals against counting every character, over states of seeded boss battle playouts, and checks they agree
+std::vector<EvaluationBenchmarkResult> RunEvaluationBenchmark(int states = 4096, int repeats = 200);
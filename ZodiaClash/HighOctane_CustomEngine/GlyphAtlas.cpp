@@ -0,0 +1,265 @@
+/******************************************************************************
+*
+*	\copyright
+*		All content(C) 2023/2024 DigiPen Institute of Technology Singapore.
+*		All rights reserved. Reproduction or disclosure of this file or its
+*		contents without the prior written consent of DigiPen Institute of
+*		Technology is prohibited.
+*
+* *****************************************************************************
+*
+*	@file		GlyphAtlas.cpp
+*
+*	@author		agent
+*
+*	@email		agent\@local
+*
+*	@course		CSD 2401 - Software Engineering Project 3
+*				CSD 2451 - Software Engineering Project 4
+*
+*	@section	Section A
+*
+*	@date		19 October 2026
+*
+* *****************************************************************************
+*
+*	@brief		Dynamic glyph atlas
+*
+*   Lazy glyph rasterization, shelf packing and LRU shelf eviction.
+*
+******************************************************************************/
+
+#include "GlyphAtlas.h"
+#include "Font.h"
+#include "AssetManager.h"
+#include "debugdiagnostic.h"
+
+GlyphAtlas glyphAtlas;
+
+namespace {
+	const char* ATLAS_TEXTURE_NAME{ "fontatlas" };
+
+	// glyphs previously baked into the font sprite sheet: printable ASCII, copyright and registered
+	bool IsSupportedGlyph(unsigned char c) {
+		return (c >= 32 && c <= 127) || c == 169 || c == 174;
+	}
+}
+
+/*!
+* \brief Atlas texture getter
+*
+* Creates the atlas texture in the texture manager if it does not exist yet, so that it
+* is bound with every other texture when renderers draw.
+*
+*/
+Texture* GlyphAtlas::GetTexture() {
+	if (texture != nullptr) {
+		return texture;
+	}
+	Texture& atlas{ assetmanager.texture.data[ATLAS_TEXTURE_NAME] };
+	glCreateTextures(GL_TEXTURE_2D, 1, &atlas.id);
+	glTextureStorage2D(atlas.id, 1, GL_R8, ATLAS_SIZE, ATLAS_SIZE);
+	glClearTexImage(atlas.id, 0, GL_RED, GL_UNSIGNED_BYTE, nullptr);
+	atlas.width = ATLAS_SIZE;
+	atlas.height = ATLAS_SIZE;
+	atlas.name = ATLAS_TEXTURE_NAME;
+	atlas.active = true;
+	atlas.texcoords.clear();
+	texture = &atlas;
+	return texture;
+}
+
+/*!
+* \brief Shelf packer
+*
+* Finds room for a w x h glyph. Prefers the tightest existing shelf with space left, then
+* opens a new shelf, and finally evicts the least recently drawn shelf tall enough to fit.
+* Shelves drawn during the current frame are never evicted.
+*
+*/
+bool GlyphAtlas::Pack(int w, int h, int& x, int& y, int& shelfIndex) {
+	if (w > ATLAS_SIZE || h > ATLAS_SIZE) {
+		return false;
+	}
+
+	int best{ -1 };
+	for (int i = 0; i < static_cast<int>(shelves.size()); ++i) {
+		Shelf& shelf{ shelves[i] };
+		if (shelf.height >= h && shelf.x + w <= ATLAS_SIZE && (best < 0 || shelf.height < shelves[best].height)) {
+			best = i;
+		}
+	}
+
+	if (best < 0 && nextShelfY + h <= ATLAS_SIZE) {
+		Shelf shelf;
+		shelf.y = nextShelfY;
+		shelf.height = h;
+		nextShelfY += h;
+		shelves.push_back(shelf);
+		best = static_cast<int>(shelves.size()) - 1;
+	}
+
+	if (best < 0) {
+		for (int i = 0; i < static_cast<int>(shelves.size()); ++i) {
+			Shelf& shelf{ shelves[i] };
+			if (shelf.height >= h && shelf.lastUsed < frame && (best < 0 || shelf.lastUsed < shelves[best].lastUsed)) {
+				best = i;
+			}
+		}
+		if (best < 0) {
+			return false;
+		}
+		EvictShelf(best);
+	}
+
+	Shelf& shelf{ shelves[best] };
+	x = shelf.x;
+	y = shelf.y;
+	shelf.x += w;
+	shelfIndex = best;
+	return true;
+}
+
+/*!
+* \brief Shelf eviction
+*
+* Unloads every glyph on the shelf and bumps the owning fonts' generation so labels
+* rebuild their cached quads, which rasterizes the glyphs again on demand.
+*
+*/
+void GlyphAtlas::EvictShelf(int shelfIndex) {
+	Shelf& shelf{ shelves[shelfIndex] };
+	for (int slotIndex : shelf.slots) {
+		Slot& slot{ slots[slotIndex] };
+		if (slot.font != nullptr) {
+			slot.font->characters[slot.c] = Character{};
+			++slot.font->generation;
+		}
+		slot = Slot{};
+		freeSlots.push_back(slotIndex);
+		--glyphCount;
+	}
+	shelf.slots.clear();
+	shelf.x = 0;
+	++evictions;
+}
+
+int GlyphAtlas::AllocateSlot() {
+	if (!freeSlots.empty()) {
+		int slotIndex{ freeSlots.back() };
+		freeSlots.pop_back();
+		return slotIndex;
+	}
+	slots.emplace_back();
+	texture->texcoords.emplace_back();
+	return static_cast<int>(slots.size()) - 1;
+}
+
+/*!
+* \brief Glyph loader
+*
+* Rasterizes glyph c of the font and copies it into the atlas. The Character entry is
+* marked as loaded even if the glyph does not exist, so missing glyphs are not retried.
+*
+*/
+bool GlyphAtlas::LoadGlyph(Font& font, unsigned char c) {
+	Character& ch{ font.characters[c] };
+	ch = Character{};
+	ch.loaded = true;
+
+	if (font.fontFace == nullptr || !IsSupportedGlyph(c)) {
+		return false;
+	}
+	if (FT_Load_Char(font.fontFace, c, FT_LOAD_DEFAULT)
+		|| FT_Render_Glyph(font.fontFace->glyph, sdf ? FT_RENDER_MODE_SDF : FT_RENDER_MODE_NORMAL)) {
+		DEBUG_PRINT("ERROR::FONT: Failed to load Glyph");
+		return false;
+	}
+
+	FT_GlyphSlot glyph{ font.fontFace->glyph };
+	int w{ static_cast<int>(glyph->bitmap.width) };
+	int h{ static_cast<int>(glyph->bitmap.rows) };
+
+	Texture* atlas{ GetTexture() };
+	int x{}, y{}, shelfIndex{};
+	if (!Pack(w + GLYPH_PADDING, h + GLYPH_PADDING, x, y, shelfIndex)) {
+		DEBUG_PRINT("ERROR::FONT: Glyph atlas is full");
+		return false;
+	}
+	// eviction may have reset this font's entry
+	Character& entry{ font.characters[c] };
+
+	if (w > 0 && h > 0) {
+		// copy rows out in case the bitmap pitch is padded or negative
+		std::vector<unsigned char> pixels(static_cast<size_t>(w) * h);
+		for (int row = 0; row < h; ++row) {
+			const unsigned char* src{ glyph->bitmap.buffer + row * glyph->bitmap.pitch };
+			std::copy(src, src + w, pixels.begin() + static_cast<size_t>(row) * w);
+		}
+		glPixelStorei(GL_UNPACK_ALIGNMENT, 1); // disable byte-alignment restriction
+		glTextureSubImage2D(atlas->GetID(), 0, x, y, w, h, GL_RED, GL_UNSIGNED_BYTE, pixels.data());
+	}
+
+	int slotIndex{ AllocateSlot() };
+	slots[slotIndex] = Slot{ &font, c, shelfIndex };
+	shelves[shelfIndex].slots.push_back(slotIndex);
+	shelves[shelfIndex].lastUsed = frame;
+	++glyphCount;
+
+	float size{ static_cast<float>(ATLAS_SIZE) };
+	Texcoords& coords{ atlas->texcoords[slotIndex] };
+	coords.tl = glm::vec2{ x / size, y / size };
+	coords.tr = glm::vec2{ (x + w) / size, y / size };
+	coords.bl = glm::vec2{ x / size, (y + h) / size };
+	coords.br = glm::vec2{ (x + w) / size, (y + h) / size };
+
+	entry = Character{
+		atlas,
+		static_cast<size_t>(slotIndex),
+		glm::ivec2(w, h),
+		glm::ivec2(glyph->bitmap_left, glyph->bitmap_top),
+		static_cast<size_t>(glyph->advance.x),
+		true,
+		static_cast<uint16_t>(shelfIndex)
+	};
+	return true;
+}
+
+void GlyphAtlas::Touch(uint16_t shelf) {
+	if (shelf < shelves.size()) {
+		shelves[shelf].lastUsed = frame;
+	}
+}
+
+void GlyphAtlas::NewFrame() {
+	++frame;
+}
+
+/*!
+* \brief Clear
+*
+* Called from FontManager::Clear() after the texture manager has released the atlas
+* texture on scene change.
+*
+*/
+void GlyphAtlas::Clear() {
+	texture = nullptr;
+	shelves.clear();
+	slots.clear();
+	freeSlots.clear();
+	nextShelfY = 0;
+	glyphCount = 0;
+	evictions = 0;
+}
+
+size_t GlyphAtlas::GetGlyphCount() {
+	return glyphCount;
+}
+
+size_t GlyphAtlas::GetEvictionCount() {
+	return evictions;
+}
+
+float GlyphAtlas::GetOccupancy() {
+	return static_cast<float>(nextShelfY) / static_cast<float>(ATLAS_SIZE);
+}
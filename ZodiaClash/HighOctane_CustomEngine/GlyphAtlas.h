@@ -0,0 +1,102 @@
+/******************************************************************************
+*
+*	\copyright
+*		All content(C) 2023/2024 DigiPen Institute of Technology Singapore.
+*		All rights reserved. Reproduction or disclosure of this file or its
+*		contents without the prior written consent of DigiPen Institute of
+*		Technology is prohibited.
+*
+* *****************************************************************************
+*
+*	@file		GlyphAtlas.h
+*
+*	@author		agent
+*
+*	@email		agent\@local
+*
+*	@course		CSD 2401 - Software Engineering Project 3
+*				CSD 2451 - Software Engineering Project 4
+*
+*	@section	Section A
+*
+*	@date		19 October 2026
+*
+* *****************************************************************************
+*
+*	@brief		Dynamic glyph atlas
+*
+*   One GL_R8 texture shared by every font. Glyphs are rasterized through
+*   FreeType the first time a TextLabel asks for them and shelf-packed into
+*   the atlas. When the atlas is full, the least recently drawn shelf is
+*   evicted and its glyphs are rasterized again on their next use.
+*
+*   Optionally glyphs are rasterized as signed distance fields, drawn through
+*   the fontsdf renderer, which keeps text crisp at any relFontSize.
+*
+******************************************************************************/
+
+#pragma once
+#include "GraphLib.h"
+#include <vector>
+#include <cstdint>
+
+class Font; //forward declaration
+class Texture; //forward declaration
+
+// pixel height glyphs are rasterized at, relFontSize scales from this
+const int GLYPH_PIXEL_SIZE = 100;
+// FreeType's default SDF spread, in pixels
+const int GLYPH_SDF_SPREAD = 2;
+
+class GlyphAtlas {
+public:
+	static constexpr int ATLAS_SIZE = 2048;
+	static constexpr int GLYPH_PADDING = 1;
+
+	bool sdf{ false }; //rasterize glyphs as signed distance fields
+
+	// rasterizes glyph c of font into the atlas and fills font.characters[c]
+	// returns false if the font has no such glyph or there is no room for it
+	bool LoadGlyph(Font& font, unsigned char c);
+	// marks a shelf as drawn this frame so it is not evicted
+	void Touch(uint16_t shelf);
+	// advances the frame counter used for LRU eviction, call once per frame
+	void NewFrame();
+	// drops all glyphs, the atlas texture is recreated on next use
+	void Clear();
+
+	size_t GetGlyphCount();		//glyphs currently resident
+	size_t GetEvictionCount();	//shelves evicted since last Clear
+	float GetOccupancy();		//fraction of atlas rows assigned to shelves
+
+private:
+	struct Shelf {
+		int y{};
+		int height{};
+		int x{};
+		uint64_t lastUsed{};
+		std::vector<int> slots{};
+	};
+
+	struct Slot {
+		Font* font{};
+		unsigned char c{};
+		int shelf{ -1 };
+	};
+
+	Texture* GetTexture();
+	bool Pack(int w, int h, int& x, int& y, int& shelfIndex);
+	void EvictShelf(int shelfIndex);
+	int AllocateSlot();
+
+	Texture* texture{};
+	std::vector<Shelf> shelves{};
+	std::vector<Slot> slots{};
+	std::vector<int> freeSlots{};
+	int nextShelfY{};
+	uint64_t frame{ 1 };
+	size_t glyphCount{};
+	size_t evictions{};
+};
+
+extern GlyphAtlas glyphAtlas;
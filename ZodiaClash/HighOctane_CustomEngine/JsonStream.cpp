@@ -0,0 +1,278 @@
+/******************************************************************************
+*
+*	\copyright
+*		All content(C) 2023/2024 DigiPen Institute of Technology Singapore.
+*		All rights reserved. Reproduction or disclosure of this file or its
+*		contents without the prior written consent of DigiPen Institute of
+*		Technology is prohibited.
+*
+* *****************************************************************************
+*
+*	@file		JsonStream.cpp
+*
+*	@author		agent
+*
+*	@email		agent\@local
+*
+*	@course		CSD 2401 - Software Engineering Project 3
+*				CSD 2451 - Software Engineering Project 4
+*
+*	@section	Section A
+*
+*	@date		19 October 2026
+*
+* *****************************************************************************
+*
+*	@brief		Streaming reader for json files made of an array of entries
+*
+*	Definitions of the in place file reader, the SAX handler that builds one
+*	entry of the root array at a time, and the parse benchmark.
+*
+******************************************************************************/
+
+#include "JsonStream.h"
+#include <rapidjson-master/include/rapidjson/document.h>
+#include <rapidjson-master/include/rapidjson/reader.h>
+#include <rapidjson-master/include/rapidjson/istreamwrapper.h>
+#include <rapidjson-master/include/rapidjson/writer.h>
+#include <rapidjson-master/include/rapidjson/stringbuffer.h>
+#include "AssetManager.h"
+#include "AssetPack.h"
+#include "debugdiagnostic.h"
+#include <algorithm>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+
+namespace {
+	// Strings are unescaped into the file buffer and point into it instead of being copied
+	constexpr unsigned JSON_STREAM_FLAGS{ rapidjson::kParseInsituFlag };
+
+	/*!
+	 * \brief Passes the SAX events of one entry of the root array to a document
+	 *
+	 * The root array's own start and end are kept back, so the document only
+	 * ever sees one entry. depth is how far into the entry the reader is.
+	 *
+	 */
+	struct EntryHandler {
+		rapidjson::Document* target{};
+		int depth{};
+		bool rootStarted{};
+		bool rootEnded{};
+
+		//Values directly in the root array are entries of their own, anything before the array is not a valid file
+		bool InArray() { return rootStarted; }
+
+		bool Null() { return InArray() && target->Null(); }
+		bool Bool(bool b) { return InArray() && target->Bool(b); }
+		bool Int(int i) { return InArray() && target->Int(i); }
+		bool Uint(unsigned u) { return InArray() && target->Uint(u); }
+		bool Int64(int64_t i) { return InArray() && target->Int64(i); }
+		bool Uint64(uint64_t u) { return InArray() && target->Uint64(u); }
+		bool Double(double d) { return InArray() && target->Double(d); }
+		bool RawNumber(const char* str, rapidjson::SizeType length, bool copy) { return InArray() && target->RawNumber(str, length, copy); }
+		bool String(const char* str, rapidjson::SizeType length, bool copy) { return InArray() && target->String(str, length, copy); }
+		bool Key(const char* str, rapidjson::SizeType length, bool copy) { return target->Key(str, length, copy); }
+
+		bool StartObject() {
+			if (!InArray()) {
+				return false;
+			}
+			++depth;
+			return target->StartObject();
+		}
+
+		bool EndObject(rapidjson::SizeType memberCount) {
+			--depth;
+			return target->EndObject(memberCount);
+		}
+
+		bool StartArray() {
+			if (!rootStarted) {
+				rootStarted = true;
+				return true;
+			}
+			++depth;
+			return target->StartArray();
+		}
+
+		bool EndArray(rapidjson::SizeType elementCount) {
+			if (depth == 0) {
+				rootEnded = true;
+				return true;
+			}
+			--depth;
+			return target->EndArray(elementCount);
+		}
+	};
+
+	/*!
+	 * \brief Reads tokens into a document until one whole entry was read
+	 *
+	 * Returns false once the root array ends or on a parse error, in which
+	 * case the document is left as it was.
+	 *
+	 */
+	struct EntryGenerator {
+		rapidjson::Reader& reader;
+		rapidjson::InsituStringStream& stream;
+		EntryHandler& handler;
+
+		bool operator()(rapidjson::Document& document) {
+			handler.target = &document;
+			do {
+				if (!reader.IterativeParseNext<JSON_STREAM_FLAGS>(stream, handler)) {
+					return false;
+				}
+			} while (handler.depth > 0);
+			return !handler.rootEnded;
+		}
+	};
+
+	//Writes value as compact json text
+	std::string WriteJson(const rapidjson::Value& value) {
+		rapidjson::StringBuffer buffer;
+		rapidjson::Writer<rapidjson::StringBuffer> writer(buffer);
+		value.Accept(writer);
+		return std::string{ buffer.GetString(), buffer.GetSize() };
+	}
+}
+
+bool ReadJsonFile(const std::string& path, std::vector<char>& buffer) {
+	const unsigned char* packed{};
+	size_t packedSize{};
+	if (assetpack.Read(path, packed, packedSize)) {
+		buffer.assign(packed, packed + packedSize);
+		buffer.push_back('\0');
+		return true;
+	}
+	std::ifstream file(path, std::ios::binary | std::ios::ate);
+	if (!file.is_open()) {
+		return false;
+	}
+	std::streamoff size{ file.tellg() };
+	file.seekg(0);
+	buffer.resize(static_cast<size_t>(std::max<std::streamoff>(size, 0)) + 1);
+	file.read(buffer.data(), size);
+	buffer.resize(static_cast<size_t>(file.gcount()) + 1);
+	buffer.back() = '\0';
+	return true;
+}
+
+JsonReadResult ReadJsonArray(const std::string& path, const std::function<bool(const rapidjson::Value&)>& onEntry, JsonReadStats* stats) {
+	std::vector<char> buffer;
+	if (!ReadJsonFile(path, buffer)) {
+		return JsonReadResult::CANNOT_OPEN;
+	}
+	if (stats) {
+		*stats = JsonReadStats{};
+		stats->fileBytes = buffer.size() - 1;
+	}
+
+	rapidjson::InsituStringStream stream{ buffer.data() };
+	rapidjson::Reader reader;
+	EntryHandler handler;
+	reader.IterativeParseInit();
+	if (!reader.IterativeParseNext<JSON_STREAM_FLAGS>(stream, handler) || !handler.rootStarted) {
+		return JsonReadResult::PARSE_ERROR;
+	}
+
+	// Every entry is built with the same pool, emptied before the next one
+	rapidjson::MemoryPoolAllocator<> allocator;
+	rapidjson::Document entry{ &allocator };
+	EntryGenerator generator{ reader, stream, handler };
+	while (!handler.rootEnded) {
+		entry.SetNull();
+		allocator.Clear();
+		entry.Populate(generator);
+		if (reader.HasParseError()) {
+			return JsonReadResult::PARSE_ERROR;
+		}
+		if (handler.rootEnded) {
+			break;
+		}
+		if (stats) {
+			++stats->entries;
+			stats->peakEntryBytes = std::max(stats->peakEntryBytes, allocator.Size());
+		}
+		if (!onEntry(entry)) {
+			break;
+		}
+	}
+	return JsonReadResult::OK;
+}
+
+JsonParseBenchmarkResult RunJsonParseBenchmark(int repeats) {
+	using clock = std::chrono::high_resolution_clock;
+	JsonParseBenchmarkResult result{};
+	result.repeats = repeats;
+
+	std::vector<std::string> files;
+	std::pair<const char*, const char*> folders[]{ { "Scenes/", ".json" }, { "Prefabs/", ".prefab" } };
+	for (auto& [folder, extension] : folders) {
+		std::error_code error;
+		for (auto& entry : std::filesystem::directory_iterator(assetmanager.GetDefaultPath() + folder, error)) {
+			if (entry.path().extension() == extension) {
+				files.push_back(entry.path().string());
+			}
+		}
+	}
+	std::sort(files.begin(), files.end());
+
+	for (const std::string& path : files) {
+		// The way files were loaded before, the whole document from an ifstream
+		auto parseDocument = [&path](rapidjson::Document& document) {
+			std::ifstream file(path);
+			rapidjson::IStreamWrapper isw(file);
+			document.ParseStream(isw);
+		};
+
+		// Both must give the same entries, compared as text since some entities repeat a member name
+		JsonParseBenchmarkFile file{};
+		file.name = std::filesystem::path{ path }.filename().string();
+		JsonReadStats stats;
+		{
+			rapidjson::Document document;
+			parseDocument(document);
+			file.documentBytes = document.GetAllocator().Size();
+			rapidjson::SizeType index{};
+			ReadJsonArray(path, [&document, &index, &file](const rapidjson::Value& entry) {
+				if (!document.IsArray() || index >= document.Size() || WriteJson(document[index]) != WriteJson(entry)) {
+					++file.mismatches;
+				}
+				++index;
+				return true;
+			}, &stats);
+			if (document.IsArray() && index != document.Size()) {
+				++file.mismatches;
+			}
+		}
+		file.entries = stats.entries;
+		file.peakEntryBytes = stats.peakEntryBytes;
+		result.mismatches += file.mismatches;
+
+		double documentMs{};
+		double streamMs{};
+		for (int r = 0; r < repeats; ++r) {
+			auto start{ clock::now() };
+			{
+				rapidjson::Document document;
+				parseDocument(document);
+			}
+			documentMs += std::chrono::duration<double, std::milli>(clock::now() - start).count();
+
+			start = clock::now();
+			ReadJsonArray(path, [](const rapidjson::Value&) { return true; });
+			streamMs += std::chrono::duration<double, std::milli>(clock::now() - start).count();
+		}
+		file.documentMilliseconds = documentMs / repeats;
+		file.streamMilliseconds = streamMs / repeats;
+		result.documentMilliseconds += file.documentMilliseconds;
+		result.streamMilliseconds += file.streamMilliseconds;
+		result.files.push_back(file);
+	}
+	DEBUG_PRINT("Json parse benchmark: %zu files, document %.3f ms, stream %.3f ms, %zu entries differ",
+		result.files.size(), result.documentMilliseconds, result.streamMilliseconds, result.mismatches);
+	return result;
+}
@@ -0,0 +1,83 @@
+/******************************************************************************
+*
+*	\copyright
+*		All content(C) 2023/2024 DigiPen Institute of Technology Singapore.
+*		All rights reserved. Reproduction or disclosure of this file or its
+*		contents without the prior written consent of DigiPen Institute of
+*		Technology is prohibited.
+*
+* *****************************************************************************
+*
+*	@file		JsonStream.h
+*
+*	@author		agent
+*
+*	@email		agent\@local
+*
+*	@course		CSD 2401 - Software Engineering Project 3
+*				CSD 2451 - Software Engineering Project 4
+*
+*	@section	Section A
+*
+*	@date		19 October 2026
+*
+* *****************************************************************************
+*
+*	@brief		Streaming reader for json files made of an array of entries
+*
+*	Scenes, prefabs and the attack list are json arrays with one object per
+*	entity or attack. Instead of building a document of the whole file, the
+*	file is read into memory in one go and parsed in place one token at a
+*	time with rapidjson's iterative SAX reader. Each entry of the root array
+*	is built on its own into a small document whose pool is reused for the
+*	next entry, and strings point into the file buffer instead of being
+*	copied, so memory stays the size of the largest entry.
+*
+******************************************************************************/
+
+#pragma once
+#include <rapidjson-master/include/rapidjson/fwd.h>
+#include <functional>
+#include <string>
+#include <vector>
+
+enum class JsonReadResult {
+	OK,
+	CANNOT_OPEN,
+	PARSE_ERROR		//entries before the error were still passed on
+};
+
+struct JsonReadStats {
+	size_t fileBytes{};
+	size_t entries{};
+	size_t peakEntryBytes{};	//most pool memory a single entry used
+};
+
+//Reads the whole of path into buffer followed by a null, so it can be parsed in place. Returns false if it cannot be opened
+bool ReadJsonFile(const std::string& path, std::vector<char>& buffer);
+
+//Parses path, which must be a json array, calling onEntry with each entry in order. Stops early if onEntry returns false
+JsonReadResult ReadJsonArray(const std::string& path, const std::function<bool(const rapidjson::Value&)>& onEntry, JsonReadStats* stats = nullptr);
+
+//Average parse times of one file in RunJsonParseBenchmark
+struct JsonParseBenchmarkFile {
+	std::string name{};			//file name of the scene or prefab
+	size_t entries{};
+	double documentMilliseconds{};
+	size_t documentBytes{};		//allocated by the whole document
+	double streamMilliseconds{};
+	size_t peakEntryBytes{};	//allocated by the largest entry of the stream
+	size_t mismatches{};		//entries the stream read differently from the document
+};
+
+//Result of RunJsonParseBenchmark
+struct JsonParseBenchmarkResult {
+	int repeats{};
+	std::vector<JsonParseBenchmarkFile> files{};
+	double documentMilliseconds{};	//every file once
+	double streamMilliseconds{};
+	size_t mismatches{};
+};
+
+//Parses every shipped scene and prefab as a whole document and as a stream, checks they match and compares the times
+JsonParseBenchmarkResult RunJsonParseBenchmark(int repeats = 10);
@@ -70,7 +70,11 @@ void ThreadPool::WorkerFunction() {
             tasks.pop();
         }
         task(); // Execute the task
-        active_tasks--;
+        {
+            // Decrement under the lock so the main thread cannot miss the notification between checking and waiting
+            std::unique_lock<std::mutex> lock(queue_mutex);
+            active_tasks--;
+        }
         main_condition.notify_one(); // Notify main thread if necessary
     }
 }
@@ -139,6 +143,15 @@ void ThreadPool::WaitForAllTasks() {
         });
 }
 
+/******************************************************************************
+*
+*	@brief Number of worker threads in the Thread Pool
+*
+******************************************************************************/
+size_t ThreadPool::GetThreadCount() const {
+    return workers.size();
+}
+
 /******************************************************************************
 *
 *	@brief Joins and ends all threads in the Thread Pool
@@ -61,6 +61,9 @@ public:
     // Wait for all tasks to finish in the current cycle
     void WaitForAllTasks();
 
+    // Number of worker threads
+    size_t GetThreadCount() const;
+
     ~ThreadPool();
 
 private:
@@ -0,0 +1,137 @@
+/******************************************************************************
+*
+*	\copyright
+*		All content(C) 2023/2024 DigiPen Institute of Technology Singapore.
+*		All rights reserved. Reproduction or disclosure of this file or its
+*		contents without the prior written consent of DigiPen Institute of
+*		Technology is prohibited.
+*
+* *****************************************************************************
+*
+*	@file		Random.cpp
+*
+*	@author		agent
+*
+*	@email		agent\@local
+*
+*	@course		CSD 2401 - Software Engineering Project 3
+*				CSD 2451 - Software Engineering Project 4
+*
+*	@section	Section A
+*
+*	@date		19 October 2026
+*
+* *****************************************************************************
+*
+*	@brief		Random number service
+*
+*	Generator seeding, ranges and the per-system streams
+*
+******************************************************************************/
+
+#include "Random.h"
+#include "debugdiagnostic.h"
+#include <random>
+
+RandomService randomService;
+
+namespace {
+	uint64_t SplitMix(uint64_t& state) {
+		uint64_t z{ (state += 0x9E3779B97F4A7C15ull) };
+		z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+		z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+		return z ^ (z >> 31);
+	}
+
+	//FNV-1a, stable across platforms unlike std::hash
+	uint64_t HashName(std::string const& name) {
+		uint64_t hash{ 0xCBF29CE484222325ull };
+		for (char c : name) {
+			hash ^= static_cast<unsigned char>(c);
+			hash *= 0x100000001B3ull;
+		}
+		return hash;
+	}
+}
+
+void Xoshiro128::Seed(uint64_t seed) {
+	uint64_t mix{ seed };
+	uint64_t a{ SplitMix(mix) };
+	uint64_t b{ SplitMix(mix) };
+	state[0] = static_cast<uint32_t>(a);
+	state[1] = static_cast<uint32_t>(a >> 32);
+	state[2] = static_cast<uint32_t>(b);
+	state[3] = static_cast<uint32_t>(b >> 32);
+}
+
+/*!
+* \brief Uniform int
+*
+* Lemire's multiply and reject, unbiased without a division in the common case.
+*
+*/
+int Xoshiro128::RangeInt(int min, int max) {
+	if (max <= min) {
+		return min;
+	}
+	uint32_t range{ static_cast<uint32_t>(static_cast<int64_t>(max) - min) + 1 };
+	if (range == 0) {
+		return static_cast<int>((*this)());
+	}
+	uint64_t m{ static_cast<uint64_t>((*this)()) * range };
+	uint32_t low{ static_cast<uint32_t>(m) };
+	if (low < range) {
+		uint32_t threshold{ (0u - range) % range };
+		while (low < threshold) {
+			m = static_cast<uint64_t>((*this)()) * range;
+			low = static_cast<uint32_t>(m);
+		}
+	}
+	return static_cast<int>(min + static_cast<int64_t>(m >> 32));
+}
+
+void Xoshiro128::Fill(float* output, size_t count, float min, float max) {
+	const float scale{ (max - min) * (1.f / 16777216.f) };
+	for (size_t i = 0; i < count; ++i) {
+		output[i] = min + static_cast<float>((*this)() >> 8) * scale;
+	}
+}
+
+Xoshiro128 Xoshiro128::Split() {
+	uint64_t seed{ static_cast<uint64_t>((*this)()) << 32 };
+	seed |= (*this)();
+	return Xoshiro128{ seed };
+}
+
+RandomService::RandomService() {
+	session = (static_cast<uint64_t>(std::random_device{}()) << 32) | std::random_device{}();
+	SetSeed(session);
+}
+
+void RandomService::SetSeed(uint64_t newSeed) {
+	seed = newSeed;
+	for (size_t i = 0; i < static_cast<size_t>(RandomStream::COUNT); ++i) {
+		streams[i].Seed(seed ^ HashName(StreamName(static_cast<RandomStream>(i))));
+	}
+}
+
+void RandomService::NewScene(std::string const& sceneName) {
+	uint64_t mix{ session ^ HashName(sceneName) };
+	SetSeed(SplitMix(mix));
+	DEBUG_PRINT("Random seed for %s: %llu (session %llu)", sceneName.c_str(), static_cast<unsigned long long>(seed), static_cast<unsigned long long>(session));
+}
+
+const char* RandomService::StreamName(RandomStream stream) {
+	switch (stream) {
+	case RandomStream::COMBAT:
+		return "Combat";
+	case RandomStream::AI:
+		return "AI";
+	case RandomStream::PARTICLES:
+		return "Particles";
+	case RandomStream::AUDIO:
+		return "Audio";
+	default:
+		return "";
+	}
+}
@@ -0,0 +1,118 @@
+/******************************************************************************
+*
+*	\copyright
+*		All content(C) 2023/2024 DigiPen Institute of Technology Singapore.
+*		All rights reserved. Reproduction or disclosure of this file or its
+*		contents without the prior written consent of DigiPen Institute of
+*		Technology is prohibited.
+*
+* *****************************************************************************
+*
+*	@file		Random.h
+*
+*	@author		agent
+*
+*	@email		agent\@local
+*
+*	@course		CSD 2401 - Software Engineering Project 3
+*				CSD 2451 - Software Engineering Project 4
+*
+*	@section	Section A
+*
+*	@date		19 October 2026
+*
+* *****************************************************************************
+*
+*	@brief		Random number service
+*
+*	Every system draws its random numbers from its own named stream of the
+*	random service instead of seeding a std::mt19937 from std::random_device
+*	on each call. Streams are xoshiro128** generators, 16 bytes of state
+*	each and a few instructions per number. They are all reseeded from a
+*	single seed whenever a scene is loaded, so a battle or particle effect
+*	replays identically given the same seed and inputs, and streams do not
+*	disturb each other when one system draws more numbers than before.
+*
+******************************************************************************/
+
+#pragma once
+#include <cstdint>
+#include <cstddef>
+#include <limits>
+#include <string>
+
+//xoshiro128** generator, usable with the <random> distributions
+class Xoshiro128 {
+public:
+	using result_type = uint32_t;
+
+	Xoshiro128() { Seed(0); }
+	explicit Xoshiro128(uint64_t seed) { Seed(seed); }
+	//Expands a 64 bit seed into the state with splitmix64
+	void Seed(uint64_t seed);
+
+	static constexpr result_type min() { return 0; }
+	static constexpr result_type max() { return std::numeric_limits<result_type>::max(); }
+	result_type operator()() {
+		const uint32_t result{ Rotl(state[1] * 5, 7) * 9 };
+		const uint32_t t{ state[1] << 9 };
+		state[2] ^= state[0];
+		state[3] ^= state[1];
+		state[1] ^= state[2];
+		state[0] ^= state[3];
+		state[2] ^= t;
+		state[3] = Rotl(state[3], 11);
+		return result;
+	}
+
+	//Uniform float in [0, 1)
+	float Float() { return static_cast<float>((*this)() >> 8) * (1.f / 16777216.f); }
+	//Uniform float in [min, max)
+	float Range(float min, float max) { return min + (max - min) * Float(); }
+	//Uniform int in [min, max]
+	int RangeInt(int min, int max);
+	//True with the given chance
+	bool Chance(float chance) { return Float() < chance; }
+	//Fills count floats in [min, max), for spawning many particles at once
+	void Fill(float* output, size_t count, float min, float max);
+	//New generator seeded from this one, for giving a task its own sequence
+	Xoshiro128 Split();
+
+private:
+	static uint32_t Rotl(uint32_t x, int k) { return (x << k) | (x >> (32 - k)); }
+
+	uint32_t state[4]{};
+};
+
+//Systems with their own random sequence
+enum class RandomStream : uint8_t {
+	COMBAT,		//damage rolls, crits and skill procs
+	AI,			//AI move choice between equally good moves
+	PARTICLES,	//emitter spawn positions, velocities and textures
+	AUDIO,		//sound variations
+	COUNT
+};
+
+class RandomService {
+public:
+	RandomService();
+
+	//Reseeds every stream from a seed, each stream's sequence only depends on the seed and the stream
+	void SetSeed(uint64_t seed);
+	uint64_t GetSeed() const { return seed; }
+	//Seeds the streams for a newly loaded scene from the session seed and the scene name
+	void NewScene(std::string const& sceneName);
+	//Session seed, random per launch unless set for a replay
+	void SetSessionSeed(uint64_t sessionSeed) { session = sessionSeed; }
+	uint64_t GetSessionSeed() const { return session; }
+
+	Xoshiro128& Stream(RandomStream stream) { return streams[static_cast<size_t>(stream)]; }
+	static const char* StreamName(RandomStream stream);
+
+private:
+	Xoshiro128 streams[static_cast<size_t>(RandomStream::COUNT)]{};
+	uint64_t seed{};
+	uint64_t session{};
+};
+
+extern RandomService randomService;
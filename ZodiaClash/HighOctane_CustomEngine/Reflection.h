@@ -0,0 +1,203 @@
+/******************************************************************************
+*
+*	\copyright
+*		All content(C) 2023/2024 DigiPen Institute of Technology Singapore.
+*		All rights reserved. Reproduction or disclosure of this file or its
+*		contents without the prior written consent of DigiPen Institute of
+*		Technology is prohibited.
+*
+* *****************************************************************************
+*
+*	@file		Reflection.h
+*
+*	@author		agent
+*
+*	@email		agent\@local
+*
+*	@course		CSD 2401 - Software Engineering Project 3
+*				CSD 2451 - Software Engineering Project 4
+*
+*	@section	Section A
+*
+*	@date		19 October 2026
+*
+* *****************************************************************************
+*
+*	@brief		Compile time field lists of components
+*
+*	A component is reflected by specializing Reflect<T> with a constexpr
+*	tuple of its fields. Each field has the json key it is saved under, the
+*	hash of that key worked out at compile time, and the path of member
+*	pointers to the value (&Transform::position, &Vec2::x).
+*
+*	WriteFields and ReadFields save and load a component from that one
+*	list, so the keys written and read cannot drift apart. Reading goes
+*	over the members of the json object once and matches each key by its
+*	hash, instead of looking up every field by name.
+*
+*	Fields can be bool, int, unsigned, 64 bit integers, float, enums (saved
+*	as int), std::string and std::vector<std::string>.
+*
+******************************************************************************/
+
+#pragma once
+#include <rapidjson-master/include/rapidjson/document.h>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+#include <vector>
+
+//Fields of a component, specialized for every reflected component with a static constexpr tuple named fields
+template <typename T>
+struct Reflect;
+
+//FNV-1a hash of a json key
+constexpr std::uint32_t HashKey(std::string_view key) {
+	std::uint32_t hash{ 2166136261u };
+	for (char c : key) {
+		hash = (hash ^ static_cast<std::uint8_t>(c)) * 16777619u;
+	}
+	return hash;
+}
+
+/*!
+ * \brief One field of a reflected component
+ *
+ * path is the chain of member pointers from the component to the value.
+ *
+ */
+template <typename... Members>
+struct Field {
+	std::string_view name;
+	std::uint32_t hash;
+	std::tuple<Members...> path;
+};
+
+template <typename... Members>
+constexpr Field<Members...> MakeField(std::string_view name, Members... path) {
+	return Field<Members...>{ name, HashKey(name), std::tuple<Members...>{ path... } };
+}
+
+//Follows a chain of member pointers from object
+template <typename Object, typename Member, typename... Rest>
+constexpr auto& ResolveField(Object& object, Member member, Rest... rest) {
+	if constexpr (sizeof...(Rest) == 0) {
+		return object.*member;
+	}
+	else {
+		return ResolveField(object.*member, rest...);
+	}
+}
+
+//Returns the value of field in component
+template <typename T, typename... Members>
+constexpr auto& FieldOf(T& component, const Field<Members...>& field) {
+	return std::apply([&component](auto... members) -> auto& { return ResolveField(component, members...); }, field.path);
+}
+
+//Value a component is loaded from before its fields are read. Specialized where a missing field has a default of its own
+template <typename T>
+T LoadDefault() {
+	return T{};
+}
+
+//Converts a field value to json
+template <typename V>
+rapidjson::Value WriteFieldValue(const V& value, rapidjson::Document::AllocatorType& allocator) {
+	if constexpr (std::is_enum_v<V>) {
+		return rapidjson::Value(static_cast<int>(value));
+	}
+	else if constexpr (std::is_same_v<V, std::string>) {
+		return rapidjson::Value(value.c_str(), static_cast<rapidjson::SizeType>(value.length()), allocator);
+	}
+	else if constexpr (std::is_same_v<V, std::vector<std::string>>) {
+		rapidjson::Value array(rapidjson::kArrayType);
+		for (const std::string& entry : value) {
+			array.PushBack(rapidjson::Value(entry.c_str(), static_cast<rapidjson::SizeType>(entry.length()), allocator), allocator);
+		}
+		return array;
+	}
+	else if constexpr (std::is_same_v<V, bool> || std::is_same_v<V, int> || std::is_same_v<V, unsigned> || std::is_floating_point_v<V>) {
+		return rapidjson::Value(value);
+	}
+	else if constexpr (std::is_unsigned_v<V>) {
+		return rapidjson::Value(static_cast<std::uint64_t>(value));
+	}
+	else {
+		static_assert(std::is_signed_v<V>, "Field type cannot be reflected");
+		return rapidjson::Value(static_cast<std::int64_t>(value));
+	}
+}
+
+//Reads a field value from json, leaving it as it was if the json holds another type
+template <typename V>
+void ReadFieldValue(const rapidjson::Value& json, V& value) {
+	if constexpr (std::is_enum_v<V>) {
+		if (json.IsInt()) {
+			value = static_cast<V>(json.GetInt());
+		}
+	}
+	else if constexpr (std::is_same_v<V, std::string>) {
+		if (json.IsString()) {
+			value.assign(json.GetString(), json.GetStringLength());
+		}
+	}
+	else if constexpr (std::is_same_v<V, std::vector<std::string>>) {
+		if (json.IsArray()) {
+			value.clear();
+			for (const rapidjson::Value& entry : json.GetArray()) {
+				if (entry.IsString()) {
+					value.emplace_back(entry.GetString(), entry.GetStringLength());
+				}
+			}
+		}
+	}
+	else if constexpr (std::is_same_v<V, bool>) {
+		if (json.IsBool()) {
+			value = json.GetBool();
+		}
+	}
+	else if constexpr (std::is_floating_point_v<V>) {
+		if (json.IsNumber()) {
+			value = static_cast<V>(json.GetDouble());
+		}
+	}
+	else if constexpr (std::is_unsigned_v<V>) {
+		if (json.IsUint64()) {
+			value = static_cast<V>(json.GetUint64());
+		}
+	}
+	else {
+		if (json.IsInt64()) {
+			value = static_cast<V>(json.GetInt64());
+		}
+	}
+}
+
+//Saves the reflected fields of component as a json object
+template <typename T>
+rapidjson::Value WriteFields(const T& component, rapidjson::Document::AllocatorType& allocator) {
+	rapidjson::Value object(rapidjson::kObjectType);
+	std::apply([&component, &object, &allocator](const auto&... fields) {
+		(object.AddMember(rapidjson::StringRef(fields.name.data(), static_cast<rapidjson::SizeType>(fields.name.length())),
+			WriteFieldValue(FieldOf(component, fields), allocator), allocator), ...);
+	}, Reflect<T>::fields);
+	return object;
+}
+
+//Loads the reflected fields of component from a json object. Fields missing from it are left as they were
+template <typename T>
+void ReadFields(const rapidjson::Value& object, T& component) {
+	if (!object.IsObject()) {
+		return;
+	}
+	for (const auto& member : object.GetObject()) {
+		std::string_view key{ member.name.GetString(), member.name.GetStringLength() };
+		std::uint32_t hash{ HashKey(key) };
+		std::apply([&component, &member, &key, hash](const auto&... fields) {
+			(void)(((fields.hash == hash && fields.name == key) && (ReadFieldValue(member.value, FieldOf(component, fields)), true)) || ...);
+		}, Reflect<T>::fields);
+	}
+}
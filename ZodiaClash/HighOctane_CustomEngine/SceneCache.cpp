@@ -0,0 +1,1149 @@
+/******************************************************************************
+*
+*	\copyright
+*		All content(C) 2023/2024 DigiPen Institute of Technology Singapore.
+*		All rights reserved. Reproduction or disclosure of this file or its
+*		contents without the prior written consent of DigiPen Institute of
+*		Technology is prohibited.
+*
+* *****************************************************************************
+*
+*	@file		SceneCache.cpp
+*
+*	@author		agent
+*
+*	@email		agent\@local
+*
+*	@course		CSD 2401 - Software Engineering Project 3
+*				CSD 2451 - Software Engineering Project 4
+*
+*	@section	Section A
+*
+*	@date		19 October 2026
+*
+* *****************************************************************************
+*
+*	@brief		Cooked scene and prefab cache (.zscn)
+*
+*	Cooking, validation and loading of .zscn scene containers, and the
+*	scene load benchmark
+*
+******************************************************************************/
+
+#include "SceneCache.h"
+#include "Serialization.h"
+#include <rapidjson-master/include/rapidjson/document.h>
+#include <rapidjson-master/include/rapidjson/writer.h>
+#include <rapidjson-master/include/rapidjson/stringbuffer.h>
+#include "JsonStream.h"
+#include "EntityFactory.h"
+#include "AssetManager.h"
+#include "AssetPack.h"
+#include "CharacterStats.h"
+#include "model.h"
+#include "Global.h"
+#include "Layering.h"
+#include "Events.h"
+#include "File.h"
+#include "debugdiagnostic.h"
+
+#include <filesystem>
+#include <fstream>
+#include <cstring>
+#include <chrono>
+#include <algorithm>
+#include <unordered_map>
+#include <unordered_set>
+#include <type_traits>
+
+SceneCache scenecache;
+
+namespace {
+	const uint32_t ZSCN_VERSION{ 1 };
+	const uint32_t ZSCN_ALIGNMENT{ 16 };
+	const uint32_t NO_STRING{ 0xFFFFFFFF };
+
+	uint32_t Align(size_t offset) {
+		return static_cast<uint32_t>((offset + ZSCN_ALIGNMENT - 1) & ~static_cast<size_t>(ZSCN_ALIGNMENT - 1));
+	}
+
+	//How an entity of the file is created before its components are loaded
+	enum class CookedEntityKind : uint32_t {
+		PLAIN = 0,		//no Clone member
+		CLONE,			//Clone member without a prefab
+		PREFAB_CLONE	//clone of a prefab, with its unique components
+	};
+
+	struct CookedEntity {
+		uint32_t kind{};
+		uint32_t prefab{ NO_STRING };
+		uint32_t uniqueFirst{};		//first string list entry of the unique components
+		uint32_t uniqueCount{};
+	};
+
+	//Records of each block, the first member is always the index of the entity in the file
+
+	const uint32_t LAYER_COUNTER{ 1 };
+	const uint32_t GROUP_COUNTER{ 2 };
+	const uint32_t LAYER_NAMES{ 4 };
+
+	struct LayeringRecord {
+		uint32_t entity;
+		uint32_t flags;
+		uint64_t layerCounter;
+		uint64_t groupCounter;
+		uint32_t namesFirst;
+		uint32_t namesCount;
+	};
+
+	struct NameRecord {
+		uint32_t entity;
+		uint32_t name;
+		uint64_t layer;
+		uint64_t order;
+		uint32_t lock;
+		uint32_t skip;
+	};
+
+	struct ColorRecord {
+		uint32_t entity;
+		float r, g, b, a;
+	};
+
+	struct TransformRecord {
+		uint32_t entity;
+		float x, y, rotation, scale, velocityX, velocityY;
+	};
+
+	struct TextureRecord {
+		uint32_t entity;
+		uint32_t path;
+		uint32_t variant, rows, cols, spritenum;
+	};
+
+	struct VisibleRecord {
+		uint32_t entity;
+		uint32_t visible;
+	};
+
+	struct SizeRecord {
+		uint32_t entity;
+		float width, height;
+	};
+
+	struct CircleRecord {
+		uint32_t entity;
+		float radius;
+	};
+
+	struct CollisionRecord {
+		uint32_t entity;
+		float minX, minY, maxX, maxY, extentX, extentY;
+	};
+
+	//Master, MainCharacter, Movable and Temporary
+	struct TagRecord {
+		uint32_t entity;
+	};
+
+	const uint32_t MODEL_COLOR{ 1 };
+	const uint32_t MODEL_MIRROR{ 2 };
+
+	struct ModelRecord {
+		uint32_t entity;
+		int32_t type;
+		float scrollSpeed;
+		uint32_t flags;
+		float r, g, b, a;
+		uint32_t mirror;
+	};
+
+	const uint32_t COLLIDER_DIMENSION{ 1 };
+	const uint32_t COLLIDER_TYPE{ 2 };
+
+	struct ColliderRecord {
+		uint32_t entity;
+		int32_t shape;
+		uint32_t flags;
+		float dimensionX, dimensionY;
+		int32_t type;
+		uint32_t eventName;
+		uint32_t eventInput;
+	};
+
+	struct JsonRecord {
+		uint32_t entity;
+		uint32_t json;
+	};
+
+	const uint32_t HIERARCHY_PARENT{ 1 };
+	const uint32_t HIERARCHY_CHILD{ 2 };
+
+	struct HierarchyRecord {
+		uint32_t entity;
+		uint32_t flags;
+		float x, y, rotation, scale, velocityX, velocityY;	//offset from the parent
+	};
+
+	//Size of the records the loader expects in each block
+	uint32_t RecordSize(CookedComponent type) {
+		switch (type) {
+		case CookedComponent::LAYERING: return sizeof(LayeringRecord);
+		case CookedComponent::NAME: return sizeof(NameRecord);
+		case CookedComponent::COLOR: return sizeof(ColorRecord);
+		case CookedComponent::TRANSFORM: return sizeof(TransformRecord);
+		case CookedComponent::TEXTURE: return sizeof(TextureRecord);
+		case CookedComponent::VISIBLE: return sizeof(VisibleRecord);
+		case CookedComponent::SIZE: return sizeof(SizeRecord);
+		case CookedComponent::CIRCLE: return sizeof(CircleRecord);
+		case CookedComponent::COLLISION: return sizeof(CollisionRecord);
+		case CookedComponent::MODEL: return sizeof(ModelRecord);
+		case CookedComponent::COLLIDER: return sizeof(ColliderRecord);
+		case CookedComponent::JSON: return sizeof(JsonRecord);
+		case CookedComponent::HIERARCHY: return sizeof(HierarchyRecord);
+		case CookedComponent::MASTER:
+		case CookedComponent::MAIN_CHARACTER:
+		case CookedComponent::MOVABLE:
+		case CookedComponent::TEMPORARY:
+			return sizeof(TagRecord);
+		default:
+			return 0;
+		}
+	}
+
+	//Members of an entity object that have a block of their own, the rest are kept as json
+	const char* const COOKED_MEMBERS[]{
+		"Clone", "Entity", "Color", "Transform", "Texture", "Visible", "Size", "Circle", "Collision",
+		"Master", "MainCharacter", "Model", "Collider", "Movable", "Temporary", "Parent", "Child"
+	};
+
+	//Strings of a container, each stored once
+	class StringTable {
+	public:
+		uint32_t Add(const char* string) {
+			auto found{ indices.find(string) };
+			if (found != indices.end()) {
+				return found->second;
+			}
+			uint32_t index{ static_cast<uint32_t>(offsets.size()) };
+			offsets.push_back(static_cast<uint32_t>(characters.size()));
+			characters.insert(characters.end(), string, string + std::strlen(string) + 1);
+			indices.emplace(string, index);
+			return index;
+		}
+
+		std::vector<uint32_t> offsets{};
+		std::vector<char> characters{};
+
+	private:
+		std::unordered_map<std::string, uint32_t> indices{};
+	};
+
+	//Everything cooked from one json file before it is written
+	struct CookedScene {
+		StringTable strings{};
+		std::vector<CookedEntity> entities{};
+		std::vector<uint32_t> lists{};
+		std::vector<LayeringRecord> layering{};
+		std::vector<NameRecord> names{};
+		std::vector<ColorRecord> colors{};
+		std::vector<TransformRecord> transforms{};
+		std::vector<TextureRecord> textures{};
+		std::vector<VisibleRecord> visibles{};
+		std::vector<SizeRecord> sizes{};
+		std::vector<CircleRecord> circles{};
+		std::vector<CollisionRecord> collisions{};
+		std::vector<TagRecord> masters{};
+		std::vector<TagRecord> mainCharacters{};
+		std::vector<ModelRecord> models{};
+		std::vector<ColliderRecord> colliders{};
+		std::vector<TagRecord> movables{};
+		std::vector<TagRecord> temporaries{};
+		std::vector<JsonRecord> jsons{};
+		std::vector<HierarchyRecord> hierarchy{};
+	};
+
+	struct BlockData {
+		CookedComponent type;
+		uint32_t count;
+		uint32_t recordSize;
+		const void* records;
+	};
+
+	template <typename T>
+	void AddBlock(std::vector<BlockData>& blocks, CookedComponent type, const std::vector<T>& records) {
+		static_assert(std::is_trivially_copyable_v<T>, "Cooked records are written and read as raw bytes");
+		if (!records.empty()) {
+			blocks.push_back(BlockData{ type, static_cast<uint32_t>(records.size()), static_cast<uint32_t>(sizeof(T)), records.data() });
+		}
+	}
+
+	//Mirrors LoadLayeringData
+	void CookLayering(CookedScene& scene, const rapidjson::Value& layeringObject, uint32_t entity) {
+		LayeringRecord record{ entity, 0, 0, 0, static_cast<uint32_t>(scene.lists.size()), 0 };
+		if (layeringObject.HasMember("layerCounter")) {
+			record.flags |= LAYER_COUNTER;
+			record.layerCounter = layeringObject["layerCounter"].GetUint();
+		}
+		if (layeringObject.HasMember("groupCounter")) {
+			record.flags |= GROUP_COUNTER;
+			record.groupCounter = layeringObject["groupCounter"].GetUint();
+		}
+		if (layeringObject.HasMember("layerNames") && layeringObject["layerNames"].IsArray()) {
+			record.flags |= LAYER_NAMES;
+			for (const rapidjson::Value& layerName : layeringObject["layerNames"].GetArray()) {
+				if (layerName.IsString()) {
+					scene.lists.push_back(scene.strings.Add(layerName.GetString()));
+				}
+			}
+			record.namesCount = static_cast<uint32_t>(scene.lists.size()) - record.namesFirst;
+		}
+		scene.layering.push_back(record);
+	}
+
+	//Mirrors the entity creation of Serializer::LoadEntityFromJson and LoadEntityComponents
+	void CookEntity(CookedScene& scene, const rapidjson::Value& entityObject, uint32_t entity) {
+		StringTable& strings{ scene.strings };
+
+		CookedEntity cookedEntity{};
+		if (entityObject.HasMember("Clone")) {
+			const rapidjson::Value& cloneObject = entityObject["Clone"];
+			cookedEntity.kind = static_cast<uint32_t>(CookedEntityKind::CLONE);
+			if (cloneObject.HasMember("Prefab")) {
+				cookedEntity.kind = static_cast<uint32_t>(CookedEntityKind::PREFAB_CLONE);
+				cookedEntity.prefab = strings.Add(cloneObject["Prefab"].GetString());
+				cookedEntity.uniqueFirst = static_cast<uint32_t>(scene.lists.size());
+				for (const rapidjson::Value& componentName : cloneObject["Unique Components"].GetArray()) {
+					scene.lists.push_back(strings.Add(componentName.GetString()));
+				}
+				cookedEntity.uniqueCount = static_cast<uint32_t>(scene.lists.size()) - cookedEntity.uniqueFirst;
+			}
+		}
+		scene.entities.push_back(cookedEntity);
+
+		if (entityObject.HasMember("Entity")) {
+			const rapidjson::Value& nameObject = entityObject["Entity"];
+			Name defaults{};
+			NameRecord record{ entity, strings.Add(nameObject["Name"].GetString()), defaults.serializationLayer,
+				defaults.serializationOrderInLayer, defaults.lock, defaults.skip };
+			if (nameObject.HasMember("Current Layer")) {
+				record.layer = nameObject["Current Layer"].GetUint64();
+			}
+			if (nameObject.HasMember("Order in Layer")) {
+				record.order = nameObject["Order in Layer"].GetUint64();
+			}
+			if (nameObject.HasMember("isLocked")) {
+				record.lock = nameObject["isLocked"].GetBool();
+			}
+			if (nameObject.HasMember("isSkipped")) {
+				record.skip = nameObject["isSkipped"].GetBool();
+			}
+			scene.names.push_back(record);
+		}
+		if (entityObject.HasMember("Color")) {
+			const rapidjson::Value& colorObject = entityObject["Color"];
+			scene.colors.push_back(ColorRecord{ entity, colorObject["r"].GetFloat(), colorObject["g"].GetFloat(),
+				colorObject["b"].GetFloat(), colorObject["a"].GetFloat() });
+		}
+		if (entityObject.HasMember("Transform")) {
+			const rapidjson::Value& transformObject = entityObject["Transform"];
+			scene.transforms.push_back(TransformRecord{ entity, transformObject["position_x"].GetFloat(), transformObject["position_y"].GetFloat(),
+				transformObject["rotation"].GetFloat(), transformObject["scale"].GetFloat(),
+				transformObject["velocity_x"].GetFloat(), transformObject["velocity_y"].GetFloat() });
+		}
+		if (entityObject.HasMember("Texture")) {
+			const rapidjson::Value& texObject = entityObject["Texture"];
+			scene.textures.push_back(TextureRecord{ entity, strings.Add(texObject["Texture File Path"].GetString()),
+				texObject["Texture Index"].GetUint(), texObject["Rows"].GetUint(), texObject["Columns"].GetUint(), texObject["Sprite Number"].GetUint() });
+		}
+		if (entityObject.HasMember("Visible")) {
+			scene.visibles.push_back(VisibleRecord{ entity, entityObject["Visible"]["isVisible"].GetBool() });
+		}
+		if (entityObject.HasMember("Size")) {
+			const rapidjson::Value& sizeObject = entityObject["Size"];
+			scene.sizes.push_back(SizeRecord{ entity, sizeObject["width"].GetFloat(), sizeObject["height"].GetFloat() });
+		}
+		if (entityObject.HasMember("Circle")) {
+			scene.circles.push_back(CircleRecord{ entity, entityObject["Circle"]["radius"].GetFloat() });
+		}
+		if (entityObject.HasMember("Collision")) {
+			const rapidjson::Value& aabbObject = entityObject["Collision"];
+			scene.collisions.push_back(CollisionRecord{ entity, aabbObject["Min X"].GetFloat(), aabbObject["Min Y"].GetFloat(),
+				aabbObject["Max X"].GetFloat(), aabbObject["Max Y"].GetFloat(), aabbObject["Extent X"].GetFloat(), aabbObject["Extent Y"].GetFloat() });
+		}
+		if (entityObject.HasMember("Master")) {
+			scene.masters.push_back(TagRecord{ entity });
+		}
+		if (entityObject.HasMember("MainCharacter")) {
+			scene.mainCharacters.push_back(TagRecord{ entity });
+		}
+		if (entityObject.HasMember("Model")) {
+			const rapidjson::Value& modelObject = entityObject["Model"];
+			ModelRecord record{ entity, modelObject["Model type"].GetInt(), modelObject["Background scroll speed"].GetFloat(), 0, 0.f, 0.f, 0.f, 0.f, 0 };
+			if (modelObject.HasMember("Red")) {
+				record.flags |= MODEL_COLOR;
+				record.r = modelObject["Red"].GetFloat();
+				record.g = modelObject["Green"].GetFloat();
+				record.b = modelObject["Blue"].GetFloat();
+				record.a = modelObject["Alpha"].GetFloat();
+			}
+			if (modelObject.HasMember("Mirror")) {
+				record.flags |= MODEL_MIRROR;
+				record.mirror = modelObject["Mirror"].GetBool();
+			}
+			scene.models.push_back(record);
+		}
+		if (entityObject.HasMember("Collider")) {
+			const rapidjson::Value& colliderObject = entityObject["Collider"];
+			ColliderRecord record{ entity, colliderObject["Collider Enum"].GetInt(), 0, 0.f, 0.f, 0, NO_STRING, NO_STRING };
+			if (colliderObject.HasMember("Dimension X")) {
+				record.flags |= COLLIDER_DIMENSION;
+				record.dimensionX = colliderObject["Dimension X"].GetFloat();
+				record.dimensionY = colliderObject["Dimension Y"].GetFloat();
+			}
+			if (colliderObject.HasMember("Type")) {
+				record.flags |= COLLIDER_TYPE;
+				record.type = colliderObject["Type"].GetInt();
+				record.eventName = strings.Add(colliderObject["Event Name"].GetString());
+				record.eventInput = strings.Add(colliderObject["Event Input"].GetString());
+			}
+			scene.colliders.push_back(record);
+		}
+		if (entityObject.HasMember("Movable")) {
+			scene.movables.push_back(TagRecord{ entity });
+		}
+		if (entityObject.HasMember("Temporary")) {
+			scene.temporaries.push_back(TagRecord{ entity });
+		}
+		if (entityObject.HasMember("Parent") || entityObject.HasMember("Child")) {
+			HierarchyRecord record{ entity, 0, 0.f, 0.f, 0.f, 0.f, 0.f, 0.f };
+			if (entityObject.HasMember("Parent")) {
+				record.flags |= HIERARCHY_PARENT;
+			}
+			if (entityObject.HasMember("Child")) {
+				const rapidjson::Value& transformObject = entityObject["Child"];
+				record.flags |= HIERARCHY_CHILD;
+				record.x = transformObject["position_x"].GetFloat();
+				record.y = transformObject["position_y"].GetFloat();
+				record.rotation = transformObject["rotation"].GetFloat();
+				record.scale = transformObject["scale"].GetFloat();
+				record.velocityX = transformObject["velocity_x"].GetFloat();
+				record.velocityY = transformObject["velocity_y"].GetFloat();
+			}
+			scene.hierarchy.push_back(record);
+		}
+
+		//Everything else is kept as json text, loaded by the json loader on its own
+		rapidjson::Document remaining;
+		remaining.SetObject();
+		for (auto& member : entityObject.GetObject()) {
+			const char* memberName{ member.name.GetString() };
+			if (std::none_of(std::begin(COOKED_MEMBERS), std::end(COOKED_MEMBERS), [memberName](const char* cooked) { return std::strcmp(cooked, memberName) == 0; })) {
+				rapidjson::Value name{ member.name, remaining.GetAllocator() };
+				rapidjson::Value value{ member.value, remaining.GetAllocator() };
+				remaining.AddMember(name, value, remaining.GetAllocator());
+			}
+		}
+		if (remaining.MemberCount() > 0) {
+			rapidjson::StringBuffer buffer;
+			rapidjson::Writer<rapidjson::StringBuffer> writer(buffer);
+			remaining.Accept(writer);
+			scene.jsons.push_back(JsonRecord{ entity, strings.Add(buffer.GetString()) });
+		}
+	}
+
+	//Sets the component of an entity, adding it if the entity does not have one
+	template <typename T>
+	void Assign(Entity entity, T const& component) {
+		if (ECS::ecs().HasComponent<T>(entity)) {
+			ECS::ecs().GetComponent<T>(entity) = component;
+		}
+		else {
+			ECS::ecs().AddComponent<T>(entity, component);
+		}
+	}
+
+	//A validated container being loaded
+	class CookedView {
+	public:
+		CookedView(const unsigned char* data, const CookedSceneHeader& header) :
+			data{ data },
+			stringOffsets{ reinterpret_cast<const uint32_t*>(data + header.stringOffset) },
+			characters{ reinterpret_cast<const char*>(data + header.stringOffset) + header.stringCount * sizeof(uint32_t) },
+			lists{ reinterpret_cast<const uint32_t*>(data + header.listOffset) },
+			stringCount{ header.stringCount } {}
+
+		const char* String(uint32_t index) const {
+			return index < stringCount ? characters + stringOffsets[index] : "";
+		}
+
+		const uint32_t* List(uint32_t first) const {
+			return lists + first;
+		}
+
+		template <typename T>
+		const T* Records(const CookedBlock& block) const {
+			return reinterpret_cast<const T*>(data + block.offset);
+		}
+
+	private:
+		const unsigned char* data;
+		const uint32_t* stringOffsets;
+		const char* characters;
+		const uint32_t* lists;
+		uint32_t stringCount;
+	};
+
+	//Mirrors LoadLayeringData
+	void LoadLayering(const CookedView& view, const LayeringRecord& record) {
+		if (record.flags & LAYER_COUNTER) {
+			layerCounter = static_cast<size_t>(record.layerCounter);
+		}
+		if (record.flags & GROUP_COUNTER) {
+			groupCounter = static_cast<size_t>(record.groupCounter);
+		}
+		if ((record.flags & LAYER_NAMES) && layerNames.size() < layerCounter) {
+			layerNames.clear();
+			const uint32_t* names{ view.List(record.namesFirst) };
+			for (uint32_t i = 0; i < record.namesCount; ++i) {
+				layerNames.push_back(std::make_pair(std::string{ view.String(names[i]) }, true));
+			}
+		}
+	}
+}
+
+std::string SceneCache::GetCachePath(const std::string& sourcePath) {
+	//Assets/Scenes/name.json -> Assets/Cache/Scenes/name.zscn
+	std::filesystem::path source{ sourcePath };
+	std::filesystem::path folder{ source.parent_path() };
+	std::filesystem::path cachePath{ folder.parent_path() / "Cache" / folder.filename() / source.stem() };
+	cachePath += ".zscn";
+	return cachePath.string();
+}
+
+bool SceneCache::IsCooked(const std::string& sourcePath) {
+	uint64_t sourceTime{};
+	uint64_t sourceSize{};
+	if (!enabled || !GetSourceStamp(sourcePath, sourceTime, sourceSize)) {
+		return false;
+	}
+	std::ifstream file{ GetCachePath(sourcePath), std::ios::binary };
+	CookedSceneHeader header;
+	if (!file.read(reinterpret_cast<char*>(&header), sizeof(CookedSceneHeader))) {
+		return false;
+	}
+	return std::memcmp(header.magic, "ZSCN", 4) == 0 && header.version == ZSCN_VERSION
+		&& header.sourceTime == sourceTime && header.sourceSize == sourceSize;
+}
+
+bool SceneCache::GetSourceStamp(const std::string& sourcePath, uint64_t& time, uint64_t& size) {
+	// Packed files keep the stamp they had when packed
+	if (assetpack.GetStamp(sourcePath, time, size)) {
+		return true;
+	}
+	std::error_code error;
+	auto writeTime = std::filesystem::last_write_time(sourcePath, error);
+	if (error) {
+		return false;
+	}
+	auto fileSize = std::filesystem::file_size(sourcePath, error);
+	if (error) {
+		return false;
+	}
+	time = static_cast<uint64_t>(writeTime.time_since_epoch().count());
+	size = static_cast<uint64_t>(fileSize);
+	return true;
+}
+
+bool SceneCache::Load(const std::string& sourcePath, bool isPrefab, Entity& loaded) {
+	if (!enabled) {
+		return false;
+	}
+	if (!LoadContainer(sourcePath, isPrefab, loaded)) {
+		++misses;
+		return false;
+	}
+	++hits;
+	return true;
+}
+
+/*!
+* \brief Loads a container into the ECS
+*
+* The whole container is checked before any entity is created, so a stale
+* or damaged one falls back to the json without leaving half a scene
+* behind. Entities are created in file order, then each block is applied
+* in the order of CookedComponent, which is the order the json loader
+* reads the members of an entity in.
+*
+*/
+bool SceneCache::LoadContainer(const std::string& sourcePath, bool isPrefab, Entity& loaded) {
+	uint64_t sourceTime{};
+	uint64_t sourceSize{};
+	if (!GetSourceStamp(sourcePath, sourceTime, sourceSize)) {
+		return false;
+	}
+
+	MappedFile file;
+	if (!file.Open(GetCachePath(sourcePath)) || file.Size() < sizeof(CookedSceneHeader)) {
+		return false;
+	}
+
+	CookedSceneHeader header;
+	std::memcpy(&header, file.Data(), sizeof(CookedSceneHeader));
+	size_t fileSize{ file.Size() };
+	if (std::memcmp(header.magic, "ZSCN", 4) != 0 || header.version != ZSCN_VERSION
+		|| header.sourceTime != sourceTime || header.sourceSize != sourceSize
+		|| header.entityOffset + static_cast<size_t>(header.entityCount) * sizeof(CookedEntity) > fileSize
+		|| header.listOffset + static_cast<size_t>(header.listCount) * sizeof(uint32_t) > fileSize
+		|| header.blockOffset + static_cast<size_t>(header.blockCount) * sizeof(CookedBlock) > fileSize
+		|| header.stringOffset + static_cast<size_t>(header.stringCount) * sizeof(uint32_t) + header.stringSize > fileSize) {
+		return false;
+	}
+
+	const unsigned char* data{ file.Data() };
+	CookedView view{ data, header };
+
+	//Every string ends within the characters
+	const uint32_t* stringOffsets{ reinterpret_cast<const uint32_t*>(data + header.stringOffset) };
+	const char* characters{ reinterpret_cast<const char*>(stringOffsets + header.stringCount) };
+	if (header.stringCount > 0 && (header.stringSize == 0 || characters[header.stringSize - 1] != '\0')) {
+		return false;
+	}
+	for (uint32_t i = 0; i < header.stringCount; ++i) {
+		if (stringOffsets[i] >= header.stringSize) {
+			return false;
+		}
+	}
+
+	const CookedEntity* cookedEntities{ reinterpret_cast<const CookedEntity*>(data + header.entityOffset) };
+	for (uint32_t i = 0; i < header.entityCount; ++i) {
+		if (static_cast<size_t>(cookedEntities[i].uniqueFirst) + cookedEntities[i].uniqueCount > header.listCount) {
+			return false;
+		}
+	}
+
+	//Every block is of a known type with the record size of this build, and refers to entities of the file
+	const CookedBlock* blockTable{ reinterpret_cast<const CookedBlock*>(data + header.blockOffset) };
+	const CookedBlock* blocks[static_cast<size_t>(CookedComponent::COUNT)]{};
+	for (uint32_t i = 0; i < header.blockCount; ++i) {
+		const CookedBlock& block{ blockTable[i] };
+		if (block.type >= static_cast<uint32_t>(CookedComponent::COUNT) || blocks[block.type] != nullptr
+			|| block.recordSize != RecordSize(static_cast<CookedComponent>(block.type))
+			|| block.offset + static_cast<size_t>(block.count) * block.recordSize > fileSize) {
+			return false;
+		}
+		uint32_t lastEntity{ header.entityCount - (block.type == static_cast<uint32_t>(CookedComponent::LAYERING) ? 0 : 1) };
+		for (uint32_t r = 0; r < block.count; ++r) {
+			uint32_t entity;
+			std::memcpy(&entity, data + block.offset + static_cast<size_t>(r) * block.recordSize, sizeof(uint32_t));
+			if (entity > lastEntity || (header.entityCount == 0 && block.type != static_cast<uint32_t>(CookedComponent::LAYERING))) {
+				return false;
+			}
+		}
+		blocks[block.type] = &block;
+	}
+	const CookedBlock* layeringBlock{ blocks[static_cast<size_t>(CookedComponent::LAYERING)] };
+	if (layeringBlock != nullptr) {
+		const LayeringRecord* layering{ view.Records<LayeringRecord>(*layeringBlock) };
+		for (uint32_t r = 0; r < layeringBlock->count; ++r) {
+			if (static_cast<size_t>(layering[r].namesFirst) + layering[r].namesCount > header.listCount) {
+				return false;
+			}
+		}
+	}
+
+	//Entities, in file order with the layering data where it was in the file
+	std::vector<Entity> entities(header.entityCount);
+	const LayeringRecord* layering{ layeringBlock ? view.Records<LayeringRecord>(*layeringBlock) : nullptr };
+	uint32_t layeringCount{ layeringBlock ? layeringBlock->count : 0 };
+	uint32_t nextLayering{};
+	Entity entity{};
+	for (uint32_t i = 0; i < header.entityCount; ++i) {
+		while (nextLayering < layeringCount && layering[nextLayering].entity == i) {
+			LoadLayering(view, layering[nextLayering++]);
+		}
+
+		const CookedEntity& cookedEntity{ cookedEntities[i] };
+		entity = 0;
+		if (cookedEntity.kind == static_cast<uint32_t>(CookedEntityKind::PREFAB_CLONE)) {
+			std::string prefabName{ view.String(cookedEntity.prefab) };
+			Entity prefabID{ assetmanager.GetPrefab(prefabName) };
+			entity = EntityFactory::entityFactory().CloneMaster(prefabID);
+			Clone& cloneComponent{ ECS::ecs().GetComponent<Clone>(entity) };
+			cloneComponent.prefab = prefabName;
+			const uint32_t* uniqueComponents{ view.List(cookedEntity.uniqueFirst) };
+			for (uint32_t s = 0; s < cookedEntity.uniqueCount; ++s) {
+				cloneComponent.unique_components.insert(view.String(uniqueComponents[s]));
+			}
+		}
+		else if (cookedEntity.kind == static_cast<uint32_t>(CookedEntityKind::CLONE)) {
+			entity = ECS::ecs().CreateEntity();
+			(EntityFactory::entityFactory().cloneCounter)++;
+			ECS::ecs().AddComponent(entity, Clone{});
+		}
+		if (cookedEntity.kind != static_cast<uint32_t>(CookedEntityKind::PLAIN) && !stopButton) {
+			selectedLayer = std::numeric_limits<size_t>().max();
+		}
+
+		if (entity == 0) {
+			entity = ECS::ecs().CreateEntity();
+			(EntityFactory::entityFactory().cloneCounter)++;
+		}
+		entities[i] = entity;
+	}
+	while (nextLayering < layeringCount) {
+		LoadLayering(view, layering[nextLayering++]);
+	}
+
+	//Components, one block at a time
+	auto block = [&blocks](CookedComponent type) {
+		return blocks[static_cast<size_t>(type)];
+	};
+
+	if (const CookedBlock* names{ block(CookedComponent::NAME) }) {
+		const NameRecord* records{ view.Records<NameRecord>(*names) };
+		for (uint32_t r = 0; r < names->count; ++r) {
+			Name name{};
+			name.name = view.String(records[r].name);
+			name.serializationLayer = static_cast<size_t>(records[r].layer);
+			name.serializationOrderInLayer = static_cast<size_t>(records[r].order);
+			name.lock = records[r].lock != 0;
+			name.skip = records[r].skip != 0;
+			Assign(entities[records[r].entity], name);
+		}
+	}
+	if (const CookedBlock* colors{ block(CookedComponent::COLOR) }) {
+		const ColorRecord* records{ view.Records<ColorRecord>(*colors) };
+		for (uint32_t r = 0; r < colors->count; ++r) {
+			Color color{};
+			color.color = glm::vec4{ records[r].r, records[r].g, records[r].b, records[r].a };
+			Assign(entities[records[r].entity], color);
+		}
+	}
+	if (const CookedBlock* transforms{ block(CookedComponent::TRANSFORM) }) {
+		const TransformRecord* records{ view.Records<TransformRecord>(*transforms) };
+		for (uint32_t r = 0; r < transforms->count; ++r) {
+			Transform transform;
+			transform.position.x = records[r].x;
+			transform.position.y = records[r].y;
+			transform.rotation = records[r].rotation;
+			transform.scale = records[r].scale;
+			transform.velocity.x = records[r].velocityX;
+			transform.velocity.y = records[r].velocityY;
+			Assign(entities[records[r].entity], transform);
+		}
+	}
+	if (const CookedBlock* textures{ block(CookedComponent::TEXTURE) }) {
+		const TextureRecord* records{ view.Records<TextureRecord>(*textures) };
+		for (uint32_t r = 0; r < textures->count; ++r) {
+			Tex tex;
+			tex.texVariantIndex = records[r].variant;
+			tex.rows = records[r].rows;
+			tex.cols = records[r].cols;
+			tex.spritenum = records[r].spritenum;
+			Texture* texture = assetmanager.texture.Get(view.String(records[r].path));
+			if (texture) {
+				tex.tex = texture;
+			}
+			Assign(entities[records[r].entity], tex);
+		}
+	}
+	if (const CookedBlock* visibles{ block(CookedComponent::VISIBLE) }) {
+		const VisibleRecord* records{ view.Records<VisibleRecord>(*visibles) };
+		for (uint32_t r = 0; r < visibles->count; ++r) {
+			Assign(entities[records[r].entity], Visible{ records[r].visible != 0 });
+		}
+	}
+	if (const CookedBlock* sizes{ block(CookedComponent::SIZE) }) {
+		const SizeRecord* records{ view.Records<SizeRecord>(*sizes) };
+		for (uint32_t r = 0; r < sizes->count; ++r) {
+			Assign(entities[records[r].entity], Size{ records[r].width, records[r].height });
+		}
+	}
+	if (const CookedBlock* circles{ block(CookedComponent::CIRCLE) }) {
+		const CircleRecord* records{ view.Records<CircleRecord>(*circles) };
+		for (uint32_t r = 0; r < circles->count; ++r) {
+			Assign(entities[records[r].entity], Circle{ records[r].radius });
+		}
+	}
+	if (const CookedBlock* collisions{ block(CookedComponent::COLLISION) }) {
+		const CollisionRecord* records{ view.Records<CollisionRecord>(*collisions) };
+		for (uint32_t r = 0; r < collisions->count; ++r) {
+			AABB aabb;
+			aabb.min.x = records[r].minX;
+			aabb.min.y = records[r].minY;
+			aabb.max.x = records[r].maxX;
+			aabb.max.y = records[r].maxY;
+			aabb.extents.x = records[r].extentX;
+			aabb.extents.y = records[r].extentY;
+			Assign(entities[records[r].entity], aabb);
+		}
+	}
+	if (const CookedBlock* masters{ block(CookedComponent::MASTER) }) {
+		const TagRecord* records{ view.Records<TagRecord>(*masters) };
+		for (uint32_t r = 0; r < masters->count; ++r) {
+			Entity master{ entities[records[r].entity] };
+			if (!ECS::ecs().HasComponent<Master>(master)) {
+				ECS::ecs().AddComponent(master, Master{});
+				EntityFactory::entityFactory().masterEntitiesList[ECS::ecs().GetComponent<Name>(master).name] = master;
+				++(EntityFactory::entityFactory().masterCounter);
+			}
+		}
+	}
+	if (const CookedBlock* mainCharacters{ block(CookedComponent::MAIN_CHARACTER) }) {
+		const TagRecord* records{ view.Records<TagRecord>(*mainCharacters) };
+		for (uint32_t r = 0; r < mainCharacters->count; ++r) {
+			if (!ECS::ecs().HasComponent<MainCharacter>(entities[records[r].entity])) {
+				ECS::ecs().AddComponent(entities[records[r].entity], MainCharacter{});
+			}
+		}
+	}
+	if (const CookedBlock* models{ block(CookedComponent::MODEL) }) {
+		const ModelRecord* records{ view.Records<ModelRecord>(*models) };
+		for (uint32_t r = 0; r < models->count; ++r) {
+			Model model{ records[r].type, records[r].scrollSpeed };
+			if (records[r].flags & MODEL_COLOR) {
+				model.SetColor(records[r].r, records[r].g, records[r].b);
+				model.SetAlpha(records[r].a);
+			}
+			if (records[r].flags & MODEL_MIRROR) {
+				model.SetMirror(records[r].mirror != 0);
+			}
+			Assign(entities[records[r].entity], model);
+		}
+	}
+	if (const CookedBlock* colliders{ block(CookedComponent::COLLIDER) }) {
+		const ColliderRecord* records{ view.Records<ColliderRecord>(*colliders) };
+		for (uint32_t r = 0; r < colliders->count; ++r) {
+			Collider collider;
+			if (records[r].flags & COLLIDER_DIMENSION) {
+				collider.dimension.x = records[r].dimensionX;
+				collider.dimension.y = records[r].dimensionY;
+			}
+			collider.bodyShape = static_cast<Collider::SHAPE_ID>(records[r].shape);
+			if (records[r].flags & COLLIDER_TYPE) {
+				collider.type = static_cast<Collider::COLLISION_TYPE>(records[r].type);
+				collider.eventName = view.String(records[r].eventName);
+				collider.eventInput = view.String(records[r].eventInput);
+			}
+			Assign(entities[records[r].entity], collider);
+		}
+	}
+	if (const CookedBlock* movables{ block(CookedComponent::MOVABLE) }) {
+		const TagRecord* records{ view.Records<TagRecord>(*movables) };
+		for (uint32_t r = 0; r < movables->count; ++r) {
+			if (!ECS::ecs().HasComponent<Movable>(entities[records[r].entity])) {
+				ECS::ecs().AddComponent(entities[records[r].entity], Movable{});
+			}
+		}
+	}
+	if (const CookedBlock* temporaries{ block(CookedComponent::TEMPORARY) }) {
+		const TagRecord* records{ view.Records<TagRecord>(*temporaries) };
+		for (uint32_t r = 0; r < temporaries->count; ++r) {
+			ECS::ecs().AddComponent<Temporary>(entities[records[r].entity], Temporary{});
+		}
+	}
+	if (const CookedBlock* jsons{ block(CookedComponent::JSON) }) {
+		const JsonRecord* records{ view.Records<JsonRecord>(*jsons) };
+		for (uint32_t r = 0; r < jsons->count; ++r) {
+			Serializer::LoadComponentsFromJson(entities[records[r].entity], view.String(records[r].json));
+		}
+	}
+
+	//Children attach to the first parent of the file if it came before them, as in the json loader
+	Parent* parent{};
+	Entity parentID{};
+	if (const CookedBlock* hierarchy{ block(CookedComponent::HIERARCHY) }) {
+		const HierarchyRecord* records{ view.Records<HierarchyRecord>(*hierarchy) };
+		for (uint32_t r = 0; r < hierarchy->count; ++r) {
+			Entity current{ entities[records[r].entity] };
+			if ((records[r].flags & HIERARCHY_PARENT) && !ECS::ecs().HasComponent<Parent>(current) && parentID == 0) {
+				ECS::ecs().AddComponent<Parent>(current, Parent{});
+				parent = &ECS::ecs().GetComponent<Parent>(current);
+				parentID = current;
+			}
+			if ((records[r].flags & HIERARCHY_CHILD) && parent != nullptr) {
+				Transform transform;
+				transform.position.x = records[r].x;
+				transform.position.y = records[r].y;
+				transform.rotation = records[r].rotation;
+				transform.scale = records[r].scale;
+				transform.velocity.x = records[r].velocityX;
+				transform.velocity.y = records[r].velocityY;
+				ECS::ecs().AddComponent<Child>(current, Child{ parentID, transform });
+				parent->children.push_back(current);
+			}
+		}
+	}
+
+	if (!isPrefab) {
+		RebuildLayeringAfterDeserialization();
+		ExtractSkipLockAfterDeserialization();
+	}
+
+	if (isPrefab && ECS::ecs().HasComponent<Clone>(entity)) {
+		ECS::ecs().RemoveComponent<Clone>(entity);
+	}
+
+	loaded = (parentID == 0) ? entity : parentID;
+	return true;
+}
+
+struct SceneCooker::Scene {
+	CookedScene cooked;
+};
+
+SceneCooker::SceneCooker() : scene{ std::make_unique<Scene>() } {}
+
+SceneCooker::~SceneCooker() = default;
+
+void SceneCooker::Add(const rapidjson::Value& entry) {
+	if (!valid || !scenecache.enabled) {
+		return;
+	}
+	if (!entry.IsObject()) {
+		valid = false;
+		return;
+	}
+	CookedScene& cooked{ scene->cooked };
+	if (entry.HasMember("LayeringSystems")) {
+		CookLayering(cooked, entry["LayeringSystems"], static_cast<uint32_t>(cooked.entities.size()));
+	}
+	else {
+		CookEntity(cooked, entry, static_cast<uint32_t>(cooked.entities.size()));
+	}
+}
+
+void SceneCache::Cook(const std::string& sourcePath, const rapidjson::Document& document) {
+	if (!enabled || !document.IsArray()) {
+		return;
+	}
+	SceneCooker cooker;
+	for (const rapidjson::Value& entry : document.GetArray()) {
+		cooker.Add(entry);
+	}
+	Cook(sourcePath, cooker);
+}
+
+void SceneCache::Cook(const std::string& sourcePath, const SceneCooker& cooker) {
+	uint64_t sourceTime{};
+	uint64_t sourceSize{};
+	if (!enabled || !cooker.valid || !GetSourceStamp(sourcePath, sourceTime, sourceSize)) {
+		return;
+	}
+	const CookedScene& scene{ cooker.scene->cooked };
+
+	std::vector<BlockData> blocks;
+	AddBlock(blocks, CookedComponent::LAYERING, scene.layering);
+	AddBlock(blocks, CookedComponent::NAME, scene.names);
+	AddBlock(blocks, CookedComponent::COLOR, scene.colors);
+	AddBlock(blocks, CookedComponent::TRANSFORM, scene.transforms);
+	AddBlock(blocks, CookedComponent::TEXTURE, scene.textures);
+	AddBlock(blocks, CookedComponent::VISIBLE, scene.visibles);
+	AddBlock(blocks, CookedComponent::SIZE, scene.sizes);
+	AddBlock(blocks, CookedComponent::CIRCLE, scene.circles);
+	AddBlock(blocks, CookedComponent::COLLISION, scene.collisions);
+	AddBlock(blocks, CookedComponent::MASTER, scene.masters);
+	AddBlock(blocks, CookedComponent::MAIN_CHARACTER, scene.mainCharacters);
+	AddBlock(blocks, CookedComponent::MODEL, scene.models);
+	AddBlock(blocks, CookedComponent::COLLIDER, scene.colliders);
+	AddBlock(blocks, CookedComponent::MOVABLE, scene.movables);
+	AddBlock(blocks, CookedComponent::TEMPORARY, scene.temporaries);
+	AddBlock(blocks, CookedComponent::JSON, scene.jsons);
+	AddBlock(blocks, CookedComponent::HIERARCHY, scene.hierarchy);
+
+	CookedSceneHeader header;
+	header.version = ZSCN_VERSION;
+	header.sourceTime = sourceTime;
+	header.sourceSize = sourceSize;
+	header.entityCount = static_cast<uint32_t>(scene.entities.size());
+	header.entityOffset = Align(sizeof(CookedSceneHeader));
+	header.listCount = static_cast<uint32_t>(scene.lists.size());
+	header.listOffset = Align(header.entityOffset + scene.entities.size() * sizeof(CookedEntity));
+	header.blockCount = static_cast<uint32_t>(blocks.size());
+	header.blockOffset = Align(header.listOffset + scene.lists.size() * sizeof(uint32_t));
+
+	std::vector<CookedBlock> blockTable;
+	uint32_t offset{ Align(header.blockOffset + blocks.size() * sizeof(CookedBlock)) };
+	for (const BlockData& block : blocks) {
+		blockTable.push_back(CookedBlock{ static_cast<uint32_t>(block.type), block.count, block.recordSize, offset });
+		offset = Align(offset + static_cast<size_t>(block.count) * block.recordSize);
+	}
+	header.stringCount = static_cast<uint32_t>(scene.strings.offsets.size());
+	header.stringOffset = offset;
+	header.stringSize = static_cast<uint32_t>(scene.strings.characters.size());
+
+	std::string cachePath{ GetCachePath(sourcePath) };
+	std::string tempPath{ cachePath + ".tmp" };
+	std::error_code error;
+	std::filesystem::create_directories(std::filesystem::path{ cachePath }.parent_path(), error);
+	{
+		std::ofstream output{ tempPath, std::ios::binary | std::ios::trunc };
+		if (!output.is_open()) {
+			DEBUG_PRINT("Unable to write scene cache %s", cachePath.c_str());
+			return;
+		}
+		size_t position{};
+		auto write = [&output, &position](const void* bytes, size_t size) {
+			output.write(reinterpret_cast<const char*>(bytes), size);
+			position += size;
+		};
+		auto padTo = [&output, &position](size_t target) {
+			const char padding[ZSCN_ALIGNMENT]{};
+			output.write(padding, target - position);
+			position = target;
+		};
+		write(&header, sizeof(CookedSceneHeader));
+		padTo(header.entityOffset);
+		write(scene.entities.data(), scene.entities.size() * sizeof(CookedEntity));
+		padTo(header.listOffset);
+		write(scene.lists.data(), scene.lists.size() * sizeof(uint32_t));
+		padTo(header.blockOffset);
+		write(blockTable.data(), blockTable.size() * sizeof(CookedBlock));
+		for (size_t i = 0; i < blocks.size(); ++i) {
+			padTo(blockTable[i].offset);
+			write(blocks[i].records, static_cast<size_t>(blocks[i].count) * blocks[i].recordSize);
+		}
+		padTo(header.stringOffset);
+		write(scene.strings.offsets.data(), scene.strings.offsets.size() * sizeof(uint32_t));
+		write(scene.strings.characters.data(), scene.strings.characters.size());
+	}
+	std::filesystem::rename(tempPath, cachePath, error);
+	if (error) {
+		std::filesystem::remove(tempPath, error);
+	}
+}
+
+bool SceneCache::CookFile(const std::string& sourcePath) {
+	SceneCooker cooker;
+	JsonReadResult result{ ReadJsonArray(sourcePath, [&cooker](const rapidjson::Value& entry) {
+		cooker.Add(entry);
+		return true;
+	}) };
+	if (result == JsonReadResult::CANNOT_OPEN) {
+		return false;
+	}
+	if (result == JsonReadResult::PARSE_ERROR) {
+		DEBUG_PRINT("Unable to cook %s, it is not valid json", sourcePath.c_str());
+		return false;
+	}
+	Cook(sourcePath, cooker);
+	return std::filesystem::exists(GetCachePath(sourcePath));
+}
+
+void SceneCache::CookAll() {
+	size_t cooked{};
+	size_t failed{};
+	std::pair<const char*, const char*> folders[]{ { "Scenes/", ".json" }, { "Prefabs/", ".prefab" } };
+	for (auto& [folder, extension] : folders) {
+		std::error_code error;
+		for (auto& entry : std::filesystem::directory_iterator(assetmanager.GetDefaultPath() + folder, error)) {
+			if (entry.path().extension() == extension) {
+				CookFile(entry.path().string()) ? ++cooked : ++failed;
+			}
+		}
+	}
+	DEBUG_PRINT("Scene cache: cooked %zu scenes and prefabs, %zu could not be cooked", cooked, failed);
+}
+
+void SceneCache::ResetStats() {
+	hits = 0;
+	misses = 0;
+}
+
+size_t SceneCache::GetHits() {
+	return hits;
+}
+
+size_t SceneCache::GetMisses() {
+	return misses;
+}
+
+/*!
+* \brief Scene load benchmark
+*
+* Loads every scene under Assets/Scenes/ repeats times from its json and
+* repeats times from its container, destroying the entities it made after
+* each load. A first load of each scene loads the prefabs and textures it
+* uses and cooks it, so both formats are timed with the same assets
+* resident. The current scene is reloaded afterwards.
+*
+*/
+SceneLoadBenchmarkResult RunSceneLoadBenchmark(int repeats) {
+	using clock = std::chrono::high_resolution_clock;
+	SceneLoadBenchmarkResult result{};
+	result.repeats = repeats;
+
+	std::vector<std::string> scenes;
+	std::error_code error;
+	for (auto& entry : std::filesystem::directory_iterator(assetmanager.GetDefaultPath() + "Scenes/", error)) {
+		if (entry.path().extension() == ".json") {
+			scenes.push_back(entry.path().string());
+		}
+	}
+	std::sort(scenes.begin(), scenes.end());
+
+	//Scenes are made of clones, so unloading one destroys the clones it added
+	ComponentArray<Clone>& cloneArray{ ECS::ecs().GetComponentManager().GetComponentArrayRef<Clone>() };
+	std::vector<Entity> existingArray{ cloneArray.GetEntityArray() };
+	std::unordered_set<Entity> existing{ existingArray.begin(), existingArray.end() };
+	auto unload = [&cloneArray, &existing]() {
+		size_t count{};
+		for (Entity entity : cloneArray.GetEntityArray()) {
+			if (existing.count(entity) == 0) {
+				EntityFactory::entityFactory().DeleteCloneModel(entity);
+				++count;
+			}
+		}
+		EntityFactory::entityFactory().UpdateDeletion();
+		return count;
+	};
+
+	bool wasEnabled{ scenecache.enabled };
+	for (const std::string& scene : scenes) {
+		scenecache.enabled = true;
+		Serializer::LoadEntityFromJson(scene);
+		SceneLoadBenchmarkScene load{};
+		load.name = std::filesystem::path{ scene }.filename().string();
+		load.entities = unload();
+
+		double jsonMs{};
+		double cookedMs{};
+		scenecache.ResetStats();
+		for (int r = 0; r < repeats; ++r) {
+			scenecache.enabled = false;
+			auto start{ clock::now() };
+			Serializer::LoadEntityFromJson(scene);
+			jsonMs += std::chrono::duration<double, std::milli>(clock::now() - start).count();
+			unload();
+
+			scenecache.enabled = true;
+			start = clock::now();
+			Serializer::LoadEntityFromJson(scene);
+			cookedMs += std::chrono::duration<double, std::milli>(clock::now() - start).count();
+			unload();
+		}
+		load.jsonMilliseconds = jsonMs / repeats;
+		load.cookedMilliseconds = cookedMs / repeats;
+		load.cooked = scenecache.GetHits() == static_cast<size_t>(repeats);
+		result.jsonMilliseconds += load.jsonMilliseconds;
+		result.cookedMilliseconds += load.cookedMilliseconds;
+
+		std::error_code sizeError;
+		load.jsonBytes = std::filesystem::file_size(scene, sizeError);
+		load.cookedBytes = std::filesystem::file_size(scenecache.GetCachePath(scene), sizeError);
+		if (sizeError) {
+			load.cookedBytes = 0;
+		}
+		result.scenes.push_back(load);
+	}
+	DEBUG_PRINT("Scene load benchmark: %zu scenes, json %.3f ms, cooked %.3f ms", result.scenes.size(), result.jsonMilliseconds, result.cookedMilliseconds);
+	scenecache.enabled = wasEnabled;
+	scenecache.ResetStats();
+
+	if (!sceneName.empty()) {
+		events.Call("Change Scene", sceneName);
+	}
+	return result;
+}
@@ -0,0 +1,172 @@
+/******************************************************************************
+*
+*	\copyright
+*		All content(C) 2023/2024 DigiPen Institute of Technology Singapore.
+*		All rights reserved. Reproduction or disclosure of this file or its
+*		contents without the prior written consent of DigiPen Institute of
+*		Technology is prohibited.
+*
+* *****************************************************************************
+*
+*	@file		SceneCache.h
+*
+*	@author		agent
+*
+*	@email		agent\@local
+*
+*	@course		CSD 2401 - Software Engineering Project 3
+*				CSD 2451 - Software Engineering Project 4
+*
+*	@section	Section A
+*
+*	@date		19 October 2026
+*
+* *****************************************************************************
+*
+*	@brief		Cooked scene and prefab cache (.zscn)
+*
+*	Scenes and prefabs are authored as json. Loading one parses every entity
+*	and looks up each of its members by name. Whenever a
+*	json file is loaded or saved it is also cooked into a binary .zscn
+*	container under Assets/Cache/, which later loads memory map and read
+*	without parsing.
+*
+*	Container layout:
+*	[CookedSceneHeader][entities][string lists][CookedBlock x blockCount]
+*	[records of each block][string offsets][string characters]
+*
+*	Each block holds the records of one component type, in the order of
+*	the entities of the file. Strings are stored once and referred to by
+*	their index. Components with nested data (animation sets, dialogue,
+*	text labels, buttons, stats...) are kept in a JSON block as the json
+*	text of their members and loaded by the json loader on their own.
+*
+*	A container is only used if its version matches ZSCN_VERSION, each block
+*	has the record size the loader expects, and the source file's size and
+*	last write time match what was recorded when it was cooked, otherwise
+*	the json is loaded and cooked again.
+*
+******************************************************************************/
+
+#pragma once
+#include "ECS.h"
+#include <rapidjson-master/include/rapidjson/fwd.h>
+#include <memory>
+#include <string>
+#include <cstdint>
+#include <vector>
+
+//Component types of the blocks of a cooked scene, loaded in this order
+enum class CookedComponent : uint32_t {
+	LAYERING = 0,	//layer names and counters, its entity is the number of entities loaded before it
+	NAME,
+	COLOR,
+	TRANSFORM,
+	TEXTURE,
+	VISIBLE,
+	SIZE,
+	CIRCLE,
+	COLLISION,
+	MASTER,
+	MAIN_CHARACTER,
+	MODEL,
+	COLLIDER,
+	MOVABLE,
+	TEMPORARY,
+	JSON,			//members without a block of their own, as json text
+	HIERARCHY,		//Parent and Child members
+	COUNT
+};
+
+struct CookedSceneHeader {
+	char magic[4]{ 'Z','S','C','N' };
+	uint32_t version{};
+	uint64_t sourceTime{};		//last write time of the source json when cooked
+	uint64_t sourceSize{};		//file size of the source json when cooked
+	uint32_t entityCount{};		//entities in the order of the source file
+	uint32_t entityOffset{};	//byte offset of the entity array
+	uint32_t listCount{};
+	uint32_t listOffset{};		//byte offset of the string lists, arrays of string indices
+	uint32_t blockCount{};
+	uint32_t blockOffset{};		//byte offset of the CookedBlock array
+	uint32_t stringCount{};
+	uint32_t stringOffset{};	//byte offset of the string offsets, followed by the characters
+	uint32_t stringSize{};		//bytes of characters, each string ends with a null
+};
+
+struct CookedBlock {
+	uint32_t type{};			//CookedComponent
+	uint32_t count{};			//number of records
+	uint32_t recordSize{};		//bytes per record, checked against the loader's record
+	uint32_t offset{};			//byte offset of the first record
+};
+
+//Cooks the entries of a json file one at a time while a streaming loader parses it
+class SceneCooker {
+public:
+	SceneCooker();
+	~SceneCooker();
+	//Cooks the next entry of the file
+	void Add(const rapidjson::Value& entry);
+
+private:
+	friend class SceneCache;
+	struct Scene;
+	std::unique_ptr<Scene> scene;
+	bool valid{ true };	//false once an entry that cannot be cooked was added
+};
+
+class SceneCache {
+public:
+	bool enabled{ true };	//when false scenes and prefabs are always parsed from json
+
+	//Loads the cached copy of sourcePath the way Serializer::LoadEntityFromJson would. Returns false if no valid cache exists
+	bool Load(const std::string& sourcePath, bool isPrefab, Entity& loaded);
+	//Cooks the parsed json of sourcePath into a container
+	void Cook(const std::string& sourcePath, const rapidjson::Document& document);
+	//Writes the entries cooker was given while sourcePath was parsed into a container
+	void Cook(const std::string& sourcePath, const SceneCooker& cooker);
+	//Parses and cooks sourcePath, returns false if it could not be cooked
+	bool CookFile(const std::string& sourcePath);
+	//Cooks every scene and prefab under the asset folder
+	void CookAll();
+	//Returns true if sourcePath has a container cooked from its current version. Only reads files, so worker threads may call it
+	bool IsCooked(const std::string& sourcePath);
+	//Returns the container path used for sourcePath
+	std::string GetCachePath(const std::string& sourcePath);
+
+	void ResetStats();
+	size_t GetHits();	//files loaded from their container since last ResetStats
+	size_t GetMisses();	//files parsed from json since last ResetStats
+
+private:
+	bool LoadContainer(const std::string& sourcePath, bool isPrefab, Entity& loaded);
+	bool GetSourceStamp(const std::string& sourcePath, uint64_t& time, uint64_t& size);
+
+	size_t hits{};
+	size_t misses{};
+};
+
+extern SceneCache scenecache;
+
+//Average load times of one scene in RunSceneLoadBenchmark
+struct SceneLoadBenchmarkScene {
+	std::string name{};				//file name of the scene
+	size_t entities{};
+	double jsonMilliseconds{};
+	uintmax_t jsonBytes{};
+	double cookedMilliseconds{};
+	uintmax_t cookedBytes{};		//0 if the scene has no container
+	bool cooked{};					//every cooked load came from the container
+};
+
+//Result of RunSceneLoadBenchmark
+struct SceneLoadBenchmarkResult {
+	int repeats{};
+	std::vector<SceneLoadBenchmarkScene> scenes{};
+	double jsonMilliseconds{};		//every scene once
+	double cookedMilliseconds{};
+};
+
+//Loads every shipped scene from json and from its container, and compares the load times
+SceneLoadBenchmarkResult RunSceneLoadBenchmark(int repeats = 10);
@@ -0,0 +1,207 @@
+/******************************************************************************
+*
+*	\copyright
+*		All content(C) 2023/2024 DigiPen Institute of Technology Singapore.
+*		All rights reserved. Reproduction or disclosure of this file or its
+*		contents without the prior written consent of DigiPen Institute of
+*		Technology is prohibited.
+*
+* *****************************************************************************
+*
+*	@file		SceneSaver.cpp
+*
+*	@author		agent
+*
+*	@email		agent\@local
+*
+*	@course		CSD 2401 - Software Engineering Project 3
+*				CSD 2451 - Software Engineering Project 4
+*
+*	@section	Section A
+*
+*	@date		19 October 2026
+*
+* *****************************************************************************
+*
+*	@brief		Incremental scene saving and autosave
+*
+*	Definitions of SceneSaver.
+*
+******************************************************************************/
+
+#include "SceneSaver.h"
+#include "Serialization.h"
+#include "SceneCache.h"
+#include "AssetPack.h"
+#include "AssetManager.h"
+#include "Layering.h"
+#include "Global.h"
+#include "debugdiagnostic.h"
+#include <rapidjson-master/include/rapidjson/document.h>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <limits>
+
+SceneSaver sceneSaver;
+
+namespace {
+	//Writes text to a temporary file next to path, then renames it over path
+	bool WriteFileAtomically(const std::string& path, const std::string& text) {
+		std::string tempPath{ path + ".tmp" };
+		{
+			std::ofstream output{ tempPath, std::ios::binary | std::ios::trunc };
+			if (!output.is_open()) {
+				return false;
+			}
+			output.write(text.data(), text.size());
+			if (!output) {
+				return false;
+			}
+		}
+		std::error_code error;
+		std::filesystem::rename(tempPath, path, error);
+		if (error) {
+			std::filesystem::remove(tempPath, error);
+			return false;
+		}
+		return true;
+	}
+}
+
+void SceneSaver::Save(const std::string& fileName, const std::vector<Entity>& entities, bool isAutosave) {
+	using clock = std::chrono::high_resolution_clock;
+
+	// Only one save is written at a time
+	Wait();
+	// The scene is read from the Assets folder from now on, not from the pack
+	assetpack.Evict(fileName);
+	auto snapshotStart{ clock::now() };
+
+	PrepareLayeringForSerialization();
+	EmbedSkipLockForSerialization();
+	std::vector<std::shared_ptr<const std::string>> entries{ std::make_shared<const std::string>(Serializer::WriteLayeringJson()) };
+
+	// On autosaves, entities that did not change and did not move in the layers keep the text they were last saved with
+	ComponentArray<Name>& nameArray{ ECS::ecs().GetComponentManager().GetComponentArrayRef<Name>() };
+	std::unordered_map<Entity, SavedEntity> current{};
+	size_t serialized{};
+	std::string json{};
+	for (Entity entity : entities) {
+		SavedEntity entry{};
+		if (nameArray.HasComponent(entity)) {
+			Name& name{ nameArray.GetData(entity) };
+			entry.layer = name.serializationLayer;
+			entry.orderInLayer = name.serializationOrderInLayer;
+			entry.skip = name.skip;
+			entry.lock = name.lock;
+		}
+		auto previous{ saved.find(entity) };
+		if (isAutosave && previous != saved.end() && !ECS::ecs().IsChanged(entity) && previous->second.layer == entry.layer
+			&& previous->second.orderInLayer == entry.orderInLayer && previous->second.skip == entry.skip && previous->second.lock == entry.lock) {
+			entry.json = previous->second.json;
+		}
+		else {
+			++serialized;
+			if (Serializer::WriteEntityJson(entity, json)) {
+				entry.json = std::make_shared<const std::string>(json);
+			}
+		}
+		// Entities that are not saved in scene files are remembered without text, so they are not checked again until they change
+		if (entry.json) {
+			entries.push_back(entry.json);
+		}
+		current[entity] = entry;
+	}
+	saved = std::move(current);
+	ECS::ecs().ClearChanged();
+	if (!isAutosave) {
+		selectedLayer = std::numeric_limits<size_t>().max();
+	}
+
+	SceneSaveStats stats{};
+	stats.file = fileName;
+	stats.entities = entries.size() - 1;
+	stats.serialized = serialized;
+	stats.snapshotMilliseconds = std::chrono::duration<double, std::milli>(clock::now() - snapshotStart).count();
+	stats.autosave = isAutosave;
+	{
+		std::lock_guard<std::mutex> lock{ statsMutex };
+		lastSave = stats;
+	}
+
+	// Autosaves are never loaded, so they are not cooked
+	bool cook{ !isAutosave };
+	writing = std::async(std::launch::async, [this, fileName, entries{ std::move(entries) }, cook]() {
+		using clock = std::chrono::high_resolution_clock;
+		auto writeStart{ clock::now() };
+		size_t length{ 4 };
+		for (auto& entry : entries) {
+			length += entry->size() + 2;
+		}
+		std::string text{ "[" };
+		text.reserve(length);
+		for (size_t i = 0; i < entries.size(); ++i) {
+			text += i == 0 ? "\n" : ",\n";
+			text += *entries[i];
+		}
+		text += "\n]\n";
+
+		bool written{ WriteFileAtomically(fileName, text) };
+		if (written && cook && scenecache.enabled) {
+			rapidjson::Document document;
+			document.ParseInsitu(text.data());
+			if (!document.HasParseError()) {
+				scenecache.Cook(fileName, document);
+			}
+		}
+
+		double writeMilliseconds{ std::chrono::duration<double, std::milli>(clock::now() - writeStart).count() };
+		{
+			std::lock_guard<std::mutex> lock{ statsMutex };
+			if (lastSave.file == fileName) {
+				lastSave.writeMilliseconds = writeMilliseconds;
+			}
+		}
+		if (written) {
+			std::cout << "Entity saved to " << fileName << std::endl;
+		}
+		else {
+			std::cerr << "Failed to open file: " << fileName << std::endl;
+		}
+	});
+	DEBUG_PRINT("Saving %s: %zu entities, %zu serialized in %.2f ms", fileName.c_str(), stats.entities, serialized, stats.snapshotMilliseconds);
+}
+
+void SceneSaver::Update(float dt) {
+	if (!autosave || GetCurrentSystemMode() != SystemMode::EDIT || sceneName.empty()) {
+		return;
+	}
+	autosaveTimer += dt;
+	if (autosaveTimer < autosaveInterval || IsWriting()) {
+		return;
+	}
+	autosaveTimer = 0.f;
+
+	std::string folder{ assetmanager.GetDefaultPath() + "Scenes/Autosave/" };
+	std::error_code error;
+	std::filesystem::create_directories(folder, error);
+	std::vector<Entity> entities{ s_ptr->m_Entities.begin(), s_ptr->m_Entities.end() };
+	Save(folder + sceneName.substr(0, sceneName.find(".scn")) + ".json", entities, true);
+}
+
+void SceneSaver::Wait() {
+	if (writing.valid()) {
+		writing.get();
+	}
+}
+
+bool SceneSaver::IsWriting() {
+	return writing.valid() && writing.wait_for(std::chrono::seconds(0)) != std::future_status::ready;
+}
+
+SceneSaveStats SceneSaver::GetLastSave() {
+	std::lock_guard<std::mutex> lock{ statsMutex };
+	return lastSave;
+}
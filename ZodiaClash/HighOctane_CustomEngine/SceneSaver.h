@@ -0,0 +1,96 @@
+/******************************************************************************
+*
+*	\copyright
+*		All content(C) 2023/2024 DigiPen Institute of Technology Singapore.
+*		All rights reserved. Reproduction or disclosure of this file or its
+*		contents without the prior written consent of DigiPen Institute of
+*		Technology is prohibited.
+*
+* *****************************************************************************
+*
+*	@file		SceneSaver.h
+*
+*	@author		agent
+*
+*	@email		agent\@local
+*
+*	@course		CSD 2401 - Software Engineering Project 3
+*				CSD 2451 - Software Engineering Project 4
+*
+*	@section	Section A
+*
+*	@date		19 October 2026
+*
+* *****************************************************************************
+*
+*	@brief		Incremental scene saving and autosave
+*
+*	The json text of every entity saved is kept. Autosaves only serialize
+*	the entities the ECS marked as changed since the last save (components
+*	added or removed, entities made or destroyed, edits recorded by
+*	UndoRedo, edits of the selected entity in the editor panels) or whose
+*	layer moved, and reuse the text of the others. Components written
+*	directly are not marked, so saving the scene from the editor always
+*	serializes every entity, and an autosave may miss such an edit until
+*	then. The text is written compact, one entity per line.
+*
+*	Joining the text, writing it and cooking the scene cache happen on a
+*	background thread. The file is written to a temporary file first and
+*	renamed over the old one, so a save that fails part way leaves the old
+*	file as it was.
+*
+******************************************************************************/
+
+#pragma once
+#include "ECS.h"
+#include <future>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+//Timing of the last save
+struct SceneSaveStats {
+	std::string file{};
+	size_t entities{};				//entities saved
+	size_t serialized{};			//entities serialized again as they changed
+	double snapshotMilliseconds{};	//main thread time to serialize the changed entities
+	double writeMilliseconds{};		//background time to write the file and cook it
+	bool autosave{};
+};
+
+class SceneSaver {
+public:
+	bool autosave{};				//saves a copy of the scene under Scenes/Autosave/ while editing
+	float autosaveInterval{ 60.f };	//seconds between autosaves
+
+	//Saves entities to fileName as a scene file and writes it on a background thread. Autosaves only serialize the entities that changed
+	void Save(const std::string& fileName, const std::vector<Entity>& entities, bool isAutosave = false);
+	//Counts down to the next autosave of the current scene. Autosaves are skipped while playing or while a save is still being written
+	void Update(float dt);
+	//Waits for the save being written, if any
+	void Wait();
+	//Returns true while a save is being written
+	bool IsWriting();
+
+	SceneSaveStats GetLastSave();
+
+private:
+	struct SavedEntity {
+		std::shared_ptr<const std::string> json{};
+		//Layer data the layering system writes into the Name component when saving
+		size_t layer{};
+		size_t orderInLayer{};
+		bool skip{};
+		bool lock{};
+	};
+
+	std::unordered_map<Entity, SavedEntity> saved{};	//text of every entity as last saved
+	std::future<void> writing{};
+	std::mutex statsMutex{};
+	SceneSaveStats lastSave{};
+	float autosaveTimer{};
+};
+
+extern SceneSaver sceneSaver;
@@ -0,0 +1,201 @@
+/******************************************************************************
+*
+*	\copyright
+*		All content(C) 2023/2024 DigiPen Institute of Technology Singapore.
+*		All rights reserved. Reproduction or disclosure of this file or its
+*		contents without the prior written consent of DigiPen Institute of
+*		Technology is prohibited.
+*
+* *****************************************************************************
+*
+*	@file		SceneSnapshot.cpp
+*
+*	@author		agent
+*
+*	@email		agent\@local
+*
+*	@course		CSD 2401 - Software Engineering Project 3
+*				CSD 2451 - Software Engineering Project 4
+*
+*	@section	Section A
+*
+*	@date		19 October 2026
+*
+* *****************************************************************************
+*
+*	@brief		In memory snapshot of the scene for the editor's Play and Stop
+*
+*	Definitions of SceneSnapshot and of the CloneComponent versions for
+*	components that point to their own data.
+*
+******************************************************************************/
+
+#include "SceneSnapshot.h"
+#include "Global.h"
+#include "EntityFactory.h"
+#include "AssetManager.h"
+#include "SpatialIndex.h"
+#include "Animation.h"
+#include "UIComponents.h"
+#include "debugdiagnostic.h"
+#include <algorithm>
+#include <chrono>
+#include <limits>
+
+SceneSnapshot sceneSnapshot;
+
+//Holder name of the assets kept loaded for the snapshot
+const std::string SNAPSHOT_HOLDER{ "Play snapshot" };
+
+/*!
+ * \brief Copies an animation set
+ *
+ * The assignment operator already points the active and queued animations
+ * at the copy's own animation groups, but leaves out whether the set is paused.
+ *
+ */
+template <>
+void CloneComponent<AnimationSet>(AnimationSet& dst, AnimationSet const& src) {
+	dst = src;
+	dst.paused = src.paused;
+}
+
+/*!
+ * \brief Copies a text label without its laid out lines and glyphs
+ *
+ * They are rebuilt from the text on the next update, against the glyph atlas
+ * as it is then.
+ *
+ */
+template <>
+void CloneComponent<TextLabel>(TextLabel& dst, TextLabel const& src) {
+	dst = src;
+	dst.lineData.clear();
+	dst.glyphQuads.clear();
+	dst.InvalidateLayout();
+}
+
+void SceneSnapshot::Capture() {
+	auto captureStart{ std::chrono::high_resolution_clock::now() };
+
+	components.clear();
+	for (auto& type : ECS::ecs().GetTypeManager()) {
+		components[type.first] = type.second->Snapshot();
+	}
+	EntityManager& entityManager{ ECS::ecs().GetEntityManager() };
+	existingEntities = entityManager.GetExistingEntities();
+	availableEntities = entityManager.GetAvailableEntities();
+
+	layerCounter = ::layerCounter;
+	groupCounter = ::groupCounter;
+	layerNames = ::layerNames;
+	layering = ::layering;
+	layersToSkip = ::layersToSkip;
+	entitiesToSkip = ::entitiesToSkip;
+	layersToLock = ::layersToLock;
+	entitiesToLock = ::entitiesToLock;
+
+	EntityFactory& factory{ EntityFactory::entityFactory() };
+	masterEntitiesList = factory.masterEntitiesList;
+	masterCounter = factory.masterCounter;
+	cloneCounter = factory.cloneCounter;
+
+	// Everything the scene uses stays loaded until Stop, even if the game changes scene
+	prefabs = assetmanager.GetPrefabMap();
+	assets = assetmanager.GetFiles();
+	for (auto& prefab : prefabs) {
+		assets.push_back(prefab.first);
+	}
+	if (captured) {
+		assetmanager.ReleaseAssets(SNAPSHOT_HOLDER);
+	}
+	assetmanager.HoldAssets(SNAPSHOT_HOLDER, assets);
+	scene = sceneName;
+	bgm = assetmanager.audio.GetCurrentBGM();
+	ambience = assetmanager.audio.GetCurrentAmbience();
+	captured = true;
+
+	std::chrono::duration<double, std::milli> elapsed{ std::chrono::high_resolution_clock::now() - captureStart };
+	captureTime = elapsed.count();
+	DEBUG_PRINT("Scene snapshot of %zu entities taken in %.2f ms", existingEntities.size(), captureTime);
+}
+
+bool SceneSnapshot::Restore() {
+	if (!captured) {
+		return false;
+	}
+	auto restoreStart{ std::chrono::high_resolution_clock::now() };
+
+	// Entities made while playing
+	EntityManager& entityManager{ ECS::ecs().GetEntityManager() };
+	std::vector<Entity> liveEntities{ entityManager.GetExistingEntities().begin(), entityManager.GetExistingEntities().end() };
+	for (Entity entity : liveEntities) {
+		if (!existingEntities.count(entity)) {
+			ECS::ecs().DestroyEntity(entity);
+		}
+	}
+	EntityFactory& factory{ EntityFactory::entityFactory() };
+	factory.deletionEntitiesList.clear();
+
+	// Entities destroyed while playing get their IDs back, then every component array is written back
+	entityManager.SetEntities(existingEntities, availableEntities);
+	for (auto& type : ECS::ecs().GetTypeManager()) {
+		auto saved{ components.find(type.first) };
+		if (saved != components.end()) {
+			type.second->Restore(*saved->second);
+		}
+	}
+
+	::layerCounter = layerCounter;
+	::groupCounter = groupCounter;
+	::layerNames = layerNames;
+	::layering = layering;
+	::layersToSkip = layersToSkip;
+	::entitiesToSkip = entitiesToSkip;
+	::layersToLock = layersToLock;
+	::entitiesToLock = entitiesToLock;
+	if (::selectedLayer != std::numeric_limits<size_t>().max() && ::selectedLayer >= ::layering.size()) {
+		::selectedLayer = std::numeric_limits<size_t>().max();
+	}
+
+	factory.masterEntitiesList = masterEntitiesList;
+	factory.masterCounter = masterCounter;
+	factory.cloneCounter = cloneCounter;
+
+	// Components were written back in place, so every entity has to be saved again
+	ECS::ecs().MarkAllChanged();
+
+	// Models keep their bounds from when they were captured, so the grid is rebuilt as they update
+	spatialGrid.Clear();
+
+	// The game may have changed scene while playing
+	assetmanager.GetPrefabMap() = prefabs;
+	assetmanager.RestoreScene(scene, assets);
+	assetmanager.ReleaseAssets(SNAPSHOT_HOLDER);
+	assetmanager.audio.ResetSceneAudio();
+	if (bgm != "") {
+		assetmanager.LoadAssets(bgm);
+	}
+	if (ambience != "") {
+		assetmanager.LoadAssets(ambience);
+	}
+
+	captured = false;
+	components.clear();
+	std::chrono::duration<double, std::milli> elapsed{ std::chrono::high_resolution_clock::now() - restoreStart };
+	restoreTime = elapsed.count();
+	DEBUG_PRINT("Scene snapshot of %zu entities restored in %.2f ms", existingEntities.size(), restoreTime);
+	return true;
+}
+
+bool SceneSnapshot::HasCapture() {
+	return captured;
+}
+
+double SceneSnapshot::GetCaptureTime() {
+	return captureTime;
+}
+
+double SceneSnapshot::GetRestoreTime() {
+	return restoreTime;
+}
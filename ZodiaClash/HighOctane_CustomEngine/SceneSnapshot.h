@@ -0,0 +1,95 @@
+/******************************************************************************
+*
+*	\copyright
+*		All content(C) 2023/2024 DigiPen Institute of Technology Singapore.
+*		All rights reserved. Reproduction or disclosure of this file or its
+*		contents without the prior written consent of DigiPen Institute of
+*		Technology is prohibited.
+*
+* *****************************************************************************
+*
+*	@file		SceneSnapshot.h
+*
+*	@author		agent
+*
+*	@email		agent\@local
+*
+*	@course		CSD 2401 - Software Engineering Project 3
+*				CSD 2451 - Software Engineering Project 4
+*
+*	@section	Section A
+*
+*	@date		19 October 2026
+*
+* *****************************************************************************
+*
+*	@brief		In memory snapshot of the scene for the editor's Play and Stop
+*
+*	Pressing Play copies every component array of the ECS, the entity IDs in
+*	use, the layers and the prefabs into memory. Pressing Stop writes them
+*	back in place: entities made while playing are destroyed, entities
+*	destroyed while playing come back with their old IDs, and entities that
+*	lived through it keep their component storage, so nothing is parsed or
+*	written to disk.
+*
+*	The assets the scene used are held by the snapshot until Stop, so they
+*	stay loaded even if the game changes scene while playing.
+*
+******************************************************************************/
+
+#pragma once
+#include "ECS.h"
+#include <array>
+#include <deque>
+#include <memory>
+#include <queue>
+#include <set>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+class SceneSnapshot {
+public:
+	//Copies every entity, component, layer and prefab of the current scene
+	void Capture();
+	//Puts the scene back the way it was captured, keeping entity IDs. Returns false if nothing was captured
+	bool Restore();
+	//Returns true if a capture is waiting to be restored
+	bool HasCapture();
+
+	double GetCaptureTime();	//milliseconds taken by the last Capture
+	double GetRestoreTime();	//milliseconds taken by the last Restore
+
+private:
+	bool captured{};
+
+	//ECS
+	std::set<Entity> existingEntities{};
+	std::queue<Entity> availableEntities{};
+	std::unordered_map<std::string, std::shared_ptr<ComponentSnapshot>> components{};	//by component type name
+
+	//Layers
+	size_t layerCounter{};
+	size_t groupCounter{};
+	std::deque<std::pair<std::string, bool>> layerNames{};
+	std::deque<std::deque<Entity>> layering{};
+	std::array<bool, 10000> layersToSkip{};
+	std::array<bool, 100000> entitiesToSkip{};
+	std::array<bool, 10000> layersToLock{};
+	std::array<bool, 100000> entitiesToLock{};
+
+	//Entity factory and assets
+	std::unordered_map<std::string, Entity> masterEntitiesList{};
+	size_t masterCounter{};
+	size_t cloneCounter{};
+	std::unordered_map<std::string, Entity> prefabs{};
+	std::vector<std::string> assets{};
+	std::string scene{};
+	std::string bgm{};
+	std::string ambience{};
+
+	double captureTime{};
+	double restoreTime{};
+};
+
+extern SceneSnapshot sceneSnapshot;
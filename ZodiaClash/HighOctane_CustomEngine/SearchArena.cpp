@@ -0,0 +1,68 @@
+/******************************************************************************
+*
+*	\copyright
+*		All content(C) 2023/2024 DigiPen Institute of Technology Singapore.
+*		All rights reserved. Reproduction or disclosure of this file or its
+*		contents without the prior written consent of DigiPen Institute of
+*		Technology is prohibited.
+*
+* *****************************************************************************
+*
+*	@file		SearchArena.cpp
+*
+*	@author		agent
+*
+*	@email		agent\@local
+*
+*	@course		CSD 2401 - Software Engineering Project 3
+*				CSD 2451 - Software Engineering Project 4
+*
+*	@section	Section A
+*
+*	@date		19 October 2026
+*
+* *****************************************************************************
+*
+*	@brief		Bump allocator for the AI search
+*
+*	Block management of the search arena
+*
+******************************************************************************/
+
+#include "SearchArena.h"
+#include "debugdiagnostic.h"
+#include <algorithm>
+
+void SearchArena::Reset() {
+	position = 0;
+	stats = ArenaStats{};
+}
+
+/*!
+* \brief Allocates from the current block
+*
+* Moves on to the next block when the allocation does not fit in what is
+* left of the current one, allocating it from the heap if the arena has
+* never been that large before.
+*
+*/
+void* SearchArena::AllocateBytes(size_t size, size_t alignment) {
+	ASSERT(size > BLOCK_SIZE, "Search arena allocation is larger than a block");
+
+	size_t block{ position / BLOCK_SIZE };
+	size_t offset{ (position % BLOCK_SIZE + alignment - 1) / alignment * alignment };
+	if (offset + size > BLOCK_SIZE) {
+		++block;
+		offset = 0;
+	}
+	//A full block moves the position to the start of the next one, which may not exist yet
+	if (block >= blocks.size()) {
+		blocks.emplace_back(new std::byte[BLOCK_SIZE]);
+		++stats.heapAllocations;
+	}
+
+	position = block * BLOCK_SIZE + offset + size;
+	stats.peakBytes = std::max(stats.peakBytes, position);
+	++stats.allocations;
+	return blocks[block].get() + offset;
+}
@@ -0,0 +1,88 @@
+/******************************************************************************
+*
+*	\copyright
+*		All content(C) 2023/2024 DigiPen Institute of Technology Singapore.
+*		All rights reserved. Reproduction or disclosure of this file or its
+*		contents without the prior written consent of DigiPen Institute of
+*		Technology is prohibited.
+*
+* *****************************************************************************
+*
+*	@file		SearchArena.h
+*
+*	@author		agent
+*
+*	@email		agent\@local
+*
+*	@course		CSD 2401 - Software Engineering Project 3
+*				CSD 2451 - Software Engineering Project 4
+*
+*	@section	Section A
+*
+*	@date		19 October 2026
+*
+* *****************************************************************************
+*
+*	@brief		Bump allocator for the AI search
+*
+*	Every state and move list the search creates comes from a per-worker
+*	arena of fixed size blocks. Allocation moves an offset forward, each
+*	search node gives its memory back by rewinding to a mark on return,
+*	and a decision is torn down by a single Reset(). Blocks are kept
+*	between decisions, so once warmed up the search makes no heap
+*	allocations.
+*
+******************************************************************************/
+
+#pragma once
+#include <cstddef>
+#include <memory>
+#include <type_traits>
+#include <vector>
+
+//Memory use of an arena since its last reset
+struct ArenaStats {
+	size_t peakBytes{};			//most bytes in use at once
+	size_t allocations{};		//objects allocated from the arena
+	size_t heapAllocations{};	//blocks allocated from the heap
+};
+
+class SearchArena {
+public:
+	static constexpr size_t BLOCK_SIZE = 64 * 1024;
+
+	//Allocates count uninitialised objects, T must be trivially copyable as nothing is destroyed
+	template <typename T>
+	T* Allocate(size_t count = 1) {
+		static_assert(std::is_trivially_copyable_v<T>, "SearchArena does not run destructors");
+		return static_cast<T*>(AllocateBytes(sizeof(T) * count, alignof(T)));
+	}
+
+	//Position to rewind to, frees everything allocated after it
+	size_t Mark() const { return position; }
+	void Release(size_t mark) { position = mark; }
+	//Frees everything and clears the statistics, blocks are kept for the next decision
+	void Reset();
+
+	ArenaStats const& GetStats() const { return stats; }
+
+private:
+	void* AllocateBytes(size_t size, size_t alignment);
+
+	std::vector<std::unique_ptr<std::byte[]>> blocks{};
+	size_t position{}; //block index * BLOCK_SIZE + offset in the block
+	ArenaStats stats{};
+};
+
+//Releases everything allocated in a scope on exit
+class ArenaScope {
+public:
+	explicit ArenaScope(SearchArena& scopeArena) : arena{ scopeArena }, mark{ scopeArena.Mark() } {}
+	~ArenaScope() { arena.Release(mark); }
+	ArenaScope(ArenaScope const&) = delete;
+	ArenaScope& operator=(ArenaScope const&) = delete;
+
+private:
+	SearchArena& arena;
+	size_t mark;
+};
@@ -49,6 +49,13 @@
 #include "Layering.h"
 #include "Animation.h"
 #include "Particles.h"
+#include "TextureCache.h"
+#include "SceneCache.h"
+#include "JsonStream.h"
+#include "ComponentReflection.h"
+#include "AssetPack.h"
+#include "SceneSaver.h"
+#include "GlyphAtlas.h"
 
 //extern std::unordered_map<std::string, Entity> masterEntitiesList;
 
@@ -56,8 +63,21 @@
 
 bool Serializer::Open(const std::string& file)
 {
-	stream.open(file.c_str());
-	return stream.is_open();
+	stream.str(std::string{});
+	stream.clear();
+	const unsigned char* packed{};
+	size_t packedSize{};
+	if (assetpack.Read(file, packed, packedSize)) {
+		stream.str(std::string{ reinterpret_cast<const char*>(packed), packedSize });
+		return true;
+	}
+	std::ifstream input{ file.c_str(), std::ios::binary };
+	if (!input.is_open()) {
+		stream.setstate(std::ios::failbit | std::ios::eofbit);
+		return false;
+	}
+	stream.str(std::string{ std::istreambuf_iterator<char>{ input }, std::istreambuf_iterator<char>{} });
+	return true;
 }
 
 bool Serializer::IsGood()
@@ -145,79 +165,6 @@ void Serializer::SerializeCSV(const std::string& file) {
 	}
 }
 
-rapidjson::Value SerializeName(const Name& entityName, rapidjson::Document::AllocatorType& allocator) {
-	
-	rapidjson::Value nameObject(rapidjson::kObjectType);
-	rapidjson::Value nameValue;
-	nameValue.SetString(entityName.name.c_str(), static_cast<rapidjson::SizeType>(entityName.name.length()), allocator);
-	nameObject.AddMember("Name", nameValue, allocator);
-	//nameObject.AddMember("Selected", entityName.selected, allocator);
-	nameObject.AddMember("Current Layer", static_cast<uint64_t>(entityName.serializationLayer), allocator);
-	nameObject.AddMember("Order in Layer", static_cast<uint64_t>(entityName.serializationOrderInLayer), allocator);
-	nameObject.AddMember("isLocked", entityName.lock, allocator);
-	nameObject.AddMember("isSkipped", entityName.skip, allocator);
-
-	return nameObject;
-
-}
-
-rapidjson::Value SerializeTransform(const Transform& transform, rapidjson::Document::AllocatorType& allocator) {
-	rapidjson::Value transformObject(rapidjson::kObjectType);
-	transformObject.AddMember("position_x", transform.position.x, allocator);
-	transformObject.AddMember("position_y", transform.position.y, allocator);
-	transformObject.AddMember("rotation", transform.rotation, allocator);
-	transformObject.AddMember("scale", transform.scale, allocator);
-	transformObject.AddMember("velocity_x", transform.velocity.x, allocator);
-	transformObject.AddMember("velocity_y", transform.velocity.y, allocator);
-	return transformObject;
-}
-
-rapidjson::Value SerializeSize(const Size& size, rapidjson::Document::AllocatorType& allocator) {
-	rapidjson::Value sizeObject(rapidjson::kObjectType);
-	sizeObject.AddMember("width", size.width, allocator);
-	sizeObject.AddMember("height", size.height, allocator);
-	return sizeObject;
-}
-
-rapidjson::Value SerializeColor(const Color& color, rapidjson::Document::AllocatorType& allocator) {
-	rapidjson::Value colorObject(rapidjson::kObjectType);
-	colorObject.AddMember("r", color.color.r, allocator);
-	colorObject.AddMember("g", color.color.g, allocator);
-	colorObject.AddMember("b", color.color.b, allocator);
-	colorObject.AddMember("a", color.color.a, allocator);
-	return colorObject;
-}
-
-rapidjson::Value SerializeParticle(const Emitter& emitter, rapidjson::Document::AllocatorType& allocator) {
-	rapidjson::Value emitterObject(rapidjson::kObjectType);
-	emitterObject.AddMember("Emitter Lifetime", emitter.emitterLifetime, allocator);
-	emitterObject.AddMember("Emitter PositionX", emitter.position.x, allocator);
-	emitterObject.AddMember("Emitter PositionY", emitter.position.y, allocator);
-	emitterObject.AddMember("Particles SizeX", emitter.size.x, allocator);
-	emitterObject.AddMember("Particles SizeY", emitter.size.y, allocator);
-	emitterObject.AddMember("Particles ColorR", emitter.particleColor.color.r, allocator);
-	emitterObject.AddMember("Particles ColorG", emitter.particleColor.color.g, allocator);
-	emitterObject.AddMember("Particles ColorB", emitter.particleColor.color.b, allocator);
-	emitterObject.AddMember("Particles ColorA", emitter.particleColor.color.a, allocator);
-	emitterObject.AddMember("Frequency", emitter.frequency, allocator);
-	emitterObject.AddMember("Particle Lifetime", emitter.particleLifetime, allocator);
-	emitterObject.AddMember("Rotation", emitter.rotation, allocator);
-	emitterObject.AddMember("Rotation Speed", emitter.rotationSpeed, allocator);
-	emitterObject.AddMember("VelocityX", emitter.velocity.x, allocator);
-	emitterObject.AddMember("VelocityY", emitter.velocity.y, allocator);
-	emitterObject.AddMember("Single Sided", emitter.singleSided, allocator);
-
-	rapidjson::Value particleTextures(rapidjson::kArrayType);
-	for (std::string const& a : emitter.textures) {
-		rapidjson::Value tex;
-		tex.SetString(a.c_str(), static_cast<rapidjson::SizeType>(a.length()), allocator);
-		particleTextures.PushBack(tex, allocator);
-	}
-	emitterObject.AddMember("Textures", particleTextures, allocator);
-
-	return emitterObject;
-}
-
 rapidjson::Value SerializeTex(const Tex& tex, rapidjson::Document::AllocatorType& allocator) {
 	rapidjson::Value texObject(rapidjson::kObjectType);
 	texObject.AddMember("Texture Index", tex.texVariantIndex, allocator);
@@ -237,27 +184,6 @@ rapidjson::Value SerializeTex(const Tex& tex, rapidjson::Document::AllocatorType
 }
 
 
-rapidjson::Value SerializeVisible(const Visible& visible, rapidjson::Document::AllocatorType& allocator) {
-	rapidjson::Value visibleObject(rapidjson::kObjectType);
-	visibleObject.AddMember("isVisible", visible.isVisible, allocator);
-	return visibleObject;
-}
-
-rapidjson::Value SerializeCircle(const Circle& circle, rapidjson::Document::AllocatorType& allocator) {
-	rapidjson::Value circleObject(rapidjson::kObjectType);
-	circleObject.AddMember("radius", circle.radius, allocator);
-	return circleObject;
-}
-rapidjson::Value SerializeAABB(const AABB& aabb, rapidjson::Document::AllocatorType& allocator) {
-	rapidjson::Value aabbObject(rapidjson::kObjectType);
-	aabbObject.AddMember("Min X", aabb.min.x, allocator);
-	aabbObject.AddMember("Min Y", aabb.min.y, allocator);
-	aabbObject.AddMember("Max X", aabb.max.x, allocator);
-	aabbObject.AddMember("Max Y", aabb.max.y, allocator);
-	aabbObject.AddMember("Extent X", aabb.extents.x, allocator);
-	aabbObject.AddMember("Extent Y", aabb.extents.y, allocator);
-	return aabbObject;
-}
 rapidjson::Value SerializeAnimation(const Animator& anim, rapidjson::Document::AllocatorType& allocator) {
 	rapidjson::Value animObject(rapidjson::kObjectType);
 	animObject.AddMember("Animation Type", (int)anim.GetAnimationType(), allocator);
@@ -306,28 +232,6 @@ rapidjson::Value SerializeModel(const Model& model, rapidjson::Document::Allocat
 	return modelObject;
 }
 
-rapidjson::Value SerializeCollider(const Collider& collider, rapidjson::Document::AllocatorType& allocator) {
-	rapidjson::Value colliderObject(rapidjson::kObjectType);
-	colliderObject.AddMember("Collider Enum", (int)collider.bodyShape, allocator);
-	colliderObject.AddMember("Dimension X", collider.dimension.x, allocator);
-	colliderObject.AddMember("Dimension Y", collider.dimension.y, allocator);
-	colliderObject.AddMember("Type", (int)collider.type, allocator);
-	colliderObject.AddMember("Event Name", rapidjson::Value(collider.eventName.c_str(), allocator).Move(), allocator);
-	colliderObject.AddMember("Event Input", rapidjson::Value(collider.eventInput.c_str(), allocator).Move(), allocator);
-	return colliderObject;
-}
-
-rapidjson::Value SerializeSliderUI(const SliderUI& slider, rapidjson::Document::AllocatorType& allocator) {
-	rapidjson::Value sliderObject(rapidjson::kObjectType);
-
-	sliderObject.AddMember("Linked Entity", slider.linkedEntity, allocator);
-
-	sliderObject.AddMember("Slider Type", (int)slider.type, allocator);
-	sliderObject.AddMember("Control Which", (int)slider.controlWhich, allocator);
-
-	return sliderObject;
-}
-
 rapidjson::Value SerializeTextLabel(const TextLabel& textLabel, rapidjson::Document::AllocatorType& allocator) {
 	rapidjson::Value textObject(rapidjson::kObjectType);
 	
@@ -397,56 +301,6 @@ rapidjson::Value SerializeButton(const Button& button, rapidjson::Document::Allo
 	return buttonObject;
 }
 
-rapidjson::Value SerializeHealthBar(const HealthBar& hpBar, rapidjson::Document::AllocatorType& allocator) {
-	rapidjson::Value hpBarObject(rapidjson::kObjectType);
-	hpBarObject.AddMember("Show Health Stat", (bool)hpBar.showHealthStat, allocator);
-	hpBarObject.AddMember("Show Value or Percentage", (bool)hpBar.showValOrPct, allocator);
-	hpBarObject.AddMember("Bar Width", hpBar.barWidth, allocator);
-	hpBarObject.AddMember("Bar Height", hpBar.barHeight, allocator);
-
-	hpBarObject.AddMember("Current Health", hpBar.currentHealth, allocator);
-	hpBarObject.AddMember("Max Health", hpBar.maxHealth, allocator);
-	hpBarObject.AddMember("Health Percentage", hpBar.healthPct, allocator);
-	return hpBarObject;
-}
-
-rapidjson::Value SerializeHealthRemaining(const HealthRemaining& hpRemBar, rapidjson::Document::AllocatorType& allocator) {
-	rapidjson::Value hpRemBarObject(rapidjson::kObjectType);
-	hpRemBarObject.AddMember("Current Health", hpRemBar.currentHealth, allocator);
-	return hpRemBarObject;
-}
-
-rapidjson::Value SerializeSkillPointHUD(const SkillPointHUD& spHUD, rapidjson::Document::AllocatorType& allocator) {
-	rapidjson::Value spHudObject(rapidjson::kObjectType);
-	spHudObject.AddMember("Skill Point Balance", spHUD.skillPointBalance, allocator);
-	spHudObject.AddMember("Skill Point Cap", spHUD.maxSkillPoints, allocator);
-	return spHudObject;
-}
-
-rapidjson::Value SerializeSkillPoint(const SkillPoint& skillpt, rapidjson::Document::AllocatorType& allocator) {
-	rapidjson::Value skillPtObject(rapidjson::kObjectType);
-	skillPtObject.AddMember("Active State", skillpt.isActive, allocator);
-	return skillPtObject;
-}
-
-rapidjson::Value SerializeAttackSkill(const AttackSkill& atkSkill, rapidjson::Document::AllocatorType& allocator) {
-	rapidjson::Value atkSkillObject(rapidjson::kObjectType);
-	atkSkillObject.AddMember("Skill Index", atkSkill.skillIndex, allocator);
-	return atkSkillObject;
-}
-
-rapidjson::Value SerializeAllyHUD(const AllyHUD& allyHUD, rapidjson::Document::AllocatorType& allocator) {
-	rapidjson::Value allyHudObject(rapidjson::kObjectType);
-	allyHudObject.AddMember("Ally Index", allyHUD.allyIndex, allocator);
-	return allyHudObject;
-}
-
-rapidjson::Value SerializeEnemyHUD(const EnemyHUD& enemyHUD, rapidjson::Document::AllocatorType& allocator) {
-	rapidjson::Value enemyHudObject(rapidjson::kObjectType);
-	enemyHudObject.AddMember("Enemy Index", enemyHUD.enemyIndex, allocator);
-	return enemyHudObject;
-}
-
 //rapidjson::Value SerializeDialogueSpeaker(const DialogueSpeaker& dialogueSpeaker, rapidjson::Document::AllocatorType& allocator) {
 //	rapidjson::Value dialogueSpeakerObject(rapidjson::kObjectType);
 //	dialogueSpeakerObject.AddMember("Enemy Index", dialogueSpeaker.enemyIndex, allocator);
@@ -712,15 +566,10 @@ bool CheckSerialize(const Entity& entity, const bool& isPrefabClone, const std::
 }
 
 
-void Serializer::SaveEntityToJson(const std::string& fileName, const std::vector<Entity>& m_entity, bool isPrefab) {
-	// Create a JSON document
-	rapidjson::Document document;
-	document.SetArray();
-	rapidjson::Document::AllocatorType& allocator = document.GetAllocator();
-
-	/************************FOR LAYERING***************************/
-	PrepareLayeringForSerialization();
-	EmbedSkipLockForSerialization();
+/*!
+* \brief Serializes the layer names and counters, the first entry of a scene file
+*/
+rapidjson::Value SerializeLayering(rapidjson::Document::AllocatorType& allocator) {
 	rapidjson::Value layeringHeader(rapidjson::kObjectType);
 
 	rapidjson::Value layeringObject(rapidjson::kObjectType);
@@ -739,9 +588,18 @@ void Serializer::SaveEntityToJson(const std::string& fileName, const std::vector
 
 	layeringHeader.AddMember("LayeringSystems", layeringObject, allocator);
 
-	document.PushBack(layeringHeader, allocator);
+	return layeringHeader;
+}
 
-	/*******************For ENTITIES****************/
+/*!
+* \brief Serializes one entity into entityObject
+*
+* Returns false if the entity is not saved: temporary entities and entities
+* that are not clones outside of prefabs, and children of clones, which are
+* saved with their prefab.
+*
+*/
+bool SerializeEntity(Entity entity, bool isPrefab, rapidjson::Value& entityObject, rapidjson::Document::AllocatorType& allocator) {
 	Color* color = nullptr;
 	Transform* transform = nullptr;
 	Tex* tex = nullptr;
@@ -770,224 +628,238 @@ void Serializer::SaveEntityToJson(const std::string& fileName, const std::vector
 	//Temporary* temporary = nullptr;
 	SliderUI* sliderUI = nullptr;
 
-	for (const Entity& entity : m_entity) {
+	if (ECS::ecs().HasComponent<Temporary>(entity) && !isPrefab) {
+		return false;
+	}
+	
+	if (!isPrefab && !ECS::ecs().HasComponent<Clone>(entity)) {
+		return false;
+	}
 
-		if (ECS::ecs().HasComponent<Temporary>(entity) && !isPrefab) {
-			continue;
-		}
-		
-		if (!isPrefab && !ECS::ecs().HasComponent<Clone>(entity)) {
-			continue;
-		}
+	entityObject.SetObject();
 
-		rapidjson::Value entityObject(rapidjson::kObjectType);
+	bool isPrefabClone{ false };
+	std::unordered_set<std::string>* uComponentMap{};
 
-		bool isPrefabClone{ false };
-		std::unordered_set<std::string>* uComponentMap{};
-
-		if (ECS::ecs().HasComponent<Clone>(entity)) {
-			rapidjson::Value cloneObject(rapidjson::kObjectType);
-			std::string prefabName{ ECS::ecs().GetComponent<Clone>(entity).prefab };
-			if (prefabName != "") {
-				rapidjson::Value typeObject(rapidjson::kArrayType);
-				cloneObject.AddMember("Prefab", rapidjson::Value(prefabName.c_str(), allocator).Move(), allocator);
-				isPrefabClone = true;
-				uComponentMap = &ECS::ecs().GetComponent<Clone>(entity).unique_components;
-				for (auto& u : *uComponentMap) {
-					typeObject.PushBack(rapidjson::Value(u.c_str(), allocator).Move(), allocator);
-				}
-				cloneObject.AddMember("Unique Components", typeObject, allocator);
+	if (ECS::ecs().HasComponent<Clone>(entity)) {
+		rapidjson::Value cloneObject(rapidjson::kObjectType);
+		std::string prefabName{ ECS::ecs().GetComponent<Clone>(entity).prefab };
+		if (prefabName != "") {
+			rapidjson::Value typeObject(rapidjson::kArrayType);
+			cloneObject.AddMember("Prefab", rapidjson::Value(prefabName.c_str(), allocator).Move(), allocator);
+			isPrefabClone = true;
+			uComponentMap = &ECS::ecs().GetComponent<Clone>(entity).unique_components;
+			for (auto& u : *uComponentMap) {
+				typeObject.PushBack(rapidjson::Value(u.c_str(), allocator).Move(), allocator);
 			}
-			entityObject.AddMember("Clone", cloneObject, allocator);
+			cloneObject.AddMember("Unique Components", typeObject, allocator);
 		}
+		entityObject.AddMember("Clone", cloneObject, allocator);
+	}
 
-		if (ECS::ecs().HasComponent<Clone>(entity) && ECS::ecs().HasComponent<Child>(entity)) {
-			continue;
-		}
+	if (ECS::ecs().HasComponent<Clone>(entity) && ECS::ecs().HasComponent<Child>(entity)) {
+		return false;
+	}
 
-		if (CheckSerialize<Name>(entity, isPrefabClone,uComponentMap)) {
-			name = &ECS::ecs().GetComponent<Name>(entity);
-			rapidjson::Value nameObject = SerializeName(*name, allocator);
-			entityObject.AddMember("Entity", nameObject, allocator);
-		}
-		if (CheckSerialize<Master>(entity, isPrefabClone, uComponentMap)) {
-			entityObject.AddMember("Master", rapidjson::Value(rapidjson::kObjectType), allocator);
-		}
-		if (CheckSerialize<Color>(entity, isPrefabClone, uComponentMap)) {
-			color = &ECS::ecs().GetComponent<Color>(entity);
-			rapidjson::Value colorObject = SerializeColor(*color, allocator);
-			entityObject.AddMember("Color", colorObject, allocator);
-			//DECLARE(float, redCol, color->color.r);
-			//DECLARE(float, greenCol, color->color.g);
-			//DECLARE(float, blueCol, color->color.b);
-			//DECLARE(float, alphaCol, color->color.a);
-		}
-		if (CheckSerialize<Transform>(entity, isPrefabClone, uComponentMap)) {
-			transform = &ECS::ecs().GetComponent<Transform>(entity);
-			rapidjson::Value transformObject = SerializeTransform(*transform, allocator);
-			entityObject.AddMember("Transform", transformObject, allocator);
-		}
-		if (CheckSerialize<Tex>(entity, isPrefabClone, uComponentMap)) {
-			tex = &ECS::ecs().GetComponent<Tex>(entity);
-			rapidjson::Value textureObject = SerializeTex(*tex, allocator);
-			entityObject.AddMember("Texture", textureObject, allocator);
-		}
-		if (CheckSerialize<Visible>(entity, isPrefabClone, uComponentMap)) {
-			visible = &ECS::ecs().GetComponent<Visible>(entity);
-			rapidjson::Value visibleObject = SerializeVisible(*visible, allocator);
-			entityObject.AddMember("Visible", visibleObject, allocator);
-		}
-		if (CheckSerialize<Size>(entity, isPrefabClone, uComponentMap)) {
-			size = &ECS::ecs().GetComponent<Size>(entity);
-			rapidjson::Value sizeObject = SerializeSize(*size, allocator);
-			entityObject.AddMember("Size", sizeObject, allocator);
-		}
-		if (CheckSerialize<Circle>(entity, isPrefabClone, uComponentMap)) {
-			circle = &ECS::ecs().GetComponent<Circle>(entity);
-			rapidjson::Value circleObject = SerializeCircle(*circle, allocator);
-			entityObject.AddMember("Circle", circleObject, allocator);
+	if (CheckSerialize<Name>(entity, isPrefabClone,uComponentMap)) {
+		name = &ECS::ecs().GetComponent<Name>(entity);
+		rapidjson::Value nameObject = WriteFields(*name, allocator);
+		entityObject.AddMember("Entity", nameObject, allocator);
+	}
+	if (CheckSerialize<Master>(entity, isPrefabClone, uComponentMap)) {
+		entityObject.AddMember("Master", rapidjson::Value(rapidjson::kObjectType), allocator);
+	}
+	if (CheckSerialize<Color>(entity, isPrefabClone, uComponentMap)) {
+		color = &ECS::ecs().GetComponent<Color>(entity);
+		rapidjson::Value colorObject = WriteFields(*color, allocator);
+		entityObject.AddMember("Color", colorObject, allocator);
+		//DECLARE(float, redCol, color->color.r);
+		//DECLARE(float, greenCol, color->color.g);
+		//DECLARE(float, blueCol, color->color.b);
+		//DECLARE(float, alphaCol, color->color.a);
+	}
+	if (CheckSerialize<Transform>(entity, isPrefabClone, uComponentMap)) {
+		transform = &ECS::ecs().GetComponent<Transform>(entity);
+		rapidjson::Value transformObject = WriteFields(*transform, allocator);
+		entityObject.AddMember("Transform", transformObject, allocator);
+	}
+	if (CheckSerialize<Tex>(entity, isPrefabClone, uComponentMap)) {
+		tex = &ECS::ecs().GetComponent<Tex>(entity);
+		rapidjson::Value textureObject = SerializeTex(*tex, allocator);
+		entityObject.AddMember("Texture", textureObject, allocator);
+	}
+	if (CheckSerialize<Visible>(entity, isPrefabClone, uComponentMap)) {
+		visible = &ECS::ecs().GetComponent<Visible>(entity);
+		rapidjson::Value visibleObject = WriteFields(*visible, allocator);
+		entityObject.AddMember("Visible", visibleObject, allocator);
+	}
+	if (CheckSerialize<Size>(entity, isPrefabClone, uComponentMap)) {
+		size = &ECS::ecs().GetComponent<Size>(entity);
+		rapidjson::Value sizeObject = WriteFields(*size, allocator);
+		entityObject.AddMember("Size", sizeObject, allocator);
+	}
+	if (CheckSerialize<Circle>(entity, isPrefabClone, uComponentMap)) {
+		circle = &ECS::ecs().GetComponent<Circle>(entity);
+		rapidjson::Value circleObject = WriteFields(*circle, allocator);
+		entityObject.AddMember("Circle", circleObject, allocator);
 
+	}
+	if (CheckSerialize<AABB>(entity, isPrefabClone, uComponentMap)) {
+		aabb = &ECS::ecs().GetComponent<AABB>(entity);
+		rapidjson::Value aabbObject = WriteFields(*aabb, allocator);
+		entityObject.AddMember("Collision", aabbObject, allocator);
+	}
+	if (CheckSerialize<Emitter>(entity, isPrefabClone, uComponentMap)) {
+		emitter = &ECS::ecs().GetComponent<Emitter>(entity);
+		rapidjson::Value emitterObject = WriteFields(*emitter, allocator);
+		entityObject.AddMember("Emitter", emitterObject, allocator);
+	}
+	//if (CheckSerialize<Animator>(entity, isPrefabClone, uComponentMap)) {
+	//	anim = &ECS::ecs().GetComponent<Animator>(entity);
+	//	rapidjson::Value animationObject = SerializeAnimation(*anim, allocator);
+	//	entityObject.AddMember("Animation", animationObject, allocator);
+	//}
+	
+	if (CheckSerialize<CharacterStats>(entity, isPrefabClone, uComponentMap)) {
+		charstats = &ECS::ecs().GetComponent<CharacterStats>(entity);
+		rapidjson::Value charstatsObject = SerializeCharacterStats(*charstats, allocator);
+		entityObject.AddMember("CharacterStats", charstatsObject, allocator);
+	}
+	if (CheckSerialize<Model>(entity, isPrefabClone, uComponentMap)) {
+		model = &ECS::ecs().GetComponent<Model>(entity);
+		rapidjson::Value modelObject = SerializeModel(*model, allocator);
+		entityObject.AddMember("Model", modelObject, allocator);
+	}
+	if (CheckSerialize<Movable>(entity, isPrefabClone, uComponentMap)) {
+		entityObject.AddMember("Movable", rapidjson::Value(rapidjson::kObjectType), allocator);
+	}
+	if (CheckSerialize<MainCharacter>(entity, isPrefabClone, uComponentMap)) {
+		entityObject.AddMember("MainCharacter", rapidjson::Value(rapidjson::kObjectType), allocator);
+	}
+	if (CheckSerialize<TextLabel>(entity, isPrefabClone, uComponentMap)) {
+		textLabel = &ECS::ecs().GetComponent<TextLabel>(entity);
+		rapidjson::Value textObject = SerializeTextLabel(*textLabel, allocator);
+		entityObject.AddMember("Text Label", textObject, allocator);
+	}
+	if (CheckSerialize<Button>(entity, isPrefabClone, uComponentMap)) {
+		button = &ECS::ecs().GetComponent<Button>(entity);
+		rapidjson::Value buttonObject = SerializeButton(*button, allocator);
+		entityObject.AddMember("Button", buttonObject, allocator);
+	}
+	if (CheckSerialize<HealthBar>(entity, isPrefabClone, uComponentMap)) {
+		hpBar = &ECS::ecs().GetComponent<HealthBar>(entity);
+		rapidjson::Value hpBarObject = WriteFields(*hpBar, allocator);
+		entityObject.AddMember("HealthBar", hpBarObject, allocator);
+	}
+	if (CheckSerialize<HealthRemaining>(entity, isPrefabClone, uComponentMap)) {
+		hpRemBar = &ECS::ecs().GetComponent<HealthRemaining>(entity);
+		rapidjson::Value hpRemBarObject = WriteFields(*hpRemBar, allocator);
+		entityObject.AddMember("HealthRemaining", hpRemBarObject, allocator);
+	}
+	if (CheckSerialize<HealthLerp>(entity, isPrefabClone, uComponentMap)) {
+		entityObject.AddMember("HealthLerp", rapidjson::Value(rapidjson::kObjectType), allocator);
+	}
+	if (CheckSerialize<SkillPointHUD>(entity, isPrefabClone, uComponentMap)) {
+		spHUD = &ECS::ecs().GetComponent<SkillPointHUD>(entity);
+		rapidjson::Value spHudObject = WriteFields(*spHUD, allocator);
+		entityObject.AddMember("SkillPointHUD", spHudObject, allocator);
+	}
+	if (CheckSerialize<SkillPoint>(entity, isPrefabClone, uComponentMap)) {
+		skillpt = &ECS::ecs().GetComponent<SkillPoint>(entity);
+		rapidjson::Value skillPtObject = WriteFields(*skillpt, allocator);
+		entityObject.AddMember("SkillPoint", skillPtObject, allocator);
+	}
+	if (CheckSerialize<AttackSkill>(entity, isPrefabClone, uComponentMap)) {
+		atkSkill = &ECS::ecs().GetComponent<AttackSkill>(entity);
+		rapidjson::Value atkSkillObject = WriteFields(*atkSkill, allocator);
+		entityObject.AddMember("AttackSkill", atkSkillObject, allocator);
+	}
+	if (CheckSerialize<SkillIcon>(entity, isPrefabClone, uComponentMap)) {
+		entityObject.AddMember("SkillIcon", rapidjson::Value(rapidjson::kObjectType), allocator);
+	}
+	if (CheckSerialize<SkillCost>(entity, isPrefabClone, uComponentMap)) {
+		entityObject.AddMember("SkillCost", rapidjson::Value(rapidjson::kObjectType), allocator);
+	}
+	if (CheckSerialize<SkillAttackType>(entity, isPrefabClone, uComponentMap)) {
+		entityObject.AddMember("SkillAttackType", rapidjson::Value(rapidjson::kObjectType), allocator);
+	}
+	if (CheckSerialize<AllyHUD>(entity, isPrefabClone, uComponentMap)) {
+		allyHud = &ECS::ecs().GetComponent<AllyHUD>(entity);
+		rapidjson::Value allyHudObject = WriteFields(*allyHud, allocator);
+		entityObject.AddMember("AllyHUD", allyHudObject, allocator);
+	}
+	if (CheckSerialize<EnemyHUD>(entity, isPrefabClone, uComponentMap)) {
+		enemyHud = &ECS::ecs().GetComponent<EnemyHUD>(entity);
+		rapidjson::Value enemyHudObject = WriteFields(*enemyHud, allocator);
+		entityObject.AddMember("EnemyHUD", enemyHudObject, allocator);
+	}
+	if (CheckSerialize<TurnIndicator>(entity, isPrefabClone, uComponentMap)) {
+		entityObject.AddMember("TurnIndicator", rapidjson::Value(rapidjson::kObjectType), allocator);
+	}
+	//if (CheckSerialize<StatusEffectsPanel>(entity, isPrefabClone, uComponentMap)) {
+	//	//statusFxPanel = &ECS::ecs().GetComponent<StatusEffectsPanel>(entity);
+	//	//rapidjson::Value statusFxPanelObject = SerializeStatusEffectsPanel(*statusFxPanel, allocator);
+	//	entityObject.AddMember("StatusEffectsPanel", rapidjson::Value(rapidjson::kObjectType), allocator);
+	//}
+	if (CheckSerialize<StatusEffect>(entity, isPrefabClone, uComponentMap)) {
+		entityObject.AddMember("StatusEffect", rapidjson::Value(rapidjson::kObjectType), allocator);
+	}
+	if (CheckSerialize<DialogueSpeaker>(entity, isPrefabClone, uComponentMap)) {
+		entityObject.AddMember("DialogueSpeaker", rapidjson::Value(rapidjson::kObjectType), allocator);
+	}
+	if (CheckSerialize<DialogueHUD>(entity, isPrefabClone, uComponentMap)) {
+		dialogueHud = &ECS::ecs().GetComponent<DialogueHUD>(entity);
+		rapidjson::Value dialogueHudObject = SerializeDialogueHUD(*dialogueHud, allocator);
+		entityObject.AddMember("DialogueHUD", dialogueHudObject, allocator);
+	}
+	if (CheckSerialize<Collider>(entity, isPrefabClone, uComponentMap)) {
+		collider = &ECS::ecs().GetComponent<Collider>(entity);
+		rapidjson::Value colliderObject = WriteFields(*collider, allocator);
+		entityObject.AddMember("Collider", colliderObject, allocator);
+	}
+	if (CheckSerialize<AnimationSet>(entity, isPrefabClone, uComponentMap)) {
+		animset = &ECS::ecs().GetComponent<AnimationSet>(entity);
+		rapidjson::Value animsetObject = SerializeAnimationSet(*animset, allocator);
+		entityObject.AddMember("Animation Set", animsetObject, allocator);
+		entityObject.AddMember("Animation Set Default Animation", rapidjson::Value(animset->defaultAnimation.c_str(), allocator).Move(), allocator);
+	}
+	if (CheckSerialize<Parent>(entity, isPrefabClone, uComponentMap)) {
+		entityObject.AddMember("Parent", rapidjson::Value(rapidjson::kObjectType), allocator);
+	}
+	if (CheckSerialize<Child>(entity, isPrefabClone, uComponentMap)) {
+		transform = &ECS::ecs().GetComponent<Child>(entity).offset;
+		rapidjson::Value transformObject = WriteFields(*transform, allocator);
+		entityObject.AddMember("Child", transformObject, allocator);
+	}
+	if (CheckSerialize<Temporary>(entity, isPrefabClone, uComponentMap)) {
+		entityObject.AddMember("Temporary", rapidjson::Value(rapidjson::kObjectType), allocator);
+	}
+	if (CheckSerialize<SliderUI>(entity, isPrefabClone, uComponentMap)) {
+		printf("Inside CheckSerialize<SliderUI>\n");
+		sliderUI = &ECS::ecs().GetComponent<SliderUI>(entity);
+		rapidjson::Value sliderObject = WriteFields(*sliderUI, allocator);
+		entityObject.AddMember("SliderUI", sliderObject, allocator);
+	}
+	return true;
+}
+
+void Serializer::SaveEntityToJson(const std::string& fileName, const std::vector<Entity>& m_entity, bool isPrefab) {
+	// Create a JSON document
+	rapidjson::Document document;
+	document.SetArray();
+	rapidjson::Document::AllocatorType& allocator = document.GetAllocator();
+
+	/************************FOR LAYERING***************************/
+	PrepareLayeringForSerialization();
+	EmbedSkipLockForSerialization();
+	document.PushBack(SerializeLayering(allocator), allocator);
+
+	/*******************For ENTITIES****************/
+	for (const Entity& entity : m_entity) {
+		rapidjson::Value entityObject(rapidjson::kObjectType);
+		if (SerializeEntity(entity, isPrefab, entityObject, allocator)) {
+			document.PushBack(entityObject, allocator);
 		}
-		if (CheckSerialize<AABB>(entity, isPrefabClone, uComponentMap)) {
-			aabb = &ECS::ecs().GetComponent<AABB>(entity);
-			rapidjson::Value aabbObject = SerializeAABB(*aabb, allocator);
-			entityObject.AddMember("Collision", aabbObject, allocator);
-		}
-		if (CheckSerialize<Emitter>(entity, isPrefabClone, uComponentMap)) {
-			emitter = &ECS::ecs().GetComponent<Emitter>(entity);
-			rapidjson::Value emitterObject = SerializeParticle(*emitter, allocator);
-			entityObject.AddMember("Emitter", emitterObject, allocator);
-		}
-		//if (CheckSerialize<Animator>(entity, isPrefabClone, uComponentMap)) {
-		//	anim = &ECS::ecs().GetComponent<Animator>(entity);
-		//	rapidjson::Value animationObject = SerializeAnimation(*anim, allocator);
-		//	entityObject.AddMember("Animation", animationObject, allocator);
-		//}
-		
-		if (CheckSerialize<CharacterStats>(entity, isPrefabClone, uComponentMap)) {
-			charstats = &ECS::ecs().GetComponent<CharacterStats>(entity);
-			rapidjson::Value charstatsObject = SerializeCharacterStats(*charstats, allocator);
-			entityObject.AddMember("CharacterStats", charstatsObject, allocator);
-		}
-		if (CheckSerialize<Model>(entity, isPrefabClone, uComponentMap)) {
-			model = &ECS::ecs().GetComponent<Model>(entity);
-			rapidjson::Value modelObject = SerializeModel(*model, allocator);
-			entityObject.AddMember("Model", modelObject, allocator);
-		}
-		if (CheckSerialize<Movable>(entity, isPrefabClone, uComponentMap)) {
-			entityObject.AddMember("Movable", rapidjson::Value(rapidjson::kObjectType), allocator);
-		}
-		if (CheckSerialize<MainCharacter>(entity, isPrefabClone, uComponentMap)) {
-			entityObject.AddMember("MainCharacter", rapidjson::Value(rapidjson::kObjectType), allocator);
-		}
-		if (CheckSerialize<TextLabel>(entity, isPrefabClone, uComponentMap)) {
-			textLabel = &ECS::ecs().GetComponent<TextLabel>(entity);
-			rapidjson::Value textObject = SerializeTextLabel(*textLabel, allocator);
-			entityObject.AddMember("Text Label", textObject, allocator);
-		}
-		if (CheckSerialize<Button>(entity, isPrefabClone, uComponentMap)) {
-			button = &ECS::ecs().GetComponent<Button>(entity);
-			rapidjson::Value buttonObject = SerializeButton(*button, allocator);
-			entityObject.AddMember("Button", buttonObject, allocator);
-		}
-		if (CheckSerialize<HealthBar>(entity, isPrefabClone, uComponentMap)) {
-			hpBar = &ECS::ecs().GetComponent<HealthBar>(entity);
-			rapidjson::Value hpBarObject = SerializeHealthBar(*hpBar, allocator);
-			entityObject.AddMember("HealthBar", hpBarObject, allocator);
-		}
-		if (CheckSerialize<HealthRemaining>(entity, isPrefabClone, uComponentMap)) {
-			hpRemBar = &ECS::ecs().GetComponent<HealthRemaining>(entity);
-			rapidjson::Value hpRemBarObject = SerializeHealthRemaining(*hpRemBar, allocator);
-			entityObject.AddMember("HealthRemaining", hpRemBarObject, allocator);
-		}
-		if (CheckSerialize<HealthLerp>(entity, isPrefabClone, uComponentMap)) {
-			entityObject.AddMember("HealthLerp", rapidjson::Value(rapidjson::kObjectType), allocator);
-		}
-		if (CheckSerialize<SkillPointHUD>(entity, isPrefabClone, uComponentMap)) {
-			spHUD = &ECS::ecs().GetComponent<SkillPointHUD>(entity);
-			rapidjson::Value spHudObject = SerializeSkillPointHUD(*spHUD, allocator);
-			entityObject.AddMember("SkillPointHUD", spHudObject, allocator);
-		}
-		if (CheckSerialize<SkillPoint>(entity, isPrefabClone, uComponentMap)) {
-			skillpt = &ECS::ecs().GetComponent<SkillPoint>(entity);
-			rapidjson::Value skillPtObject = SerializeSkillPoint(*skillpt, allocator);
-			entityObject.AddMember("SkillPoint", skillPtObject, allocator);
-		}
-		if (CheckSerialize<AttackSkill>(entity, isPrefabClone, uComponentMap)) {
-			atkSkill = &ECS::ecs().GetComponent<AttackSkill>(entity);
-			rapidjson::Value atkSkillObject = SerializeAttackSkill(*atkSkill, allocator);
-			entityObject.AddMember("AttackSkill", atkSkillObject, allocator);
-		}
-		if (CheckSerialize<SkillIcon>(entity, isPrefabClone, uComponentMap)) {
-			entityObject.AddMember("SkillIcon", rapidjson::Value(rapidjson::kObjectType), allocator);
-		}
-		if (CheckSerialize<SkillCost>(entity, isPrefabClone, uComponentMap)) {
-			entityObject.AddMember("SkillCost", rapidjson::Value(rapidjson::kObjectType), allocator);
-		}
-		if (CheckSerialize<SkillAttackType>(entity, isPrefabClone, uComponentMap)) {
-			entityObject.AddMember("SkillAttackType", rapidjson::Value(rapidjson::kObjectType), allocator);
-		}
-		if (CheckSerialize<AllyHUD>(entity, isPrefabClone, uComponentMap)) {
-			allyHud = &ECS::ecs().GetComponent<AllyHUD>(entity);
-			rapidjson::Value allyHudObject = SerializeAllyHUD(*allyHud, allocator);
-			entityObject.AddMember("AllyHUD", allyHudObject, allocator);
-		}
-		if (CheckSerialize<EnemyHUD>(entity, isPrefabClone, uComponentMap)) {
-			enemyHud = &ECS::ecs().GetComponent<EnemyHUD>(entity);
-			rapidjson::Value enemyHudObject = SerializeEnemyHUD(*enemyHud, allocator);
-			entityObject.AddMember("EnemyHUD", enemyHudObject, allocator);
-		}
-		if (CheckSerialize<TurnIndicator>(entity, isPrefabClone, uComponentMap)) {
-			entityObject.AddMember("TurnIndicator", rapidjson::Value(rapidjson::kObjectType), allocator);
-		}
-		//if (CheckSerialize<StatusEffectsPanel>(entity, isPrefabClone, uComponentMap)) {
-		//	//statusFxPanel = &ECS::ecs().GetComponent<StatusEffectsPanel>(entity);
-		//	//rapidjson::Value statusFxPanelObject = SerializeStatusEffectsPanel(*statusFxPanel, allocator);
-		//	entityObject.AddMember("StatusEffectsPanel", rapidjson::Value(rapidjson::kObjectType), allocator);
-		//}
-		if (CheckSerialize<StatusEffect>(entity, isPrefabClone, uComponentMap)) {
-			entityObject.AddMember("StatusEffect", rapidjson::Value(rapidjson::kObjectType), allocator);
-		}
-		if (CheckSerialize<DialogueSpeaker>(entity, isPrefabClone, uComponentMap)) {
-			entityObject.AddMember("DialogueSpeaker", rapidjson::Value(rapidjson::kObjectType), allocator);
-		}
-		if (CheckSerialize<DialogueHUD>(entity, isPrefabClone, uComponentMap)) {
-			dialogueHud = &ECS::ecs().GetComponent<DialogueHUD>(entity);
-			rapidjson::Value dialogueHudObject = SerializeDialogueHUD(*dialogueHud, allocator);
-			entityObject.AddMember("DialogueHUD", dialogueHudObject, allocator);
-		}
-		if (CheckSerialize<Collider>(entity, isPrefabClone, uComponentMap)) {
-			collider = &ECS::ecs().GetComponent<Collider>(entity);
-			rapidjson::Value colliderObject = SerializeCollider(*collider, allocator);
-			entityObject.AddMember("Collider", colliderObject, allocator);
-		}
-		if (CheckSerialize<AnimationSet>(entity, isPrefabClone, uComponentMap)) {
-			animset = &ECS::ecs().GetComponent<AnimationSet>(entity);
-			rapidjson::Value animsetObject = SerializeAnimationSet(*animset, allocator);
-			entityObject.AddMember("Animation Set", animsetObject, allocator);
-			entityObject.AddMember("Animation Set Default Animation", rapidjson::Value(animset->defaultAnimation.c_str(), allocator).Move(), allocator);
-		}
-		if (CheckSerialize<Parent>(entity, isPrefabClone, uComponentMap)) {
-			entityObject.AddMember("Parent", rapidjson::Value(rapidjson::kObjectType), allocator);
-		}
-		if (CheckSerialize<Child>(entity, isPrefabClone, uComponentMap)) {
-			transform = &ECS::ecs().GetComponent<Child>(entity).offset;
-			rapidjson::Value transformObject = SerializeTransform(*transform, allocator);
-			entityObject.AddMember("Child", transformObject, allocator);
-		}
-		if (CheckSerialize<Emitter>(entity, isPrefabClone, uComponentMap)) {
-			entityObject.AddMember("Emitter", rapidjson::Value(rapidjson::kObjectType), allocator);
-		}
-		if (CheckSerialize<Temporary>(entity, isPrefabClone, uComponentMap)) {
-			entityObject.AddMember("Temporary", rapidjson::Value(rapidjson::kObjectType), allocator);
-		}
-		if (CheckSerialize<SliderUI>(entity, isPrefabClone, uComponentMap)) {
-			printf("Inside CheckSerialize<SliderUI>\n");
-			sliderUI = &ECS::ecs().GetComponent<SliderUI>(entity);
-			rapidjson::Value sliderObject = SerializeSliderUI(*sliderUI, allocator);
-			entityObject.AddMember("SliderUI", sliderObject, allocator);
-		}
-		document.PushBack(entityObject, allocator);
 		//document.PushBack(entityArray, allocator);
 	}
 	selectedLayer = std::numeric_limits<size_t>().max();
@@ -1000,7 +872,9 @@ void Serializer::SaveEntityToJson(const std::string& fileName, const std::vector
 		document.Accept(writer);
 		ofs << buffer.GetString();
 		ofs.close();
+		assetpack.Evict(fileName);
 		std::cout << "Entity saved to " << fileName << std::endl;
+		scenecache.Cook(fileName, document);
 	}
 	else {
 		std::cerr << "Failed to open file: " << fileName << std::endl;
@@ -1010,6 +884,27 @@ void Serializer::SaveEntityToJson(const std::string& fileName, const std::vector
 	//SerializeVariablesToFile("variables.sav", variablesTEST);
 }
 
+bool Serializer::WriteEntityJson(Entity entity, std::string& json) {
+	rapidjson::Document document;
+	if (!SerializeEntity(entity, false, document, document.GetAllocator())) {
+		return false;
+	}
+	rapidjson::StringBuffer buffer;
+	rapidjson::Writer<rapidjson::StringBuffer> writer(buffer);
+	document.Accept(writer);
+	json.assign(buffer.GetString(), buffer.GetSize());
+	return true;
+}
+
+std::string Serializer::WriteLayeringJson() {
+	rapidjson::Document document;
+	rapidjson::Value layering{ SerializeLayering(document.GetAllocator()) };
+	rapidjson::StringBuffer buffer;
+	rapidjson::Writer<rapidjson::StringBuffer> writer(buffer);
+	layering.Accept(writer);
+	return std::string{ buffer.GetString(), buffer.GetSize() };
+}
+
 void LoadLayeringData(const rapidjson::Value& layeringObject) {
 	
 	if (layeringObject.HasMember("layerCounter")) {
@@ -1032,879 +927,685 @@ void LoadLayeringData(const rapidjson::Value& layeringObject) {
 	}
 }
 
-Entity Serializer::LoadEntityFromJson(const std::string& fileName, bool isPrefab) {
-	rapidjson::Document document;
-	std::ifstream file(fileName);
-	Entity entity{0};
-	Parent* parent{};
-	Entity parentID{};
-	if (!file.is_open()) {
-		std::cerr << "Failed to open file: " << fileName << std::endl;
-		return entity;
+/*!
+* \brief Loads the components listed in one entity object of a scene or prefab
+*
+* parent and parentID carry the first parent of the file across its entities,
+* so that the children after it are attached to it.
+*
+*/
+/*!
+* \brief Loads a component saved from its field list, replacing the one the entity has
+*/
+template <typename T>
+void LoadReflected(Entity entity, const rapidjson::Value& componentObject) {
+	T component{ LoadDefault<T>() };
+	ReadFields(componentObject, component);
+
+	if (ECS::ecs().HasComponent<T>(entity)) {
+		ECS::ecs().GetComponent<T>(entity) = component;
 	}
-	rapidjson::IStreamWrapper isw(file);
-	document.ParseStream(isw);
-	if (document.HasParseError()) {
-		std::cerr << "Failed to parse .json file: " << fileName << std::endl;
+	else {
+		ECS::ecs().AddComponent<T>(entity, component);
 	}
-	//layering.clear();
-
-	for (rapidjson::SizeType i = 0; i < document.Size(); ++i) {
-		const rapidjson::Value& entityObject = document[i];
-		
-		if (document.Size() > 0 && document[i].HasMember("LayeringSystems")) {
-			const rapidjson::Value& layeringObject = document[0]["LayeringSystems"];
-			LoadLayeringData(layeringObject);
-		}
-		else {
-			entity = 0;
-			if (entityObject.HasMember("Clone")) {
-				const rapidjson::Value& cloneObject = entityObject["Clone"];
-				if (cloneObject.HasMember("Prefab")) {
-					std::string prefabName = cloneObject["Prefab"].GetString();
-					Entity prefabID{ assetmanager.GetPrefab(prefabName) };
-					entity = EntityFactory::entityFactory().CloneMaster(prefabID);
-					const rapidjson::Value& componentSet{ cloneObject["Unique Components"] };
-					Clone& cloneComponent{ ECS::ecs().GetComponent<Clone>(entity) };
-					cloneComponent.prefab = prefabName;
-					for (rapidjson::SizeType s = 0; s < componentSet.Size(); s++) {
-						std::string componentName{ componentSet[s].GetString() };
-						cloneComponent.unique_components.insert(componentName);
-					}
-				}
-				else {
-					entity = ECS::ecs().CreateEntity();
-					(EntityFactory::entityFactory().cloneCounter)++;
-					ECS::ecs().AddComponent(entity, Clone{});
-				}
-				if (!stopButton) {
-					selectedLayer = std::numeric_limits<size_t>().max();
-				}
-			}
+}
 
-			if (entity == 0) {
-				entity = ECS::ecs().CreateEntity();
-				(EntityFactory::entityFactory().cloneCounter)++;
-			}
+void LoadEntityComponents(Entity entity, const rapidjson::Value& entityObject, Parent*& parent, Entity& parentID) {
+	if (entityObject.HasMember("Entity")) {
+		LoadReflected<Name>(entity, entityObject["Entity"]);
+	}
 
-			if (entityObject.HasMember("Entity")) {
-				const rapidjson::Value& nameObject = entityObject["Entity"];
-				Name name{};
-				name.name = nameObject["Name"].GetString();
-				if (nameObject.HasMember("Current Layer")) {
-					name.serializationLayer = nameObject["Current Layer"].GetUint64();
-				}
-				if (nameObject.HasMember("Order in Layer")) {
-					name.serializationOrderInLayer = nameObject["Order in Layer"].GetUint64();
-				}
-				if (nameObject.HasMember("isLocked")) {
-					name.lock = nameObject["isLocked"].GetBool();
-				}
-				if (nameObject.HasMember("isSkipped")) {
-					name.skip = nameObject["isSkipped"].GetBool();
-				}
+	if (entityObject.HasMember("Color")) {
+		LoadReflected<Color>(entity, entityObject["Color"]);
+	}
 
-				if (ECS::ecs().HasComponent<Name>(entity)) {
-					ECS::ecs().GetComponent<Name>(entity) = name;
-				}
-				else {
-					ECS::ecs().AddComponent<Name>(entity, name);
-				}
-			}
+	if (entityObject.HasMember("Transform")) {
+		LoadReflected<Transform>(entity, entityObject["Transform"]);
+	}
 
-			if (entityObject.HasMember("Color")) {
-				const rapidjson::Value& colorObject = entityObject["Color"];
-				Color color{};
-				color.color.r = colorObject["r"].GetFloat();
-				color.color.g = colorObject["g"].GetFloat();
-				color.color.b = colorObject["b"].GetFloat();
-				color.color.a = colorObject["a"].GetFloat();
+	if (entityObject.HasMember("Texture")) {
+		const rapidjson::Value& texObject = entityObject["Texture"];
+		Tex tex;
+		tex.texVariantIndex = texObject["Texture Index"].GetUint();
+		tex.rows = texObject["Rows"].GetUint();
+		tex.cols = texObject["Columns"].GetUint();
+		tex.spritenum = texObject["Sprite Number"].GetUint();
 
-				if (ECS::ecs().HasComponent<Color>(entity)) {
-					ECS::ecs().GetComponent<Color>(entity) = color;
-				}
-				else {
-					ECS::ecs().AddComponent<Color>(entity, color);
-				}
-			}
+		// Get the file path from JSON
+		const char* filePath = texObject["Texture File Path"].GetString();
 
-			if (entityObject.HasMember("Transform")) {
-				const rapidjson::Value& transformObject = entityObject["Transform"];
-				Transform transform;
-				transform.position.x = transformObject["position_x"].GetFloat();
-				transform.position.y = transformObject["position_y"].GetFloat();
-				transform.rotation = transformObject["rotation"].GetFloat();
-				transform.scale = transformObject["scale"].GetFloat();
-				transform.velocity.x = transformObject["velocity_x"].GetFloat();
-				transform.velocity.y = transformObject["velocity_y"].GetFloat();
-
-				if (ECS::ecs().HasComponent<Transform>(entity)) {
-					ECS::ecs().GetComponent<Transform>(entity) = transform;
-				}
-				else {
-					ECS::ecs().AddComponent<Transform>(entity, transform);
-				}
-			}
+		// Attempt to add or retrieve the Texture from the TextureManager
+		Texture* texture = assetmanager.texture.Get(filePath);
 
-			if (entityObject.HasMember("Texture")) {
-				const rapidjson::Value& texObject = entityObject["Texture"];
-				Tex tex;
-				tex.texVariantIndex = texObject["Texture Index"].GetUint();
-				tex.rows = texObject["Rows"].GetUint();
-				tex.cols = texObject["Columns"].GetUint();
-				tex.spritenum = texObject["Sprite Number"].GetUint();
+		if (texture) {
+			tex.tex = texture;
+		}
 
-				// Get the file path from JSON
-				const char* filePath = texObject["Texture File Path"].GetString();
+		if (ECS::ecs().HasComponent<Tex>(entity)) {
+			ECS::ecs().GetComponent<Tex>(entity) = tex;
+		}
+		else {
+			ECS::ecs().AddComponent<Tex>(entity, tex);
+		}
+	}
 
-				// Attempt to add or retrieve the Texture from the TextureManager
-				Texture* texture = assetmanager.texture.Get(filePath);
+	if (entityObject.HasMember("Visible")) {
+		LoadReflected<Visible>(entity, entityObject["Visible"]);
+	}
 
-				if (texture) {
-					tex.tex = texture;
-				}
+	if (entityObject.HasMember("Size")) {
+		LoadReflected<Size>(entity, entityObject["Size"]);
+	}
 
-				if (ECS::ecs().HasComponent<Tex>(entity)) {
-					ECS::ecs().GetComponent<Tex>(entity) = tex;
-				}
-				else {
-					ECS::ecs().AddComponent<Tex>(entity, tex);
-				}
-			}
+	if (entityObject.HasMember("Circle")) {
+		LoadReflected<Circle>(entity, entityObject["Circle"]);
+	}
 
-			if (entityObject.HasMember("Visible")) {
-				const rapidjson::Value& visibleObject = entityObject["Visible"];
-				Visible visible{};
-				visible.isVisible = visibleObject["isVisible"].GetBool();
+	if (entityObject.HasMember("Collision")) {
+		LoadReflected<AABB>(entity, entityObject["Collision"]);
+	}
 
-				if (ECS::ecs().HasComponent<Visible>(entity)) {
-					ECS::ecs().GetComponent<Visible>(entity) = visible;
-				}
-				else {
-					ECS::ecs().AddComponent<Visible>(entity, visible);
-				}
-			}
+	if (entityObject.HasMember("Emitter")) {
+		LoadReflected<Emitter>(entity, entityObject["Emitter"]);
+	}
 
-			if (entityObject.HasMember("Size")) {
-				const rapidjson::Value& sizeObject = entityObject["Size"];
-				Size size{};
-				size.width = sizeObject["width"].GetFloat();
-				size.height = sizeObject["height"].GetFloat();
+	if (entityObject.HasMember("Master")) {
+		if (!ECS::ecs().HasComponent<Master>(entity)) {
+			ECS::ecs().AddComponent(entity, Master{});
+			EntityFactory::entityFactory().masterEntitiesList[ECS::ecs().GetComponent<Name>(entity).name] = entity;
+			++(EntityFactory::entityFactory().masterCounter);
+		}
+	}
+	if (entityObject.HasMember("MainCharacter")) {
+		if (!ECS::ecs().HasComponent<MainCharacter>(entity)) {
+			ECS::ecs().AddComponent(entity, MainCharacter{});
+		}
+	}
+	if (entityObject.HasMember("Model")) {
+		const rapidjson::Value& modelObject = entityObject["Model"];
+		Model model{ modelObject["Model type"].GetInt(),modelObject["Background scroll speed"].GetFloat() };
+		if (modelObject.HasMember("Red")) {
+			glm::vec4 modelColor{};
+			modelColor.r = modelObject["Red"].GetFloat();
+			modelColor.g = modelObject["Green"].GetFloat();
+			modelColor.b = modelObject["Blue"].GetFloat();
+			modelColor.a = modelObject["Alpha"].GetFloat();
+			model.SetColor(modelColor.r, modelColor.g, modelColor.b);
+			model.SetAlpha(modelColor.a);
+		}
 
-				if (ECS::ecs().HasComponent<Size>(entity)) {
-					ECS::ecs().GetComponent<Size>(entity) = size;
-				}
-				else {
-					ECS::ecs().AddComponent<Size>(entity, size);
-				}
-			}
+		if (modelObject.HasMember("Mirror")) {
+			bool mirror{};
+			mirror = modelObject["Mirror"].GetBool();
+			model.SetMirror(mirror);
+		}
 
-			if (entityObject.HasMember("Circle")) {
-				const rapidjson::Value& circleObject = entityObject["Circle"];
-				Circle circle{};
-				circle.radius = circleObject["radius"].GetFloat();
+		if (ECS::ecs().HasComponent<Model>(entity)) {
+			ECS::ecs().GetComponent<Model>(entity) = model;
+		}
+		else {
+			ECS::ecs().AddComponent<Model>(entity, model);
+		}
+	}
+	if (entityObject.HasMember("Collider")) {
+		LoadReflected<Collider>(entity, entityObject["Collider"]);
+	}
+	if (entityObject.HasMember("Movable")) {
+		if (!ECS::ecs().HasComponent<Movable>(entity)) {
+			ECS::ecs().AddComponent(entity, Movable{});
+		}
+	}
 
-				if (ECS::ecs().HasComponent<Circle>(entity)) {
-					ECS::ecs().GetComponent<Circle>(entity) = circle;
-				}
-				else {
-					ECS::ecs().AddComponent<Circle>(entity, circle);
-				}
-			}
+	if (entityObject.HasMember("Temporary")) {
+		ECS::ecs().AddComponent<Temporary>(entity, Temporary{});
+	}
+	if (entityObject.HasMember("CharacterStats")) {
+		const rapidjson::Value& statsObject = entityObject["CharacterStats"];
+		CharacterStats charstats;
+		charstats.stats.attack = statsObject["Attack"].GetFloat();
+		charstats.stats.defense = statsObject["Defense"].GetFloat();
+		charstats.stats.maxHealth = statsObject["Max Health"].GetFloat();
+		charstats.stats.health = charstats.stats.maxHealth;
+		charstats.stats.speed = statsObject["Speed"].GetInt();
+		charstats.tag = (CharacterType)statsObject["Character type"].GetInt();
+		if (statsObject.HasMember("Icon")) {
+			charstats.icon = statsObject["Icon"].GetString();
+		}
+		if (statsObject.HasMember("Boss")) {
+			charstats.boss = statsObject["Boss"].GetBool();
+		}
+		for (auto& a : statsObject["Skills"].GetArray()) {
+			charstats.action.skills.push_back(assetmanager.attacks.data[a.GetString()]);
+		}
 
-			if (entityObject.HasMember("Collision")) {
-				const rapidjson::Value& aabbObject = entityObject["Collision"];
-				AABB aabb;
-				aabb.min.x = aabbObject["Min X"].GetFloat();
-				aabb.min.y = aabbObject["Min Y"].GetFloat();
-				aabb.max.x = aabbObject["Max X"].GetFloat();
-				aabb.max.y = aabbObject["Max Y"].GetFloat();
-				aabb.extents.x = aabbObject["Extent X"].GetFloat();
-				aabb.extents.y = aabbObject["Extent Y"].GetFloat();
-
-				if (ECS::ecs().HasComponent<AABB>(entity)) {
-					ECS::ecs().GetComponent<AABB>(entity) = aabb;
-				}
-				else {
-					ECS::ecs().AddComponent<AABB>(entity, aabb);
-				}
-			}
+		if (statsObject.HasMember("Untargetable")) {
+			charstats.untargetable = statsObject["Untargetable"].GetBool();
+		}
 
-			if (entityObject.HasMember("Emitter")) {
-				const rapidjson::Value& emitterObject = entityObject["Emitter"];
-				Emitter emitter;
-				emitter.position.x= (emitterObject.HasMember("Emitter PositionX")) ? emitterObject["Emitter PositionX"].GetFloat() : 0.f;
-				emitter.position.y = (emitterObject.HasMember("Emitter PositionY")) ? emitterObject["Emitter PositionY"].GetFloat() : 0.f;
-				emitter.emitterLifetime = (emitterObject.HasMember("Emitter Lifetime")) ? emitterObject["Emitter Lifetime"].GetFloat() : 2.f;
-				emitter.size.x = (emitterObject.HasMember("Particles SizeX")) ? emitterObject["Particles SizeX"].GetFloat() : 5.f;
-				emitter.size.y = (emitterObject.HasMember("Particles SizeY")) ? emitterObject["Particles SizeY"].GetFloat() : 5.f;
-				emitter.particleColor.color.r = (emitterObject.HasMember("Particle ColorR")) ? emitterObject["Particle ColorR"].GetFloat() : 1.f;
-				emitter.particleColor.color.g = (emitterObject.HasMember("Particle ColorG")) ? emitterObject["Particle ColorG"].GetFloat() : 1.f;
-				emitter.particleColor.color.b = (emitterObject.HasMember("Particle ColorB")) ? emitterObject["Particle ColorB"].GetFloat() : 1.f;
-				emitter.particleColor.color.a = (emitterObject.HasMember("Particle ColorA")) ? emitterObject["Particle ColorA"].GetFloat() : 1.f;
-				emitter.particlesRate = (emitterObject.HasMember("Particle Rate")) ? emitterObject["Particle Rate"].GetInt() : 1;
-				emitter.frequency = (emitterObject.HasMember("Frequency")) ? emitterObject["Frequency"].GetFloat() : 1.f;
-				emitter.particleLifetime = (emitterObject.HasMember("Particle Lifetime")) ? emitterObject["Particle Lifetime"].GetFloat() : 1.f;
-				emitter.rotation = (emitterObject.HasMember("Rotation")) ? emitterObject["Rotation"].GetFloat() : 0.f;
-				emitter.rotationSpeed = (emitterObject.HasMember("Rotation Speed")) ? emitterObject["Rotation Speed"].GetFloat() : 0.f;
-				emitter.velocity.x = (emitterObject.HasMember("VelocityX")) ? emitterObject["VelocityX"].GetFloat() : 0.f;
-				emitter.velocity.y = (emitterObject.HasMember("VelocityY")) ? emitterObject["VelocityY"].GetFloat() : 0.f;
-				emitter.singleSided = (emitterObject.HasMember("Single Sided")) ? emitterObject["Single Sided"].GetBool() : false;
-
-				if (emitterObject.HasMember("Textures")) {
-					for (auto& a : emitterObject["Textures"].GetArray()) {
-						emitter.textures.push_back(a.GetString());
-					}
-				}
-				
-
-				if (ECS::ecs().HasComponent<Emitter>(entity)) {
-					ECS::ecs().GetComponent<Emitter>(entity) = emitter;
-				}
-				else {
-					ECS::ecs().AddComponent<Emitter>(entity, emitter);
-				}
-			}
-
-			if (entityObject.HasMember("Master")) {
-				if (!ECS::ecs().HasComponent<Master>(entity)) {
-					ECS::ecs().AddComponent(entity, Master{});
-					EntityFactory::entityFactory().masterEntitiesList[ECS::ecs().GetComponent<Name>(entity).name] = entity;
-					++(EntityFactory::entityFactory().masterCounter);
-				}
-			}
-			if (entityObject.HasMember("MainCharacter")) {
-				if (!ECS::ecs().HasComponent<MainCharacter>(entity)) {
-					ECS::ecs().AddComponent(entity, MainCharacter{});
-				}
-			}
-			if (entityObject.HasMember("Model")) {
-				const rapidjson::Value& modelObject = entityObject["Model"];
-				Model model{ modelObject["Model type"].GetInt(),modelObject["Background scroll speed"].GetFloat() };
-				if (modelObject.HasMember("Red")) {
-					glm::vec4 modelColor{};
-					modelColor.r = modelObject["Red"].GetFloat();
-					modelColor.g = modelObject["Green"].GetFloat();
-					modelColor.b = modelObject["Blue"].GetFloat();
-					modelColor.a = modelObject["Alpha"].GetFloat();
-					model.SetColor(modelColor.r, modelColor.g, modelColor.b);
-					model.SetAlpha(modelColor.a);
-				}
-
-				if (modelObject.HasMember("Mirror")) {
-					bool mirror{};
-					mirror = modelObject["Mirror"].GetBool();
-					model.SetMirror(mirror);
-				}
-
-				if (ECS::ecs().HasComponent<Model>(entity)) {
-					ECS::ecs().GetComponent<Model>(entity) = model;
-				}
-				else {
-					ECS::ecs().AddComponent<Model>(entity, model);
-				}
-			}
-			if (entityObject.HasMember("Collider")) {
-				const rapidjson::Value& colliderObject = entityObject["Collider"];
-				Collider collider;
-				int enumID = colliderObject["Collider Enum"].GetInt();
-				if (colliderObject.HasMember("Dimension X")) {
-					collider.dimension.x = colliderObject["Dimension X"].GetFloat();
-					collider.dimension.y = colliderObject["Dimension Y"].GetFloat();
-				}
-				collider.bodyShape = static_cast<Collider::SHAPE_ID>(enumID);
-				if (colliderObject.HasMember("Type")) {
-					int typeID = colliderObject["Type"].GetInt();
-					collider.type = static_cast<Collider::COLLISION_TYPE>(typeID);
-					collider.eventName = colliderObject["Event Name"].GetString();
-					collider.eventInput = colliderObject["Event Input"].GetString();
-				}
-				if (ECS::ecs().HasComponent<Collider>(entity)) {
-					ECS::ecs().GetComponent<Collider>(entity) = collider;
-				}
-				else {
-					ECS::ecs().AddComponent<Collider>(entity, collider);
-				}
-			}
-			if (entityObject.HasMember("Movable")) {
-				if (!ECS::ecs().HasComponent<Movable>(entity)) {
-					ECS::ecs().AddComponent(entity, Movable{});
-				}
-			}
-
-			if (entityObject.HasMember("Temporary")) {
-				ECS::ecs().AddComponent<Temporary>(entity, Temporary{});
-			}
-			if (entityObject.HasMember("CharacterStats")) {
-				const rapidjson::Value& statsObject = entityObject["CharacterStats"];
-				CharacterStats charstats;
-				charstats.stats.attack = statsObject["Attack"].GetFloat();
-				charstats.stats.defense = statsObject["Defense"].GetFloat();
-				charstats.stats.maxHealth = statsObject["Max Health"].GetFloat();
-				charstats.stats.health = charstats.stats.maxHealth;
-				charstats.stats.speed = statsObject["Speed"].GetInt();
-				charstats.tag = (CharacterType)statsObject["Character type"].GetInt();
-				if (statsObject.HasMember("Icon")) {
-					charstats.icon = statsObject["Icon"].GetString();
-				}
-				if (statsObject.HasMember("Boss")) {
-					charstats.boss = statsObject["Boss"].GetBool();
-				}
-				for (auto& a : statsObject["Skills"].GetArray()) {
-					charstats.action.skills.push_back(assetmanager.attacks.data[a.GetString()]);
-				}
-
-				if (statsObject.HasMember("Untargetable")) {
-					charstats.untargetable = statsObject["Untargetable"].GetBool();
-				}
+		if (ECS::ecs().HasComponent<CharacterStats>(entity)) {
+			ECS::ecs().GetComponent<CharacterStats>(entity) = charstats;
+		}
+		else {
+			ECS::ecs().AddComponent<CharacterStats>(entity, charstats);
+		}
+	}
+	if (entityObject.HasMember("Text Label")) {
+		const rapidjson::Value& textObject = entityObject["Text Label"];
+		TextLabel textLabel;
+		std::string fontFamily = textObject["Font Family"].GetString();
+		std::string fontvariant = textObject["Font Variant"].GetString();
+		textLabel.font = fonts.GetFont(fontFamily, fontvariant);
+
+		if (textObject.HasMember("Font Size")) {
+			textLabel.relFontSize = textObject["Font Size"].GetFloat();
+		}
 
-				if (ECS::ecs().HasComponent<CharacterStats>(entity)) {
-					ECS::ecs().GetComponent<CharacterStats>(entity) = charstats;
-				}
-				else {
-					ECS::ecs().AddComponent<CharacterStats>(entity, charstats);
-				}
-			}
-			if (entityObject.HasMember("Text Label")) {
-				const rapidjson::Value& textObject = entityObject["Text Label"];
-				TextLabel textLabel;
-				std::string fontFamily = textObject["Font Family"].GetString();
-				std::string fontvariant = textObject["Font Variant"].GetString();
-				textLabel.font = fonts.GetFont(fontFamily, fontvariant);
-
-				if (textObject.HasMember("Font Size")) {
-					textLabel.relFontSize = textObject["Font Size"].GetFloat();
-				}
+		textLabel.textString = textObject["Text String"].GetString();
 
-				textLabel.textString = textObject["Text String"].GetString();
+		textLabel.textColor.r = textObject["r"].GetFloat();
+		textLabel.textColor.g = textObject["g"].GetFloat();
+		textLabel.textColor.b = textObject["b"].GetFloat();
+		textLabel.textColor.a = textObject["a"].GetFloat();
 
-				textLabel.textColor.r = textObject["r"].GetFloat();
-				textLabel.textColor.g = textObject["g"].GetFloat();
-				textLabel.textColor.b = textObject["b"].GetFloat();
-				textLabel.textColor.a = textObject["a"].GetFloat();
+		textLabel.initClr = textObject["Color Preset"].GetString();
 
-				textLabel.initClr = textObject["Color Preset"].GetString();
+		if (textObject.HasMember("Horizontal Alignment") && textObject.HasMember("Vertical Alignment")) {
+			textLabel.hAlignment = (UI_HORIZONTAL_ALIGNMENT)(textObject["Horizontal Alignment"].GetInt());
+			textLabel.vAlignment = (UI_VERTICAL_ALIGNMENT)(textObject["Vertical Alignment"].GetInt());
+		}
 
-				if (textObject.HasMember("Horizontal Alignment") && textObject.HasMember("Vertical Alignment")) {
-					textLabel.hAlignment = (UI_HORIZONTAL_ALIGNMENT)(textObject["Horizontal Alignment"].GetInt());
-					textLabel.vAlignment = (UI_VERTICAL_ALIGNMENT)(textObject["Vertical Alignment"].GetInt());
-				}
+		if (textObject.HasMember("Text Wrap")) {
+			textLabel.textWrap = (UI_TEXT_WRAP)(textObject["Text Wrap"].GetInt());
+		}
 
-				if (textObject.HasMember("Text Wrap")) {
-					textLabel.textWrap = (UI_TEXT_WRAP)(textObject["Text Wrap"].GetInt());
-				}
+		if (textObject.HasMember("Background")) {
+			textLabel.hasBackground = textObject["Background"].GetBool();
+		}				
 
-				if (textObject.HasMember("Background")) {
-					textLabel.hasBackground = textObject["Background"].GetBool();
-				}				
+		if (ECS::ecs().HasComponent<TextLabel>(entity)) {
+			ECS::ecs().GetComponent<TextLabel>(entity) = textLabel;
+		}
+		else {
+			ECS::ecs().AddComponent<TextLabel>(entity, textLabel);
+		}
+	}
+	if (entityObject.HasMember("Button")) {
+		const rapidjson::Value& buttonObject = entityObject["Button"];
+		Button button;
+		glm::vec4 buttonColor{};
+		glm::vec4 textColor{};
+		// init with default ColorSet
+		if (buttonObject.HasMember("Default Button R") && buttonObject.HasMember("Default Button G") &&
+			buttonObject.HasMember("Default Button B") && buttonObject.HasMember("Default Button A")) {
+			buttonColor.r = buttonObject["Default Button R"].GetFloat();
+			buttonColor.g = buttonObject["Default Button G"].GetFloat();
+			buttonColor.b = buttonObject["Default Button B"].GetFloat();
+			buttonColor.a = buttonObject["Default Button A"].GetFloat();
+		}
+		if (buttonObject.HasMember("Default Text R") && buttonObject.HasMember("Default Text G") &&
+			buttonObject.HasMember("Default Text B") && buttonObject.HasMember("Default Text A")) {
+			textColor.r = buttonObject["Default Text R"].GetFloat();
+			textColor.g = buttonObject["Default Text G"].GetFloat();
+			textColor.b = buttonObject["Default Text B"].GetFloat();
+			textColor.a = buttonObject["Default Text A"].GetFloat();
+		}
+		button = { buttonColor, textColor };
+
+		// load hovered and focused ColorSets
+		if (buttonObject.HasMember("Hovered Button R") && buttonObject.HasMember("Hovered Button G") &&
+			buttonObject.HasMember("Hovered Button B") && buttonObject.HasMember("Hovered Button A")) {
+			buttonColor.r = buttonObject["Hovered Button R"].GetFloat();
+			buttonColor.g = buttonObject["Hovered Button G"].GetFloat();
+			buttonColor.b = buttonObject["Hovered Button B"].GetFloat();
+			buttonColor.a = buttonObject["Hovered Button A"].GetFloat();
+		}
+		if (buttonObject.HasMember("Hovered Text R") && buttonObject.HasMember("Hovered Text G") &&
+			buttonObject.HasMember("Hovered Text B") && buttonObject.HasMember("Hovered Text A")) {
+			textColor.r = buttonObject["Hovered Text R"].GetFloat();
+			textColor.g = buttonObject["Hovered Text G"].GetFloat();
+			textColor.b = buttonObject["Hovered Text B"].GetFloat();
+			textColor.a = buttonObject["Hovered Text A"].GetFloat();
+		}
+		button.hoveredColor = { buttonColor, textColor };
+
+		if (buttonObject.HasMember("Focused Button R") && buttonObject.HasMember("Focused Button G") &&
+			buttonObject.HasMember("Focused Button B") && buttonObject.HasMember("Focused Button A")) {
+			buttonColor.r = buttonObject["Focused Button R"].GetFloat();
+			buttonColor.g = buttonObject["Focused Button G"].GetFloat();
+			buttonColor.b = buttonObject["Focused Button B"].GetFloat();
+			buttonColor.a = buttonObject["Focused Button A"].GetFloat();
+		}
+		if (buttonObject.HasMember("Focused Text R") && buttonObject.HasMember("Focused Text G") &&
+			buttonObject.HasMember("Focused Text B") && buttonObject.HasMember("Focused Text A")) {
+			textColor.r = buttonObject["Focused Text R"].GetFloat();
+			textColor.g = buttonObject["Focused Text G"].GetFloat();
+			textColor.b = buttonObject["Focused Text B"].GetFloat();
+			textColor.a = buttonObject["Focused Text A"].GetFloat();
+		}
+		button.focusedColor = { buttonColor, textColor };
+
+
+		if (buttonObject.HasMember("Padding Top") && buttonObject.HasMember("Padding Bottom") &&
+			buttonObject.HasMember("Padding Left") && buttonObject.HasMember("Padding Right")) {
+			button.padding.top = buttonObject["Padding Top"].GetFloat();
+			button.padding.bottom = buttonObject["Padding Bottom"].GetFloat();
+			button.padding.left = buttonObject["Padding Left"].GetFloat();
+			button.padding.right = buttonObject["Padding Right"].GetFloat();
+			if (buttonObject.HasMember("Padding Setting")) {
+				button.padding.setting = buttonObject["Padding Setting"].GetInt();
+			}					
+		}
 
-				if (ECS::ecs().HasComponent<TextLabel>(entity)) {
-					ECS::ecs().GetComponent<TextLabel>(entity) = textLabel;
-				}
-				else {
-					ECS::ecs().AddComponent<TextLabel>(entity, textLabel);
-				}
-			}
-			if (entityObject.HasMember("Button")) {
-				const rapidjson::Value& buttonObject = entityObject["Button"];
-				Button button;
-				glm::vec4 buttonColor{};
-				glm::vec4 textColor{};
-				// init with default ColorSet
-				if (buttonObject.HasMember("Default Button R") && buttonObject.HasMember("Default Button G") &&
-					buttonObject.HasMember("Default Button B") && buttonObject.HasMember("Default Button A")) {
-					buttonColor.r = buttonObject["Default Button R"].GetFloat();
-					buttonColor.g = buttonObject["Default Button G"].GetFloat();
-					buttonColor.b = buttonObject["Default Button B"].GetFloat();
-					buttonColor.a = buttonObject["Default Button A"].GetFloat();
-				}
-				if (buttonObject.HasMember("Default Text R") && buttonObject.HasMember("Default Text G") &&
-					buttonObject.HasMember("Default Text B") && buttonObject.HasMember("Default Text A")) {
-					textColor.r = buttonObject["Default Text R"].GetFloat();
-					textColor.g = buttonObject["Default Text G"].GetFloat();
-					textColor.b = buttonObject["Default Text B"].GetFloat();
-					textColor.a = buttonObject["Default Text A"].GetFloat();
-				}
-				button = { buttonColor, textColor };
-
-				// load hovered and focused ColorSets
-				if (buttonObject.HasMember("Hovered Button R") && buttonObject.HasMember("Hovered Button G") &&
-					buttonObject.HasMember("Hovered Button B") && buttonObject.HasMember("Hovered Button A")) {
-					buttonColor.r = buttonObject["Hovered Button R"].GetFloat();
-					buttonColor.g = buttonObject["Hovered Button G"].GetFloat();
-					buttonColor.b = buttonObject["Hovered Button B"].GetFloat();
-					buttonColor.a = buttonObject["Hovered Button A"].GetFloat();
-				}
-				if (buttonObject.HasMember("Hovered Text R") && buttonObject.HasMember("Hovered Text G") &&
-					buttonObject.HasMember("Hovered Text B") && buttonObject.HasMember("Hovered Text A")) {
-					textColor.r = buttonObject["Hovered Text R"].GetFloat();
-					textColor.g = buttonObject["Hovered Text G"].GetFloat();
-					textColor.b = buttonObject["Hovered Text B"].GetFloat();
-					textColor.a = buttonObject["Hovered Text A"].GetFloat();
-				}
-				button.hoveredColor = { buttonColor, textColor };
-
-				if (buttonObject.HasMember("Focused Button R") && buttonObject.HasMember("Focused Button G") &&
-					buttonObject.HasMember("Focused Button B") && buttonObject.HasMember("Focused Button A")) {
-					buttonColor.r = buttonObject["Focused Button R"].GetFloat();
-					buttonColor.g = buttonObject["Focused Button G"].GetFloat();
-					buttonColor.b = buttonObject["Focused Button B"].GetFloat();
-					buttonColor.a = buttonObject["Focused Button A"].GetFloat();
-				}
-				if (buttonObject.HasMember("Focused Text R") && buttonObject.HasMember("Focused Text G") &&
-					buttonObject.HasMember("Focused Text B") && buttonObject.HasMember("Focused Text A")) {
-					textColor.r = buttonObject["Focused Text R"].GetFloat();
-					textColor.g = buttonObject["Focused Text G"].GetFloat();
-					textColor.b = buttonObject["Focused Text B"].GetFloat();
-					textColor.a = buttonObject["Focused Text A"].GetFloat();
-				}
-				button.focusedColor = { buttonColor, textColor };
-
-
-				if (buttonObject.HasMember("Padding Top") && buttonObject.HasMember("Padding Bottom") &&
-					buttonObject.HasMember("Padding Left") && buttonObject.HasMember("Padding Right")) {
-					button.padding.top = buttonObject["Padding Top"].GetFloat();
-					button.padding.bottom = buttonObject["Padding Bottom"].GetFloat();
-					button.padding.left = buttonObject["Padding Left"].GetFloat();
-					button.padding.right = buttonObject["Padding Right"].GetFloat();
-					if (buttonObject.HasMember("Padding Setting")) {
-						button.padding.setting = buttonObject["Padding Setting"].GetInt();
-					}					
-				}
+		if (buttonObject.HasMember("Event Name")) {
+			button.eventName = buttonObject["Event Name"].GetString();
+		}
 
-				if (buttonObject.HasMember("Event Name")) {
-					button.eventName = buttonObject["Event Name"].GetString();
-				}
+		if (buttonObject.HasMember("Event Input")) {
+			button.eventInput = buttonObject["Event Input"].GetString();
+		}
 
-				if (buttonObject.HasMember("Event Input")) {
-					button.eventInput = buttonObject["Event Input"].GetString();
+		if (ECS::ecs().HasComponent<Button>(entity)) {
+			ECS::ecs().GetComponent<Button>(entity) = button;
+		}
+		else {
+			ECS::ecs().AddComponent<Button>(entity, button);
+		}
+	}
+	if (entityObject.HasMember("HealthBar")) {
+		LoadReflected<HealthBar>(entity, entityObject["HealthBar"]);
+	}
+	if (entityObject.HasMember("HealthRemaining")) {
+		LoadReflected<HealthRemaining>(entity, entityObject["HealthRemaining"]);
+	}
+	if (entityObject.HasMember("HealthLerp")) {
+		ECS::ecs().AddComponent<HealthLerp>(entity, HealthLerp{});
+	}
+	if (entityObject.HasMember("SkillPointHUD")) {
+		LoadReflected<SkillPointHUD>(entity, entityObject["SkillPointHUD"]);
+	}
+	if (entityObject.HasMember("SkillPoint")) {
+		LoadReflected<SkillPoint>(entity, entityObject["SkillPoint"]);
+	}
+	if (entityObject.HasMember("AttackSkill")) {
+		LoadReflected<AttackSkill>(entity, entityObject["AttackSkill"]);
+	}
+	if (entityObject.HasMember("SkillIcon")) {
+		ECS::ecs().AddComponent<SkillIcon>(entity, SkillIcon{});
+	}
+	if (entityObject.HasMember("SkillCost")) {
+		ECS::ecs().AddComponent<SkillCost>(entity, SkillCost{});
+	}
+	if (entityObject.HasMember("SkillAttackType")) {
+		ECS::ecs().AddComponent<SkillAttackType>(entity, SkillAttackType{});
+	}
+	if (entityObject.HasMember("AllyHUD")) {
+		LoadReflected<AllyHUD>(entity, entityObject["AllyHUD"]);
+	}
+	if (entityObject.HasMember("EnemyHUD")) {
+		LoadReflected<EnemyHUD>(entity, entityObject["EnemyHUD"]);
+	}
+	if (entityObject.HasMember("DialogueSpeaker")) {
+		ECS::ecs().AddComponent<DialogueSpeaker>(entity, DialogueSpeaker{});
+	}
+	if (entityObject.HasMember("DialogueHUD")) {
+		DialogueHUD dialogueHud;
+		const rapidjson::Value& dialogueHudObject = entityObject["DialogueHUD"];
+
+		// Check for dialogues
+		if (dialogueHudObject.HasMember("Dialogues") && dialogueHudObject["Dialogues"].IsArray()) {
+			const rapidjson::Value& dialoguesArray = dialogueHudObject["Dialogues"];
+			for (rapidjson::SizeType j = 0; j < dialoguesArray.Size(); ++j) {
+				const rapidjson::Value& dialogueObject = dialoguesArray[j];
+				DialogueHUD::Dialogue dialogue;
+
+				// Check if any dialogue lines have been added
+				if (dialogueObject.HasMember("Dialogue Lines") && dialogueObject["Dialogue Lines"].IsArray()) {
+					const rapidjson::Value& dialogueLinesArray = dialogueObject["Dialogue Lines"];
+					for (rapidjson::SizeType k = 0; k < dialogueLinesArray.Size(); ++k) {
+						if (dialogueLinesArray[k].IsObject()) {
+							DialogueHUD::DialogueLine line;
+							line.speaker = dialogueLinesArray[k]["Speaker"].GetString();
+							line.line = dialogueLinesArray[k]["Line"].GetString();
+							if (dialogueLinesArray[k].HasMember("Voice")) {
+								line.voice = dialogueLinesArray[k]["Voice"].GetString();
+							}
+							dialogue.dialogueLines.push_back(line);
+						}
+					}
 				}
 
-				if (ECS::ecs().HasComponent<Button>(entity)) {
-					ECS::ecs().GetComponent<Button>(entity) = button;
+				if (dialogueObject.HasMember("Trigger Type")) {
+					dialogue.triggerType = static_cast<DIALOGUE_TRIGGER>(dialogueObject["Trigger Type"].GetInt());
 				}
-				else {
-					ECS::ecs().AddComponent<Button>(entity, button);
+				if (dialogueObject.HasMember("Round Trigger")) {
+					dialogue.roundTrigger = dialogueObject["Round Trigger"].GetInt();
 				}
-			}
-			if (entityObject.HasMember("HealthBar")) {
-				HealthBar hpBar;
-				const rapidjson::Value& hpBarObject = entityObject["HealthBar"];
-
-				if (hpBarObject.HasMember("Show Health Stat") && hpBarObject.HasMember("Show Value or Percentage")) {
-					hpBar.showHealthStat = hpBarObject["Show Health Stat"].GetBool();
-					hpBar.showValOrPct = hpBarObject["Show Value or Percentage"].GetBool();
+				if (dialogueObject.HasMember("Health Trigger")) {
+					dialogue.healthTrigger = dialogueObject["Health Trigger"].GetInt();
 				}
-				
-				hpBar.barWidth = hpBarObject["Bar Width"].GetFloat();
-				hpBar.barHeight = hpBarObject["Bar Height"].GetFloat();
-
-				hpBar.currentHealth = hpBarObject["Current Health"].GetFloat();
-				hpBar.maxHealth = hpBarObject["Max Health"].GetFloat();
-				hpBar.healthPct = hpBarObject["Health Percentage"].GetFloat();
 
-				if (ECS::ecs().HasComponent<HealthBar>(entity)) {
-					ECS::ecs().GetComponent<HealthBar>(entity) = hpBar;
+				if (dialogueObject.HasMember("Viewing Index")) {
+					dialogue.viewingIndex = dialogueObject["Viewing Index"].GetInt();
 				}
-				else {
-					ECS::ecs().AddComponent<HealthBar>(entity, hpBar);
-				}
-			}
-			if (entityObject.HasMember("HealthRemaining")) {
-				HealthRemaining hpRemBar;
-				const rapidjson::Value& hpBarObject = entityObject["HealthRemaining"];
-				hpRemBar.currentHealth = hpBarObject["Current Health"].GetFloat();
 
-				if (ECS::ecs().HasComponent<HealthRemaining>(entity)) {
-					ECS::ecs().GetComponent<HealthRemaining>(entity) = hpRemBar;
-				}
-				else {
-					ECS::ecs().AddComponent<HealthRemaining>(entity, hpRemBar);
-				}
-			}
-			if (entityObject.HasMember("HealthLerp")) {
-				ECS::ecs().AddComponent<HealthLerp>(entity, HealthLerp{});
-			}
-			if (entityObject.HasMember("SkillPointHUD")) {
-				SkillPointHUD spHud;
-				const rapidjson::Value& spHudObject = entityObject["SkillPointHUD"];
-				spHud.skillPointBalance = spHudObject["Skill Point Balance"].GetInt();
-				spHud.maxSkillPoints = spHudObject["Skill Point Cap"].GetInt();
-
-				if (ECS::ecs().HasComponent<SkillPointHUD>(entity)) {
-					ECS::ecs().GetComponent<SkillPointHUD>(entity) = spHud;
+				if (dialogueObject.HasMember("Display Duration")) {
+					dialogue.displayDuration = dialogueObject["Display Duration"].GetFloat();
 				}
-				else {
-					ECS::ecs().AddComponent<SkillPointHUD>(entity, spHud);
-				}
-			}
-			if (entityObject.HasMember("SkillPoint")) {
-				SkillPoint skillpt;
-				const rapidjson::Value& spObject = entityObject["SkillPoint"];
-				skillpt.isActive = spObject["Active State"].GetBool();
 
-				if (ECS::ecs().HasComponent<SkillPoint>(entity)) {
-					ECS::ecs().GetComponent<SkillPoint>(entity) = skillpt;
+				if (dialogueObject.HasMember("Is Active")) {
+					dialogue.isActive = dialogueObject["Is Active"].GetBool();
 				}
-				else {
-					ECS::ecs().AddComponent<SkillPoint>(entity, skillpt);
-				}
-			}
-			if (entityObject.HasMember("AttackSkill")) {
-				AttackSkill atkSkill;
-				const rapidjson::Value& atkSkillObject = entityObject["AttackSkill"];
-				atkSkill.skillIndex = atkSkillObject["Skill Index"].GetInt();
 
-				if (ECS::ecs().HasComponent<AttackSkill>(entity)) {
-					ECS::ecs().GetComponent<AttackSkill>(entity) = atkSkill;
-				}
-				else {
-					ECS::ecs().AddComponent<AttackSkill>(entity, atkSkill);
-				}
-			}
-			if (entityObject.HasMember("SkillIcon")) {
-				ECS::ecs().AddComponent<SkillIcon>(entity, SkillIcon{});
-			}
-			if (entityObject.HasMember("SkillCost")) {
-				ECS::ecs().AddComponent<SkillCost>(entity, SkillCost{});
-			}
-			if (entityObject.HasMember("SkillAttackType")) {
-				ECS::ecs().AddComponent<SkillAttackType>(entity, SkillAttackType{});
-			}
-			if (entityObject.HasMember("AllyHUD")) {
-				AllyHUD allyHud;
-				const rapidjson::Value& allyHudObject = entityObject["AllyHUD"];
-				if (allyHudObject.HasMember("Ally Index")) {
-					allyHud.allyIndex = allyHudObject["Ally Index"].GetInt();
+				if (dialogueObject.HasMember("Is Triggered")) {
+					dialogue.isTriggered = dialogueObject["Is Triggered"].GetBool();
 				}
-
-				if (ECS::ecs().HasComponent<AllyHUD>(entity)) {
-					ECS::ecs().GetComponent<AllyHUD>(entity) = allyHud;
+				/*if (dialogueHudObject.HasMember("Auto Launch")) {
+					dialogue.autoLaunch = dialogueHudObject["Auto Launch"].GetBool();
+				}*/
+				if (dialogueObject.HasMember("Speaker Required")) {
+					dialogue.speakerRequired = dialogueObject["Speaker Required"].GetBool();
 				}
-				else {
-					ECS::ecs().AddComponent<AllyHUD>(entity, allyHud);
+				if (dialogueObject.HasMember("Post Dialogue Scene")) {
+					dialogue.postDialogueScene = dialogueObject["Post Dialogue Scene"].GetBool();
 				}
-			}
-			if (entityObject.HasMember("EnemyHUD")) {
-				EnemyHUD enemyHud;
-				const rapidjson::Value& enemyHudObject = entityObject["EnemyHUD"];
-				if (enemyHudObject.HasMember("Enemy Index")) {
-					enemyHud.enemyIndex = enemyHudObject["Enemy Index"].GetInt();
+				if (dialogueObject.HasMember("Target Scene")) {
+					dialogue.targetScene = dialogueObject["Target Scene"].GetString();
 				}
 
-				if (ECS::ecs().HasComponent<EnemyHUD>(entity)) {
-					ECS::ecs().GetComponent<EnemyHUD>(entity) = enemyHud;
-				}
-				else {
-					ECS::ecs().AddComponent<EnemyHUD>(entity, enemyHud);
-				}
+				dialogueHud.dialogues.push_back(dialogue);
 			}
-			if (entityObject.HasMember("DialogueSpeaker")) {
-				ECS::ecs().AddComponent<DialogueSpeaker>(entity, DialogueSpeaker{});
-			}
-			if (entityObject.HasMember("DialogueHUD")) {
-				DialogueHUD dialogueHud;
-				const rapidjson::Value& dialogueHudObject = entityObject["DialogueHUD"];
-
-				// Check for dialogues
-				if (dialogueHudObject.HasMember("Dialogues") && dialogueHudObject["Dialogues"].IsArray()) {
-					const rapidjson::Value& dialoguesArray = dialogueHudObject["Dialogues"];
-					for (rapidjson::SizeType j = 0; j < dialoguesArray.Size(); ++j) {
-						const rapidjson::Value& dialogueObject = dialoguesArray[j];
-						DialogueHUD::Dialogue dialogue;
-
-						// Check if any dialogue lines have been added
-						if (dialogueObject.HasMember("Dialogue Lines") && dialogueObject["Dialogue Lines"].IsArray()) {
-							const rapidjson::Value& dialogueLinesArray = dialogueObject["Dialogue Lines"];
-							for (rapidjson::SizeType k = 0; k < dialogueLinesArray.Size(); ++k) {
-								if (dialogueLinesArray[k].IsObject()) {
-									DialogueHUD::DialogueLine line;
-									line.speaker = dialogueLinesArray[k]["Speaker"].GetString();
-									line.line = dialogueLinesArray[k]["Line"].GetString();
-									if (dialogueLinesArray[k].HasMember("Voice")) {
-										line.voice = dialogueLinesArray[k]["Voice"].GetString();
-									}
-									dialogue.dialogueLines.push_back(line);
-								}
-							}
-						}
-
-						if (dialogueObject.HasMember("Trigger Type")) {
-							dialogue.triggerType = static_cast<DIALOGUE_TRIGGER>(dialogueObject["Trigger Type"].GetInt());
-						}
-						if (dialogueObject.HasMember("Round Trigger")) {
-							dialogue.roundTrigger = dialogueObject["Round Trigger"].GetInt();
-						}
-						if (dialogueObject.HasMember("Health Trigger")) {
-							dialogue.healthTrigger = dialogueObject["Health Trigger"].GetInt();
-						}
-
-						if (dialogueObject.HasMember("Viewing Index")) {
-							dialogue.viewingIndex = dialogueObject["Viewing Index"].GetInt();
-						}
-
-						if (dialogueObject.HasMember("Display Duration")) {
-							dialogue.displayDuration = dialogueObject["Display Duration"].GetFloat();
-						}
+		}						
 
-						if (dialogueObject.HasMember("Is Active")) {
-							dialogue.isActive = dialogueObject["Is Active"].GetBool();
-						}
+		if (ECS::ecs().HasComponent<DialogueHUD>(entity)) {
+			ECS::ecs().GetComponent<DialogueHUD>(entity) = dialogueHud;
+		}
+		else {
+			ECS::ecs().AddComponent<DialogueHUD>(entity, dialogueHud);
+		}
+	}
+	if (entityObject.HasMember("TurnIndicator")) {
+		ECS::ecs().AddComponent<TurnIndicator>(entity, TurnIndicator{});
+	}
+	if (entityObject.HasMember("StatusEffect")) {
+		ECS::ecs().AddComponent<StatusEffect>(entity, StatusEffect{});
+	}
+	if (entityObject.HasMember("Animation Set")) {
+		AnimationSet animset{};
+		
+		if (entityObject.HasMember("Animation Set Default Animation")) {
+			const rapidjson::Value& defaultanimObject = entityObject["Animation Set Default Animation"];
+			animset.defaultAnimation = defaultanimObject.GetString();
+		}
 
-						if (dialogueObject.HasMember("Is Triggered")) {
-							dialogue.isTriggered = dialogueObject["Is Triggered"].GetBool();
+		for (auto& animGroups : entityObject["Animation Set"].GetArray()) {
+			AnimationGroup anigrp{};
+			anigrp.totalFrames = animGroups["Total Frames"].GetInt();
+			anigrp.name = animGroups["Group Name"].GetString();
+			anigrp.loop = animGroups["Loop"].GetBool();
+			if (animGroups.HasMember("Frame Time")) {
+				anigrp.frametime = animGroups["Frame Time"].GetFloat();
+			}
+			for (auto& animations : animGroups["Animations"].GetArray()) {
+				std::string animType = animations["Animation Type"].GetString();
+				if (animType == "Sprite") {
+					SpriteAnimation a{};
+					for (auto& k : animations["Key Frames"].GetArray()) {
+						bool data{ false };
+						if (k.HasMember("Reverse")) {
+							data = k["Reverse"].GetBool();
 						}
-						/*if (dialogueHudObject.HasMember("Auto Launch")) {
-							dialogue.autoLaunch = dialogueHudObject["Auto Launch"].GetBool();
-						}*/
-						if (dialogueObject.HasMember("Speaker Required")) {
-							dialogue.speakerRequired = dialogueObject["Speaker Required"].GetBool();
-						}
-						if (dialogueObject.HasMember("Post Dialogue Scene")) {
-							dialogue.postDialogueScene = dialogueObject["Post Dialogue Scene"].GetBool();
+						a.AddKeyFrame(k["Frame Number"].GetInt(), &data);
+					}
+					anigrp.animations.push_back(std::make_shared<SpriteAnimation>(a));
+				}
+				else if (animType == "TextureChange") {
+					ChangeTexAnimation a{};
+					for (auto& k : animations["Key Frames"].GetArray()) {
+						std::string data{ k["Texture"].GetString() };
+						a.AddKeyFrame(k["Frame Number"].GetInt(), &data);
+					}
+					anigrp.animations.push_back(std::make_shared<ChangeTexAnimation>(a));
+				}
+				else if (animType == "Sound") {
+					SoundAnimation a{};
+					for (auto& k : animations["Key Frames"].GetArray()) {
+						std::vector<std::string> data{};
+						if (k.HasMember("Sound")) {
+							data.push_back(k["Sound"].GetString());
 						}
-						if (dialogueObject.HasMember("Target Scene")) {
-							dialogue.targetScene = dialogueObject["Target Scene"].GetString();
+						else if (k.HasMember("Sounds")) {
+							for (auto& s : k["Sounds"].GetArray()) {
+								data.push_back(s.GetString());
+							}
 						}
-
-						dialogueHud.dialogues.push_back(dialogue);
+						a.AddKeyFrame(k["Frame Number"].GetInt(), &data);
 					}
-				}						
-
-				if (ECS::ecs().HasComponent<DialogueHUD>(entity)) {
-					ECS::ecs().GetComponent<DialogueHUD>(entity) = dialogueHud;
+					anigrp.animations.push_back(std::make_shared<SoundAnimation>(a));
 				}
-				else {
-					ECS::ecs().AddComponent<DialogueHUD>(entity, dialogueHud);
+				else if (animType == "Swap") {
+					SwapAnimation a{};
+					for (auto& k : animations["Key Frames"].GetArray()) {
+						std::string data{ k["Destination"].GetString() };
+						a.AddKeyFrame(k["Frame Number"].GetInt(), &data);
+					}
+					anigrp.animations.push_back(std::make_shared<SwapAnimation>(a));
 				}
-			}
-			if (entityObject.HasMember("TurnIndicator")) {
-				ECS::ecs().AddComponent<TurnIndicator>(entity, TurnIndicator{});
-			}
-			if (entityObject.HasMember("StatusEffect")) {
-				ECS::ecs().AddComponent<StatusEffect>(entity, StatusEffect{});
-			}
-			if (entityObject.HasMember("Animation Set")) {
-				AnimationSet animset{};
-				
-				if (entityObject.HasMember("Animation Set Default Animation")) {
-					const rapidjson::Value& defaultanimObject = entityObject["Animation Set Default Animation"];
-					animset.defaultAnimation = defaultanimObject.GetString();
+				else if (animType == "TransformAttach") {
+					TransformAttachAnimation a{};
+					for (auto& k : animations["Key Frames"].GetArray()) {
+						std::string data = k["Target"].GetString();
+						a.AddKeyFrame(k["Frame Number"].GetInt(), &data);
+					}
+					anigrp.animations.push_back(std::make_shared<TransformAttachAnimation>(a));
+				}
+				else if (animType == "TransformDirect") {
+					TransformDirectAnimation a{};
+					for (auto& k : animations["Key Frames"].GetArray()) {
+						Transform data{};
+						data.position.x = k["X movement"].GetFloat();
+						data.position.y = k["Y movement"].GetFloat();
+						data.rotation = k["Rotation"].GetFloat();
+						data.scale = k["Scale"].GetFloat();
+						a.AddKeyFrame(k["Frame Number"].GetInt(), &data);
+					}
+					anigrp.animations.push_back(std::make_shared<TransformDirectAnimation>(a));
+				}
+				else if (animType == "Color") {
+					ColorAnimation a{};
+					for (auto& k : animations["Key Frames"].GetArray()) {
+						glm::vec3 data{};
+						data.r = k["Red"].GetFloat();
+						data.g = k["Green"].GetFloat();
+						data.b = k["Blue"].GetFloat();
+						a.AddKeyFrame(k["Frame Number"].GetInt(), &data);
+					}
+					anigrp.animations.push_back(std::make_shared<ColorAnimation>(a));
 				}
-
-				for (auto& animGroups : entityObject["Animation Set"].GetArray()) {
-					AnimationGroup anigrp{};
-					anigrp.totalFrames = animGroups["Total Frames"].GetInt();
-					anigrp.name = animGroups["Group Name"].GetString();
-					anigrp.loop = animGroups["Loop"].GetBool();
-					if (animGroups.HasMember("Frame Time")) {
-						anigrp.frametime = animGroups["Frame Time"].GetFloat();
+				else if (animType == "Fade") {
+					FadeAnimation a{};
+					for (auto& k : animations["Key Frames"].GetArray()) {
+						float data{ k["Alpha"].GetFloat() };
+						a.AddKeyFrame(k["Frame Number"].GetInt(), &data);
 					}
-					for (auto& animations : animGroups["Animations"].GetArray()) {
-						std::string animType = animations["Animation Type"].GetString();
-						if (animType == "Sprite") {
-							SpriteAnimation a{};
-							for (auto& k : animations["Key Frames"].GetArray()) {
-								bool data{ false };
-								if (k.HasMember("Reverse")) {
-									data = k["Reverse"].GetBool();
-								}
-								a.AddKeyFrame(k["Frame Number"].GetInt(), &data);
-							}
-							anigrp.animations.push_back(std::make_shared<SpriteAnimation>(a));
-						}
-						else if (animType == "TextureChange") {
-							ChangeTexAnimation a{};
-							for (auto& k : animations["Key Frames"].GetArray()) {
-								std::string data{ k["Texture"].GetString() };
-								a.AddKeyFrame(k["Frame Number"].GetInt(), &data);
-							}
-							anigrp.animations.push_back(std::make_shared<ChangeTexAnimation>(a));
-						}
-						else if (animType == "Sound") {
-							SoundAnimation a{};
-							for (auto& k : animations["Key Frames"].GetArray()) {
-								std::vector<std::string> data{};
-								if (k.HasMember("Sound")) {
-									data.push_back(k["Sound"].GetString());
-								}
-								else if (k.HasMember("Sounds")) {
-									for (auto& s : k["Sounds"].GetArray()) {
-										data.push_back(s.GetString());
-									}
-								}
-								a.AddKeyFrame(k["Frame Number"].GetInt(), &data);
-							}
-							anigrp.animations.push_back(std::make_shared<SoundAnimation>(a));
-						}
-						else if (animType == "Swap") {
-							SwapAnimation a{};
-							for (auto& k : animations["Key Frames"].GetArray()) {
-								std::string data{ k["Destination"].GetString() };
-								a.AddKeyFrame(k["Frame Number"].GetInt(), &data);
-							}
-							anigrp.animations.push_back(std::make_shared<SwapAnimation>(a));
-						}
-						else if (animType == "TransformAttach") {
-							TransformAttachAnimation a{};
-							for (auto& k : animations["Key Frames"].GetArray()) {
-								std::string data = k["Target"].GetString();
-								a.AddKeyFrame(k["Frame Number"].GetInt(), &data);
-							}
-							anigrp.animations.push_back(std::make_shared<TransformAttachAnimation>(a));
-						}
-						else if (animType == "TransformDirect") {
-							TransformDirectAnimation a{};
-							for (auto& k : animations["Key Frames"].GetArray()) {
-								Transform data{};
-								data.position.x = k["X movement"].GetFloat();
-								data.position.y = k["Y movement"].GetFloat();
-								data.rotation = k["Rotation"].GetFloat();
-								data.scale = k["Scale"].GetFloat();
-								a.AddKeyFrame(k["Frame Number"].GetInt(), &data);
-							}
-							anigrp.animations.push_back(std::make_shared<TransformDirectAnimation>(a));
-						}
-						else if (animType == "Color") {
-							ColorAnimation a{};
-							for (auto& k : animations["Key Frames"].GetArray()) {
-								glm::vec3 data{};
-								data.r = k["Red"].GetFloat();
-								data.g = k["Green"].GetFloat();
-								data.b = k["Blue"].GetFloat();
-								a.AddKeyFrame(k["Frame Number"].GetInt(), &data);
-							}
-							anigrp.animations.push_back(std::make_shared<ColorAnimation>(a));
-						}
-						else if (animType == "Fade") {
-							FadeAnimation a{};
-							for (auto& k : animations["Key Frames"].GetArray()) {
-								float data{ k["Alpha"].GetFloat() };
-								a.AddKeyFrame(k["Frame Number"].GetInt(), &data);
-							}
-							anigrp.animations.push_back(std::make_shared<FadeAnimation>(a));
-						}
-						else if (animType == "SelfDestruct") {
-							SelfDestructAnimation a{};
-							for (auto& k : animations["Key Frames"].GetArray()) {
-								a.AddKeyFrame(k["Frame Number"].GetInt(), nullptr);
-							}
-							anigrp.animations.push_back(std::make_shared<SelfDestructAnimation>(a));
-						}
-						else if (animType == "DamageImpact") {
-							DamageImpactAnimation a{};
-							for (auto& k : animations["Key Frames"].GetArray()) {
-								std::string data{};
-								if (k.HasMember("Prefab")) {
-									data = k["Prefab"].GetString();
-								}
-								a.AddKeyFrame(k["Frame Number"].GetInt(), &data);
-							}
-							anigrp.animations.push_back(std::make_shared<DamageImpactAnimation>(a));
-						}
-						else if (animType == "CameraZoom") {
-							CameraZoomAnimation a{};
-							for (auto& k : animations["Key Frames"].GetArray()) {
-								float data{ k["Zoom"].GetFloat() };
-								a.AddKeyFrame(k["Frame Number"].GetInt(), &data);
-							}
-							anigrp.animations.push_back(std::make_shared<CameraZoomAnimation>(a));
-						}
-						else if (animType == "CameraTarget") {
-							CameraTargetAnimation a{};
-							for (auto& k : animations["Key Frames"].GetArray()) {
-								a.AddKeyFrame(k["Frame Number"].GetInt(), nullptr);
-							}
-							anigrp.animations.push_back(std::make_shared<CameraTargetAnimation>(a));
-						}
-						else if (animType == "CameraReset") {
-							CameraResetAnimation a{};
-							for (auto& k : animations["Key Frames"].GetArray()) {
-								a.AddKeyFrame(k["Frame Number"].GetInt(), nullptr);
-							}
-							anigrp.animations.push_back(std::make_shared<CameraResetAnimation>(a));
-						}
-						else if (animType == "CreatePrefab") {
-							CreatePrefabAnimation a{};
-							for (auto& k : animations["Key Frames"].GetArray()) {
-								std::string data = k["Prefab"].GetString();
-								a.AddKeyFrame(k["Frame Number"].GetInt(), &data);
-							}
-							anigrp.animations.push_back(std::make_shared<CreatePrefabAnimation>(a));
-						}
-						else if (animType == "Event") {
-							EventAnimation a{};
-							for (auto& k : animations["Key Frames"].GetArray()) {
-								std::pair<std::string, std::string> data{};
-								data.first = k["Event Name"].GetString();
-								data.second = k["Event Input"].GetString();
-								a.AddKeyFrame(k["Frame Number"].GetInt(), &data);
-							}
-							anigrp.animations.push_back(std::make_shared<EventAnimation>(a));
-						}
-						else if (animType == "Child") {
-							ChildAnimation a{};
-							for (auto& k : animations["Key Frames"].GetArray()) {
-								std::pair<std::string, std::string> data{};
-								data.first = k["Child Name"].GetString();
-								data.second = k["Child Animation"].GetString();
-								a.AddKeyFrame(k["Frame Number"].GetInt(), &data);
-							}
-							anigrp.animations.push_back(std::make_shared<ChildAnimation>(a));
+					anigrp.animations.push_back(std::make_shared<FadeAnimation>(a));
+				}
+				else if (animType == "SelfDestruct") {
+					SelfDestructAnimation a{};
+					for (auto& k : animations["Key Frames"].GetArray()) {
+						a.AddKeyFrame(k["Frame Number"].GetInt(), nullptr);
+					}
+					anigrp.animations.push_back(std::make_shared<SelfDestructAnimation>(a));
+				}
+				else if (animType == "DamageImpact") {
+					DamageImpactAnimation a{};
+					for (auto& k : animations["Key Frames"].GetArray()) {
+						std::string data{};
+						if (k.HasMember("Prefab")) {
+							data = k["Prefab"].GetString();
 						}
-						else if (animType == "Parent") {
-							ParentAnimation a{};
-							for (auto& k : animations["Key Frames"].GetArray()) {
-								std::string data{};
-								data = k["Animation"].GetString();
-								a.AddKeyFrame(k["Frame Number"].GetInt(), &data);
-							}
-							anigrp.animations.push_back(std::make_shared<ParentAnimation>(a));
-							}
+						a.AddKeyFrame(k["Frame Number"].GetInt(), &data);
 					}
-					animset.animationSet.push_back(anigrp);
+					anigrp.animations.push_back(std::make_shared<DamageImpactAnimation>(a));
 				}
-
-				if (ECS::ecs().HasComponent<AnimationSet>(entity)) {
-					ECS::ecs().GetComponent<AnimationSet>(entity) = animset;
+				else if (animType == "CameraZoom") {
+					CameraZoomAnimation a{};
+					for (auto& k : animations["Key Frames"].GetArray()) {
+						float data{ k["Zoom"].GetFloat() };
+						a.AddKeyFrame(k["Frame Number"].GetInt(), &data);
+					}
+					anigrp.animations.push_back(std::make_shared<CameraZoomAnimation>(a));
 				}
-				else {
-					ECS::ecs().AddComponent<AnimationSet>(entity, animset);
+				else if (animType == "CameraTarget") {
+					CameraTargetAnimation a{};
+					for (auto& k : animations["Key Frames"].GetArray()) {
+						a.AddKeyFrame(k["Frame Number"].GetInt(), nullptr);
+					}
+					anigrp.animations.push_back(std::make_shared<CameraTargetAnimation>(a));
 				}
+				else if (animType == "CameraReset") {
+					CameraResetAnimation a{};
+					for (auto& k : animations["Key Frames"].GetArray()) {
+						a.AddKeyFrame(k["Frame Number"].GetInt(), nullptr);
+					}
+					anigrp.animations.push_back(std::make_shared<CameraResetAnimation>(a));
+				}
+				else if (animType == "CreatePrefab") {
+					CreatePrefabAnimation a{};
+					for (auto& k : animations["Key Frames"].GetArray()) {
+						std::string data = k["Prefab"].GetString();
+						a.AddKeyFrame(k["Frame Number"].GetInt(), &data);
+					}
+					anigrp.animations.push_back(std::make_shared<CreatePrefabAnimation>(a));
+				}
+				else if (animType == "Event") {
+					EventAnimation a{};
+					for (auto& k : animations["Key Frames"].GetArray()) {
+						std::pair<std::string, std::string> data{};
+						data.first = k["Event Name"].GetString();
+						data.second = k["Event Input"].GetString();
+						a.AddKeyFrame(k["Frame Number"].GetInt(), &data);
+					}
+					anigrp.animations.push_back(std::make_shared<EventAnimation>(a));
+				}
+				else if (animType == "Child") {
+					ChildAnimation a{};
+					for (auto& k : animations["Key Frames"].GetArray()) {
+						std::pair<std::string, std::string> data{};
+						data.first = k["Child Name"].GetString();
+						data.second = k["Child Animation"].GetString();
+						a.AddKeyFrame(k["Frame Number"].GetInt(), &data);
+					}
+					anigrp.animations.push_back(std::make_shared<ChildAnimation>(a));
+				}
+				else if (animType == "Parent") {
+					ParentAnimation a{};
+					for (auto& k : animations["Key Frames"].GetArray()) {
+						std::string data{};
+						data = k["Animation"].GetString();
+						a.AddKeyFrame(k["Frame Number"].GetInt(), &data);
+					}
+					anigrp.animations.push_back(std::make_shared<ParentAnimation>(a));
+					}
 			}
-			if (entityObject.HasMember("Parent") && !ECS::ecs().HasComponent<Parent>(entity) && parentID == 0) {
-				ECS::ecs().AddComponent<Parent>(entity, Parent{});
-				parent = &ECS::ecs().GetComponent<Parent>(entity);
-				parentID = entity;
-			}
-			if (entityObject.HasMember("Child") && parent != nullptr) {
-				const rapidjson::Value& transformObject = entityObject["Child"];
-				Transform transform;
-				transform.position.x = transformObject["position_x"].GetFloat();
-				transform.position.y = transformObject["position_y"].GetFloat();
-				transform.rotation = transformObject["rotation"].GetFloat();
-				transform.scale = transformObject["scale"].GetFloat();
-				transform.velocity.x = transformObject["velocity_x"].GetFloat();
-				transform.velocity.y = transformObject["velocity_y"].GetFloat();
-
-				ECS::ecs().AddComponent<Child>(entity, Child{ parentID, transform });
-				parent->children.push_back(entity);
-			}
-			if (entityObject.HasMember("SliderUI")) {
-				const rapidjson::Value& sliderObject = entityObject["SliderUI"];
-				SliderUI sliderUI;
-				sliderUI.linkedEntity = sliderObject["Linked Entity"].GetUint();
-				sliderUI.type = static_cast<SliderUI::UI_TYPE>(sliderObject["Slider Type"].GetInt());
-				sliderUI.controlWhich = static_cast<SliderUI::CONTROL_WHICH>(sliderObject["Control Which"].GetInt());
-				ECS::ecs().AddComponent<SliderUI>(entity, sliderUI);
+			animset.animationSet.push_back(anigrp);
+		}
 
+		if (ECS::ecs().HasComponent<AnimationSet>(entity)) {
+			ECS::ecs().GetComponent<AnimationSet>(entity) = animset;
+		}
+		else {
+			ECS::ecs().AddComponent<AnimationSet>(entity, animset);
+		}
+	}
+	if (entityObject.HasMember("Parent") && !ECS::ecs().HasComponent<Parent>(entity) && parentID == 0) {
+		ECS::ecs().AddComponent<Parent>(entity, Parent{});
+		parent = &ECS::ecs().GetComponent<Parent>(entity);
+		parentID = entity;
+	}
+	if (entityObject.HasMember("Child") && parent != nullptr) {
+		Transform transform;
+		ReadFields(entityObject["Child"], transform);
+
+		ECS::ecs().AddComponent<Child>(entity, Child{ parentID, transform });
+		parent->children.push_back(entity);
+	}
+	if (entityObject.HasMember("SliderUI")) {
+		LoadReflected<SliderUI>(entity, entityObject["SliderUI"]);
+	}
+	//if (entityObject.HasMember("Emitter")) {
+	//	ECS::ecs().AddComponent<Emitter>(entity, Emitter{});
+	//}
+}
+
+void Serializer::LoadComponentsFromJson(Entity entity, const char* json) {
+	rapidjson::Document document;
+	document.Parse(json);
+	if (document.HasParseError() || !document.IsObject()) {
+		return;
+	}
+	Parent* parent{};
+	Entity parentID{};
+	LoadEntityComponents(entity, document, parent, parentID);
+}
+
+/*!
+* \brief Loads one entry of a scene or prefab file
+*
+* The entry is either the layering data or an entity, which is created,
+* cloned from its prefab if it has one, and given its components. entity is
+* set to the entity loaded.
+*
+*/
+void LoadJsonEntry(const rapidjson::Value& entityObject, Entity& entity, Parent*& parent, Entity& parentID) {
+	if (!entityObject.IsObject()) {
+		return;
+	}
+	if (entityObject.HasMember("LayeringSystems")) {
+		LoadLayeringData(entityObject["LayeringSystems"]);
+		return;
+	}
+
+	entity = 0;
+	if (entityObject.HasMember("Clone")) {
+		const rapidjson::Value& cloneObject = entityObject["Clone"];
+		if (cloneObject.HasMember("Prefab")) {
+			std::string prefabName = cloneObject["Prefab"].GetString();
+			Entity prefabID{ assetmanager.GetPrefab(prefabName) };
+			entity = EntityFactory::entityFactory().CloneMaster(prefabID);
+			const rapidjson::Value& componentSet{ cloneObject["Unique Components"] };
+			Clone& cloneComponent{ ECS::ecs().GetComponent<Clone>(entity) };
+			cloneComponent.prefab = prefabName;
+			for (rapidjson::SizeType s = 0; s < componentSet.Size(); s++) {
+				std::string componentName{ componentSet[s].GetString() };
+				cloneComponent.unique_components.insert(componentName);
 			}
-			//if (entityObject.HasMember("Emitter")) {
-			//	ECS::ecs().AddComponent<Emitter>(entity, Emitter{});
-			//}
+		}
+		else {
+			entity = ECS::ecs().CreateEntity();
+			(EntityFactory::entityFactory().cloneCounter)++;
+			ECS::ecs().AddComponent(entity, Clone{});
+		}
+		if (!stopButton) {
+			selectedLayer = std::numeric_limits<size_t>().max();
 		}
 	}
 
+	if (entity == 0) {
+		entity = ECS::ecs().CreateEntity();
+		(EntityFactory::entityFactory().cloneCounter)++;
+	}
+
+	LoadEntityComponents(entity, entityObject, parent, parentID);
+}
+
+/*!
+* \brief Finishes loading a scene or prefab file once all its entries are loaded
+*
+* Scenes rebuild their layers, prefabs are not clones. Returns the entity
+* loaded, or the file's first parent if it has one.
+*
+*/
+Entity FinishEntityLoad(Entity entity, Entity parentID, bool isPrefab) {
 	if (!isPrefab) {
 		RebuildLayeringAfterDeserialization();
 		ExtractSkipLockAfterDeserialization();
@@ -1924,6 +1625,55 @@ Entity Serializer::LoadEntityFromJson(const std::string& fileName, bool isPrefab
 	}
 }
 
+Entity Serializer::LoadEntityFromJson(const std::string& fileName, bool isPrefab) {
+	// A scene still being saved is finished before it is read back
+	sceneSaver.Wait();
+
+	// A cooked copy of the file that is up to date is loaded without parsing the json
+	Entity cookedEntity{};
+	if (scenecache.Load(fileName, isPrefab, cookedEntity)) {
+		return cookedEntity;
+	}
+
+	Entity entity{0};
+	Parent* parent{};
+	Entity parentID{};
+	//layering.clear();
+
+	// Each entry is loaded and cooked as soon as it is parsed, without building the whole document
+	SceneCooker cooker;
+	JsonReadResult result{ ReadJsonArray(fileName, [&](const rapidjson::Value& entityObject) {
+		cooker.Add(entityObject);
+		LoadJsonEntry(entityObject, entity, parent, parentID);
+		return true;
+	}) };
+	if (result == JsonReadResult::CANNOT_OPEN) {
+		std::cerr << "Failed to open file: " << fileName << std::endl;
+		return entity;
+	}
+	if (result == JsonReadResult::PARSE_ERROR) {
+		std::cerr << "Failed to parse .json file: " << fileName << std::endl;
+	}
+	else {
+		scenecache.Cook(fileName, cooker);
+	}
+	return FinishEntityLoad(entity, parentID, isPrefab);
+}
+
+Entity Serializer::LoadEntityFromDocument(const std::string& fileName, const rapidjson::Value& document, bool isPrefab) {
+	Entity entity{0};
+	Parent* parent{};
+	Entity parentID{};
+	if (!document.IsArray()) {
+		std::cerr << "Failed to parse .json file: " << fileName << std::endl;
+		return entity;
+	}
+	for (const rapidjson::Value& entityObject : document.GetArray()) {
+		LoadJsonEntry(entityObject, entity, parent, parentID);
+	}
+	return FinishEntityLoad(entity, parentID, isPrefab);
+}
+
 void LoadConfig() {
 	// Open the file
 	std::ifstream ifs("Config.txt");
@@ -1943,6 +1693,27 @@ void LoadConfig() {
 	// Read and extract the height
 	ifs >> temp >> height;
 
+	// Optional flags:
+	// "TextureCache 0" decodes every texture from source instead of using the cooked cache
+	// "SceneCache 0" parses every scene and prefab from json instead of using the cooked copies
+	// "KeepSharedAssets 0" unloads every asset on a scene change instead of only those the new scene does not use
+	// "FontSDF 1" rasterizes glyphs as signed distance fields
+	int value;
+	while (ifs >> temp >> value) {
+		if (temp == "TextureCache") {
+			texturecache.enabled = (value != 0);
+		}
+		else if (temp == "SceneCache") {
+			scenecache.enabled = (value != 0);
+		}
+		else if (temp == "KeepSharedAssets") {
+			assetmanager.keepSharedAssets = (value != 0);
+		}
+		else if (temp == "FontSDF") {
+			glyphAtlas.sdf = (value != 0);
+		}
+	}
+
 	GRAPHICS::UpdateConstants(width, height);
 
 	// Close the file
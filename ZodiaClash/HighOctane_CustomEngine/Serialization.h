@@ -53,10 +53,11 @@
 #include "VMath.h"
 #include "GraphLib.h"
 #include "Texture.h"
+#include <rapidjson-master/include/rapidjson/fwd.h>
  
 class Serializer {
 public:
-	std::ifstream stream;
+	std::stringstream stream;
 /*!***********************************************************************
  \brief
 	Opens stream
@@ -163,6 +164,27 @@ public:
  *************************************************************************/
 	static void SaveEntityToJson(const std::string& fileName, const std::vector<Entity>& entity, bool isPrefab = false);
 
+/*!***********************************************************************
+ \brief
+	Writes one entity of a scene file as compact json text, the way
+	SaveEntityToJson saves it
+ \param [in] entity
+	Entity to write
+ \param [out] json
+	Json object of the entity
+ \return
+	False if the entity is not saved in scene files
+ *************************************************************************/
+	static bool WriteEntityJson(Entity entity, std::string& json);
+
+/*!***********************************************************************
+ \brief
+	Writes the layering entry of a scene file as compact json text
+ \return
+	Json object of the layer names and counters
+ *************************************************************************/
+	static std::string WriteLayeringJson();
+
 /*!***********************************************************************
  \brief
 	Json deserializer using RapidJson library
@@ -173,6 +195,30 @@ public:
  *************************************************************************/
 	static Entity LoadEntityFromJson(const std::string& fileName, bool isPrefab = false);
 
+/*!***********************************************************************
+ \brief
+	Loads a scene or prefab file that was already parsed, the way
+	LoadEntityFromJson would load it, without cooking it again
+ \param [in] fileName
+	Filepath the document was parsed from
+ \param [in] document
+	Parsed json array of the file
+ \return
+	The entity loaded, or the file's first parent if it has one
+ *************************************************************************/
+	static Entity LoadEntityFromDocument(const std::string& fileName, const rapidjson::Value& document, bool isPrefab = false);
+
+/*!***********************************************************************
+ \brief
+	Loads components into an existing entity from the json text of one
+	entity object, used for the components a cooked scene keeps as json
+ \param [in] entity
+	Entity to load the components into
+ \param [in] json
+	Json object with the same members as an entity of a scene file
+ *************************************************************************/
+	static void LoadComponentsFromJson(Entity entity, const char* json);
+
 };
 
 /*!***********************************************************************
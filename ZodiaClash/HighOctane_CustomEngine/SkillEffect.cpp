@@ -0,0 +1,367 @@
+/******************************************************************************
+*
+*	\copyright
+*		All content(C) 2023/2024 DigiPen Institute of Technology Singapore.
+*		All rights reserved. Reproduction or disclosure of this file or its
+*		contents without the prior written consent of DigiPen Institute of
+*		Technology is prohibited.
+*
+* *****************************************************************************
+*
+*	@file		SkillEffect.cpp
+*
+*	@author		agent
+*
+*	@email		agent\@local
+*
+*	@course		CSD 2401 - Software Engineering Project 3
+*				CSD 2451 - Software Engineering Project 4
+*
+*	@section	Section A
+*
+*	@date		19 October 2026
+*
+* *****************************************************************************
+*
+*	@brief		Data driven skill effects
+*
+*	Compiles the effects written in .skill files into instructions
+*
+******************************************************************************/
+
+#include "SkillEffect.h"
+#include <climits>
+#include <unordered_map>
+
+#include <rapidjson-master/include/rapidjson/writer.h>
+#include <rapidjson-master/include/rapidjson/stringbuffer.h>
+
+namespace {
+	const char* EFFECTS{ "Effects" };
+	const char* FINISH_EFFECTS{ "Finish Effects" };
+
+	const std::unordered_map<std::string, EffectOp> operations{
+		{ "Heal", EffectOp::HEAL },
+		{ "Cancel Damage", EffectOp::CANCEL_DAMAGE },
+		{ "Lifesteal", EffectOp::LIFESTEAL },
+		{ "Clear Debuffs", EffectOp::CLEAR_DEBUFFS },
+		{ "Clear Buffs", EffectOp::CLEAR_BUFFS },
+		{ "Consume Bleed", EffectOp::CONSUME_BLEED },
+		{ "Speed Up", EffectOp::SPEED_UP },
+		{ "Attack Buff", EffectOp::ATTACK_BUFF },
+		{ "Defense Buff", EffectOp::DEFENSE_BUFF },
+		{ "Defense Debuff", EffectOp::DEFENSE_DEBUFF },
+		{ "Stun", EffectOp::STUN },
+		{ "Taunt", EffectOp::TAUNT },
+		{ "Hunted", EffectOp::HUNTED },
+		{ "Ignite", EffectOp::IGNITE },
+		{ "Set Charge", EffectOp::SET_CHARGE },
+		{ "Advance Cycle", EffectOp::ADVANCE_CYCLE },
+		{ "Set Cycle", EffectOp::SET_CYCLE },
+		{ "AI Score", EffectOp::AI_SCORE },
+		{ "Spawn Shield", EffectOp::SPAWN_SHIELD }
+	};
+
+	const std::unordered_map<std::string, EffectCondition> conditions{
+		{ "Owner Health Below", EffectCondition::OWNER_HEALTH_BELOW },
+		{ "Owner Charged", EffectCondition::OWNER_CHARGED },
+		{ "Owner Cycle", EffectCondition::OWNER_CYCLE },
+		{ "Owner Cycle Above", EffectCondition::OWNER_CYCLE_ABOVE },
+		{ "Owner Shielded", EffectCondition::OWNER_SHIELDED },
+		{ "Target Shielded", EffectCondition::TARGET_SHIELDED },
+		{ "Target Is Enemy", EffectCondition::TARGET_IS_ENEMY },
+		{ "Target Is Owner", EffectCondition::TARGET_IS_OWNER },
+		{ "Target Is Prey", EffectCondition::TARGET_IS_PREY },
+		{ "Target Ignited", EffectCondition::TARGET_IGNITED },
+		{ "Enemies Above", EffectCondition::ENEMIES_ABOVE },
+		{ "Enemy Stunned", EffectCondition::ENEMY_STUNNED },
+		{ "Proc", EffectCondition::PROC }
+	};
+
+	struct Compiler {
+		EffectProgram& program;
+		std::string& error;
+		bool finish{}; //finish effects run without a target
+	};
+
+	bool CompileBlock(Compiler& compiler, rapidjson::Value const& block, std::vector<EffectInstruction>& output);
+
+	//Reads an int member, the default if it is missing
+	bool ReadInt(Compiler& compiler, rapidjson::Value const& object, const char* name, int& output, bool required, int defaultValue = 0) {
+		if (!object.HasMember(name)) {
+			output = defaultValue;
+			if (required) {
+				compiler.error = std::string("missing \"") + name + "\"";
+			}
+			return !required;
+		}
+		rapidjson::Value const& value{ object[name] };
+		if (value.IsBool()) {
+			output = value.GetBool() ? 1 : 0;
+			return true;
+		}
+		if (!value.IsInt()) {
+			compiler.error = std::string("\"") + name + "\" must be a whole number";
+			return false;
+		}
+		output = value.GetInt();
+		return true;
+	}
+
+	bool ReadFloat(Compiler& compiler, rapidjson::Value const& object, const char* name, float& output) {
+		if (!object.HasMember(name) || !object[name].IsNumber()) {
+			compiler.error = std::string("missing number \"") + name + "\"";
+			return false;
+		}
+		output = object[name].GetFloat();
+		return true;
+	}
+
+	bool NeedsTarget(EffectInstruction const& instruction) {
+		switch (instruction.op) {
+		case EffectOp::BRANCH:
+			return instruction.condition == EffectCondition::TARGET_SHIELDED
+				|| instruction.condition == EffectCondition::TARGET_IS_ENEMY
+				|| instruction.condition == EffectCondition::TARGET_IS_OWNER
+				|| instruction.condition == EffectCondition::TARGET_IS_PREY
+				|| instruction.condition == EffectCondition::TARGET_IGNITED;
+		case EffectOp::ATTACK_BUFF:
+		case EffectOp::DEFENSE_BUFF:
+			return instruction.subject == EffectSubject::TARGET;
+		case EffectOp::JUMP:
+		case EffectOp::SET_CHARGE:
+		case EffectOp::ADVANCE_CYCLE:
+		case EffectOp::SET_CYCLE:
+		case EffectOp::AI_SCORE:
+		case EffectOp::SPAWN_SHIELD:
+			return false;
+		default:
+			return true;
+		}
+	}
+
+	bool CompileCondition(Compiler& compiler, rapidjson::Value const& object, EffectInstruction& instruction) {
+		if (!object.IsObject() || !object.HasMember("Condition") || !object["Condition"].IsString()) {
+			compiler.error = "conditions need a \"Condition\" name";
+			return false;
+		}
+		auto it{ conditions.find(object["Condition"].GetString()) };
+		if (it == conditions.end()) {
+			compiler.error = std::string("unknown condition \"") + object["Condition"].GetString() + "\"";
+			return false;
+		}
+		instruction.op = EffectOp::BRANCH;
+		instruction.condition = it->second;
+		instruction.negate = object.HasMember("Not") && object["Not"].IsBool() && object["Not"].GetBool();
+		switch (instruction.condition) {
+		case EffectCondition::OWNER_HEALTH_BELOW:
+			return ReadFloat(compiler, object, "Value", instruction.value);
+		case EffectCondition::OWNER_CYCLE:
+		case EffectCondition::OWNER_CYCLE_ABOVE:
+		case EffectCondition::ENEMIES_ABOVE:
+			return ReadInt(compiler, object, "Value", instruction.amount, true);
+		case EffectCondition::PROC:
+			compiler.program.usesProc = true;
+			return true;
+		default:
+			return true;
+		}
+	}
+
+	bool CompileOperation(Compiler& compiler, rapidjson::Value const& object, std::vector<EffectInstruction>& output) {
+		if (!object.HasMember("Op") || !object["Op"].IsString()) {
+			compiler.error = "effects need an \"Op\" or an \"If\"";
+			return false;
+		}
+		auto it{ operations.find(object["Op"].GetString()) };
+		if (it == operations.end()) {
+			compiler.error = std::string("unknown operation \"") + object["Op"].GetString() + "\"";
+			return false;
+		}
+
+		EffectInstruction instruction;
+		instruction.op = it->second;
+		bool valid{ true };
+		switch (instruction.op) {
+		case EffectOp::HEAL:
+			valid = ReadFloat(compiler, object, "Percent", instruction.value);
+			break;
+		case EffectOp::ATTACK_BUFF:
+		case EffectOp::DEFENSE_BUFF:
+			if (object.HasMember("Who") && object["Who"].IsString()) {
+				std::string who{ object["Who"].GetString() };
+				if (who != "Owner" && who != "Target") {
+					compiler.error = "\"Who\" must be \"Owner\" or \"Target\"";
+					return false;
+				}
+				instruction.subject = who == "Owner" ? EffectSubject::OWNER : EffectSubject::TARGET;
+			}
+			[[fallthrough]];
+		case EffectOp::DEFENSE_DEBUFF:
+			valid = ReadFloat(compiler, object, "Value", instruction.value)
+				&& ReadInt(compiler, object, "Stacks", instruction.amount, true);
+			break;
+		case EffectOp::STUN:
+		case EffectOp::TAUNT:
+		case EffectOp::HUNTED:
+		case EffectOp::IGNITE:
+			valid = ReadInt(compiler, object, "Stacks", instruction.amount, true);
+			break;
+		case EffectOp::SET_CHARGE:
+		case EffectOp::SET_CYCLE:
+		case EffectOp::AI_SCORE:
+			valid = ReadInt(compiler, object, "Value", instruction.amount, true);
+			break;
+		case EffectOp::ADVANCE_CYCLE:
+			valid = ReadInt(compiler, object, "Wrap", instruction.amount, false, INT_MAX);
+			break;
+		case EffectOp::SPAWN_SHIELD:
+			if (!object.HasMember("Prefab") || !object["Prefab"].IsString()) {
+				compiler.error = "\"Spawn Shield\" needs a \"Prefab\"";
+				return false;
+			}
+			compiler.program.shieldPrefab = object["Prefab"].GetString();
+			break;
+		default:
+			break;
+		}
+		if (!valid) {
+			return false;
+		}
+		if (compiler.finish && NeedsTarget(instruction)) {
+			compiler.error = std::string("\"") + object["Op"].GetString() + "\" needs a target and cannot be a finish effect";
+			return false;
+		}
+		output.push_back(instruction);
+		return true;
+	}
+
+	/*!
+	* \brief If block
+	*
+	* Conditions become branches to the end of "Then" when they fail, or with
+	* "Any" to the start of "Then" when they hold. "Then" jumps over "Else".
+	*
+	*/
+	bool CompileIf(Compiler& compiler, rapidjson::Value const& object, std::vector<EffectInstruction>& output) {
+		rapidjson::Value const& conditionList{ object["If"] };
+		if (!conditionList.IsArray() || conditionList.Empty() || !object.HasMember("Then")) {
+			compiler.error = "\"If\" needs a list of conditions and \"Then\"";
+			return false;
+		}
+		bool any{ object.HasMember("Any") && object["Any"].IsBool() && object["Any"].GetBool() };
+
+		std::vector<size_t> toThen{};
+		std::vector<size_t> toElse{};
+		for (rapidjson::Value const& condition : conditionList.GetArray()) {
+			EffectInstruction branch;
+			if (!CompileCondition(compiler, condition, branch)) {
+				return false;
+			}
+			if (compiler.finish && NeedsTarget(branch)) {
+				compiler.error = "finish effects cannot check the target";
+				return false;
+			}
+			if (!any) {
+				branch.negate = !branch.negate;
+			}
+			(any ? toThen : toElse).push_back(output.size());
+			output.push_back(branch);
+		}
+		if (any) {
+			toElse.push_back(output.size());
+			output.push_back(EffectInstruction{ EffectOp::JUMP });
+		}
+
+		for (size_t i : toThen) {
+			output[i].amount = static_cast<int>(output.size() - i);
+		}
+		if (!CompileBlock(compiler, object["Then"], output)) {
+			return false;
+		}
+
+		size_t toEnd{ output.size() };
+		bool hasElse{ object.HasMember("Else") };
+		if (hasElse) {
+			output.push_back(EffectInstruction{ EffectOp::JUMP });
+		}
+		for (size_t i : toElse) {
+			output[i].amount = static_cast<int>(output.size() - i);
+		}
+		if (hasElse) {
+			if (!CompileBlock(compiler, object["Else"], output)) {
+				return false;
+			}
+			output[toEnd].amount = static_cast<int>(output.size() - toEnd);
+		}
+		return true;
+	}
+
+	bool CompileBlock(Compiler& compiler, rapidjson::Value const& block, std::vector<EffectInstruction>& output) {
+		if (!block.IsArray()) {
+			compiler.error = "effects must be a list";
+			return false;
+		}
+		for (rapidjson::Value const& effect : block.GetArray()) {
+			if (!effect.IsObject()) {
+				compiler.error = "effects must be objects";
+				return false;
+			}
+			if (!(effect.HasMember("If") ? CompileIf(compiler, effect, output) : CompileOperation(compiler, effect, output))) {
+				return false;
+			}
+		}
+		return true;
+	}
+}
+
+/*!
+* \brief Compile skill effects
+*
+* Compiles the "Effects" list, run on every target, and the "Finish Effects"
+* list, run once after an AOE skill hits every target. Skills without
+* either compile to empty programs.
+*
+*/
+bool CompileSkillEffects(rapidjson::Value const& skill, EffectProgram& program, std::string& error) {
+	program = EffectProgram{};
+	Compiler compiler{ program, error };
+	rapidjson::Document source;
+	source.SetObject();
+
+	if (skill.HasMember(EFFECTS)) {
+		if (!CompileBlock(compiler, skill[EFFECTS], program.hit)) {
+			return false;
+		}
+		source.AddMember(rapidjson::StringRef(EFFECTS), rapidjson::Value(skill[EFFECTS], source.GetAllocator()), source.GetAllocator());
+	}
+	if (skill.HasMember(FINISH_EFFECTS)) {
+		compiler.finish = true;
+		if (!CompileBlock(compiler, skill[FINISH_EFFECTS], program.finish)) {
+			return false;
+		}
+		source.AddMember(rapidjson::StringRef(FINISH_EFFECTS), rapidjson::Value(skill[FINISH_EFFECTS], source.GetAllocator()), source.GetAllocator());
+	}
+
+	if (source.MemberCount()) {
+		rapidjson::StringBuffer buffer;
+		rapidjson::Writer<rapidjson::StringBuffer> writer(buffer);
+		source.Accept(writer);
+		program.source = buffer.GetString();
+	}
+	return true;
+}
+
+void WriteSkillEffects(EffectProgram const& program, rapidjson::Value& skill, rapidjson::Document::AllocatorType& allocator) {
+	if (program.source.empty()) {
+		return;
+	}
+	rapidjson::Document source;
+	source.Parse(program.source.c_str());
+	if (source.HasParseError() || !source.IsObject()) {
+		return;
+	}
+	for (auto& member : source.GetObject()) {
+		skill.AddMember(rapidjson::Value(member.name, allocator), rapidjson::Value(member.value, allocator), allocator);
+	}
+}
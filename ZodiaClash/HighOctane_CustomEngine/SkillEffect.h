@@ -0,0 +1,148 @@
+/******************************************************************************
+*
+*	\copyright
+*		All content(C) 2023/2024 DigiPen Institute of Technology Singapore.
+*		All rights reserved. Reproduction or disclosure of this file or its
+*		contents without the prior written consent of DigiPen Institute of
+*		Technology is prohibited.
+*
+* *****************************************************************************
+*
+*	@file		SkillEffect.h
+*
+*	@author		agent
+*
+*	@email		agent\@local
+*
+*	@course		CSD 2401 - Software Engineering Project 3
+*				CSD 2451 - Software Engineering Project 4
+*
+*	@section	Section A
+*
+*	@date		19 October 2026
+*
+* *****************************************************************************
+*
+*	@brief		Data driven skill effects
+*
+*	Special rules of a skill are written in its .skill file as a list of
+*	effects, each either an operation ("Stun", "Heal", "Advance Cycle"...)
+*	or an "If" block with conditions and "Then"/"Else" lists. They are
+*	compiled once when the skill is loaded into a flat list of
+*	instructions with relative jumps, which the game (Attack::UseAttack)
+*	and the AI simulation (BattleSimState) each run with their own
+*	version of the operations.
+*
+*	Example:
+*	"Effects": [
+*		{ "Op": "Stun", "Stacks": 1 },
+*		{ "If": [ { "Condition": "Owner Cycle Above", "Value": 0 }, { "Condition": "Owner Charged", "Not": true } ],
+*		  "Then": [ { "Op": "AI Score", "Value": 100000 }, { "Op": "Advance Cycle", "Wrap": 3 } ] }
+*	]
+*
+******************************************************************************/
+
+#pragma once
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <type_traits>
+#include <rapidjson-master/include/rapidjson/document.h>
+
+enum class EffectOp : uint8_t {
+	BRANCH,			//jumps by amount if the condition holds, or does not when negated
+	JUMP,			//jumps by amount
+	HEAL,			//the skill heals value * the owner's max health instead of dealing damage
+	CANCEL_DAMAGE,	//the skill deals no damage
+	LIFESTEAL,		//the owner heals by the damage dealt
+	CLEAR_DEBUFFS,	//removes the target's bleed, taunt and stun
+	CLEAR_BUFFS,	//removes the target's attack and defense buffs
+	CONSUME_BLEED,	//applies all of the target's bleed stacks at once
+	SPEED_UP,		//moves the target to the front of the turn order
+	ATTACK_BUFF,	//sets the subject's attack buff to value for amount turns
+	DEFENSE_BUFF,	//sets the subject's defense buff to value for amount turns
+	DEFENSE_DEBUFF,	//sets the target's defense debuff to value for amount turns
+	STUN,			//adds amount stun stacks to the target
+	TAUNT,			//adds amount taunt stacks to the target, taunting it towards the owner
+	HUNTED,			//sets the target's hunted stacks to amount
+	IGNITE,			//sets the target's ignite stacks to amount
+	SET_CHARGE,		//sets the owner's charge to amount != 0
+	ADVANCE_CYCLE,	//advances the owner's boss cycle, back to 0 once it goes above amount
+	SET_CYCLE,		//sets the owner's boss cycle to amount
+	AI_SCORE,		//adds amount to the battle's AI multiplier
+	SPAWN_SHIELD	//shields every enemy with a shield entity, the AI simulation skips the entity
+};
+
+enum class EffectCondition : uint8_t {
+	NONE,
+	OWNER_HEALTH_BELOW,	//owner's health is below value * max health
+	OWNER_CHARGED,
+	OWNER_CYCLE,		//owner's boss cycle is amount
+	OWNER_CYCLE_ABOVE,	//owner's boss cycle is above amount
+	OWNER_SHIELDED,
+	TARGET_SHIELDED,
+	TARGET_IS_ENEMY,
+	TARGET_IS_OWNER,
+	TARGET_IS_PREY,		//target is the cat or the player goat
+	TARGET_IGNITED,
+	ENEMIES_ABOVE,		//more than amount enemies are alive
+	ENEMY_STUNNED,		//any enemy is stunned
+	PROC				//25% chance, rolled by the game and chosen by the AI
+};
+
+enum class EffectSubject : uint8_t {
+	TARGET,
+	OWNER
+};
+
+struct EffectInstruction {
+	EffectOp op{};
+	EffectCondition condition{};
+	EffectSubject subject{};
+	bool negate{};
+	int amount{};	//stacks, cycle, AI score or jump distance
+	float value{};	//buff strength, heal or health fraction
+};
+
+static_assert(std::is_trivially_copyable_v<EffectInstruction>, "EffectInstruction is copied into the AI simulation");
+
+struct EffectProgram {
+	std::vector<EffectInstruction> hit{};		//run on every target the skill hits
+	std::vector<EffectInstruction> finish{};	//run once after every target of an AOE skill is hit, has no target
+	std::string shieldPrefab{};					//spawned by SPAWN_SHIELD
+	std::string source{};						//effects as written in the skill file, for saving
+	bool usesProc{};
+};
+
+//Compiles the "Effects" and "Finish Effects" of a skill object. Returns false and describes the problem in error if they are invalid.
+bool CompileSkillEffects(rapidjson::Value const& skill, EffectProgram& program, std::string& error);
+
+//Adds the effects of a program back to a skill object, for saving
+void WriteSkillEffects(EffectProgram const& program, rapidjson::Value& skill, rapidjson::Document::AllocatorType& allocator);
+
+/*!
+* \brief Effect interpreter
+*
+* Runs count instructions, test(instruction) evaluates the condition of a
+* branch and execute(instruction) applies any other operation.
+*
+*/
+template <typename Test, typename Execute>
+void RunSkillEffects(EffectInstruction const* program, size_t count, Test&& test, Execute&& execute) {
+	size_t pc{};
+	while (pc < count) {
+		EffectInstruction const& instruction{ program[pc] };
+		switch (instruction.op) {
+		case EffectOp::BRANCH:
+			pc += test(instruction) != instruction.negate ? instruction.amount : 1;
+			break;
+		case EffectOp::JUMP:
+			pc += instruction.amount;
+			break;
+		default:
+			execute(instruction);
+			++pc;
+			break;
+		}
+	}
+}
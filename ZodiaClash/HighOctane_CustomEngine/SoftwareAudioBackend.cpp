@@ -0,0 +1,677 @@
+/******************************************************************************
+*
+*	\copyright
+*		All content(C) 2023/2024 DigiPen Institute of Technology Singapore.
+*		All rights reserved. Reproduction or disclosure of this file or its
+*		contents without the prior written consent of DigiPen Institute of
+*		Technology is prohibited.
+*
+* *****************************************************************************
+*
+*	@file		SoftwareAudioBackend.cpp
+*
+*	@author		agent
+*
+*	@email		agent\@local
+*
+*	@course		CSD 2401 - Software Engineering Project 3
+*				CSD 2451 - Software Engineering Project 4
+*
+*	@section	Section A
+*
+*	@date		19 October 2026
+*
+* *****************************************************************************
+*
+*	@brief		Audio backend mixing to a null sink
+*
+*	Stands in for FMOD where it is not linked. .ogg files are decoded with
+*	stb_vorbis and PCM or float .wav files are read directly. Sounds are
+*	loaded on the thread pool when async, and a mixer thread mixes every
+*	playing channel to stereo at MIX_RATE every MIX_FRAMES frames, with the
+*	same group volumes, pausing, pan and low pass as FMOD. The mix is then
+*	thrown away, so the cost of loading, holding and decoding the sounds is
+*	what remains to be measured.
+*
+*	- decoded sounds are decoded to float samples once loaded
+*	- compressed sounds keep the file in memory, each channel decodes it
+*	- streamed sounds keep only a block of samples per channel, each channel
+*	  reads the file, or its packed copy, as it plays
+*
+******************************************************************************/
+
+#include "AudioBackend.h"
+#include "AssetPack.h"
+#include "MultiThreading.h"
+#include "DebugDiagnostic.h"
+#include <stb-master/stb_vorbis.c>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstring>
+#include <fstream>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace {
+	using Clock = std::chrono::steady_clock;
+
+	constexpr int MIX_RATE{ 48000 };
+	constexpr int MIX_FRAMES{ 480 };		//10 ms of mixing at a time
+	constexpr int BLOCK_FRAMES{ 4096 };		//frames decoded at a time by a channel of a compressed or streamed sound
+
+	uint16_t ReadU16(const unsigned char* bytes) {
+		return static_cast<uint16_t>(bytes[0] | (bytes[1] << 8));
+	}
+
+	uint32_t ReadU32(const unsigned char* bytes) {
+		return static_cast<uint32_t>(bytes[0]) | (static_cast<uint32_t>(bytes[1]) << 8) | (static_cast<uint32_t>(bytes[2]) << 16) | (static_cast<uint32_t>(bytes[3]) << 24);
+	}
+
+	//Decodes a sound a block at a time to interleaved float samples
+	class Decoder {
+	public:
+		virtual ~Decoder() = default;
+		//Decodes up to frames frames into out. Returns the frames decoded, 0 once the sound ends
+		virtual int Read(float* out, int frames) = 0;
+		virtual void Rewind() = 0;
+		//Bytes the decoder allocates for itself
+		virtual size_t GetMemory() const = 0;
+
+		int channels{};
+		int sampleRate{};
+	};
+
+	class VorbisDecoder : public Decoder {
+	public:
+		explicit VorbisDecoder(stb_vorbis* vorbis) : vorbis{ vorbis } {
+			info = stb_vorbis_get_info(vorbis);
+			channels = info.channels;
+			sampleRate = static_cast<int>(info.sample_rate);
+		}
+
+		~VorbisDecoder() override {
+			stb_vorbis_close(vorbis);
+		}
+
+		int Read(float* out, int frames) override {
+			return stb_vorbis_get_samples_float_interleaved(vorbis, channels, out, frames * channels);
+		}
+
+		void Rewind() override {
+			stb_vorbis_seek_start(vorbis);
+		}
+
+		size_t GetMemory() const override {
+			return static_cast<size_t>(info.setup_memory_required) + info.temp_memory_required;
+		}
+
+	private:
+		stb_vorbis* vorbis{};
+		stb_vorbis_info info{};
+	};
+
+	//Reads 8, 16, 24 and 32 bit PCM and 32 bit float .wav files, from memory or from the file a block at a time
+	class WavDecoder : public Decoder {
+	public:
+		WavDecoder(const unsigned char* data, size_t size) : memory{ data }, memorySize{ size } {}
+		explicit WavDecoder(const std::string& path) : file{ path, std::ios::binary } {}
+
+		//Reads the format and finds the samples. Returns false if it is not a .wav file that can be played
+		bool Open() {
+			unsigned char header[12];
+			if (ReadBytes(0, header, 12) != 12 || std::memcmp(header, "RIFF", 4) != 0 || std::memcmp(header + 8, "WAVE", 4) != 0) {
+				return false;
+			}
+			bool hasFormat{};
+			size_t offset{ 12 };
+			for (;;) {
+				unsigned char chunk[8];
+				if (ReadBytes(offset, chunk, 8) != 8) {
+					return false;
+				}
+				size_t chunkSize{ ReadU32(chunk + 4) };
+				if (std::memcmp(chunk, "fmt ", 4) == 0) {
+					unsigned char format[40]{};
+					size_t formatSize{ std::min<size_t>(chunkSize, sizeof(format)) };
+					if (formatSize < 16 || ReadBytes(offset + 8, format, formatSize) != formatSize) {
+						return false;
+					}
+					encoding = ReadU16(format);
+					channels = ReadU16(format + 2);
+					sampleRate = static_cast<int>(ReadU32(format + 4));
+					bitsPerSample = ReadU16(format + 14);
+					// WAVE_FORMAT_EXTENSIBLE keeps the encoding in its sub format
+					if (encoding == 0xFFFE && formatSize >= 26) {
+						encoding = ReadU16(format + 24);
+					}
+					hasFormat = true;
+				}
+				else if (std::memcmp(chunk, "data", 4) == 0) {
+					dataOffset = offset + 8;
+					dataSize = chunkSize;
+					break;
+				}
+				offset += 8 + chunkSize + (chunkSize & 1);
+			}
+			if (memory != nullptr) {
+				dataSize = std::min(dataSize, memorySize - std::min(memorySize, dataOffset));
+			}
+			bool pcm{ encoding == 1 && (bitsPerSample == 8 || bitsPerSample == 16 || bitsPerSample == 24 || bitsPerSample == 32) };
+			bool floats{ encoding == 3 && bitsPerSample == 32 };
+			frameBytes = static_cast<size_t>(channels) * (bitsPerSample / 8);
+			return hasFormat && (pcm || floats) && channels > 0 && sampleRate > 0;
+		}
+
+		int Read(float* out, int frames) override {
+			size_t bytes{ std::min(static_cast<size_t>(frames) * frameBytes, dataSize - position) };
+			bytes -= bytes % frameBytes;
+			const unsigned char* samples;
+			if (memory != nullptr) {
+				samples = memory + dataOffset + position;
+			}
+			else {
+				block.resize(bytes);
+				bytes = ReadBytes(dataOffset + position, block.data(), bytes);
+				bytes -= bytes % frameBytes;
+				samples = block.data();
+			}
+			position += bytes;
+
+			size_t count{ bytes / (bitsPerSample / 8) };
+			for (size_t s = 0; s < count; ++s) {
+				switch (bitsPerSample) {
+				case 8:
+					out[s] = (static_cast<int>(samples[s]) - 128) / 128.f;
+					break;
+				case 16:
+					out[s] = static_cast<int16_t>(ReadU16(samples + s * 2)) / 32768.f;
+					break;
+				case 24:
+					out[s] = static_cast<int32_t>((static_cast<uint32_t>(samples[s * 3]) << 8) | (static_cast<uint32_t>(samples[s * 3 + 1]) << 16)
+						| (static_cast<uint32_t>(samples[s * 3 + 2]) << 24)) / 2147483648.f;
+					break;
+				default:
+					if (encoding == 3) {
+						std::memcpy(out + s, samples + s * 4, 4);
+					}
+					else {
+						out[s] = static_cast<int32_t>(ReadU32(samples + s * 4)) / 2147483648.f;
+					}
+					break;
+				}
+			}
+			return static_cast<int>(bytes / frameBytes);
+		}
+
+		void Rewind() override {
+			position = 0;
+		}
+
+		size_t GetMemory() const override {
+			return block.capacity();
+		}
+
+	private:
+		size_t ReadBytes(size_t offset, unsigned char* out, size_t count) {
+			if (memory != nullptr) {
+				if (offset >= memorySize) {
+					return 0;
+				}
+				count = std::min(count, memorySize - offset);
+				std::memcpy(out, memory + offset, count);
+				return count;
+			}
+			file.clear();
+			file.seekg(static_cast<std::streamoff>(offset));
+			file.read(reinterpret_cast<char*>(out), static_cast<std::streamsize>(count));
+			return static_cast<size_t>(file.gcount());
+		}
+
+		const unsigned char* memory{};
+		size_t memorySize{};
+		std::ifstream file{};
+		std::vector<unsigned char> block{};
+		int encoding{};
+		int bitsPerSample{};
+		size_t frameBytes{};
+		size_t dataOffset{};
+		size_t dataSize{};
+		size_t position{};			//bytes of samples read
+	};
+
+	//Opens a decoder over a file held in memory
+	std::unique_ptr<Decoder> OpenDecoder(const unsigned char* data, size_t size) {
+		if (size >= 4 && std::memcmp(data, "OggS", 4) == 0) {
+			int error{};
+			stb_vorbis* vorbis{ stb_vorbis_open_memory(data, static_cast<int>(size), &error, nullptr) };
+			return vorbis ? std::make_unique<VorbisDecoder>(vorbis) : nullptr;
+		}
+		auto wav{ std::make_unique<WavDecoder>(data, size) };
+		return wav->Open() ? std::move(wav) : nullptr;
+	}
+
+	//Opens a decoder reading the file as it plays
+	std::unique_ptr<Decoder> OpenDecoder(const std::string& path) {
+		char magic[4]{};
+		std::ifstream{ path, std::ios::binary }.read(magic, 4);
+		if (std::memcmp(magic, "OggS", 4) == 0) {
+			int error{};
+			stb_vorbis* vorbis{ stb_vorbis_open_filename(path.c_str(), &error, nullptr) };
+			return vorbis ? std::make_unique<VorbisDecoder>(vorbis) : nullptr;
+		}
+		auto wav{ std::make_unique<WavDecoder>(path) };
+		return wav->Open() ? std::move(wav) : nullptr;
+	}
+
+	struct Sound {
+		std::string path{};
+		AudioResidency residency{};
+		bool loop{};
+		std::atomic<AudioLoadState> state{ AudioLoadState::LOADING };
+		Clock::time_point start{};
+		// Set by the load before state is READY, and not changed after
+		std::vector<unsigned char> file{};		//compressed sounds not in the pack
+		const unsigned char* data{};			//the file in memory, from the pack or file, null for loose streamed sounds
+		size_t size{};
+		std::vector<float> pcm{};				//decoded sounds
+		int channels{};
+		int sampleRate{};
+		size_t memory{};
+		double loadMilliseconds{};
+	};
+
+	//Reads and checks the file of a sound, and decodes it if it is held decoded
+	void LoadSound(Sound& sound) {
+		const unsigned char* packed{};
+		size_t packedSize{};
+		if (assetpack.Read(sound.path, packed, packedSize)) {
+			sound.data = packed;
+			sound.size = packedSize;
+		}
+		else if (sound.residency != AudioResidency::STREAMED) {
+			std::ifstream input{ sound.path, std::ios::binary | std::ios::ate };
+			if (input) {
+				sound.file.resize(static_cast<size_t>(input.tellg()));
+				input.seekg(0);
+				input.read(reinterpret_cast<char*>(sound.file.data()), static_cast<std::streamsize>(sound.file.size()));
+			}
+			sound.data = sound.file.data();
+			sound.size = sound.file.size();
+		}
+
+		std::unique_ptr<Decoder> decoder{ sound.data != nullptr ? OpenDecoder(sound.data, sound.size) : OpenDecoder(sound.path) };
+		if (decoder == nullptr) {
+			DEBUG_PRINT("Unable to decode %s", sound.path.c_str());
+			sound.state = AudioLoadState::FAILED;
+			return;
+		}
+		sound.channels = decoder->channels;
+		sound.sampleRate = decoder->sampleRate;
+
+		switch (sound.residency) {
+		case AudioResidency::DECODED: {
+			std::vector<float> block(static_cast<size_t>(BLOCK_FRAMES) * sound.channels);
+			for (int frames = decoder->Read(block.data(), BLOCK_FRAMES); frames > 0; frames = decoder->Read(block.data(), BLOCK_FRAMES)) {
+				sound.pcm.insert(sound.pcm.end(), block.begin(), block.begin() + static_cast<size_t>(frames) * sound.channels);
+			}
+			sound.pcm.shrink_to_fit();
+			std::vector<unsigned char>{}.swap(sound.file);
+			sound.data = nullptr;
+			sound.memory = sound.pcm.size() * sizeof(float);
+			break;
+		}
+		case AudioResidency::COMPRESSED:
+			sound.memory = sound.size;
+			break;
+		case AudioResidency::STREAMED:
+			sound.memory = static_cast<size_t>(BLOCK_FRAMES) * sound.channels * sizeof(float) + decoder->GetMemory();
+			break;
+		}
+		sound.loadMilliseconds = std::chrono::duration<double, std::milli>(Clock::now() - sound.start).count();
+		sound.state = AudioLoadState::READY;
+	}
+
+	struct Group {
+		float volume{ 1.f };
+		bool paused{};
+	};
+
+	struct Voice {
+		std::shared_ptr<Sound> sound{};
+		AudioGroupHandle group{};
+		float pan{};
+		float lowPass{ 1.f };
+		bool started{};
+		bool opened{};							//decoder was opened, it is null if the sound could not be decoded
+		std::unique_ptr<Decoder> decoder{};		//compressed and streamed sounds
+		std::vector<float> block{};				//samples decoded by decoder
+		int blockFrames{};
+		int blockFrame{};
+		size_t frame{};							//next frame of a decoded sound
+		double phase{};							//position between frame and the one after it
+		float current[2]{};						//frame being played, in stereo
+		float filtered[2]{};					//low pass output
+	};
+
+	class SoftwareAudioBackend : public IAudioBackend {
+	public:
+		~SoftwareAudioBackend() override {
+			Release();
+		}
+
+		const char* GetName() const override { return "Software (null sink)"; }
+		bool Initialize() override;
+		void Update() override {}
+		void Release() override;
+
+		AudioGroupHandle GetMasterGroup() override { return 1; }
+		AudioGroupHandle CreateGroup(const char* name) override;
+		void SetGroupVolume(AudioGroupHandle group, float volume) override;
+		float GetGroupVolume(AudioGroupHandle group) override;
+		void SetGroupPaused(AudioGroupHandle group, bool paused) override;
+		bool IsGroupPaused(AudioGroupHandle group) override;
+		void StopGroup(AudioGroupHandle group) override;
+
+		AudioSoundHandle CreateSound(const char* path, AudioResidency residency, bool loop, bool async) override;
+		AudioSoundInfo GetSoundInfo(AudioSoundHandle sound) override;
+		void ReleaseSound(AudioSoundHandle sound) override;
+
+		AudioChannelHandle Play(AudioSoundHandle sound, AudioGroupHandle group) override;
+		bool IsPlaying(AudioChannelHandle channel) override;
+		void SetChannelPan(AudioChannelHandle channel, float pan) override;
+		void SetChannelLowPass(AudioChannelHandle channel, float gain) override;
+
+	private:
+		void Mix();		//runs on the mixer thread until Release
+		//Opens the decoders of the voices about to start. lock is released while they are opened, as a streamed sound reads its file
+		void OpenDecoders(std::unique_lock<std::mutex>& lock);
+		//Moves voice on to the next frame of its sound. Returns false once the sound ends
+		bool NextFrame(Voice& voice);
+
+		std::thread mixer{};
+		std::atomic<bool> stopping{};
+		std::condition_variable wake{};
+		std::mutex mutex{};			//guards groups and voices, which the mixer reads
+		std::vector<Group> groups{};							//by handle - 1
+		std::unordered_map<AudioChannelHandle, Voice> voices{};
+		std::unordered_map<AudioSoundHandle, std::shared_ptr<Sound>> sounds{};	//only used from the frame thread
+		std::vector<float> mix{};
+		AudioSoundHandle nextSound{ 1 };
+		AudioChannelHandle nextChannel{ 1 };
+	};
+
+	bool SoftwareAudioBackend::Initialize() {
+		groups.push_back(Group{});
+		mix.resize(static_cast<size_t>(MIX_FRAMES) * 2);
+		stopping = false;
+		mixer = std::thread{ &SoftwareAudioBackend::Mix, this };
+		return true;
+	}
+
+	void SoftwareAudioBackend::Release() {
+		if (mixer.joinable()) {
+			{
+				std::lock_guard<std::mutex> lock{ mutex };
+				stopping = true;
+			}
+			wake.notify_all();
+			mixer.join();
+		}
+		std::lock_guard<std::mutex> lock{ mutex };
+		voices.clear();
+		sounds.clear();
+		groups.clear();
+	}
+
+	AudioGroupHandle SoftwareAudioBackend::CreateGroup(const char*) {
+		std::lock_guard<std::mutex> lock{ mutex };
+		groups.push_back(Group{});
+		return static_cast<AudioGroupHandle>(groups.size());
+	}
+
+	void SoftwareAudioBackend::SetGroupVolume(AudioGroupHandle group, float volume) {
+		std::lock_guard<std::mutex> lock{ mutex };
+		if (group != 0 && group <= groups.size()) {
+			groups[group - 1].volume = volume;
+		}
+	}
+
+	float SoftwareAudioBackend::GetGroupVolume(AudioGroupHandle group) {
+		std::lock_guard<std::mutex> lock{ mutex };
+		return group != 0 && group <= groups.size() ? groups[group - 1].volume : 0.f;
+	}
+
+	void SoftwareAudioBackend::SetGroupPaused(AudioGroupHandle group, bool paused) {
+		std::lock_guard<std::mutex> lock{ mutex };
+		if (group != 0 && group <= groups.size()) {
+			groups[group - 1].paused = paused;
+		}
+	}
+
+	bool SoftwareAudioBackend::IsGroupPaused(AudioGroupHandle group) {
+		std::lock_guard<std::mutex> lock{ mutex };
+		return group != 0 && group <= groups.size() && groups[group - 1].paused;
+	}
+
+	void SoftwareAudioBackend::StopGroup(AudioGroupHandle group) {
+		std::lock_guard<std::mutex> lock{ mutex };
+		for (auto it = voices.begin(); it != voices.end();) {
+			it = it->second.group == group || group == GetMasterGroup() ? voices.erase(it) : std::next(it);
+		}
+	}
+
+	AudioSoundHandle SoftwareAudioBackend::CreateSound(const char* path, AudioResidency residency, bool loop, bool async) {
+		auto sound{ std::make_shared<Sound>() };
+		sound->path = path;
+		sound->residency = residency;
+		sound->loop = loop;
+		sound->start = Clock::now();
+		if (async) {
+			ThreadPool::threadPool().Enqueue([sound]() { LoadSound(*sound); });
+		}
+		else {
+			LoadSound(*sound);
+			if (sound->state == AudioLoadState::FAILED) {
+				return 0;
+			}
+		}
+		AudioSoundHandle handle{ nextSound++ };
+		sounds[handle] = sound;
+		return handle;
+	}
+
+	AudioSoundInfo SoftwareAudioBackend::GetSoundInfo(AudioSoundHandle sound) {
+		auto it{ sounds.find(sound) };
+		if (it == sounds.end()) {
+			return {};
+		}
+		AudioSoundInfo info{};
+		info.state = it->second->state;
+		if (info.state == AudioLoadState::READY) {
+			info.memory = it->second->memory;
+			info.loadMilliseconds = it->second->loadMilliseconds;
+		}
+		return info;
+	}
+
+	void SoftwareAudioBackend::ReleaseSound(AudioSoundHandle sound) {
+		auto it{ sounds.find(sound) };
+		if (it == sounds.end()) {
+			return;
+		}
+		{
+			std::lock_guard<std::mutex> lock{ mutex };
+			for (auto voice = voices.begin(); voice != voices.end();) {
+				voice = voice->second.sound == it->second ? voices.erase(voice) : std::next(voice);
+			}
+		}
+		// A load still running on the thread pool holds the sound until it finishes
+		sounds.erase(it);
+	}
+
+	AudioChannelHandle SoftwareAudioBackend::Play(AudioSoundHandle sound, AudioGroupHandle group) {
+		auto it{ sounds.find(sound) };
+		if (it == sounds.end() || it->second->state == AudioLoadState::FAILED) {
+			return 0;
+		}
+		std::lock_guard<std::mutex> lock{ mutex };
+		AudioChannelHandle handle{ nextChannel++ };
+		Voice& voice{ voices[handle] };
+		voice.sound = it->second;
+		voice.group = group;
+		return handle;
+	}
+
+	bool SoftwareAudioBackend::IsPlaying(AudioChannelHandle channel) {
+		std::lock_guard<std::mutex> lock{ mutex };
+		return voices.count(channel) != 0;
+	}
+
+	void SoftwareAudioBackend::SetChannelPan(AudioChannelHandle channel, float pan) {
+		std::lock_guard<std::mutex> lock{ mutex };
+		auto it{ voices.find(channel) };
+		if (it != voices.end()) {
+			it->second.pan = std::clamp(pan, -1.f, 1.f);
+		}
+	}
+
+	void SoftwareAudioBackend::SetChannelLowPass(AudioChannelHandle channel, float gain) {
+		std::lock_guard<std::mutex> lock{ mutex };
+		auto it{ voices.find(channel) };
+		if (it != voices.end()) {
+			it->second.lowPass = std::clamp(gain, 0.f, 1.f);
+		}
+	}
+
+	bool SoftwareAudioBackend::NextFrame(Voice& voice) {
+		Sound const& sound{ *voice.sound };
+		const float* frame;
+		if (sound.residency == AudioResidency::DECODED) {
+			size_t frames{ sound.pcm.size() / sound.channels };
+			if (voice.frame >= frames) {
+				if (!sound.loop || frames == 0) {
+					return false;
+				}
+				voice.frame = 0;
+			}
+			frame = sound.pcm.data() + voice.frame * sound.channels;
+			++voice.frame;
+		}
+		else {
+			if (voice.blockFrame >= voice.blockFrames) {
+				voice.blockFrames = voice.decoder->Read(voice.block.data(), BLOCK_FRAMES);
+				if (voice.blockFrames == 0 && sound.loop) {
+					voice.decoder->Rewind();
+					voice.blockFrames = voice.decoder->Read(voice.block.data(), BLOCK_FRAMES);
+				}
+				voice.blockFrame = 0;
+				if (voice.blockFrames <= 0) {
+					return false;
+				}
+			}
+			frame = voice.block.data() + static_cast<size_t>(voice.blockFrame) * sound.channels;
+			++voice.blockFrame;
+		}
+		voice.current[0] = frame[0];
+		voice.current[1] = sound.channels > 1 ? frame[1] : frame[0];
+		return true;
+	}
+
+	void SoftwareAudioBackend::OpenDecoders(std::unique_lock<std::mutex>& lock) {
+		std::vector<std::pair<AudioChannelHandle, std::shared_ptr<Sound>>> opening{};
+		for (auto& [handle, voice] : voices) {
+			if (!voice.opened && voice.sound->residency != AudioResidency::DECODED && voice.sound->state == AudioLoadState::READY) {
+				opening.emplace_back(handle, voice.sound);
+			}
+		}
+		if (opening.empty()) {
+			return;
+		}
+
+		lock.unlock();
+		std::vector<std::unique_ptr<Decoder>> decoders{};
+		for (auto& [handle, sound] : opening) {
+			decoders.push_back(sound->data != nullptr ? OpenDecoder(sound->data, sound->size) : OpenDecoder(sound->path));
+		}
+		lock.lock();
+
+		// Voices stopped meanwhile are no longer found, as handles are never reused
+		for (size_t i = 0; i < opening.size(); ++i) {
+			auto it{ voices.find(opening[i].first) };
+			if (it != voices.end()) {
+				Voice& voice{ it->second };
+				voice.decoder = std::move(decoders[i]);
+				voice.block.resize(static_cast<size_t>(BLOCK_FRAMES) * opening[i].second->channels);
+				voice.opened = true;
+			}
+		}
+	}
+
+	void SoftwareAudioBackend::Mix() {
+		auto next{ Clock::now() };
+		std::unique_lock<std::mutex> lock{ mutex };
+		while (!stopping) {
+			next += std::chrono::microseconds{ 1000000LL * MIX_FRAMES / MIX_RATE };
+			wake.wait_until(lock, next, [this]() { return stopping.load(); });
+			if (stopping) {
+				break;
+			}
+			OpenDecoders(lock);
+
+			std::fill(mix.begin(), mix.end(), 0.f);
+			Group const& master{ groups[0] };
+			for (auto it = voices.begin(); it != voices.end();) {
+				Voice& voice{ it->second };
+				AudioLoadState state{ voice.sound->state };
+				if (state == AudioLoadState::FAILED) {
+					it = voices.erase(it);
+					continue;
+				}
+				Group const& group{ voice.group != 0 && voice.group <= groups.size() ? groups[voice.group - 1] : master };
+				if (state == AudioLoadState::LOADING || group.paused || master.paused) {
+					++it;
+					continue;
+				}
+
+				bool playing{ true };
+				if (!voice.started) {
+					Sound const& sound{ *voice.sound };
+					// Loaded after the decoders were opened, it starts on the next mix
+					if (sound.residency != AudioResidency::DECODED && !voice.opened) {
+						++it;
+						continue;
+					}
+					voice.started = true;
+					playing = (sound.residency == AudioResidency::DECODED || voice.decoder != nullptr) && NextFrame(voice);
+				}
+
+				// Linear pan as FMOD does for stereo sounds
+				float gain{ group.volume * (&group == &master ? 1.f : master.volume) };
+				float left{ gain * std::min(1.f, 1.f - voice.pan) };
+				float right{ gain * std::min(1.f, 1.f + voice.pan) };
+				double step{ static_cast<double>(voice.sound->sampleRate) / MIX_RATE };
+				for (int f = 0; playing && f < MIX_FRAMES; ++f) {
+					voice.filtered[0] += voice.lowPass * (voice.current[0] - voice.filtered[0]);
+					voice.filtered[1] += voice.lowPass * (voice.current[1] - voice.filtered[1]);
+					mix[static_cast<size_t>(f) * 2] += voice.filtered[0] * left;
+					mix[static_cast<size_t>(f) * 2 + 1] += voice.filtered[1] * right;
+					for (voice.phase += step; playing && voice.phase >= 1.0; voice.phase -= 1.0) {
+						playing = NextFrame(voice);
+					}
+				}
+				it = playing ? std::next(it) : voices.erase(it);
+			}
+			// The null sink, the mix is not played anywhere
+		}
+	}
+}
+
+std::unique_ptr<IAudioBackend> CreateSoftwareAudioBackend() {
+	return std::make_unique<SoftwareAudioBackend>();
+}
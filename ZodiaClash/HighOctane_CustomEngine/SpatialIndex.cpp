@@ -0,0 +1,293 @@
+/******************************************************************************
+*
+*	\copyright
+*		All content(C) 2023/2024 DigiPen Institute of Technology Singapore.
+*		All rights reserved. Reproduction or disclosure of this file or its
+*		contents without the prior written consent of DigiPen Institute of
+*		Technology is prohibited.
+*
+* *****************************************************************************
+*
+*	@file		SpatialIndex.cpp
+*
+*	@author		agent
+*
+*	@email		agent\@local
+*
+*	@course		CSD 2401 - Software Engineering Project 3
+*				CSD 2451 - Software Engineering Project 4
+*
+*	@section	Section A
+*
+*	@date		19 October 2026
+*
+* *****************************************************************************
+*
+*	@brief		Spatial index for camera culling
+*
+*	Uniform hash grid implementation and the synthetic culling benchmark
+*
+******************************************************************************/
+
+#include "SpatialIndex.h"
+#include "debugdiagnostic.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <random>
+
+SpatialGrid spatialGrid;
+
+int SpatialGrid::CellCoord(float value) {
+	return static_cast<int>(std::floor(value / CELL_SIZE));
+}
+
+uint64_t SpatialGrid::CellKey(int x, int y) {
+	return (static_cast<uint64_t>(static_cast<uint32_t>(x)) << 32) | static_cast<uint32_t>(y);
+}
+
+void SpatialGrid::Link(Entity entity, Record const& record) {
+	if (record.large) {
+		largeEntities.push_back(entity);
+		return;
+	}
+	for (int y = record.y0; y <= record.y1; ++y) {
+		for (int x = record.x0; x <= record.x1; ++x) {
+			cells[CellKey(x, y)].push_back(entity);
+		}
+	}
+}
+
+void SpatialGrid::Unlink(Entity entity, Record const& record) {
+	auto erase = [entity](std::vector<Entity>& list) {
+		auto it = std::find(list.begin(), list.end(), entity);
+		if (it != list.end()) {
+			*it = list.back();
+			list.pop_back();
+		}
+	};
+	if (record.large) {
+		erase(largeEntities);
+		return;
+	}
+	for (int y = record.y0; y <= record.y1; ++y) {
+		for (int x = record.x0; x <= record.x1; ++x) {
+			auto cell = cells.find(CellKey(x, y));
+			if (cell != cells.end()) {
+				erase(cell->second);
+				if (cell->second.empty()) {
+					cells.erase(cell);
+				}
+			}
+		}
+	}
+}
+
+/*!
+* \brief Insert or move an entity
+*
+* The entity is only relinked if its cell range changed, moving within the same
+* cells just updates the stored bounds.
+*
+*/
+void SpatialGrid::Update(Entity entity, vmath::Vector2 const& min, vmath::Vector2 const& max) {
+	if (entity >= records.size()) {
+		records.resize(static_cast<size_t>(entity) + 1);
+		queryStamps.resize(static_cast<size_t>(entity) + 1);
+	}
+
+	Record updated;
+	updated.min = min;
+	updated.max = max;
+	updated.x0 = CellCoord(min.x);
+	updated.y0 = CellCoord(min.y);
+	updated.x1 = CellCoord(max.x);
+	updated.y1 = CellCoord(max.y);
+	updated.large = (updated.x1 - updated.x0 >= MAX_CELL_SPAN) || (updated.y1 - updated.y0 >= MAX_CELL_SPAN);
+	updated.valid = true;
+
+	Record& record{ records[entity] };
+	if (record.valid) {
+		if (record.large == updated.large && (record.large || (record.x0 == updated.x0 && record.y0 == updated.y0 && record.x1 == updated.x1 && record.y1 == updated.y1))) {
+			record.min = updated.min;
+			record.max = updated.max;
+			return;
+		}
+		Unlink(entity, record);
+	}
+	else {
+		++count;
+	}
+	Link(entity, updated);
+	record = updated;
+}
+
+void SpatialGrid::Remove(Entity entity) {
+	if (!Contains(entity)) {
+		return;
+	}
+	Unlink(entity, records[entity]);
+	records[entity] = Record{};
+	--count;
+}
+
+bool SpatialGrid::Contains(Entity entity) const {
+	return entity < records.size() && records[entity].valid;
+}
+
+bool SpatialGrid::Visit(Entity entity, vmath::Vector2 const& min, vmath::Vector2 const& max) {
+	if (queryStamps[entity] == queryStamp) {
+		return false;
+	}
+	queryStamps[entity] = queryStamp;
+	Record const& record{ records[entity] };
+	return record.min.x <= max.x && record.max.x >= min.x && record.min.y <= max.y && record.max.y >= min.y;
+}
+
+/*!
+* \brief Rect query
+*
+* Walks the cells covered by the rect, or every occupied cell if that is fewer
+* (zoomed far out), and tests the stored bounds of each entity found.
+*
+*/
+void SpatialGrid::Query(vmath::Vector2 const& min, vmath::Vector2 const& max, std::vector<Entity>& result) {
+	if (++queryStamp == 0) {
+		std::fill(queryStamps.begin(), queryStamps.end(), 0);
+		queryStamp = 1;
+	}
+
+	for (Entity entity : largeEntities) {
+		if (Visit(entity, min, max)) {
+			result.push_back(entity);
+		}
+	}
+
+	int x0{ CellCoord(min.x) };
+	int y0{ CellCoord(min.y) };
+	int x1{ CellCoord(max.x) };
+	int y1{ CellCoord(max.y) };
+	double coveredCells{ (static_cast<double>(x1) - x0 + 1) * (static_cast<double>(y1) - y0 + 1) };
+
+	if (coveredCells > static_cast<double>(cells.size())) {
+		for (auto const& [key, list] : cells) {
+			for (Entity entity : list) {
+				if (Visit(entity, min, max)) {
+					result.push_back(entity);
+				}
+			}
+		}
+		return;
+	}
+
+	for (int y = y0; y <= y1; ++y) {
+		for (int x = x0; x <= x1; ++x) {
+			auto cell = cells.find(CellKey(x, y));
+			if (cell == cells.end()) {
+				continue;
+			}
+			for (Entity entity : cell->second) {
+				if (Visit(entity, min, max)) {
+					result.push_back(entity);
+				}
+			}
+		}
+	}
+}
+
+void SpatialGrid::Clear() {
+	cells.clear();
+	largeEntities.clear();
+	records.clear();
+	queryStamps.clear();
+	queryStamp = 0;
+	count = 0;
+	stats = CullingStats{};
+}
+
+size_t SpatialGrid::Size() const {
+	return count;
+}
+
+/*!
+* \brief Culling benchmark
+*
+* Scatters spriteCount sprites over a world 20 screens wide and tall, then pans a
+* 1920x1080 camera across it. Each frame moves a tenth of the sprites and compares
+* a grid query against testing every sprite's AABB, as GraphicsSystem::Draw did
+* before culling.
+*
+*/
+CullingBenchmarkResult RunCullingBenchmark(size_t spriteCount) {
+	using clock = std::chrono::high_resolution_clock;
+	const float worldWidth{ 1920.f * 20.f };
+	const float worldHeight{ 1080.f * 20.f };
+	const vmath::Vector2 halfView{ 960.f, 540.f };
+	const int frames{ 600 };
+
+	std::mt19937 rng{ 2024 };
+	std::uniform_real_distribution<float> posX{ -worldWidth / 2.f, worldWidth / 2.f };
+	std::uniform_real_distribution<float> posY{ -worldHeight / 2.f, worldHeight / 2.f };
+	std::uniform_real_distribution<float> extent{ 16.f, 128.f };
+	std::uniform_real_distribution<float> step{ -8.f, 8.f };
+
+	std::vector<vmath::Vector2> mins(spriteCount);
+	std::vector<vmath::Vector2> maxs(spriteCount);
+	SpatialGrid grid;
+	for (size_t i = 0; i < spriteCount; ++i) {
+		vmath::Vector2 centre{ posX(rng), posY(rng) };
+		vmath::Vector2 half{ extent(rng), extent(rng) };
+		mins[i] = centre - half;
+		maxs[i] = centre + half;
+		grid.Update(static_cast<Entity>(i), mins[i], maxs[i]);
+	}
+
+	std::vector<Entity> visible;
+	visible.reserve(spriteCount);
+	double updateMs{}, queryMs{}, scanMs{};
+	size_t queried{}, scanned{};
+	for (int frame = 0; frame < frames; ++frame) {
+		float t{ static_cast<float>(frame) / frames };
+		vmath::Vector2 cam{ (t - 0.5f) * worldWidth * 0.8f, std::sin(t * 6.2831853f) * worldHeight * 0.3f };
+		vmath::Vector2 viewMin{ cam - halfView };
+		vmath::Vector2 viewMax{ cam + halfView };
+
+		auto start{ clock::now() };
+		for (size_t i = static_cast<size_t>(frame) % 10; i < spriteCount; i += 10) {
+			vmath::Vector2 delta{ step(rng), step(rng) };
+			mins[i] += delta;
+			maxs[i] += delta;
+			grid.Update(static_cast<Entity>(i), mins[i], maxs[i]);
+		}
+		auto updated{ clock::now() };
+
+		visible.clear();
+		grid.Query(viewMin, viewMax, visible);
+		auto queriedTime{ clock::now() };
+		queried += visible.size();
+
+		for (size_t i = 0; i < spriteCount; ++i) {
+			if (mins[i].x <= viewMax.x && maxs[i].x >= viewMin.x && mins[i].y <= viewMax.y && maxs[i].y >= viewMin.y) {
+				++scanned;
+			}
+		}
+		auto scannedTime{ clock::now() };
+
+		updateMs += std::chrono::duration<double, std::milli>(updated - start).count();
+		queryMs += std::chrono::duration<double, std::milli>(queriedTime - updated).count();
+		scanMs += std::chrono::duration<double, std::milli>(scannedTime - queriedTime).count();
+	}
+
+	CullingBenchmarkResult result{};
+	result.sprites = spriteCount;
+	result.frames = frames;
+	result.visible = static_cast<double>(queried) / frames;
+	result.scanned = static_cast<double>(scanned) / frames;
+	result.queryMilliseconds = queryMs / frames;
+	result.scanMilliseconds = scanMs / frames;
+	result.updateMilliseconds = updateMs / frames;
+	DEBUG_PRINT("Culling benchmark: %zu sprites, %d frames, grid query %.4f ms/frame, linear scan %.4f ms/frame",
+		result.sprites, result.frames, result.queryMilliseconds, result.scanMilliseconds);
+	return result;
+}
@@ -0,0 +1,101 @@
+/******************************************************************************
+*
+*	\copyright
+*		All content(C) 2023/2024 DigiPen Institute of Technology Singapore.
+*		All rights reserved. Reproduction or disclosure of this file or its
+*		contents without the prior written consent of DigiPen Institute of
+*		Technology is prohibited.
+*
+* *****************************************************************************
+*
+*	@file		SpatialIndex.h
+*
+*	@author		agent
+*
+*	@email		agent\@local
+*
+*	@course		CSD 2401 - Software Engineering Project 3
+*				CSD 2451 - Software Engineering Project 4
+*
+*	@section	Section A
+*
+*	@date		19 October 2026
+*
+* *****************************************************************************
+*
+*	@brief		Spatial index for camera culling
+*
+*	Uniform hash grid over world space model AABBs. Entities are moved
+*	between cells only when their bounds change, and the graphics system
+*	queries the camera rect every frame to skip models that are off screen.
+*
+******************************************************************************/
+
+#pragma once
+#include "VMath.h"
+#include <vector>
+#include <unordered_map>
+#include <cstdint>
+
+using Entity = std::uint32_t;
+
+struct CullingStats {
+	size_t indexed{};	//entities currently in the spatial index
+	size_t visible{};	//indexed entities intersecting the camera rect
+	size_t drawn{};		//models submitted to the renderers last frame
+	size_t culled{};	//models skipped last frame for being off screen
+	size_t updated{};	//models whose vertices were recomputed last update, unchanged models are skipped
+};
+
+class SpatialGrid {
+public:
+	static constexpr float CELL_SIZE = 256.f; //world units per cell side
+	static constexpr int MAX_CELL_SPAN = 32; //entities spanning more cells than this on an axis are kept out of the grid
+
+	void Update(Entity entity, vmath::Vector2 const& min, vmath::Vector2 const& max); //insert or move an entity
+	void Remove(Entity entity); //remove an entity, does nothing if it is not indexed
+	bool Contains(Entity entity) const; //true if the entity is indexed
+	void Query(vmath::Vector2 const& min, vmath::Vector2 const& max, std::vector<Entity>& result); //appends every entity overlapping the rect, no duplicates
+	void Clear(); //remove every entity
+	size_t Size() const; //number of entities indexed
+
+	CullingStats stats{};
+
+private:
+	struct Record {
+		vmath::Vector2 min{};
+		vmath::Vector2 max{};
+		int x0{}, y0{}, x1{}, y1{}; //inclusive cell range
+		bool large{}; //stored in largeEntities instead of cells
+		bool valid{};
+	};
+
+	static int CellCoord(float value);
+	static uint64_t CellKey(int x, int y);
+	void Link(Entity entity, Record const& record);
+	void Unlink(Entity entity, Record const& record);
+	bool Visit(Entity entity, vmath::Vector2 const& min, vmath::Vector2 const& max);
+
+	std::unordered_map<uint64_t, std::vector<Entity>> cells{};
+	std::vector<Entity> largeEntities{};
+	std::vector<Record> records{}; //indexed by entity
+	std::vector<uint32_t> queryStamps{}; //indexed by entity, prevents an entity spanning cells being returned twice
+	uint32_t queryStamp{};
+	size_t count{};
+};
+
+extern SpatialGrid spatialGrid;
+
+//Result of RunCullingBenchmark, averaged per frame
+struct CullingBenchmarkResult {
+	size_t sprites{};
+	int frames{};
+	double visible{};				//sprites returned by the grid query
+	double scanned{};				//sprites found by the linear scan
+	double queryMilliseconds{};
+	double scanMilliseconds{};
+	double updateMilliseconds{};	//moving a tenth of the sprites
+};
+
+//Builds a synthetic level of spriteCount sprites and compares grid queries against a linear scan
+CullingBenchmarkResult RunCullingBenchmark(size_t spriteCount = 50000);
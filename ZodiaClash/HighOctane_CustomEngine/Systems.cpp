@@ -58,13 +58,18 @@
 #include "Animation.h"
 #include "UndoRedo.h"
 #include "Particles.h"
-#include <random>
+#include "GlyphAtlas.h"
+#include "SpatialIndex.h"
+#include "Random.h"
+#include "AIDecisionJob.h"
+#include "SceneSnapshot.h"
 #define FIXED_DT 1.0f/60.f
 #define MAX_ACCUMULATED_TIME 5.f // to avoid the "spiral of death" if the system cannot keep up
 
 constexpr float CORNER_SIZE{ 10.f };
 constexpr float CROSS_SIZE{ 10.f };
 constexpr float Y_OFFSET{ 75.f };
+constexpr float CULL_MARGIN{ 1.1f }; // camera rect scale used for culling, covers camera shake
 
 // Extern for the vector to contain the full name for ImGui for scripting system
 extern std::vector<std::string> fullNameVecImGUI;
@@ -189,6 +194,11 @@ void PhysicsSystem::Draw() {
 
 void EmitterSystem::Update()
 {
+	//Random values drawn per particle: position (4), velocity (2), rotation (2)
+	const int PARTICLE_RANDOMS{ 8 };
+	static std::vector<float> randomValues{};
+	Xoshiro128& rng{ randomService.Stream(RandomStream::PARTICLES) };
+
 	ComponentManager& componentManager = ECS::ecs().GetComponentManager();
 	auto& sizeArray = componentManager.GetComponentArrayRef<Size>();
 	auto& transformArray = componentManager.GetComponentArrayRef<Transform>();
@@ -202,14 +212,8 @@ void EmitterSystem::Update()
 				continue;
 			}
 
-			std::random_device rd;
-			std::mt19937 gen(rd());
-			// Create a uniform distribution
-			std::uniform_real_distribution<float> dis(-1.f, 1.f);
-			std::uniform_int_distribution<int> disTex(0, (int)(emitter->textures.size()) - 1);
-
 			if (!emitter->initialised) {
-				emitter->emitterLifetime = fabs(dis(gen)) * emitter->frequency;
+				emitter->emitterLifetime = rng.Float() * emitter->frequency;
 				emitter->initialised = true;
 			}
 
@@ -220,20 +224,26 @@ void EmitterSystem::Update()
 			int layernum = static_cast<int>(FindInLayer(entity).first);
 
 			if (emitter->emitterLifetime >= emitter->frequency) {
+				// Draw the random values of every particle of this cycle at once
+				randomValues.resize(static_cast<size_t>(std::max(emitter->particlesRate, 0)) * PARTICLE_RANDOMS);
+				rng.Fill(randomValues.data(), randomValues.size(), -1.f, 1.f);
+
 				for (int i = 0; i < emitter->particlesRate; ++i) {
+					float const* dis{ &randomValues[static_cast<size_t>(i) * PARTICLE_RANDOMS] };
+
 					// Here, you might introduce randomness or variations based on the emitter's properties
-					Vec2 position = emitter->position + Vec2{dis(gen) * emitterWidth,dis(gen) * emitterHeight}; // Plus any offset or randomness
+					Vec2 position = emitter->position + Vec2{dis[0] * emitterWidth,dis[1] * emitterHeight}; // Plus any offset or randomness
 					Vec2 size = emitter->size;
 
 					if (!emitter->singleSided) {
-						position = emitter->position + Vec2{ dis(gen) * (emitterWidth / 2),-fabs(dis(gen)) * emitterHeight };
+						position = emitter->position + Vec2{ dis[2] * (emitterWidth / 2),-fabs(dis[3]) * emitterHeight };
 					}
 
-					float velocityRandomness = emitter->singleSided ? fabs(dis(gen)) : dis(gen);
-					Vec2 velocity = { emitter->velocity.x * velocityRandomness, emitter->velocity.y * fabs(dis(gen))}; // Plus any randomness or directional adjustments
+					float velocityRandomness = emitter->singleSided ? fabs(dis[4]) : dis[4];
+					Vec2 velocity = { emitter->velocity.x * velocityRandomness, emitter->velocity.y * fabs(dis[5])}; // Plus any randomness or directional adjustments
 					Color color = emitter->particleColor;
-					float rotation = emitter->rotation * dis(gen);
-					float rotationSpeed = emitter->rotationSpeed * dis(gen);
+					float rotation = emitter->rotation * dis[6];
+					float rotationSpeed = emitter->rotationSpeed * dis[7];
 					float timer = emitter->particleLifetime;
 
 					// Assuming nullptr for now, but you can pass custom update functions based on emitter or particle type
@@ -245,7 +255,7 @@ void EmitterSystem::Update()
 					p.timer = timer;
 					p.layer = layernum;
 
-					int textureIndex{ disTex(gen) };
+					int textureIndex{ emitter->textures.size() > 1 ? rng.RangeInt(0, (int)(emitter->textures.size()) - 1) : 0 };
 					p.texture = assetmanager.texture.Get(emitter->textures[textureIndex].c_str());
 					if (!p.texture) continue;
 					p.textureID = (float)(p.texture->GetID() - 1.f);
@@ -571,6 +581,7 @@ void GraphicsSystem::Update() {
 	auto& sizeArray = componentManager.GetComponentArrayRef<Size>();
 	auto& textArray = componentManager.GetComponentArrayRef<TextLabel>();
 
+	size_t modelUpdates{};
 	//for (Entity const& entity : m_Entities) {
 	for (size_t layer_it = 0; layer_it < layering.size(); ++layer_it) {
 		if (layersToSkip[layer_it] && layersToLock[layer_it]) {
@@ -580,13 +591,29 @@ void GraphicsSystem::Update() {
 						Model* m = &modelArray.GetData(entity);
 						Size* size = &sizeArray.GetData(entity);
 						Transform* transform = &transformArray.GetData(entity);
-						m->Update(*transform, *size);
+						// looping backgrounds follow the camera, everything else is only recomputed when it moves or resizes
+						bool changed{ m->CheckTransformUpdated(*transform, *size) };
+						if (changed || m->type == ModelType::BACKGROUNDLOOP) {
+							m->Update(*transform, *size);
+							++modelUpdates;
+						}
+						// gameplay models are culled against the camera
+						if (m->type == ModelType::GAMEPLAY) {
+							if (changed || !spatialGrid.Contains(entity)) {
+								spatialGrid.Update(entity, m->GetWorldMin(), m->GetWorldMax());
+							}
+						}
+						else {
+							spatialGrid.Remove(entity);
+						}
 					}
 				}
 			}
 		}
 	}
 
+	spatialGrid.stats.updated = modelUpdates;
+
 	//UPDATE FREE CAMERA MOVEMENT
 	if (viewportWindowHovered) {
 		for (Postcard const& msg : Mail::mail().mailbox[ADDRESS::MOVEMENT]) {
@@ -655,6 +682,25 @@ void GraphicsSystem::Draw() {
 		return;
 	}
 
+	// glyph shelves not drawn since the last frame become eviction candidates
+	glyphAtlas.NewFrame();
+
+	// mark indexed models intersecting the camera rect, with a margin for camera shake
+	static std::array<bool, MAX_ENTITIES> entityVisible{};
+	static std::vector<Entity> visibleEntities{};
+	float zoom{ std::max(camera.GetZoom(), 0.01f) };
+	vmath::Vector2 halfView{ GRAPHICS::w / zoom * CULL_MARGIN, GRAPHICS::h / zoom * CULL_MARGIN };
+	vmath::Vector2 cameraPos{ camera.GetPos() };
+	visibleEntities.clear();
+	spatialGrid.Query(cameraPos - halfView, cameraPos + halfView, visibleEntities);
+	for (Entity entity : visibleEntities) {
+		entityVisible[entity] = true;
+	}
+	spatialGrid.stats.indexed = spatialGrid.Size();
+	spatialGrid.stats.visible = visibleEntities.size();
+	spatialGrid.stats.drawn = 0;
+	spatialGrid.stats.culled = 0;
+
 	graphics.viewport.Unuse();
 	for (size_t layer_it = 0; layer_it < layering.size(); ++layer_it) {
 		if (layersToSkip[layer_it]/* || GetCurrentSystemMode() != SystemMode::EDIT*/) {
@@ -665,6 +711,12 @@ void GraphicsSystem::Draw() {
 					Model* m{};
 					if (modelArray.HasComponent(entity)) {
 						m = &modelArray.GetData(entity);
+						// models missing from the index have not been updated yet, so they are always drawn
+						if (m->type == ModelType::GAMEPLAY && !entityVisible[entity] && spatialGrid.Contains(entity)) {
+							++spatialGrid.stats.culled;
+							continue;
+						}
+						++spatialGrid.stats.drawn;
 						if (texArray.HasComponent(entity)) {
 							tex = &texArray.GetData(entity);
 						}
@@ -690,6 +742,10 @@ void GraphicsSystem::Draw() {
 		particles.Draw((int)layer_it);
 	}
 
+	for (Entity entity : visibleEntities) {
+		entityVisible[entity] = false;
+	}
+
 	if (GetCurrentSystemMode() == SystemMode::EDIT && snappingOn) {
 		Renderer* render = &graphics.renderer["staticline"];
 		for (auto& it : snappingLines) {
@@ -763,11 +819,9 @@ void SerializationSystem::Update() {
 	}
 
 	if (newScene) {
+		aiDecisionJob.Cancel();
 		if (newSceneName != sceneName) {
-			assetmanager.UnloadAll();
-			if (newSceneName != "") {
-				assetmanager.LoadAssets(newSceneName);
-			}
+			assetmanager.ChangeScene(newSceneName);
 		}
 		else {
 			std::string jsonpath{ sceneName.substr(0,sceneName.find('.')) };
@@ -775,6 +829,7 @@ void SerializationSystem::Update() {
 			assetmanager.LoadAssets(jsonpath);
 			assetmanager.audio.RestartBGM();
 		}
+		randomService.NewScene(newSceneName);
 		initLevel = true;
 		newScene = false;
 		if (GetCurrentSystemMode() == SystemMode::PAUSE) {
@@ -787,26 +842,24 @@ void SerializationSystem::Update() {
 	}
 
 	if (playButton) {
+		sceneSnapshot.Capture();
+		playButton = false;
+	}
 
-		std::string scenePath{ assetmanager.GetDefaultPath() + "Scenes/tmp.scn" };
-		if (scenePath != "") {
-			std::ofstream sceneFile{ scenePath.c_str() };
-
-			std::string jsonPath{ assetmanager.GetDefaultPath() + "Scenes/tmp.json" };
-			std::vector<Entity> entityList{};
-			for (auto& e : m_Entities) {
-				entityList.push_back(e);
-			}
-			Serializer::SaveEntityToJson(jsonPath, entityList);
-
-			auto files = assetmanager.GetFiles();
-			for (auto& f : files) {
-				sceneFile << f << "\n";
-			}
-			sceneFile << "tmp.json";
-			sceneFile.close();
+	if (stopButton) {
+		aiDecisionJob.Cancel();
+		if (sceneSnapshot.Restore()) {
+			randomService.NewScene(sceneName);
+			initLevel = true;
 		}
-		playButton = false;
+		keyObjectID = std::numeric_limits<Entity>().max();
+		keyObjectColor = { RESET_VEC4 };
+		assetmanager.audio.ResumeGroup("Master");
+		assetmanager.audio.ResumeGroup("BGM");
+		assetmanager.audio.ResumeGroup("SFX");
+		assetmanager.audio.ResumeGroup("VOC");
+		EngineCore::engineCore().set_m_previousTime(GetTime());
+		stopButton = false;
 	}
 
 
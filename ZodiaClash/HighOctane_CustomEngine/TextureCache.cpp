@@ -0,0 +1,334 @@
+/******************************************************************************
+*
+*	\copyright
+*		All content(C) 2023/2024 DigiPen Institute of Technology Singapore.
+*		All rights reserved. Reproduction or disclosure of this file or its
+*		contents without the prior written consent of DigiPen Institute of
+*		Technology is prohibited.
+*
+* *****************************************************************************
+*
+*	@file		TextureCache.cpp
+*
+*	@author		agent
+*
+*	@email		agent\@local
+*
+*	@course		CSD 2401 - Software Engineering Project 3
+*				CSD 2451 - Software Engineering Project 4
+*
+*	@section	Section A
+*
+*	@date		19 October 2026
+*
+* *****************************************************************************
+*
+*	@brief		Cooked texture cache (.ztex)
+*
+*	Cooking, validation and upload of .ztex texture containers
+*
+******************************************************************************/
+
+#include "TextureCache.h"
+#include "Texture.h"
+#include "File.h"
+#include "AssetPack.h"
+#include "debugdiagnostic.h"
+
+#include <filesystem>
+#include <fstream>
+#include <cstring>
+#include <algorithm>
+
+#define STB_DXT_IMPLEMENTATION
+#include <stb-master/stb_dxt.h>
+
+TextureCache texturecache;
+
+namespace {
+	const uint32_t ZTEX_VERSION{ 1 };
+	const uint32_t ZTEX_ALIGNMENT{ 16 };
+	const uint32_t ZTEX_MAX_SIDE{ 32768 };	//largest width or height loaded, keeps the level sizes from overflowing
+
+	uint32_t Align(uint32_t offset) {
+		return (offset + ZTEX_ALIGNMENT - 1) & ~(ZTEX_ALIGNMENT - 1);
+	}
+
+	//Bytes used by one mip level of the given format
+	size_t LevelSize(CookedFormat format, int width, int height) {
+		if (format == CookedFormat::RGBA8) {
+			return static_cast<size_t>(width) * static_cast<size_t>(height) * channelnum;
+		}
+		return static_cast<size_t>((width + 3) / 4) * static_cast<size_t>((height + 3) / 4) * 16;
+	}
+
+	//Checks the format, mip count and level sizes of a header against each other, so a truncated or
+	//stale container is cooked again instead of being uploaded past the end of the file
+	bool IsValidLayout(const CookedTextureHeader& header) {
+		CookedFormat format{ static_cast<CookedFormat>(header.format) };
+		if (format != CookedFormat::RGBA8 && format != CookedFormat::BC3 && format != CookedFormat::BC7 && format != CookedFormat::ETC2) {
+			return false;
+		}
+		if (header.width == 0 || header.height == 0 || header.width > ZTEX_MAX_SIDE || header.height > ZTEX_MAX_SIDE) {
+			return false;
+		}
+		uint32_t maxMipCount{ 1 };
+		for (uint32_t side = std::max(header.width, header.height); side > 1; side >>= 1) {
+			++maxMipCount;
+		}
+		if (header.mipCount == 0 || header.mipCount > maxMipCount) {
+			return false;
+		}
+		size_t pixelSize{};
+		for (uint32_t level = 0; level < header.mipCount; ++level) {
+			pixelSize += LevelSize(format, std::max(1, static_cast<int>(header.width >> level)), std::max(1, static_cast<int>(header.height >> level)));
+		}
+		return pixelSize == header.pixelSize;
+	}
+
+	GLenum GLFormat(CookedFormat format) {
+		switch (format) {
+		case CookedFormat::BC3:
+			return GL_COMPRESSED_RGBA_S3TC_DXT5_EXT;
+		case CookedFormat::BC7:
+			return GL_COMPRESSED_RGBA_BPTC_UNORM;
+		case CookedFormat::ETC2:
+			return GL_COMPRESSED_RGBA8_ETC2_EAC;
+		default:
+			return GL_RGBA8;
+		}
+	}
+
+	//Compresses an RGBA8 image into DXT5 blocks, edge pixels are repeated to pad partial blocks
+	void EncodeBC3(const unsigned char* pixels, int width, int height, std::vector<unsigned char>& output) {
+		unsigned char block[64];
+		unsigned char encoded[16];
+		for (int by = 0; by < height; by += 4) {
+			for (int bx = 0; bx < width; bx += 4) {
+				for (int y = 0; y < 4; ++y) {
+					int sy = std::min(by + y, height - 1);
+					for (int x = 0; x < 4; ++x) {
+						int sx = std::min(bx + x, width - 1);
+						std::memcpy(block + (y * 4 + x) * channelnum, pixels + (static_cast<size_t>(sy) * width + sx) * channelnum, channelnum);
+					}
+				}
+				stb_compress_dxt_block(encoded, block, 1, STB_DXT_HIGHQUAL);
+				output.insert(output.end(), encoded, encoded + 16);
+			}
+		}
+	}
+
+	//Box filters an RGBA8 image down to half its size
+	std::vector<unsigned char> Downsample(const std::vector<unsigned char>& pixels, int width, int height, int newWidth, int newHeight) {
+		std::vector<unsigned char> output(static_cast<size_t>(newWidth) * newHeight * channelnum);
+		for (int y = 0; y < newHeight; ++y) {
+			int y0 = std::min(y * 2, height - 1);
+			int y1 = std::min(y * 2 + 1, height - 1);
+			for (int x = 0; x < newWidth; ++x) {
+				int x0 = std::min(x * 2, width - 1);
+				int x1 = std::min(x * 2 + 1, width - 1);
+				for (int c = 0; c < channelnum; ++c) {
+					int sum = pixels[(static_cast<size_t>(y0) * width + x0) * channelnum + c]
+						+ pixels[(static_cast<size_t>(y0) * width + x1) * channelnum + c]
+						+ pixels[(static_cast<size_t>(y1) * width + x0) * channelnum + c]
+						+ pixels[(static_cast<size_t>(y1) * width + x1) * channelnum + c];
+					output[(static_cast<size_t>(y) * newWidth + x) * channelnum + c] = static_cast<unsigned char>((sum + 2) / 4);
+				}
+			}
+		}
+		return output;
+	}
+}
+
+std::string TextureCache::GetCachePath(const std::string& sourcePath) {
+	//Assets/Textures/name.png -> Assets/Cache/Textures/name.ztex
+	std::filesystem::path source{ sourcePath };
+	std::filesystem::path folder{ source.parent_path() };
+	std::filesystem::path cachePath{ folder.parent_path() / "Cache" / folder.filename() / source.stem() };
+	cachePath += ".ztex";
+	return cachePath.string();
+}
+
+bool TextureCache::GetSourceStamp(const std::string& sourcePath, uint64_t& time, uint64_t& size) {
+	// Packed files keep the stamp they had when packed
+	if (assetpack.GetStamp(sourcePath, time, size)) {
+		return true;
+	}
+	std::error_code error;
+	auto writeTime = std::filesystem::last_write_time(sourcePath, error);
+	if (error) {
+		return false;
+	}
+	auto fileSize = std::filesystem::file_size(sourcePath, error);
+	if (error) {
+		return false;
+	}
+	time = static_cast<uint64_t>(writeTime.time_since_epoch().count());
+	size = static_cast<uint64_t>(fileSize);
+	return true;
+}
+
+bool TextureCache::Load(Texture& texture, const std::string& sourcePath) {
+	if (!enabled) {
+		return false;
+	}
+	uint64_t sourceTime{};
+	uint64_t sourceSize{};
+	if (!GetSourceStamp(sourcePath, sourceTime, sourceSize)) {
+		return false;
+	}
+
+	MappedFile file;
+	if (!file.Open(GetCachePath(sourcePath)) || file.Size() < sizeof(CookedTextureHeader)) {
+		return false;
+	}
+
+	CookedTextureHeader header;
+	std::memcpy(&header, file.Data(), sizeof(CookedTextureHeader));
+	if (std::memcmp(header.magic, "ZTEX", 4) != 0 || header.version != ZTEX_VERSION
+		|| header.sourceTime != sourceTime || header.sourceSize != sourceSize
+		|| !IsValidLayout(header)
+		|| static_cast<size_t>(header.pixelOffset) + header.pixelSize > file.Size()
+		|| static_cast<size_t>(header.texcoordOffset) + static_cast<size_t>(header.frameCount) * sizeof(Texcoords) > file.Size()) {
+		return false;
+	}
+
+	CookedFormat format{ static_cast<CookedFormat>(header.format) };
+	GLenum glFormat{ GLFormat(format) };
+	int width{ static_cast<int>(header.width) };
+	int height{ static_cast<int>(header.height) };
+
+	GLuint id;
+	glCreateTextures(GL_TEXTURE_2D, 1, &id);
+	glTextureStorage2D(id, static_cast<GLsizei>(header.mipCount), glFormat, width, height);
+	const unsigned char* pixels{ file.Data() + header.pixelOffset };
+	for (uint32_t level = 0; level < header.mipCount; ++level) {
+		int levelWidth{ std::max(1, width >> level) };
+		int levelHeight{ std::max(1, height >> level) };
+		size_t levelSize{ LevelSize(format, levelWidth, levelHeight) };
+		if (format == CookedFormat::RGBA8) {
+			glTextureSubImage2D(id, static_cast<GLint>(level), 0, 0, levelWidth, levelHeight, GL_RGBA, GL_UNSIGNED_BYTE, pixels);
+		}
+		else {
+			glCompressedTextureSubImage2D(id, static_cast<GLint>(level), 0, 0, levelWidth, levelHeight, glFormat, static_cast<GLsizei>(levelSize), pixels);
+		}
+		pixels += levelSize;
+	}
+	if (header.mipCount > 1) {
+		glTextureParameteri(id, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
+	}
+
+	texture.id = id;
+	texture.width = width;
+	texture.height = height;
+	texture.active = true;
+	if (header.frameCount > 0) {
+		const Texcoords* coords{ reinterpret_cast<const Texcoords*>(file.Data() + header.texcoordOffset) };
+		texture.cachedRowCount = header.rowCount;
+		texture.cachedColCount = header.colCount;
+		texture.cachedTexcoords.assign(coords, coords + header.frameCount);
+	}
+	++hits;
+	return true;
+}
+
+void TextureCache::Cook(const std::string& sourcePath, const unsigned char* pixels, int width, int height) {
+	++misses;
+	uint64_t sourceTime{};
+	uint64_t sourceSize{};
+	if (!enabled || pixels == nullptr || !GetSourceStamp(sourcePath, sourceTime, sourceSize)) {
+		return;
+	}
+
+	CookedFormat format{ compress ? CookedFormat::BC3 : CookedFormat::RGBA8 };
+	std::vector<unsigned char> payload;
+	std::vector<unsigned char> level(pixels, pixels + static_cast<size_t>(width) * height * channelnum);
+	int levelWidth{ width };
+	int levelHeight{ height };
+	uint32_t mipCount{ 0 };
+	while (true) {
+		if (format == CookedFormat::BC3) {
+			EncodeBC3(level.data(), levelWidth, levelHeight, payload);
+		}
+		else {
+			payload.insert(payload.end(), level.begin(), level.end());
+		}
+		++mipCount;
+		if (!generateMips || (levelWidth == 1 && levelHeight == 1)) {
+			break;
+		}
+		int nextWidth{ std::max(1, levelWidth / 2) };
+		int nextHeight{ std::max(1, levelHeight / 2) };
+		level = Downsample(level, levelWidth, levelHeight, nextWidth, nextHeight);
+		levelWidth = nextWidth;
+		levelHeight = nextHeight;
+	}
+
+	CookedTextureHeader header;
+	header.version = ZTEX_VERSION;
+	header.sourceTime = sourceTime;
+	header.sourceSize = sourceSize;
+	header.width = static_cast<uint32_t>(width);
+	header.height = static_cast<uint32_t>(height);
+	header.format = static_cast<uint32_t>(format);
+	header.mipCount = mipCount;
+	header.pixelOffset = Align(sizeof(CookedTextureHeader));
+	header.pixelSize = static_cast<uint32_t>(payload.size());
+	header.texcoordOffset = Align(header.pixelOffset + header.pixelSize);
+
+	std::string cachePath{ GetCachePath(sourcePath) };
+	std::string tempPath{ cachePath + ".tmp" };
+	std::error_code error;
+	std::filesystem::create_directories(std::filesystem::path{ cachePath }.parent_path(), error);
+	{
+		std::ofstream output{ tempPath, std::ios::binary | std::ios::trunc };
+		if (!output.is_open()) {
+			DEBUG_PRINT("Unable to write texture cache %s", cachePath.c_str());
+			return;
+		}
+		const char padding[ZTEX_ALIGNMENT]{};
+		output.write(reinterpret_cast<const char*>(&header), sizeof(CookedTextureHeader));
+		output.write(padding, header.pixelOffset - sizeof(CookedTextureHeader));
+		output.write(reinterpret_cast<const char*>(payload.data()), payload.size());
+		output.write(padding, header.texcoordOffset - (header.pixelOffset + header.pixelSize));
+	}
+	std::filesystem::rename(tempPath, cachePath, error);
+	if (error) {
+		std::filesystem::remove(tempPath, error);
+	}
+}
+
+void TextureCache::StoreLayout(const std::string& sourcePath, int row, int col, const std::vector<Texcoords>& texcoords) {
+	if (!enabled || texcoords.empty()) {
+		return;
+	}
+	std::fstream file{ GetCachePath(sourcePath), std::ios::binary | std::ios::in | std::ios::out };
+	if (!file.is_open()) {
+		return;
+	}
+	CookedTextureHeader header;
+	file.read(reinterpret_cast<char*>(&header), sizeof(CookedTextureHeader));
+	if (!file || std::memcmp(header.magic, "ZTEX", 4) != 0 || header.version != ZTEX_VERSION) {
+		return;
+	}
+	header.rowCount = row;
+	header.colCount = col;
+	header.frameCount = static_cast<int32_t>(texcoords.size());
+	file.seekp(0);
+	file.write(reinterpret_cast<const char*>(&header), sizeof(CookedTextureHeader));
+	file.seekp(header.texcoordOffset);
+	file.write(reinterpret_cast<const char*>(texcoords.data()), texcoords.size() * sizeof(Texcoords));
+}
+
+void TextureCache::ResetStats() {
+	hits = 0;
+	misses = 0;
+}
+
+size_t TextureCache::GetHits() {
+	return hits;
+}
+
+size_t TextureCache::GetMisses() {
+	return misses;
+}
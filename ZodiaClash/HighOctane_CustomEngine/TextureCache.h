@@ -0,0 +1,102 @@
+/******************************************************************************
+*
+*	\copyright
+*		All content(C) 2023/2024 DigiPen Institute of Technology Singapore.
+*		All rights reserved. Reproduction or disclosure of this file or its
+*		contents without the prior written consent of DigiPen Institute of
+*		Technology is prohibited.
+*
+* *****************************************************************************
+*
+*	@file		TextureCache.h
+*
+*	@author		agent
+*
+*	@email		agent\@local
+*
+*	@course		CSD 2401 - Software Engineering Project 3
+*				CSD 2451 - Software Engineering Project 4
+*
+*	@section	Section A
+*
+*	@date		19 October 2026
+*
+* *****************************************************************************
+*
+*	@brief		Cooked texture cache (.ztex)
+*
+*	Decoding PNGs through stb_image is the bulk of our startup time. The first
+*	time a texture is loaded its decoded pixels are cooked into a binary .ztex
+*	container under Assets/Cache/. Later launches memory map the container and
+*	upload it straight to OpenGL without decoding.
+*
+*	Container layout:
+*	[CookedTextureHeader][pad to 16][mip 0 .. mip n-1][pad to 16][Texcoords x frameCount]
+*
+*	A container is only used if the source file's size and last write time
+*	match what was recorded when it was cooked, and its format, mip count and
+*	pixel size agree with each other, otherwise it is cooked again.
+*
+******************************************************************************/
+
+#pragma once
+#include "GraphLib.h"
+#include <string>
+#include <vector>
+#include <cstdint>
+
+class Texture; //forward declaration
+struct Texcoords; //forward declaration
+
+//Pixel formats a cooked texture may be stored in
+enum class CookedFormat : uint32_t {
+	RGBA8 = 0,	//raw RGBA, 4 bytes per pixel
+	BC3 = 1,	//DXT5 blocks, 16 bytes per 4x4 block (produced by the cooker when compression is on)
+	BC7 = 2,	//BPTC blocks, 16 bytes per 4x4 block (accepted by the loader, produced by external tools)
+	ETC2 = 3	//ETC2 RGBA8 EAC blocks, 16 bytes per 4x4 block (accepted by the loader, produced by external tools)
+};
+
+struct CookedTextureHeader {
+	char magic[4]{ 'Z','T','E','X' };
+	uint32_t version{};
+	uint64_t sourceTime{};		//last write time of the source image when cooked
+	uint64_t sourceSize{};		//file size of the source image when cooked
+	uint32_t width{};			//width of the full image (mip 0)
+	uint32_t height{};			//height of the full image (mip 0)
+	uint32_t format{};			//CookedFormat
+	uint32_t mipCount{};		//number of mip levels stored
+	int32_t rowCount{};			//sprite sheet rows, 0 if no sheet layout is stored
+	int32_t colCount{};			//sprite sheet columns
+	int32_t frameCount{};		//number of Texcoords stored
+	uint32_t pixelOffset{};		//byte offset of mip 0
+	uint32_t pixelSize{};		//total bytes of all mips
+	uint32_t texcoordOffset{};	//byte offset of the Texcoords array
+};
+
+class TextureCache {
+public:
+	bool enabled{ true };		//when false textures are always decoded from source
+	bool generateMips{ false };	//cook a full mip chain (off by default, sprites are drawn 1:1)
+	bool compress{ false };		//cook to BC3 blocks instead of RGBA8 (off by default, lossy on pixel art)
+
+	//Uploads the cached copy of sourcePath into texture. Returns false if no valid cache exists
+	bool Load(Texture& texture, const std::string& sourcePath);
+	//Cooks decoded RGBA8 pixels of sourcePath into a container
+	void Cook(const std::string& sourcePath, const unsigned char* pixels, int width, int height);
+	//Records the sprite sheet layout of sourcePath in its container so it does not need to be rebuilt
+	void StoreLayout(const std::string& sourcePath, int row, int col, const std::vector<Texcoords>& texcoords);
+	//Returns the container path used for sourcePath
+	std::string GetCachePath(const std::string& sourcePath);
+
+	void ResetStats();
+	size_t GetHits();	//containers uploaded without decoding since last ResetStats
+	size_t GetMisses();	//textures decoded (and cooked) since last ResetStats
+
+private:
+	bool GetSourceStamp(const std::string& sourcePath, uint64_t& time, uint64_t& size);
+
+	size_t hits{};
+	size_t misses{};
+};
+
+extern TextureCache texturecache;
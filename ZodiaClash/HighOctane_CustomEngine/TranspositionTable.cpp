@@ -0,0 +1,311 @@
+/******************************************************************************
+*
+*	\copyright
+*		All content(C) 2023/2024 DigiPen Institute of Technology Singapore.
+*		All rights reserved. Reproduction or disclosure of this file or its
+*		contents without the prior written consent of DigiPen Institute of
+*		Technology is prohibited.
+*
+* *****************************************************************************
+*
+*	@file		TranspositionTable.cpp
+*
+*	@author		agent
+*
+*	@email		agent\@local
+*
+*	@course		CSD 2401 - Software Engineering Project 3
+*				CSD 2451 - Software Engineering Project 4
+*
+*	@section	Section A
+*
+*	@date		19 October 2026
+*
+* *****************************************************************************
+*
+*	@brief		Transposition table for the AI search
+*
+*	Zobrist hashing of simulated battle states and the lock-free table
+*
+******************************************************************************/
+
+#include "TranspositionTable.h"
+#include "CharacterStats.h"
+
+#include <algorithm>
+#include <cstring>
+
+TranspositionTable transpositionTable;
+
+namespace {
+	//Small integer fields of a character, hashed by value
+	enum CharacterField {
+		ATTACK_STACK,
+		DEFENSE_STACK,
+		REFLECT_STACK,
+		SHIELD_STACK,
+		SHIELD_ENTITY,
+		BLOOD_STACK,
+		TAUNT_STACK,
+		TAUNT_TARGET,
+		STUN_STACK,
+		HUNTED_STACK,
+		IGNITE_STACK,
+		ATTACK_DEBUFF_STACK,
+		DEFENSE_DEBUFF_STACK,
+		CYCLE,
+		ENTITY_STATE,
+		CHARGE,
+		REMOVED,
+		CHARACTER_FIELD_COUNT
+	};
+
+	//Float fields of a character, hashed by their bits
+	enum FloatField {
+		HEALTH,
+		ATTACK_BUFF,
+		DEFENSE_BUFF,
+		ATTACK_DEBUFF,
+		DEFENSE_DEBUFF,
+		FLOAT_FIELD_COUNT
+	};
+
+	//Fields of the battle, hashed by value
+	enum BattleField {
+		TURN_COUNT,
+		ACTIVE_CHARACTER,
+		SPEEDUP_CHARACTER,
+		BATTLE_STATE,
+		SPEEDUP,
+		SPEEDUP_ANIMATION_PLAYED,
+		ROUND_IN_PROGRESS,
+		ROUND_CHARACTER_COUNT,
+		CHI,
+		BATTLE_FIELD_COUNT
+	};
+
+	const int VALUES = 16; //values of each small field with their own key, larger values wrap around
+
+	uint64_t SplitMix(uint64_t& state) {
+		uint64_t z{ (state += 0x9E3779B97F4A7C15ull) };
+		z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+		z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+		return z ^ (z >> 31);
+	}
+
+	//Spreads a value that has no table of its own (floats, the AI multiplier) over the key
+	uint64_t Mix(uint64_t key, uint64_t value) {
+		uint64_t state{ key ^ value };
+		return SplitMix(state);
+	}
+
+	struct ZobristKeys {
+		uint64_t characters[SIM_MAX_CHARACTERS][CHARACTER_FIELD_COUNT][VALUES];
+		uint64_t floats[SIM_MAX_CHARACTERS][FLOAT_FIELD_COUNT];
+		uint64_t turnOrder[SIM_MAX_TURNS][SIM_MAX_CHARACTERS + 1];
+		uint64_t battle[BATTLE_FIELD_COUNT][VALUES];
+		uint64_t aiMultiplier;
+
+		ZobristKeys() {
+			uint64_t seed{ 0x5A0D1AC1A54ull };
+			for (auto& character : characters) {
+				for (auto& field : character) {
+					for (uint64_t& key : field) {
+						key = SplitMix(seed);
+					}
+				}
+			}
+			for (auto& character : floats) {
+				for (uint64_t& key : character) {
+					key = SplitMix(seed);
+				}
+			}
+			for (auto& position : turnOrder) {
+				for (uint64_t& key : position) {
+					key = SplitMix(seed);
+				}
+			}
+			for (auto& field : battle) {
+				for (uint64_t& key : field) {
+					key = SplitMix(seed);
+				}
+			}
+			aiMultiplier = SplitMix(seed);
+		}
+	};
+
+	const ZobristKeys zobrist{};
+
+	inline uint64_t FieldKey(uint64_t const (&keys)[VALUES], int value) {
+		return keys[static_cast<unsigned>(value) % VALUES];
+	}
+
+	inline uint64_t FloatBits(float value) {
+		uint32_t bits{};
+		std::memcpy(&bits, &value, sizeof(bits));
+		return bits;
+	}
+
+	//Entry layout in the 64 bit data word
+	const int EVAL_BITS = 28;
+	const int DEPTH_SHIFT = 28;
+	const int BOUND_SHIFT = 34;
+	const int SKILL_SHIFT = 36;
+	const int TARGET_SHIFT = 39;
+	const int NODES_SHIFT = 43;
+	const int AGE_SHIFT = 48;
+}
+
+/*!
+* \brief Zobrist hash
+*
+* XOR of a random key per character field value and per turn order position, so
+* states differing in any stat, stack, chi or turn order get different hashes.
+* Fields that only affect presentation (damage taken, crit) are left out.
+*
+*/
+uint64_t HashState(BattleSimState const& state) {
+	uint64_t hash{};
+	for (int i = 0; i < state.characterCount; ++i) {
+		SimCharacter const& c{ state.characters[i] };
+		auto const& keys{ zobrist.characters[i] };
+		hash ^= FieldKey(keys[ATTACK_STACK], c.attackStack);
+		hash ^= FieldKey(keys[DEFENSE_STACK], c.defenseStack);
+		hash ^= FieldKey(keys[REFLECT_STACK], c.reflectStack);
+		hash ^= FieldKey(keys[SHIELD_STACK], c.shieldStack);
+		hash ^= FieldKey(keys[SHIELD_ENTITY], c.shieldEntity + 1);
+		hash ^= FieldKey(keys[BLOOD_STACK], c.bloodStack);
+		hash ^= FieldKey(keys[TAUNT_STACK], c.tauntStack);
+		hash ^= FieldKey(keys[TAUNT_TARGET], c.tauntTarget + 1);
+		hash ^= FieldKey(keys[STUN_STACK], c.stunStack);
+		hash ^= FieldKey(keys[HUNTED_STACK], c.huntedStack);
+		hash ^= FieldKey(keys[IGNITE_STACK], c.igniteStack);
+		hash ^= FieldKey(keys[ATTACK_DEBUFF_STACK], c.attackDebuffStack);
+		hash ^= FieldKey(keys[DEFENSE_DEBUFF_STACK], c.defenseDebuffStack);
+		hash ^= FieldKey(keys[CYCLE], c.cycle);
+		hash ^= FieldKey(keys[ENTITY_STATE], c.entityState);
+		hash ^= FieldKey(keys[CHARGE], c.charge);
+		hash ^= FieldKey(keys[REMOVED], c.removed);
+		hash ^= Mix(zobrist.floats[i][HEALTH], FloatBits(c.health));
+		hash ^= Mix(zobrist.floats[i][ATTACK_BUFF], FloatBits(c.attackBuff));
+		hash ^= Mix(zobrist.floats[i][DEFENSE_BUFF], FloatBits(c.defenseBuff));
+		hash ^= Mix(zobrist.floats[i][ATTACK_DEBUFF], FloatBits(c.attackDebuff));
+		hash ^= Mix(zobrist.floats[i][DEFENSE_DEBUFF], FloatBits(c.defenseDebuff));
+	}
+	for (int i = 0; i < state.turnCount; ++i) {
+		hash ^= zobrist.turnOrder[i][state.turnOrder[i] + 1];
+	}
+	hash ^= FieldKey(zobrist.battle[TURN_COUNT], state.turnCount);
+	hash ^= FieldKey(zobrist.battle[ACTIVE_CHARACTER], state.activeCharacter + 1);
+	hash ^= FieldKey(zobrist.battle[SPEEDUP_CHARACTER], state.speedupCharacter + 1);
+	hash ^= FieldKey(zobrist.battle[BATTLE_STATE], state.battleState);
+	hash ^= FieldKey(zobrist.battle[SPEEDUP], state.speedup);
+	hash ^= FieldKey(zobrist.battle[SPEEDUP_ANIMATION_PLAYED], state.speedupAnimationPlayed);
+	hash ^= FieldKey(zobrist.battle[ROUND_IN_PROGRESS], state.roundInProgress);
+	hash ^= FieldKey(zobrist.battle[ROUND_CHARACTER_COUNT], state.roundCharacterCount);
+	hash ^= FieldKey(zobrist.battle[CHI], state.chi);
+	hash ^= Mix(zobrist.aiMultiplier, static_cast<uint32_t>(state.aiMultiplier));
+	return hash;
+}
+
+uint64_t TranspositionTable::Pack(Entry const& entry, uint8_t entryAge) {
+	uint64_t eval{ static_cast<uint64_t>(std::clamp(entry.eval, -MAX_EVAL, MAX_EVAL) + MAX_EVAL + 1) };
+	uint64_t depth{ static_cast<uint64_t>(std::clamp(entry.depth, 0, 63)) };
+	uint64_t nodesLog{};
+	while (nodesLog < 31 && (size_t{ 1 } << (nodesLog + 1)) <= entry.nodes) {
+		++nodesLog;
+	}
+	return eval
+		| depth << DEPTH_SHIFT
+		| static_cast<uint64_t>(entry.bound) << BOUND_SHIFT
+		| static_cast<uint64_t>(entry.move.skill + 1) << SKILL_SHIFT
+		| static_cast<uint64_t>(entry.move.target + 1) << TARGET_SHIFT
+		| nodesLog << NODES_SHIFT
+		| static_cast<uint64_t>(entryAge) << AGE_SHIFT;
+}
+
+TranspositionTable::Entry TranspositionTable::Unpack(uint64_t data) {
+	Entry entry;
+	entry.eval = static_cast<int>(data & ((uint64_t{ 1 } << EVAL_BITS) - 1)) - MAX_EVAL - 1;
+	entry.depth = static_cast<int>((data >> DEPTH_SHIFT) & 0x3F);
+	entry.bound = static_cast<Bound>((data >> BOUND_SHIFT) & 0x3);
+	entry.move.skill = static_cast<int8_t>(((data >> SKILL_SHIFT) & 0x7)) - 1;
+	entry.move.target = static_cast<int8_t>(((data >> TARGET_SHIFT) & 0xF)) - 1;
+	entry.nodes = size_t{ 1 } << ((data >> NODES_SHIFT) & 0x1F);
+	return entry;
+}
+
+uint8_t TranspositionTable::Age(uint64_t data) {
+	return static_cast<uint8_t>(data >> AGE_SHIFT);
+}
+
+int TranspositionTable::Depth(uint64_t data) {
+	return static_cast<int>((data >> DEPTH_SHIFT) & 0x3F);
+}
+
+void TranspositionTable::NewSearch(BattleSimState const& root) {
+	if (!slots) {
+		slots.reset(new Slot[BUCKET_COUNT * 2]());
+	}
+	++age;
+	uint64_t seed{ HashState(root) ^ age };
+	salt = SplitMix(seed);
+}
+
+uint64_t TranspositionTable::Key(BattleSimState const& state) const {
+	return HashState(state) ^ salt;
+}
+
+bool TranspositionTable::Probe(uint64_t key, Entry& entry) const {
+	if (!slots) {
+		return false;
+	}
+	Slot const* bucket{ &slots[(key & (BUCKET_COUNT - 1)) * 2] };
+	for (int i = 0; i < 2; ++i) {
+		uint64_t data{ bucket[i].data.load(std::memory_order_relaxed) };
+		uint64_t check{ bucket[i].check.load(std::memory_order_relaxed) };
+		if ((check ^ data) == key && data != 0) {
+			entry = Unpack(data);
+			return entry.bound != Bound::NONE;
+		}
+	}
+	return false;
+}
+
+void TranspositionTable::Store(uint64_t key, Entry const& entry) {
+	if (!slots) {
+		return;
+	}
+	Slot* bucket{ &slots[(key & (BUCKET_COUNT - 1)) * 2] };
+	Slot* victim{ nullptr };
+	uint64_t victimData{};
+	for (int i = 0; i < 2; ++i) {
+		uint64_t data{ bucket[i].data.load(std::memory_order_relaxed) };
+		uint64_t check{ bucket[i].check.load(std::memory_order_relaxed) };
+		//Same state, always refresh
+		if ((check ^ data) == key) {
+			victim = &bucket[i];
+			break;
+		}
+		//Prefer slots of older decisions, then the shallower slot
+		if (victim == nullptr
+			|| (Age(data) != age && Age(victimData) == age)
+			|| (Age(data) == Age(victimData) && Depth(data) < Depth(victimData))) {
+			victim = &bucket[i];
+			victimData = data;
+		}
+	}
+	uint64_t data{ Pack(entry, age) };
+	victim->data.store(data, std::memory_order_relaxed);
+	victim->check.store(key ^ data, std::memory_order_relaxed);
+}
+
+void TranspositionTable::Clear() {
+	if (!slots) {
+		return;
+	}
+	for (size_t i = 0; i < BUCKET_COUNT * 2; ++i) {
+		slots[i].data.store(0, std::memory_order_relaxed);
+		slots[i].check.store(0, std::memory_order_relaxed);
+	}
+}
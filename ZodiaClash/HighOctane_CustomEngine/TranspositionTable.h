@@ -0,0 +1,93 @@
+/******************************************************************************
+*
+*	\copyright
+*		All content(C) 2023/2024 DigiPen Institute of Technology Singapore.
+*		All rights reserved. Reproduction or disclosure of this file or its
+*		contents without the prior written consent of DigiPen Institute of
+*		Technology is prohibited.
+*
+* *****************************************************************************
+*
+*	@file		TranspositionTable.h
+*
+*	@author		agent
+*
+*	@email		agent\@local
+*
+*	@course		CSD 2401 - Software Engineering Project 3
+*				CSD 2451 - Software Engineering Project 4
+*
+*	@section	Section A
+*
+*	@date		19 October 2026
+*
+* *****************************************************************************
+*
+*	@brief		Transposition table for the AI search
+*
+*	Battle states reached through different move orders are looked up by
+*	their Zobrist hash so they are only searched once per decision. The
+*	table has a fixed size and is shared by the search workers without
+*	locks: each slot stores its key XORed with its data, so a slot torn by
+*	two workers writing at once fails the key check instead of returning
+*	another state's value.
+*
+******************************************************************************/
+
+#pragma once
+#include "BattleSim.h"
+#include <atomic>
+#include <cstdint>
+#include <memory>
+
+//Zobrist hash of everything in a state the combat rules and the evaluation read
+uint64_t HashState(BattleSimState const& state);
+
+class TranspositionTable {
+public:
+	static constexpr size_t BUCKET_COUNT = size_t{ 1 } << 17; //2 slots of 16 bytes per bucket, 4 MB
+	static constexpr int MAX_EVAL = (1 << 27) - 1; //evaluations are stored in 28 bits
+
+	enum class Bound : uint8_t {
+		NONE,
+		EXACT,
+		LOWER, //the search failed high, the value is at least eval
+		UPPER  //the search failed low, the value is at most eval
+	};
+
+	struct Entry {
+		int eval{};
+		int depth{};
+		Bound bound{};
+		SimAction move{};
+		size_t nodes{}; //approximate size of the subtree searched to get the entry
+	};
+
+	//Starts a decision. Entries of other decisions no longer match, as evaluations are relative to the root, and are replaced first.
+	void NewSearch(BattleSimState const& root);
+	//Key of a state in the current decision
+	uint64_t Key(BattleSimState const& state) const;
+	//Returns true and fills entry if the key is in the table
+	bool Probe(uint64_t key, Entry& entry) const;
+	//Stores an entry, replacing the slot of an older decision or the shallower one in the bucket
+	void Store(uint64_t key, Entry const& entry);
+	//Empties the table
+	void Clear();
+
+private:
+	struct Slot {
+		std::atomic<uint64_t> check; //key ^ data
+		std::atomic<uint64_t> data;
+	};
+
+	static uint64_t Pack(Entry const& entry, uint8_t age);
+	static Entry Unpack(uint64_t data);
+	static uint8_t Age(uint64_t data);
+	static int Depth(uint64_t data);
+
+	std::unique_ptr<Slot[]> slots{};
+	uint64_t salt{};
+	uint8_t age{};
+};
+
+extern TranspositionTable transpositionTable;
@@ -190,6 +190,40 @@ bool TextLabel::CheckStringUpdated(TextLabel& txtLblData) {
 	return false;
 }
 
+/*!
+* \brief text layout boolean checker
+*
+* Returns true if anything lineData and glyphQuads depend on (string, font, font size,
+* text wrap or wrapping width) has changed since they were last built.
+*
+*/
+bool TextLabel::CheckLayoutUpdated() {
+	bool updated{ CheckStringUpdated(*this) };
+	unsigned int fontGeneration{ (font != nullptr) ? font->generation : 0 };
+	if (font != layoutFont || fontGeneration != layoutFontGeneration || relFontSize != layoutFontSize
+		|| textWrap != layoutTextWrap || textWidth != layoutTextWidth) {
+		updated = true;
+	}
+	layoutFont = font;
+	layoutFontGeneration = fontGeneration;
+	layoutFontSize = relFontSize;
+	layoutTextWrap = textWrap;
+	layoutTextWidth = textWidth;
+	return updated;
+}
+
+/*!
+* \brief text layout invalidation
+*
+* Forces lineData and glyphQuads to be rebuilt on the next update, for labels
+* copied without them.
+*
+*/
+void TextLabel::InvalidateLayout() {
+	layoutFont = nullptr;
+	layoutFontSize = -1.f;
+}
+
 /*!
 * \brief calculate offset
 *
@@ -220,7 +254,7 @@ void TextLabel::CalculateOffset() {
 				tmpWord += " ";
 			}
 			for (c = tmpWord.begin(); c != tmpWord.end(); c++) {
-				Character ch{ (*font).characters[*c] };
+				const Character& ch{ (*font).GetCharacter(*c) };
 				float w = ch.size.x * relFontSize;
 				float h = ch.size.y * relFontSize;
 
@@ -266,6 +300,46 @@ void TextLabel::CalculateOffset() {
 		break;
 	}
 	textHeight += verticalPadding;
+
+	BuildGlyphQuads();
+}
+
+/*!
+* \brief glyph quad builder
+*
+* Internal function. Called at the end of CalculateOffset(). Converts each line's glyphs
+* into quads relative to the start of the line, so drawing a label only needs to offset
+* them by the line's relTransform instead of looking up glyph metrics every frame.
+*
+*/
+void TextLabel::BuildGlyphQuads() {
+	glyphQuads.clear();
+	for (TextLine& line : lineData) {
+		line.firstQuad = glyphQuads.size();
+		float xPos = 0.f;
+		for (char c : line.lineString) {
+			const Character& ch{ (*font).GetCharacter(c) };
+			if (ch.textureID == nullptr) {
+				continue;
+			}
+			xPos += ch.bearing.x * relFontSize;
+			float yPos = -(ch.size.y - ch.bearing.y) * relFontSize;
+
+			GlyphQuad quad;
+			quad.botleft = { xPos, yPos };
+			quad.topright = { xPos + ch.size.x * relFontSize, yPos + ch.size.y * relFontSize };
+			quad.texcoords.bl = ch.textureID->GetTexCoords((int)ch.texPos, 0);
+			quad.texcoords.br = ch.textureID->GetTexCoords((int)ch.texPos, 1);
+			quad.texcoords.tl = ch.textureID->GetTexCoords((int)ch.texPos, 2);
+			quad.texcoords.tr = ch.textureID->GetTexCoords((int)ch.texPos, 3);
+			quad.texID = (float)ch.textureID->GetID() - 1;
+			quad.shelf = ch.shelf;
+			glyphQuads.push_back(quad);
+
+			xPos += (ch.advance >> 6) * relFontSize; // bitshift by 6 to get value in pixels
+		}
+		line.quadCount = glyphQuads.size() - line.firstQuad;
+	}
 }
 
 /*!
@@ -279,7 +353,10 @@ void TextLabel::CalculateOffset() {
 */
 void TextLabel::UpdateOffset(Transform const& transformData, Size& sizeData, Padding const& paddingData) {	
 
-	CalculateOffset();
+	// only re-layout the string when something affecting it has changed
+	if (CheckLayoutUpdated()) {
+		CalculateOffset();
+	}
 
 	switch (textWrap) {
 	case(UI_TEXT_WRAP::AUTO_WIDTH):
@@ -106,6 +106,17 @@ struct TextLine {
 	std::string lineString{};
 	float lineWidth{};
 	Vec2 relTransform{};
+	size_t firstQuad{}; //index of the line's first quad in TextLabel::glyphQuads
+	size_t quadCount{}; //number of quads belonging to the line
+};
+
+//struct for a cached glyph quad, positioned relative to the start of its line
+struct GlyphQuad {
+	glm::vec2 botleft{};
+	glm::vec2 topright{};
+	Texcoords texcoords{};
+	float texID{};
+	uint16_t shelf{}; //glyph atlas shelf, touched when drawn to keep it resident
 };
 
 class UIComponent {
@@ -127,6 +138,7 @@ public:
 	float glyphHeight{};
 	float lineHeight{};
 	std::vector<TextLine> lineData{};
+	std::vector<GlyphQuad> glyphQuads{}; //rebuilt only when CheckLayoutUpdated() reports a change
 	//int numLines{};
 	UI_TEXT_WRAP textWrap{};
 	UI_HORIZONTAL_ALIGNMENT hAlignment{};
@@ -160,6 +172,8 @@ public:
 	******* OTHER UTILS *******
 	**************************/
 	bool CheckStringUpdated(TextLabel& txtLblData);
+	bool CheckLayoutUpdated();
+	void InvalidateLayout();
 	void CalculateOffset();
 	void UpdateOffset(Transform const& transformData, Size& sizeData, Padding const& paddingData = { 0.f,0.f,0.f,0.f });
 
@@ -167,6 +181,16 @@ public:
 	******* SYSTEM CALLS ******
 	**************************/
 	void Update(Model& modelData, Name& nameData);
+
+private:
+	void BuildGlyphQuads();
+
+	// values lineData and glyphQuads were last built with
+	Font* layoutFont{};
+	unsigned int layoutFontGeneration{};
+	float layoutFontSize{ -1.f };
+	float layoutTextWidth{};
+	UI_TEXT_WRAP layoutTextWrap{};
 };
 
 class Button : public UIComponent {
@@ -46,6 +46,7 @@ void UndoRedo::RecordCurrent(Entity entity, ACTION action) {
     currentState.entity = entity;
     currentState.action = action;
     undoFlag = false;
+    ECS::ecs().MarkChanged(entity);
     if (!undoStack.empty()) {
         if (ECS::ecs().GetComponent<Transform>(currentState.entity) == undoRedo.CheckFrontTransform()) {
             undoRedo.StackPopFront(); //Prevents case when you double click the same entity
@@ -82,6 +83,7 @@ void UndoRedo::RecordComponent(Entity entity, ACTION action, std::string compone
     currentState.entity = entity;
     currentState.action = action;
     currentState.component = component;
+    ECS::ecs().MarkChanged(entity);
 
     undoStack.push_front(currentState);
 }
@@ -90,6 +92,7 @@ void UndoRedo::Undo() {
         undoFlag = true;
         EntityChanges currentState = undoStack.front();
         undoStack.pop_front();
+        ECS::ecs().MarkChanged(currentState.entity);
 
         // Store current state before pushing onto redo stack
         switch (currentState.action) {
@@ -157,6 +160,7 @@ void UndoRedo::Redo() {
     if (!redoStack.empty()) {
         EntityChanges currentState = redoStack.front();
         redoStack.pop_front();
+        ECS::ecs().MarkChanged(currentState.entity);
 
         undoStack.push_front(currentState);
 
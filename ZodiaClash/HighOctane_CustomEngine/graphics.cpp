@@ -45,6 +45,7 @@
 #include <algorithm>
 #include <Windows.h>
 #include "AssetManager.h"
+#include "GlyphAtlas.h"
 #include "Serialization.h"
 
 GraphicsManager graphics;
@@ -449,7 +450,9 @@ GLFWwindow* GraphicsManager::GetWindow() {
   Returns vary based on the method, including boolean status, string names, window dimensions, and GLFW window pointers.
  *************************************************************************/
 void GraphicsManager::DrawLabel(TextLabel& txtLblData, glm::vec4 color) {    
-    static Renderer* fontRenderer{ &renderer["font"] };
+    static Renderer* bitmapFontRenderer{ &renderer["font"] };
+    static Renderer* sdfFontRenderer{ &renderer["fontsdf"] };
+    Renderer* fontRenderer{ glyphAtlas.sdf ? sdfFontRenderer : bitmapFontRenderer };
 
     if (previousRenderer != fontRenderer) {
         if (previousRenderer != nullptr) {
@@ -458,39 +461,26 @@ void GraphicsManager::DrawLabel(TextLabel& txtLblData, glm::vec4 color) {
         previousRenderer = fontRenderer;
     }
 
-    // enforce relFontSize to be in range [0.f, 1.f]
-    float fontSize = txtLblData.relFontSize;
-    Font& fontData{ (txtLblData.font != nullptr) ? *txtLblData.font : *fonts.GetDefaultFont() };
-
-    std::string::const_iterator c;
-
-    for (TextLine line : txtLblData.lineData) {
-        float initPosX = line.relTransform.x;
-        float initPosY = line.relTransform.y;
-        float xPos = initPosX;
-        float yPos;
-        for (c = line.lineString.begin(); c != line.lineString.end(); c++) {
-            Character ch{ fontData.characters[*c] };
-            if (ch.textureID == nullptr) {
-				continue;
-			}
-            xPos = (xPos + ch.bearing.x * fontSize);
-            yPos = (initPosY - (ch.size.y - ch.bearing.y) * fontSize);
-                
-            float w = ch.size.x * fontSize;
-            float h = ch.size.y * fontSize;
-
-            glm::vec2 botleft{ xPos / GRAPHICS::w, yPos / GRAPHICS::h };
-            glm::vec2 botright{ (xPos + w) / GRAPHICS::w, yPos / GRAPHICS::h };
-            glm::vec2 topright{ (xPos + w) / GRAPHICS::w, (yPos + h) / GRAPHICS::h };
-            glm::vec2 topleft{ (xPos) / GRAPHICS::w, (yPos + h) / GRAPHICS::h };
-            fontRenderer->AddVertex(Vertex{ botleft, color, ch.textureID->GetTexCoords((int)ch.texPos,0), (float)ch.textureID->GetID() - 1 });
-            fontRenderer->AddVertex(Vertex{ botright,color, ch.textureID->GetTexCoords((int)ch.texPos,1), (float)ch.textureID->GetID() - 1 });
-            fontRenderer->AddVertex(Vertex{ topleft, color, ch.textureID->GetTexCoords((int)ch.texPos,2), (float)ch.textureID->GetID() - 1 });
-            fontRenderer->AddVertex(Vertex{ topright,color, ch.textureID->GetTexCoords((int)ch.texPos,3), (float)ch.textureID->GetID() - 1 });
-            fontRenderer->AddVertex(Vertex{ botright,color, ch.textureID->GetTexCoords((int)ch.texPos,1), (float)ch.textureID->GetID() - 1 });
-            fontRenderer->AddVertex(Vertex{ topleft, color, ch.textureID->GetTexCoords((int)ch.texPos,2), (float)ch.textureID->GetID() - 1 });
-            xPos += (ch.advance >> 6) * fontSize; // bitshift by 6 to get value in pixels (2^6 = 64 (divide amount of 1/64th pixels by 64to get amount of pixels))
+    // glyph quads are cached by the label relative to each line, only offset them here
+    for (TextLine const& line : txtLblData.lineData) {
+        for (size_t i = line.firstQuad; i < line.firstQuad + line.quadCount && i < txtLblData.glyphQuads.size(); ++i) {
+            GlyphQuad const& quad{ txtLblData.glyphQuads[i] };
+            glyphAtlas.Touch(quad.shelf);
+            float left = (line.relTransform.x + quad.botleft.x) / GRAPHICS::w;
+            float right = (line.relTransform.x + quad.topright.x) / GRAPHICS::w;
+            float bottom = (line.relTransform.y + quad.botleft.y) / GRAPHICS::h;
+            float top = (line.relTransform.y + quad.topright.y) / GRAPHICS::h;
+
+            glm::vec2 botleft{ left, bottom };
+            glm::vec2 botright{ right, bottom };
+            glm::vec2 topright{ right, top };
+            glm::vec2 topleft{ left, top };
+            fontRenderer->AddVertex(Vertex{ botleft, color, quad.texcoords.bl, quad.texID });
+            fontRenderer->AddVertex(Vertex{ botright,color, quad.texcoords.br, quad.texID });
+            fontRenderer->AddVertex(Vertex{ topleft, color, quad.texcoords.tl, quad.texID });
+            fontRenderer->AddVertex(Vertex{ topright,color, quad.texcoords.tr, quad.texID });
+            fontRenderer->AddVertex(Vertex{ botright,color, quad.texcoords.br, quad.texID });
+            fontRenderer->AddVertex(Vertex{ topleft, color, quad.texcoords.tl, quad.texID });
         }
     }
 }
\ No newline at end of file
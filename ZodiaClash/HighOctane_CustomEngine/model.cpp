@@ -65,6 +65,7 @@ Model& Model::operator= (const Model& rhs) {
 	backgroundScrollSpeed = rhs.backgroundScrollSpeed;
 	color = rhs.color;
 	mirror = rhs.mirror;
+	dirty = true;
 	return *this;
 }
 
@@ -126,10 +127,7 @@ void Model::Update(Transform const& entity, Size const& size) {
 	minimum.y *= GRAPHICS::h;
 	maximum.x *= GRAPHICS::w;
 	maximum.y *= GRAPHICS::h;
-	if (type != UI) {
-		minimum += camera.GetPos();
-		maximum += camera.GetPos();
-	}
+	dirty = false;
 }
 
 void Model::Draw(Tex* const entity) {
@@ -245,14 +243,19 @@ void Model::DrawOutlineRed() {
 }
 
 bool Model::CheckTransformUpdated(Transform& transform, Size& size) {
-	if (transform.position == previous.position && transform.rotation == previous.rotation && transform.scale == previous.scale && size.height == previous_size.height && size.width == previous_size.width) {
+	if (!dirty && type == previous_type && transform.position == previous.position && transform.rotation == previous.rotation && transform.scale == previous.scale && size.height == previous_size.height && size.width == previous_size.width) {
 		return false;
 	}
 	previous = transform;
 	previous_size = size;
+	previous_type = type;
 	return true;
 }
 
+void Model::MarkDirty() {
+	dirty = true;
+}
+
 void Model::SetColor(float r, float g, float b) {
 	color.r = r;
 	color.g = g;
@@ -277,11 +280,26 @@ float Model::GetAlpha() {
 	return color.a;
 }
 
+// camera offset is applied here rather than in Update() so the bounds stay valid while Update() is skipped
 vmath::Vector2 Model::GetMin() const {
-	return minimum;
+	if (type == UI) {
+		return minimum;
+	}
+	return vmath::Vector2{ minimum.x + camera.GetPos().x, minimum.y + camera.GetPos().y };
 }
 
 vmath::Vector2 Model::GetMax() const {
+	if (type == UI) {
+		return maximum;
+	}
+	return vmath::Vector2{ maximum.x + camera.GetPos().x, maximum.y + camera.GetPos().y };
+}
+
+vmath::Vector2 Model::GetWorldMin() const {
+	return minimum;
+}
+
+vmath::Vector2 Model::GetWorldMax() const {
 	return maximum;
 }
 
@@ -68,9 +68,12 @@ public:
 	float GetAlpha(); //Get alpha of model (alpha bounds are between 0 and 1)
 
 	bool CheckTransformUpdated(Transform& transform, Size& size); //Check if transform was updated since last frame, returns true if transform was updated
+	void MarkDirty(); //Force the next CheckTransformUpdated to report a change
 
 	vmath::Vector2 GetMin() const; //returns minimum point in screen coordinates
 	vmath::Vector2 GetMax() const; //returns maximum point in screen coordinates
+	vmath::Vector2 GetWorldMin() const; //returns minimum point of the AABB in world coordinates, independent of the camera
+	vmath::Vector2 GetWorldMax() const; //returns maximum point of the AABB in world coordinates, independent of the camera
 	vmath::Vector2 GetRotPoint() const; //returns rotation point in screen coordinates
 	vmath::Vector2 GetTopLeft() const; //returns top left point in screen coordinates
 	vmath::Vector2 GetTopRight() const; //returns top right point in screen coordinates
@@ -111,6 +114,8 @@ private:
 
 	Transform previous; //used for check if previous is same as current
 	Size previous_size; //used for check if previous is same as current
+	ModelType previous_type{}; //used for check if previous is same as current
+	bool dirty{ true }; //set until Update() has computed the vertices once
 };
 
 extern Renderer* previousRenderer; //FOR LAYERING
@@ -35,11 +35,13 @@
 #include "Texture.h"
 #include "debugdiagnostic.h"
 #include "GraphicConstants.h"
-#include "Font.h"
 #include "AssetManager.h"
+#include "TextureCache.h"
+#include "AssetPack.h"
 
 #include <iostream>
 #include <sstream>
+#include <unordered_set>
 
 #define STB_IMAGE_IMPLEMENTATION
 #include <stb-master/stb_image.h>
@@ -65,9 +67,21 @@ void Texture::Init(char const* filepath, char const* filename) {
 	int filechannels;
 
 	name = filename;
+	sourcePath = filepath;
+
+	if (texturecache.Load(*this, sourcePath)) {
+		return;
+	}
 
 	unsigned char* data;
-	data = stbi_load(filepath, &width, &height, &filechannels, channelnum);
+	const unsigned char* packed{};
+	size_t packedSize{};
+	if (assetpack.Read(sourcePath, packed, packedSize)) {
+		data = stbi_load_from_memory(packed, static_cast<int>(packedSize), &width, &height, &filechannels, channelnum);
+	}
+	else {
+		data = stbi_load(filepath, &width, &height, &filechannels, channelnum);
+	}
 	if (data == nullptr) {
 		active = false;
 		ASSERT("Unable to find texture %s\n", filename);
@@ -80,100 +94,10 @@ void Texture::Init(char const* filepath, char const* filename) {
 	glTextureStorage2D(id, 1, GL_RGBA8, width, height);
 	glTextureSubImage2D(id, 0, 0, 0, width, height,
 		GL_RGBA, GL_UNSIGNED_BYTE, data);
+	texturecache.Cook(sourcePath, data, width, height);
 	stbi_image_free(data);
 }
 
-void Texture::Init(Font& font, const char* texname) {
-	std::vector<Texcoords> newtexcoords;
-	glPixelStorei(GL_UNPACK_ALIGNMENT, 1); // disable byte-alignment restriction
-	//for all printable characters [32, 127], 169 (copyright) and 174 (registered copyright)
-	unsigned int fontWidth = 0;
-	unsigned int fontHeight = 0;
-
-	//first pass, get font sprite sheet size
-	for (unsigned char c = 32; c < 175; c++)
-	{
-		//skip over characters not in intended range
-		if (((c > 127) && (c < 169)) || ((c > 169) && (c < 174))) {
-			continue;
-		}
-
-		// load character glyph
-		if (FT_Load_Char(font.fontFace, c, FT_LOAD_RENDER))
-		{
-			DEBUG_PRINT("ERROR::FONT: Failed to load Glyph");
-			continue;
-		}
-		// generate texture
-		if (fontWidth < font.fontFace->glyph->bitmap.width) {
-			fontWidth = font.fontFace->glyph->bitmap.width;
-		}
-		fontHeight += font.fontFace->glyph->bitmap.rows;
-	}
-
-	unsigned char* fontData = new unsigned char[fontWidth * fontHeight] {};
-
-	// generate texture
-	unsigned int texture;
-	glCreateTextures(GL_TEXTURE_2D, 1, &texture);
-	glTextureStorage2D(texture, 1, GL_R8, fontWidth,
-		fontHeight);
-	unsigned int currHeight = 0;
-
-	for (unsigned char c = 32; c < 175; c++)
-	{
-		//skip over characters not in intended range
-		if (((c > 127) && (c < 169)) || ((c > 169) && (c < 174))) {
-			continue;
-		}
-
-		// load character glyph
-		if (FT_Load_Char(font.fontFace, c, FT_LOAD_RENDER))
-		{
-			DEBUG_PRINT("ERROR::FONT: Failed to load Glyph");
-			continue;
-		}
-		
-		//concatenate glyph data into spritesheet data
-		for (unsigned int h = 0; h < font.fontFace->glyph->bitmap.rows; ++h) {
-			for (unsigned int w = 0; w < font.fontFace->glyph->bitmap.width; ++w) {
-				fontData[(currHeight + h) * fontWidth + w] = font.fontFace->glyph->bitmap.buffer[h * font.fontFace->glyph->bitmap.width + w];
-			}
-		}
-
-		float t = static_cast<float>(currHeight) / static_cast<float>(fontHeight);
-		float b = static_cast<float>(currHeight + font.fontFace->glyph->bitmap.rows) / static_cast<float>(fontHeight);
-		float r = static_cast<float>(font.fontFace->glyph->bitmap.width) / static_cast<float>(fontWidth);
-		Texcoords spriteCoords;
-		spriteCoords.bl = glm::vec2{ 0.f, b };
-		spriteCoords.br = glm::vec2{ r, b };
-		spriteCoords.tl = glm::vec2{ 0.f, t };
-		spriteCoords.tr = glm::vec2{ r, t };
-		newtexcoords.emplace_back(spriteCoords);
-
-		// store texture in Character map
-		Character character = {
-			nullptr,
-			newtexcoords.size() - 1,
-			glm::ivec2(font.fontFace->glyph->bitmap.width, font.fontFace->glyph->bitmap.rows),
-			glm::ivec2(font.fontFace->glyph->bitmap_left, font.fontFace->glyph->bitmap_top),
-			static_cast<size_t>(font.fontFace->glyph->advance.x)
-		};
-		font.characters.insert(std::pair<char, Character>(c, character));
-		currHeight += font.fontFace->glyph->bitmap.rows;
-	}
-	glTextureSubImage2D(texture, 0, 0, 0, fontWidth,
-		fontHeight,
-		GL_RED,
-		GL_UNSIGNED_BYTE,
-		fontData);
-	delete[] fontData;
-	id = texture;
-	active = true;
-	name = texname;
-	texcoords.swap(newtexcoords);
-}
-
 void Texture::CreateSpriteSheet(int row, int column, int spritenum) {
 	int count = 0;
 	std::vector<Texcoords> newtexcoords;
@@ -183,6 +107,11 @@ void Texture::CreateSpriteSheet(int row, int column, int spritenum) {
 	float rowDist = 1.f / static_cast<float>(row);
 	width = (int)((float) width * colDist);
 	height = (int)((float)height * rowDist);
+	//layout already stored in the cooked container
+	if (row == cachedRowCount && column == cachedColCount && spritenum == (int)cachedTexcoords.size()) {
+		texcoords = cachedTexcoords;
+		return;
+	}
 	for (int i = 0; i < row; ++i) {
 		for (int t = 0; t < column; ++t) {
 			Texcoords spriteCoords;
@@ -194,11 +123,13 @@ void Texture::CreateSpriteSheet(int row, int column, int spritenum) {
 			++count;
 			if (count >= spritenum) {
 				texcoords.swap(newtexcoords);
+				texturecache.StoreLayout(sourcePath, row, column, texcoords);
 				return;
 			}
 		}
 	}
 	texcoords.swap(newtexcoords);
+	texturecache.StoreLayout(sourcePath, row, column, texcoords);
 	return;
 }
 
@@ -244,6 +175,16 @@ int Texture::GetSheetSize() {
 	return (int)texcoords.size();
 }
 
+const std::string& Texture::GetSourcePath() {
+	return sourcePath;
+}
+
+void Texture::Replace(GLuint newId, int imageWidth, int imageHeight) {
+	id = newId;
+	width = colCount > 0 ? (int)((float)imageWidth / static_cast<float>(colCount)) : imageWidth;
+	height = rowCount > 0 ? (int)((float)imageHeight / static_cast<float>(rowCount)) : imageHeight;
+}
+
 glm::vec2 Texture::GetTexCoords(int index, int pos) {
 	switch (pos) {
 	case 0:
@@ -325,24 +266,60 @@ void TextureManager::Clear() {
 	data.clear();
 }
 
-Texture* TextureManager::Add(Font& font) {
-	std::string texname = { "font0" };
-	int count = 0;
-	while (data.count(texname)) {
-		++count;
-		std::stringstream namestream{};
-		namestream << "font" << count;
-		texname = namestream.str();
+void TextureManager::Remove(const char* texname) {
+	auto it{ data.find(texname) };
+	if (it == data.end()) {
+		return;
 	}
-	Texture temp;
-	temp.Init(font, texname.c_str());
-	data[texname] = temp;
+	bool shared{ false };
+	if (it->second.IsActive()) {
+		for (auto& t : data) {
+			if (&t.second != &it->second && t.second.IsActive() && t.second.GetID() == it->second.GetID()) {
+				shared = true;
+				break;
+			}
+		}
+	}
+	if (!shared) {
+		it->second.FreeTexture();
+	}
+	data.erase(it);
+}
 
-	for (auto& c : font.characters) {
-		c.second.textureID = &data[texname];
+bool TextureManager::HasSource(const std::string& sourcePath) {
+	for (auto& t : data) {
+		if (t.second.IsActive() && t.second.GetSourcePath() == sourcePath) {
+			return true;
+		}
 	}
+	return false;
+}
 
-	return &data[texname];
+size_t TextureManager::Reload(const std::string& sourcePath, const unsigned char* pixels, int imageWidth, int imageHeight) {
+	// Sprite sheet entries share the OpenGL texture of their image, so one texture is made for all of them
+	GLuint newId{};
+	std::unordered_set<GLuint> oldIds{};
+	size_t replaced{};
+	for (auto& t : data) {
+		if (!t.second.IsActive() || t.second.GetSourcePath() != sourcePath) {
+			continue;
+		}
+		// The cooked copy is written again without a sprite sheet layout, which is stored again on the next load
+		if (newId == 0) {
+			glCreateTextures(GL_TEXTURE_2D, 1, &newId);
+			glTextureStorage2D(newId, 1, GL_RGBA8, imageWidth, imageHeight);
+			glTextureSubImage2D(newId, 0, 0, 0, imageWidth, imageHeight,
+				GL_RGBA, GL_UNSIGNED_BYTE, pixels);
+			texturecache.Cook(sourcePath, pixels, imageWidth, imageHeight);
+		}
+		oldIds.insert(t.second.GetID());
+		t.second.Replace(newId, imageWidth, imageHeight);
+		++replaced;
+	}
+	for (GLuint oldId : oldIds) {
+		glDeleteTextures(1, &oldId);
+	}
+	return replaced;
 }
 
 std::vector<std::string> TextureManager::GetTextureNames() {
@@ -39,8 +39,6 @@
 #include <unordered_map>
 #include <vector>
 
-class Font; //forward declaration
-
 const int channelnum = 4;
 
 struct Texcoords {
@@ -55,7 +53,6 @@ public:
 	Texture();
 	~Texture();
 	void Init(char const* filepath, char const* filename); //Initialise a texture using the texture file path as input
-	void Init(Font& font, const char* texname);
 	void FreeTexture();		//Free the texture from OpenGL memory
 
 	GLuint GetID();			//Get texture ID of texture
@@ -78,7 +75,11 @@ public:
 	*/
 	glm::vec2 GetTexCoords(int index, int pos); //get texture coordinates. Index is the index in the sprite sheet array while position 
 	int GetSheetSize(); //returns amount of sprites in sprite sheet
+	const std::string& GetSourcePath(); //returns the file path the texture was loaded from
+	void Replace(GLuint newId, int imageWidth, int imageHeight); //uses another OpenGL texture of the whole image, keeping the sprite sheet layout
 private:
+	friend class TextureCache;
+	friend class GlyphAtlas;
 	std::string name{}; //name of texture as stored in texture manager
 	GLuint id{}; //texture id as stored in opengl
 	int width{}; //width of individual sprite
@@ -87,6 +88,10 @@ private:
 	int colCount{}; //number of columns of texture
 	bool active{false}; //true if texture has been saved to OpenGL
 	std::vector<Texcoords> texcoords; //array containing sprite coordinates for sprite sheet
+	std::string sourcePath{}; //file path the texture was loaded from, used to locate its cooked container
+	int cachedRowCount{}; //sprite sheet rows stored in the cooked container
+	int cachedColCount{}; //sprite sheet columns stored in the cooked container
+	std::vector<Texcoords> cachedTexcoords; //sprite sheet coordinates stored in the cooked container
 };
 
 class TextureManager {
@@ -94,10 +99,12 @@ public:
 	~TextureManager(); //Calls Clear, in case of deletion without calling Clear
 	Texture* Get(char const* texname);
 	Texture* Add(const char* texpath, char const* texname); //Create a texture using the texture file path as input. If texture already exists, return the texture instead.
-	Texture* Add(Font& font);
 	Texture* AddSpriteSheet(const char* texname, int row, int col, int spritenum, const char* texpath = nullptr); //Create a sprite sheet using the number of rows, columns and the total number of sprites in the sprite sheet
 	std::vector<std::string> GetTextureNames();
 	void Clear(); //Removes all textures from OpenGL memory and empties the map
+	void Remove(const char* texname); //Removes a texture from the map, freeing it from OpenGL memory unless a sprite sheet entry shares it
 	void SetWindowIcon(GLFWwindow*, std::string iconpath);
+	bool HasSource(const std::string& sourcePath); //Returns true if a loaded texture was loaded from sourcePath
+	size_t Reload(const std::string& sourcePath, const unsigned char* pixels, int imageWidth, int imageHeight); //Uploads the decoded image again for every texture loaded from sourcePath, returns how many were replaced
 	std::unordered_map<std::string, Texture> data; //storage of textures
 };
@@ -62,6 +62,8 @@
 #include "ImGuiSceneSettings.h"
 #include "ImGuiDialogue.h"
 #include "ImGuiTilemap.h"
+#include "SceneSaver.h"
+#include "AssetWatcher.h"
 
 constexpr float fontSizeS = 10.f;
 constexpr float fontSizeM = 20.f;
@@ -94,6 +96,7 @@ GUIManager::~GUIManager()
         ImGui::DestroyContext();
     }
     //ImPlot::DestroyContext();
+    assetwatcher.Stop();
     UnloadIcons();
 }
 
@@ -144,6 +147,8 @@ void GUIManager::Init()
 
     assetmanager.LoadAllPrefabs();
 
+    // Assets changed outside the editor are reloaded while editing
+    assetwatcher.Start(assetmanager.GetDefaultPath());
 
     ImGui::StyleColorsDark();
  
@@ -506,6 +511,13 @@ void GUIManager::Update()
     UpdatePrefabHierachy();
     UpdateSceneSettingsWindow();
 
+    // Edits made through the panels are not recorded by the ECS, so the selected entity is saved again while a field is being edited
+    if (ImGui::IsAnyItemActive() && ECS::ecs().EntityExists(currentSelectedEntity)) {
+        ECS::ecs().MarkChanged(currentSelectedEntity);
+    }
+    sceneSaver.Update(g_dt);
+    assetwatcher.Update();
+
 #if _DEBUG
     // Update the performance console
     UpdatePerformance();
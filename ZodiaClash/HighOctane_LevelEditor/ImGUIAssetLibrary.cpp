@@ -42,6 +42,7 @@
 #include "Serialization.h"
 #include "EntityFactory.h"
 #include "AssetManager.h"
+#include "AssetWatcher.h"
 #include "WindowsInterlink.h"
 #include "Global.h"
 #include "GraphicConstants.h"
@@ -430,7 +431,7 @@ void ImportAudio(bool& showDialog) {
 			--importFileCount;
 
 			showDialog = false;
-			assetmanager.audio.UpdateAudioDirectory();
+			assetwatcher.Rescan("Sound/");
 			ImGui::CloseCurrentPopup();
 		}
 
@@ -36,6 +36,7 @@
 #include "ECS.h"
 #include "WindowsInterlink.h"
 #include "AssetManager.h"
+#include "AssetWatcher.h"
 #include "Serialization.h"
 #include <sstream>
 #include "UndoRedo.h"
@@ -76,7 +77,7 @@ void SaveAsPrefab(std::string prefabPath, Entity entity) {
 			ECS::ecs().GetComponent<Clone>(entity).prefab = prefabName;
 		}
 	}
-	assetmanager.UpdatePrefabPaths();
+	assetwatcher.Rescan("Prefabs/");
 }
 
 void ComponentBrowser(Entity currentEntity) {
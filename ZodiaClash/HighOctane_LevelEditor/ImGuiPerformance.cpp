@@ -32,6 +32,15 @@
 #include "ImGuiPerformance.h"
 #include "DebugProfile.h"
 #include "GUIManager.h"
+#include "SpatialIndex.h"
+#include "AIDecisionJob.h"
+#include "SceneCache.h"
+#include "JsonStream.h"
+#include "AssetManager.h"
+#include "SceneSaver.h"
+#include "AssetPack.h"
+#include "AssetWatcher.h"
+#include <filesystem>
 
 
 #if ENABLE_DEBUG_PROFILE
@@ -50,6 +59,16 @@ float avgFPS{ 0 };
 float timerFPS{ 0 };
 int tracker{ 0 };
 
+// Results of the benchmarks run from the window, kept to be shown every frame
+CullingBenchmarkResult cullingBenchmark{};
+std::vector<AISearchBenchmarkResult> aiSearchBenchmark{};
+AIScalingBenchmarkResult aiScalingBenchmark{};
+std::vector<EvaluationBenchmarkResult> evaluationBenchmark{};
+SceneLoadBenchmarkResult sceneLoadBenchmark{};
+JsonParseBenchmarkResult jsonParseBenchmark{};
+AssetReadBenchmarkResult assetReadBenchmark{};
+AudioLoadBenchmarkResult audioLoadBenchmark{};
+
 
 /*!
 * \brief Init the performance window
@@ -116,6 +135,190 @@ void UpdatePerformance() {
     ImGui::Text("Memory usage: %.3f MB", GetMemoryUsage());
     /************** PERFORMANCE USAGE ***************/
 
+    ImGui::SeparatorEx(ImGuiSeparatorFlags_Horizontal);
+
+    /************** CULLING ***************/
+    ImGui::Text("Indexed models: %zu", spatialGrid.stats.indexed);
+    ImGui::Text("Drawn models: %zu", spatialGrid.stats.drawn);
+    ImGui::Text("Culled models: %zu", spatialGrid.stats.culled);
+    ImGui::Text("Recomputed models: %zu", spatialGrid.stats.updated);
+    if (ImGui::Button("Run culling benchmark (50k sprites)")) {
+        cullingBenchmark = RunCullingBenchmark(50000);
+    }
+    if (cullingBenchmark.frames > 0) {
+        ImGui::Text("%zu sprites, %.1f visible per frame (linear scan found %.1f)", cullingBenchmark.sprites, cullingBenchmark.visible, cullingBenchmark.scanned);
+        ImGui::Text("Grid query %.4f ms/frame, linear scan %.4f ms/frame, moving %zu sprites %.4f ms/frame",
+            cullingBenchmark.queryMilliseconds, cullingBenchmark.scanMilliseconds, cullingBenchmark.sprites / 10, cullingBenchmark.updateMilliseconds);
+    }
+    /************** CULLING ***************/
+
+    ImGui::SeparatorEx(ImGuiSeparatorFlags_Horizontal);
+
+    /************** AI SEARCH ***************/
+    ImGui::Text("Last AI decision: depth %d, %zu nodes, %lld us, %d tasks%s", lastSearchResult.depth, lastSearchResult.nodes, lastSearchResult.microseconds, lastSearchResult.threads, lastSearchResult.timedOut ? " (time budget)" : "");
+    ImGui::Text("Transposition table: %zu/%zu hits, ~%zu nodes saved", lastSearchResult.ttHits, lastSearchResult.ttProbes, lastSearchResult.nodesSaved);
+    ImGui::Text("Search memory: %.1f KB peak, %zu arena allocations, %zu heap allocations", lastSearchResult.arenaBytes / 1024.0, lastSearchResult.arenaAllocations, lastSearchResult.heapAllocations);
+    if (ImGui::Button("Run AI search benchmark")) {
+        aiSearchBenchmark = RunAISearchBenchmark();
+    }
+    ImGui::SameLine();
+    if (ImGui::Button("Run AI thread scaling benchmark")) {
+        aiScalingBenchmark = RunAIScalingBenchmark();
+    }
+    ImGui::SameLine();
+    if (ImGui::Button("Run evaluation benchmark")) {
+        evaluationBenchmark = RunEvaluationBenchmark();
+    }
+    for (AISearchBenchmarkResult const& result : aiSearchBenchmark) {
+        ImGui::Text("%s: %zu decisions over %d battles, average depth %.2f, %d hit the time budget", result.battle.c_str(), result.decisions, result.battles, result.averageDepth, result.timeouts);
+        ImGui::Text("    %.0f nodes/sec, %.1f nodes per decision, latency %.1f us average, %lld us p95, %lld us max", result.nodesPerSecond, result.nodesPerDecision,
+            result.averageMicroseconds, result.p95Microseconds, result.maxMicroseconds);
+        ImGui::Text("    table %zu/%zu hits, ~%zu nodes saved, %.1f KB peak, %.1f arena and %.2f heap allocations per decision", result.ttHits, result.ttProbes, result.nodesSaved,
+            result.peakArenaBytes / 1024.0, result.arenaAllocationsPerDecision, result.heapAllocationsPerDecision);
+    }
+    if (!aiScalingBenchmark.rows.empty()) {
+        ImGui::Text("Thread scaling: %zu boss decisions at depth %d", aiScalingBenchmark.decisions, aiScalingBenchmark.depth);
+        for (AIScalingBenchmarkRow const& row : aiScalingBenchmark.rows) {
+            ImGui::Text("    %2d tasks: %9.2f ms, %.0f nodes/sec, speedup %.2fx, table hits %.1f%%%s", row.tasks, row.milliseconds, row.nodesPerSecond,
+                row.speedup, row.ttHitRate, row.sameMoves ? "" : ", DIFFERENT MOVES");
+        }
+    }
+    for (EvaluationBenchmarkResult const& result : evaluationBenchmark) {
+        ImGui::Text("%s evaluation: side totals %.2f ns, counting characters %.2f ns (%.1fx) over %zu states, %d mismatches%s", result.battle.c_str(),
+            result.sideTotalsNanoseconds, result.recountNanoseconds, result.sideTotalsNanoseconds > 0 ? result.recountNanoseconds / result.sideTotalsNanoseconds : 0.0,
+            result.states, result.mismatches, result.sumsMatch ? "" : ", sums differ");
+    }
+    ImGui::Checkbox("Async AI decisions", &aiDecisionJob.async);
+    AIFrameStats const& aiFrames{ aiDecisionJob.stats };
+    ImGui::Text("Enemy turn frames: %.2f ms avg, %.2f ms deviation, %.2f ms worst over %zu updates", aiFrames.AverageFrameMilliseconds(), aiFrames.FrameDeviationMilliseconds(), aiFrames.worstFrameMilliseconds, aiFrames.frames);
+    ImGui::Text("AI decisions: %zu (%zu forced by deadline), last %lld us over %d updates, worst update blocked %lld us", aiFrames.decisions, aiFrames.forced, aiFrames.lastLatencyMicroseconds, aiFrames.lastUpdates, aiFrames.worstBlockingMicroseconds);
+    if (ImGui::Button("Reset enemy turn frames")) {
+        aiDecisionJob.stats = AIFrameStats{};
+    }
+    /************** AI SEARCH ***************/
+
+    ImGui::SeparatorEx(ImGuiSeparatorFlags_Horizontal);
+
+    /************** SCENE CACHE ***************/
+    ImGui::Checkbox("Load cooked scenes", &scenecache.enabled);
+    ImGui::Text("Scene cache: %zu cooked loads, %zu json loads", scenecache.GetHits(), scenecache.GetMisses());
+    if (ImGui::Button("Cook all scenes and prefabs")) {
+        scenecache.CookAll();
+    }
+    ImGui::SameLine();
+    if (ImGui::Button("Run scene load benchmark")) {
+        sceneLoadBenchmark = RunSceneLoadBenchmark();
+    }
+    ImGui::SameLine();
+    if (ImGui::Button("Run json parse benchmark")) {
+        jsonParseBenchmark = RunJsonParseBenchmark();
+    }
+    if (!sceneLoadBenchmark.scenes.empty()) {
+        ImGui::Text("All scenes: json %.3f ms, cooked %.3f ms (average of %d loads)", sceneLoadBenchmark.jsonMilliseconds, sceneLoadBenchmark.cookedMilliseconds, sceneLoadBenchmark.repeats);
+        for (SceneLoadBenchmarkScene const& scene : sceneLoadBenchmark.scenes) {
+            ImGui::Text("    %-28s %4zu entities  json %8.3f ms (%6ju bytes)  cooked %8.3f ms (%6ju bytes)  %5.1fx%s", scene.name.c_str(), scene.entities,
+                scene.jsonMilliseconds, scene.jsonBytes, scene.cookedMilliseconds, scene.cookedBytes,
+                scene.cookedMilliseconds > 0.0 ? scene.jsonMilliseconds / scene.cookedMilliseconds : 0.0, scene.cooked ? "" : "  (not cooked, loaded from json)");
+        }
+    }
+    if (!jsonParseBenchmark.files.empty()) {
+        ImGui::Text("All files: document %.3f ms, stream %.3f ms (average of %d parses), %zu entries differ", jsonParseBenchmark.documentMilliseconds,
+            jsonParseBenchmark.streamMilliseconds, jsonParseBenchmark.repeats, jsonParseBenchmark.mismatches);
+        for (JsonParseBenchmarkFile const& file : jsonParseBenchmark.files) {
+            ImGui::Text("    %-28s %4zu entries  document %7.3f ms (%7zu bytes)  stream %7.3f ms (%6zu bytes per entry)  %4.1fx%s", file.name.c_str(), file.entries,
+                file.documentMilliseconds, file.documentBytes, file.streamMilliseconds, file.peakEntryBytes,
+                file.streamMilliseconds > 0.0 ? file.documentMilliseconds / file.streamMilliseconds : 0.0, file.mismatches ? "  (entries differ)" : "");
+        }
+    }
+    /************** SCENE CACHE ***************/
+
+    /************** ASSET PACK ***************/
+    ImGui::Checkbox("Read assets from pack", &assetpack.enabled);
+    if (assetpack.IsOpen()) {
+        ImGui::Text("%s: %zu files, %zu read from pack, %zu read from folder", AssetPack::FILE_NAME, assetpack.GetEntryCount(), assetpack.GetHits(), assetpack.GetMisses());
+    }
+    else {
+        ImGui::Text("No %s, run the game with --pack to build one", AssetPack::FILE_NAME);
+    }
+    if (ImGui::Button("Run asset read benchmark")) {
+        assetReadBenchmark = RunAssetReadBenchmark();
+    }
+    if (assetReadBenchmark.files > 0) {
+        ImGui::Text("%zu files, %.1f MB: pack %.2f ms, loose files %.2f ms (%.1fx, checksum %llu)", assetReadBenchmark.files, assetReadBenchmark.bytes / (1024.0 * 1024.0),
+            assetReadBenchmark.packMilliseconds, assetReadBenchmark.looseMilliseconds,
+            assetReadBenchmark.packMilliseconds > 0.0 ? assetReadBenchmark.looseMilliseconds / assetReadBenchmark.packMilliseconds : 0.0,
+            static_cast<unsigned long long>(assetReadBenchmark.checksum));
+    }
+    /************** ASSET PACK ***************/
+
+    /************** HOT RELOAD ***************/
+    ImGui::Checkbox("Hot reload changed assets", &assetwatcher.enabled);
+    ImGui::SameLine();
+    ImGui::SliderFloat("Settle time (s)", &assetwatcher.debounceSeconds, 0.05f, 2.f, "%.2f");
+    HotReloadStats const& reloads{ assetwatcher.GetStats() };
+    ImGui::Text("%s: %zu textures, %zu skills, %zu prefabs, %zu folder listings reloaded, %zu failed", assetwatcher.IsRunning() ? "Watching" : "Not watching",
+        reloads.textures, reloads.skills, reloads.prefabs, reloads.folders, reloads.failed);
+    if (reloads.lastFile != "") {
+        ImGui::Text("Last reload: %s in %.2f ms", reloads.lastFile.c_str(), reloads.lastMilliseconds);
+    }
+    /************** HOT RELOAD ***************/
+
+    /************** AUDIO ***************/
+    AudioManager& audio{ assetmanager.audio };
+    ImGui::Checkbox("Load sounds in the background", &audio.asyncLoads);
+    ImGui::SameLine();
+    ImGui::Checkbox("Stream music", &audio.streamMusic);
+    ImGui::SameLine();
+    ImGui::Checkbox("Keep sound effects compressed", &audio.compressSounds);
+    AudioStats const audioStats{ audio.GetStats() };
+    ImGui::Text("%s: %zu sounds (%zu loading) holding %.1f MB, %zu loads in %.2f ms avg, %zu unloaded over budget, %zu failed", audio.GetBackendName(),
+        audioStats.sounds, audioStats.loading, audioStats.memory / (1024.0 * 1024.0), audioStats.loads,
+        audioStats.loads > 0 ? audioStats.loadMilliseconds / audioStats.loads : 0.0, audioStats.unloaded, audioStats.failed);
+    if (audioStats.lastLoad != "") {
+        ImGui::Text("Last load: %s in %.2f ms", audioStats.lastLoad.c_str(), audioStats.lastLoadMilliseconds);
+    }
+    for (const char* groupName : { "SFX", "VOC", "BGM", "ENV" }) {
+        int budget{ static_cast<int>(audio.GetGroupBudget(groupName) >> 20) };
+        ImGui::Text("%s: %.1f MB", groupName, audio.GetGroupMemory(groupName) / (1024.0 * 1024.0));
+        ImGui::SameLine();
+        if (ImGui::SliderInt((std::string{ "Budget (MB, 0 for none)##" } + groupName).c_str(), &budget, 0, 256)) {
+            audio.SetGroupBudget(groupName, static_cast<size_t>(budget) << 20);
+        }
+    }
+    if (ImGui::Button("Run audio load benchmark")) {
+        audioLoadBenchmark = audio.RunLoadBenchmark();
+    }
+    if (audioLoadBenchmark.backend != "") {
+        ImGui::Text("Load benchmark (%s):", audioLoadBenchmark.backend.c_str());
+        ImGui::Text("%zu files decoded: %.1f MB in %.2f ms", audioLoadBenchmark.decoded.files,
+            audioLoadBenchmark.decoded.memory / (1024.0 * 1024.0), audioLoadBenchmark.decoded.milliseconds);
+        ImGui::Text("%zu files as set: %.1f MB in %.2f ms", audioLoadBenchmark.asSet.files,
+            audioLoadBenchmark.asSet.memory / (1024.0 * 1024.0), audioLoadBenchmark.asSet.milliseconds);
+    }
+    /************** AUDIO ***************/
+
+    /************** ASSET RESIDENCY ***************/
+    ImGui::Checkbox("Keep assets shared between scenes", &assetmanager.keepSharedAssets);
+    SceneSwitchStats const& sceneSwitch{ assetmanager.GetLastSceneSwitch() };
+    if (sceneSwitch.scene != "") {
+        ImGui::Text("Last scene change: %s in %.2f ms (%s)", sceneSwitch.scene.c_str(), sceneSwitch.milliseconds,
+            sceneSwitch.keptShared ? "shared assets kept" : "all assets unloaded");
+        ImGui::Text("%zu assets loaded, %zu kept loaded, %zu unloaded", sceneSwitch.loaded, sceneSwitch.reused, sceneSwitch.released);
+    }
+    /************** ASSET RESIDENCY ***************/
+
+    /************** SCENE SAVING ***************/
+    ImGui::Checkbox("Autosave", &sceneSaver.autosave);
+    ImGui::SameLine();
+    ImGui::SliderFloat("Autosave interval (s)", &sceneSaver.autosaveInterval, 5.f, 600.f, "%.0f");
+    SceneSaveStats lastSave{ sceneSaver.GetLastSave() };
+    if (lastSave.file != "") {
+        ImGui::Text("Last %s: %s", lastSave.autosave ? "autosave" : "save", std::filesystem::path{ lastSave.file }.filename().string().c_str());
+        ImGui::Text("%zu entities, %zu serialized again in %.2f ms, written in %.2f ms%s", lastSave.entities, lastSave.serialized,
+            lastSave.snapshotMilliseconds, lastSave.writeMilliseconds, sceneSaver.IsWriting() ? " (writing)" : "");
+    }
+    /************** SCENE SAVING ***************/
+
     /************** LEVEL EDITOR USAGE ***************/
     // Separate each bar with a separator
     ImGui::SeparatorEx(ImGuiSeparatorFlags_Horizontal);
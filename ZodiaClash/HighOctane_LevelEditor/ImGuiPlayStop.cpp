@@ -79,7 +79,8 @@ void UpdatePlayStop() {
             playIcon = false;
             if (!playButton && GetCurrentSystemMode() != SystemMode::PAUSE && GetCurrentSystemMode() != SystemMode::GAMEHELP) {
                 stopBuffer = true;
-                events.Call("Change Scene", "tmp.scn");
+                stopButton = true;
+                button_clicked = true;
                 SetCurrentSystemMode(SystemMode::EDIT);
             }
         }
@@ -70,6 +70,9 @@
 #include "Particles.h"
 #include "Tutorial.h"
 #include "Global.h"
+#include "AIDecisionJob.h"
+#include "BalanceSim.h"
+#include "AssetPack.h"
 
 bool gConsoleInitalized{ false };
 constexpr bool GAME_MODE{ false }; // Do not edit this
@@ -137,6 +140,56 @@ std::vector<std::pair<std::shared_ptr<System>, std::string>> systemList;
 
 
 
+/******************************************************************************
+*
+*	@brief Registers every component used in the ECS
+*
+*	Called by EngineCore::Run, and by the simulation parity check, which runs
+*	the battle system without the rest of the engine.
+*
+******************************************************************************/
+void RegisterComponents() {
+	ECS::ecs().Init();
+	ECS::ecs().RegisterComponent<Transform>();
+	ECS::ecs().RegisterComponent<Color>();
+	ECS::ecs().RegisterComponent<Size>();
+	ECS::ecs().RegisterComponent<Visible>();
+	ECS::ecs().RegisterComponent<Tex>();
+	ECS::ecs().RegisterComponent<MainCharacter>();
+	ECS::ecs().RegisterComponent<Model>();
+	ECS::ecs().RegisterComponent<Master>();
+	ECS::ecs().RegisterComponent<Clone>();
+	ECS::ecs().RegisterComponent<Collider>();
+	ECS::ecs().RegisterComponent<Name>();
+	ECS::ecs().RegisterComponent<Tag>();
+	ECS::ecs().RegisterComponent<Movable>();
+	ECS::ecs().RegisterComponent<CharacterStats>();
+	ECS::ecs().RegisterComponent<AnimationSet>();
+	ECS::ecs().RegisterComponent<TextLabel>();
+	ECS::ecs().RegisterComponent<Button>();
+	ECS::ecs().RegisterComponent<HealthBar>();
+	ECS::ecs().RegisterComponent<HealthRemaining>();
+	ECS::ecs().RegisterComponent<HealthLerp>();
+	ECS::ecs().RegisterComponent<SkillPointHUD>();
+	ECS::ecs().RegisterComponent<SkillPoint>();
+	ECS::ecs().RegisterComponent<AttackSkill>();
+	ECS::ecs().RegisterComponent<SkillIcon>();
+	ECS::ecs().RegisterComponent<SkillCost>();
+	ECS::ecs().RegisterComponent<SkillAttackType>();
+	ECS::ecs().RegisterComponent<AllyHUD>();
+	ECS::ecs().RegisterComponent<EnemyHUD>();
+	ECS::ecs().RegisterComponent<TurnIndicator>();
+	ECS::ecs().RegisterComponent<StatusEffect>();
+	ECS::ecs().RegisterComponent<DialogueSpeaker>();
+	ECS::ecs().RegisterComponent<DialogueHUD>();
+	ECS::ecs().RegisterComponent<SliderUI>();
+	ECS::ecs().RegisterComponent<Parent>();
+	ECS::ecs().RegisterComponent<Child>();
+	ECS::ecs().RegisterComponent<Emitter>();
+	ECS::ecs().RegisterComponent<Particle>();
+	ECS::ecs().RegisterComponent<Temporary>();
+}
+
 int APIENTRY wWinMain(_In_ HINSTANCE hInstance,
                      _In_opt_ HINSTANCE hPrevInstance,
                      _In_ LPWSTR    lpCmdLine,
@@ -160,11 +213,29 @@ int APIENTRY wWinMain(_In_ HINSTANCE hInstance,
     hInstance = hInstance; //unused variable
 
     UNREFERENCED_PARAMETER(hPrevInstance);
-    UNREFERENCED_PARAMETER(lpCmdLine);
 	
     // To enable the console
     Console();
 
+    // Headless balance simulation, runs without graphics or audio (see BalanceSim.h)
+    // --pack builds Assets/Assets.zpak and exits (see AssetPack.h)
+    // --verify-sim checks the AI simulation against the battle system and exits (see BalanceSim.h)
+    int commandLength{ WideCharToMultiByte(CP_UTF8, 0, lpCmdLine, -1, nullptr, 0, nullptr, nullptr) };
+    if (commandLength > 1) {
+        std::string commandLine(commandLength - 1, '\0');
+        WideCharToMultiByte(CP_UTF8, 0, lpCmdLine, -1, commandLine.data(), commandLength, nullptr, nullptr);
+        if (IsBalanceCommandLine(commandLine)) {
+            return RunBalanceCommandLine(commandLine);
+        }
+        if (IsPackCommandLine(commandLine)) {
+            return RunPackCommandLine();
+        }
+        if (IsVerifySimCommandLine(commandLine)) {
+            RegisterComponents();
+            return RunVerifySimCommandLine(commandLine);
+        }
+    }
+
 #if _DEBUG
 	LOG_SET_LEVEL(debuglog::LOG_LEVEL::Trace);
 	LOG_TRACE("This is a test trace message");
@@ -194,45 +265,7 @@ void EngineCore::Run(bool const& mode) {
 	////////// INITIALIZE //////////
 
 // Register components to be used in the ECS
-	ECS::ecs().Init();
-	ECS::ecs().RegisterComponent<Transform>();
-	ECS::ecs().RegisterComponent<Color>();
-	ECS::ecs().RegisterComponent<Size>();
-	ECS::ecs().RegisterComponent<Visible>();
-	ECS::ecs().RegisterComponent<Tex>();
-	ECS::ecs().RegisterComponent<MainCharacter>();
-	ECS::ecs().RegisterComponent<Model>();
-	ECS::ecs().RegisterComponent<Master>();
-	ECS::ecs().RegisterComponent<Clone>();
-	ECS::ecs().RegisterComponent<Collider>();
-	ECS::ecs().RegisterComponent<Name>();
-	ECS::ecs().RegisterComponent<Tag>();
-	ECS::ecs().RegisterComponent<Movable>();
-	ECS::ecs().RegisterComponent<CharacterStats>();
-	ECS::ecs().RegisterComponent<AnimationSet>();
-	ECS::ecs().RegisterComponent<TextLabel>();
-	ECS::ecs().RegisterComponent<Button>();
-	ECS::ecs().RegisterComponent<HealthBar>();
-	ECS::ecs().RegisterComponent<HealthRemaining>();
-	ECS::ecs().RegisterComponent<HealthLerp>();
-	ECS::ecs().RegisterComponent<SkillPointHUD>();
-	ECS::ecs().RegisterComponent<SkillPoint>();
-	ECS::ecs().RegisterComponent<AttackSkill>();
-	ECS::ecs().RegisterComponent<SkillIcon>();
-	ECS::ecs().RegisterComponent<SkillCost>();
-	ECS::ecs().RegisterComponent<SkillAttackType>();
-	ECS::ecs().RegisterComponent<AllyHUD>();
-	ECS::ecs().RegisterComponent<EnemyHUD>();
-	ECS::ecs().RegisterComponent<TurnIndicator>();
-	ECS::ecs().RegisterComponent<StatusEffect>();
-	ECS::ecs().RegisterComponent<DialogueSpeaker>();
-	ECS::ecs().RegisterComponent<DialogueHUD>();
-	ECS::ecs().RegisterComponent<SliderUI>();
-	ECS::ecs().RegisterComponent<Parent>();
-	ECS::ecs().RegisterComponent<Child>();
-	ECS::ecs().RegisterComponent<Emitter>();
-	ECS::ecs().RegisterComponent<Particle>();
-	ECS::ecs().RegisterComponent<Temporary>();
+	RegisterComponents();
 
 	// Register systems to be used in the ECS
 	std::shared_ptr<MovementSystem> movementSystem = ECS::ecs().RegisterSystem<MovementSystem>();
@@ -823,6 +856,9 @@ void EngineCore::Run(bool const& mode) {
 	///////////////////////////////////////
 
 
+	//Joins a search still running before the thread pool is destroyed
+	aiDecisionJob.Cancel();
+
 	delete physics::PHYSICS;
 
 